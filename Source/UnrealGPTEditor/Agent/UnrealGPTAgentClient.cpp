@@ -13,6 +13,12 @@
 #include "UnrealGPTSessionWriter.h"
 #include "UnrealGPTResponseHandler.h"
 #include "UnrealGPTRequestSender.h"
+#include "UnrealGPTToolResultCache.h"
+#include "UnrealGPTToolExecutor.h"
+#include "UnrealGPTNotifier.h"
+#include "UnrealGPTConversationState.h"
+#include "UnrealGPTJsonHelpers.h"
+#include "UnrealGPTWorldPartition.h"
 #include "UnrealGPTSessionManager.h"
 #include "Misc/EngineVersion.h"
 
@@ -162,6 +168,36 @@ void UUnrealGPTAgentClient::CancelRequest()
 		CurrentRequest->CancelRequest();
 		bRequestInProgress = false;
 	}
+
+	// Generations and imports in flight would otherwise resume the conversation when they finish
+	TArray<FString> CancelledToolCalls;
+	ActiveAsyncTools.GetKeys(CancelledToolCalls);
+	CancelActiveAsyncTools();
+	UUnrealGPTToolExecutor::CancelPythonExecution();
+
+	// Their completions will never arrive. The Responses API rejects a follow-up whose function
+	// calls have no output, so record one for each, and close out anything shown as in progress
+	const FString CancelledResult = UnrealGPTJsonHelpers::MakeToolResult(TEXT("cancelled"), TEXT("Cancelled by the user"));
+	for (const FString& ToolCallId : CancelledToolCalls)
+	{
+		UnrealGPTConversationState::AppendMessage(ConversationHistory, UnrealGPTConversationState::CreateToolMessage(CancelledResult, ToolCallId));
+		SaveToolMessageToSession(ToolCallId, CancelledResult, TArray<FString>());
+		UnrealGPTNotifier::BroadcastToolResult(this, ToolCallId, CancelledResult);
+	}
+}
+
+void UUnrealGPTAgentClient::CancelActiveAsyncTools()
+{
+	// A cancel function may complete other work synchronously, so walk a detached copy
+	TMap<FString, TFunction<void()>> Tools = MoveTemp(ActiveAsyncTools);
+	ActiveAsyncTools.Reset();
+	for (TPair<FString, TFunction<void()>>& Tool : Tools)
+	{
+		if (Tool.Value)
+		{
+			Tool.Value();
+		}
+	}
 }
 
 void UUnrealGPTAgentClient::ClearHistory()
@@ -170,8 +206,15 @@ void UUnrealGPTAgentClient::ClearHistory()
 	PreviousResponseId.Empty();
 	ToolCallIterationCount = 0;
 	ExecutedToolCallSignatures.Reset();
+	FUnrealGPTToolResultCache::Get().Invalidate();
 	bLastToolWasPythonExecute = false;
 	bLastSceneQueryFoundResults = false;
+
+	// Results of async tools started in the old conversation have nowhere to go
+	CancelActiveAsyncTools();
+
+	// World Partition actors the old conversation loaded no longer need to stay in memory
+	FUnrealGPTWorldPartition::UnpinLoadedActors();
 }
 
 FString UUnrealGPTAgentClient::GenerateSessionId()
@@ -13,6 +13,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAgentMessage, const FString&,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAgentReasoning, const FString&, ReasoningContent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnToolCall, const FString&, ToolName, const FString&, Arguments);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnToolResult, const FString&, ToolCallId, const FString&, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnToolProgress, const FString&, ToolCallId, const FString&, Status, float, Progress);
 
 USTRUCT()
 struct FAgentMessage
@@ -31,6 +32,9 @@ struct FAgentMessage
 	UPROPERTY()
 	FString ToolCallId; // For tool messages, the specific tool_call_id
 
+	UPROPERTY()
+	FString ToolName; // For tool messages, the tool that produced the result (empty for restored sessions)
+
 	UPROPERTY()
 	FString ToolCallsJson; // For assistant messages, stores the tool_calls array as JSON string
 };
@@ -112,6 +116,10 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FOnToolResult OnToolResult;
 
+	/** Delegate for progress of long-running tools; Progress is 0-1, or negative when unknown */
+	UPROPERTY(BlueprintAssignable)
+	FOnToolProgress OnToolProgress;
+
 private:
 	/** Handle HTTP response */
 	void OnResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
@@ -157,6 +165,12 @@ private:
 	 */
 	bool bLastSceneQueryFoundResults;
 
+	/** Cancel functions of the async tools this client started and that have not completed, keyed by tool call id */
+	TMap<FString, TFunction<void()>> ActiveAsyncTools;
+
+	/** Cancel this client's async tools without invoking their completions; tools started elsewhere keep running */
+	void CancelActiveAsyncTools();
+
 	/** Settings reference */
 	class UUnrealGPTSettings* Settings;
 
@@ -43,7 +43,9 @@ FString UnrealGPTAgentInstructions::GetInstructions(const FString& EngineVersion
 		"  - 'snap_actor_to_ground': Snap actor to surface below with optional normal alignment\n"
 		"  - 'duplicate_actor': Clone an actor N times with offset\n"
 		"  - 'select_actors': Select actors by label\n"
-		"  - 'scene_query': Find actors by class/label/name with optional detail flags\n\n"
+		"  - 'scene_query': Find actors by class/label/name with optional detail flags (also finds unloaded World Partition actors; load=true loads them)\n"
+		"  - 'scene_overview': Grid overview of a large level; drill into a cell id before querying actors\n"
+		"  - 'check_placement': Check boxes/spheres for overlaps with existing geometry; pass a whole layout in one call before spawning it\n\n"
 		"USE 'python_execute' for operations not covered by atomic tools:\n"
 		"  - Spawning new actors from scratch\n"
 		"  - Material/texture changes\n"
@@ -54,7 +56,7 @@ FString UnrealGPTAgentInstructions::GetInstructions(const FString& EngineVersion
 		// ==================== VERIFICATION STRATEGY ====================
 		"=== VERIFICATION STRATEGY BY TASK TYPE ===\n\n"
 		"VISUAL/SCENE CHANGES (spawning, moving, materials, lighting):\n"
-		"  - OBSERVE: scene_query to see what exists\n"
+		"  - OBSERVE: scene_query to see what exists; check_placement for where new objects will go\n"
 		"  - ACT: atomic tool or python_execute\n"
 		"  - VERIFY: scene_query + viewport_screenshot, describe what you see\n"
 		"  - Check for: correct position, no clipping into ground, proper scale, expected appearance\n\n"
@@ -68,7 +70,7 @@ FString UnrealGPTAgentInstructions::GetInstructions(const FString& EngineVersion
 
 		// ==================== AVAILABLE TOOLS ====================
 		"=== AVAILABLE TOOLS ===\n\n"
-		"Query/Inspect: scene_query, get_actor, reflection_query, viewport_screenshot\n"
+		"Query/Inspect: scene_query, scene_overview, get_actor, check_placement, reflection_query, viewport_screenshot\n"
 		"Atomic Actions: set_actor_transform, set_actors_rotation, snap_actor_to_ground, duplicate_actor, select_actors\n"
 		"Python: python_execute (for complex operations)\n"
 		"Search: file_search (UE Python API docs), web_search\n"
@@ -107,7 +109,9 @@ FString UnrealGPTAgentInstructions::GetInstructions(const FString& EngineVersion
 		"  - asset_data.object_path (removed in UE 5.1+)\n"
 		"  - Guessing at method signatures without file_search verification\n\n"
 		"Python results: Set result['status'], result['message'], result['details']. "
-		"Include result['details']['actor_label'] for auto-focus on created actors.\n\n"
+		"Include result['details']['actor_label'] for auto-focus on created actors. "
+		"In long loops, print a short line now and then or use unreal.ScopedSlowTask so the user sees progress and can cancel; "
+		"result['status'] == 'cancelled' means the user stopped the script.\n\n"
 
 		// ==================== IMPORTANT RULES ====================
 		"=== IMPORTANT RULES ===\n\n"
@@ -138,6 +142,6 @@ FString UnrealGPTAgentInstructions::GetInstructions(const FString& EngineVersion
 		"  - output_kind='image' for textures\n"
 		"  - output_kind='3d' for meshes\n"
 		"  - output_kind='audio' with output_subkind='sfx'|'music'|'speech'\n"
-		"After generation, import with python_execute using 'unrealgpt_mcp_import' helpers, then verify."
+		"After generation, import all files in one 'import_generated' call, then verify."
 	), *EngineVersion);
 }
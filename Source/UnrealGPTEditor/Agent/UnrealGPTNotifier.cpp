@@ -84,3 +84,24 @@ void UnrealGPTNotifier::BroadcastToolResult(UUnrealGPTAgentClient* Client, const
 		Client->OnToolResult.Broadcast(ToolCallIdCopy, ResultCopy);
 	});
 }
+
+void UnrealGPTNotifier::BroadcastToolProgress(UUnrealGPTAgentClient* Client, const FString& ToolCallId, const FString& Status, float Progress)
+{
+	if (!Client)
+	{
+		return;
+	}
+
+	if (IsInGameThread())
+	{
+		Client->OnToolProgress.Broadcast(ToolCallId, Status, Progress);
+		return;
+	}
+
+	FString ToolCallIdCopy = ToolCallId;
+	FString StatusCopy = Status;
+	AsyncTask(ENamedThreads::GameThread, [Client, ToolCallIdCopy, StatusCopy, Progress]()
+	{
+		Client->OnToolProgress.Broadcast(ToolCallIdCopy, StatusCopy, Progress);
+	});
+}
@@ -11,4 +11,5 @@ public:
 	static void BroadcastAgentReasoning(UUnrealGPTAgentClient* Client, const FString& Content);
 	static void BroadcastToolCall(UUnrealGPTAgentClient* Client, const FString& ToolName, const FString& ArgumentsJson);
 	static void BroadcastToolResult(UUnrealGPTAgentClient* Client, const FString& ToolCallId, const FString& Result);
+	static void BroadcastToolProgress(UUnrealGPTAgentClient* Client, const FString& ToolCallId, const FString& Status, float Progress);
 };
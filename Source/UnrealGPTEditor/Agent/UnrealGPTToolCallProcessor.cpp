@@ -5,7 +5,6 @@
 #include "UnrealGPTSettings.h"
 #include "UnrealGPTToolDispatcher.h"
 #include "UnrealGPTToolResultProcessor.h"
-#include "Async/Async.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 
@@ -67,13 +66,7 @@ void UnrealGPTToolCallProcessor::ProcessToolCalls(
 		return Name == TEXT("file_search") || Name == TEXT("web_search");
 	};
 
-	auto IsAsyncTool = [](const FString& Name) -> bool
-	{
-		// replicate_generate is async to avoid blocking the editor thread.
-		return Name == TEXT("replicate_generate");
-	};
-
-	auto ExecuteToolCall = [Client](const FString& ToolName, const FString& ArgumentsJson) -> FString
+	auto ExecuteToolCall = [Client](const FString& ToolName, const FString& ArgumentsJson, const FString& CallId) -> FString
 	{
 		return UnrealGPTToolDispatcher::ExecuteToolCall(
 			ToolName,
@@ -83,6 +76,10 @@ void UnrealGPTToolCallProcessor::ProcessToolCalls(
 			[Client](const FString& ToolNameInner, const FString& ArgumentsJsonInner)
 			{
 				UnrealGPTNotifier::BroadcastToolCall(Client, ToolNameInner, ArgumentsJsonInner);
+			},
+			[Client, CallId](const FString& Status, float Progress)
+			{
+				UnrealGPTNotifier::BroadcastToolProgress(Client, CallId, Status, Progress);
 			});
 	};
 
@@ -90,6 +87,9 @@ void UnrealGPTToolCallProcessor::ProcessToolCalls(
 	bool bHasAsyncTools = false;
 	TArray<FString> ScreenshotImages;
 
+	// All async tools of this turn answer through a single continuation once the last one finishes
+	TSharedRef<FUnrealGPTAsyncToolBatch> PendingAsyncTools = MakeShared<FUnrealGPTAsyncToolBatch>();
+
 	for (const FToolCallInfo& CallInfo : ToolCalls)
 	{
 		if (IsServerSideTool(CallInfo.Name))
@@ -98,7 +98,7 @@ void UnrealGPTToolCallProcessor::ProcessToolCalls(
 			continue;
 		}
 
-		const bool bIsAsyncTool = IsAsyncTool(CallInfo.Name);
+		const bool bIsAsyncTool = UnrealGPTToolDispatcher::IsAsyncTool(CallInfo.Name);
 
 		bHasClientSideTools = true;
 
@@ -111,41 +111,68 @@ void UnrealGPTToolCallProcessor::ProcessToolCalls(
 			const FString CallIdCopy = CallInfo.Id;
 			const int32 MaxToolResultSizeLocal = Client->MaxToolResultSize;
 
-			Async(EAsyncExecution::ThreadPool, [Client, ToolNameCopy, ArgsCopy, CallIdCopy, MaxToolResultSizeLocal, ExecuteToolCall]()
+			// Same bookkeeping ExecuteToolCall does for synchronous tools
+			Client->bLastToolWasPythonExecute = false;
+			Client->bLastSceneQueryFoundResults = false;
+			UnrealGPTNotifier::BroadcastToolCall(Client, ToolNameCopy, ArgsCopy);
+
+			// Async tools are driven by callbacks, so no thread waits on them.
+			// UUnrealGPTAgentClient::CancelRequest cancels the ones recorded here without invoking the completion.
+			TWeakObjectPtr<UUnrealGPTAgentClient> WeakClient(Client);
+			PendingAsyncTools->AddTool();
+			Client->ActiveAsyncTools.Add(CallIdCopy);
+			TFunction<void()> CancelTool = UnrealGPTToolDispatcher::StartAsyncTool(ToolNameCopy, ArgsCopy,
+				[WeakClient, ToolNameCopy, ArgsCopy, CallIdCopy, MaxToolResultSizeLocal, PendingAsyncTools](const FString& ToolResult)
 			{
-				const FString ToolResult = ExecuteToolCall(ToolNameCopy, ArgsCopy);
+				UUnrealGPTAgentClient* LiveClient = WeakClient.Get();
+				if (!LiveClient)
+				{
+					return;
+				}
+				LiveClient->ActiveAsyncTools.Remove(CallIdCopy);
 
 				FProcessedToolResult ProcessedToolResult =
 					UnrealGPTToolResultProcessor::ProcessResult(ToolNameCopy, ToolResult, MaxToolResultSizeLocal);
 
-				AsyncTask(ENamedThreads::GameThread, [Client, ToolNameCopy, ArgsCopy, CallIdCopy, ToolResult, ProcessedToolResult]()
-				{
-					FAgentMessage ToolMsg = UnrealGPTConversationState::CreateToolMessage(ProcessedToolResult.ResultForHistory, CallIdCopy);
-					UnrealGPTConversationState::AppendMessage(Client->ConversationHistory, ToolMsg);
+				FAgentMessage ToolMsg = UnrealGPTConversationState::CreateToolMessage(ProcessedToolResult.ResultForHistory, CallIdCopy, ToolNameCopy);
+				UnrealGPTConversationState::AppendMessage(LiveClient->ConversationHistory, ToolMsg);
+
+				LiveClient->SaveToolMessageToSession(CallIdCopy, ProcessedToolResult.ResultForHistory, ProcessedToolResult.Images);
+				LiveClient->SaveToolCallToSession(ToolNameCopy, ArgsCopy, ProcessedToolResult.ResultForDisplay);
 
-					Client->SaveToolMessageToSession(CallIdCopy, ProcessedToolResult.ResultForHistory, ProcessedToolResult.Images);
-					Client->SaveToolCallToSession(ToolNameCopy, ArgsCopy, ToolResult);
+				UnrealGPTNotifier::BroadcastToolResult(LiveClient, CallIdCopy, ProcessedToolResult.ResultForDisplay);
 
-					UnrealGPTNotifier::BroadcastToolResult(Client, CallIdCopy, ToolResult);
-					Client->SendMessage(TEXT(""), TArray<FString>());
-				});
+				if (PendingAsyncTools->CompleteTool(ProcessedToolResult.Images))
+				{
+					LiveClient->SendMessage(TEXT(""), PendingAsyncTools->GetImages());
+				}
+			},
+			[WeakClient, CallIdCopy](const FString& Status, float Progress)
+			{
+				UnrealGPTNotifier::BroadcastToolProgress(WeakClient.Get(), CallIdCopy, Status, Progress);
 			});
+
+			// The completion may already have run and removed the entry
+			if (TFunction<void()>* ActiveTool = Client->ActiveAsyncTools.Find(CallIdCopy))
+			{
+				*ActiveTool = MoveTemp(CancelTool);
+			}
 			continue;
 		}
 
 		// Synchronous execution
-		FString ToolResult = ExecuteToolCall(CallInfo.Name, CallInfo.Arguments);
+		FString ToolResult = ExecuteToolCall(CallInfo.Name, CallInfo.Arguments, CallInfo.Id);
 		FProcessedToolResult ProcessedToolResult =
 			UnrealGPTToolResultProcessor::ProcessResult(CallInfo.Name, ToolResult, Client->MaxToolResultSize);
 		ScreenshotImages.Append(ProcessedToolResult.Images);
 
-		FAgentMessage ToolMsg = UnrealGPTConversationState::CreateToolMessage(ProcessedToolResult.ResultForHistory, CallInfo.Id);
+		FAgentMessage ToolMsg = UnrealGPTConversationState::CreateToolMessage(ProcessedToolResult.ResultForHistory, CallInfo.Id, CallInfo.Name);
 		UnrealGPTConversationState::AppendMessage(Client->ConversationHistory, ToolMsg);
 
 		Client->SaveToolMessageToSession(CallInfo.Id, ProcessedToolResult.ResultForHistory, ProcessedToolResult.Images);
-		Client->SaveToolCallToSession(CallInfo.Name, CallInfo.Arguments, ToolResult);
+		Client->SaveToolCallToSession(CallInfo.Name, CallInfo.Arguments, ProcessedToolResult.ResultForDisplay);
 
-		UnrealGPTNotifier::BroadcastToolResult(Client, CallInfo.Id, ToolResult);
+		UnrealGPTNotifier::BroadcastToolResult(Client, CallInfo.Id, ProcessedToolResult.ResultForDisplay);
 	}
 
 	if (!bHasClientSideTools)
@@ -157,8 +184,13 @@ void UnrealGPTToolCallProcessor::ProcessToolCalls(
 
 	if (bHasAsyncTools)
 	{
-		UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Async tools scheduled; waiting for completion."));
-		return;
+		// The continuation carries this turn's screenshots along with whatever the async tools return
+		if (!PendingAsyncTools->Release(ScreenshotImages))
+		{
+			UE_LOG(LogTemp, Log, TEXT("UnrealGPT: %d async tool(s) scheduled; waiting for completion."), PendingAsyncTools->GetNumPending());
+			return;
+		}
+		ScreenshotImages = PendingAsyncTools->GetImages();
 	}
 
 	const int32 MaxIterations = Client->Settings ? Client->Settings->MaxToolCallIterations : 100;
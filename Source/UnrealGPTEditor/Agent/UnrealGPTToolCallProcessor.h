@@ -5,6 +5,40 @@
 
 class UUnrealGPTAgentClient;
 
+/**
+ * Counts the async tools of one turn so their results go out in a single continuation.
+ * The turn holds a count of its own until Release(), so tools that complete while it is
+ * still starting the others cannot send early, and exactly one of CompleteTool()/Release()
+ * returns true.
+ */
+class FUnrealGPTAsyncToolBatch
+{
+public:
+	/** Call before starting each async tool */
+	void AddTool() { ++NumPending; }
+
+	/** Record a finished tool's images; true if it was the last one and the continuation should be sent */
+	bool CompleteTool(const TArray<FString>& ToolImages)
+	{
+		Images.Append(ToolImages);
+		return --NumPending == 0;
+	}
+
+	/** Drop the turn's own count once every tool was started; true if none is still running */
+	bool Release(const TArray<FString>& TurnImages)
+	{
+		Images.Insert(TurnImages, 0);
+		return --NumPending == 0;
+	}
+
+	int32 GetNumPending() const { return NumPending; }
+	const TArray<FString>& GetImages() const { return Images; }
+
+private:
+	int32 NumPending = 1;
+	TArray<FString> Images;
+};
+
 class UnrealGPTToolCallProcessor
 {
 public:
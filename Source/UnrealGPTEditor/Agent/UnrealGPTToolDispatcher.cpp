@@ -1,8 +1,12 @@
 #include "UnrealGPTToolDispatcher.h"
+#include "UnrealGPTAssetImporter.h"
 #include "UnrealGPTJsonHelpers.h"
+#include "UnrealGPTPlacementValidator.h"
 #include "UnrealGPTReplicateClient.h"
+#include "UnrealGPTSceneClusters.h"
 #include "UnrealGPTSceneContext.h"
 #include "UnrealGPTToolExecutor.h"
+#include "UnrealGPTToolResultCache.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 
@@ -11,7 +15,8 @@ FString UnrealGPTToolDispatcher::ExecuteToolCall(
 	const FString& ArgumentsJson,
 	bool& bLastToolWasPythonExecute,
 	bool& bLastSceneQueryFoundResults,
-	TFunction<void(const FString&, const FString&)> BroadcastToolCall)
+	TFunction<void(const FString&, const FString&)> BroadcastToolCall,
+	TFunction<void(const FString&, float)> OnProgress)
 {
 	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: ExecuteToolCall ENTRY - Tool: %s, Args length: %d"), *ToolName, ArgumentsJson.Len());
 
@@ -20,7 +25,17 @@ FString UnrealGPTToolDispatcher::ExecuteToolCall(
 	const bool bIsPythonExecute = (ToolName == TEXT("python_execute"));
 	const bool bIsSceneQuery = (ToolName == TEXT("scene_query"));
 
-	if (bIsPythonExecute)
+	// Read-only tools repeated with the same arguments against an unchanged editor reuse the earlier result
+	FUnrealGPTToolResultCache& ResultCache = FUnrealGPTToolResultCache::Get();
+	const bool bCacheable = FUnrealGPTToolResultCache::IsCacheable(ToolName);
+	const uint64 StartGeneration = ResultCache.GetGeneration();
+	const bool bCacheHit = bCacheable && ResultCache.Lookup(ToolName, ArgumentsJson, Result);
+
+	if (bCacheHit)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Reused cached %s result (%d chars); the editor has not changed since"), *ToolName, Result.Len());
+	}
+	else if (bIsPythonExecute)
 	{
 		TSharedPtr<FJsonObject> ArgsObj;
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgumentsJson);
@@ -29,7 +44,7 @@ FString UnrealGPTToolDispatcher::ExecuteToolCall(
 			FString Code;
 			if (ArgsObj->TryGetStringField(TEXT("code"), Code))
 			{
-				Result = UUnrealGPTToolExecutor::ExecutePythonCode(Code);
+				Result = UUnrealGPTToolExecutor::ExecutePythonCode(Code, MoveTemp(OnProgress));
 			}
 		}
 	}
@@ -54,33 +69,14 @@ FString UnrealGPTToolDispatcher::ExecuteToolCall(
 	else if (bIsSceneQuery)
 	{
 		Result = UUnrealGPTSceneContext::QueryScene(ArgumentsJson);
-
-		bLastSceneQueryFoundResults = !Result.IsEmpty() && Result != TEXT("[]") && Result.StartsWith(TEXT("["));
-		if (bLastSceneQueryFoundResults)
-		{
-			TSharedPtr<FJsonValue> JsonValue;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Result);
-			if (FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid())
-			{
-				const TArray<TSharedPtr<FJsonValue>>* JsonArray = nullptr;
-				if (JsonValue->Type == EJson::Array && JsonValue->TryGetArray(JsonArray))
-				{
-					bLastSceneQueryFoundResults = (JsonArray->Num() > 0);
-					if (bLastSceneQueryFoundResults)
-					{
-						UE_LOG(LogTemp, Log, TEXT("UnrealGPT: scene_query found %d results - will block subsequent python_execute"), JsonArray->Num());
-					}
-				}
-				else
-				{
-					bLastSceneQueryFoundResults = false;
-				}
-			}
-			else
-			{
-				bLastSceneQueryFoundResults = false;
-			}
-		}
+	}
+	else if (ToolName == TEXT("scene_overview"))
+	{
+		Result = FUnrealGPTSceneClusters::QueryOverview(ArgumentsJson);
+	}
+	else if (ToolName == TEXT("check_placement"))
+	{
+		Result = FUnrealGPTPlacementValidator::CheckPlacements(ArgumentsJson);
 	}
 	else if (ToolName == TEXT("reflection_query"))
 	{
@@ -105,9 +101,10 @@ FString UnrealGPTToolDispatcher::ExecuteToolCall(
 
 		Result = UnrealGPTJsonHelpers::BuildReflectionSchemaJson(TargetClass);
 	}
-	else if (ToolName == TEXT("replicate_generate"))
+	else if (IsAsyncTool(ToolName))
 	{
-		Result = UUnrealGPTReplicateClient::Generate(ArgumentsJson);
+		// Async tools are started with StartAsyncTool by the caller
+		Result = FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Tool '%s' completes asynchronously and cannot be run synchronously\"}"), *ToolName);
 	}
 	else if (ToolName == TEXT("file_search") || ToolName == TEXT("web_search"))
 	{
@@ -143,9 +140,51 @@ FString UnrealGPTToolDispatcher::ExecuteToolCall(
 		Result = FString::Printf(TEXT("Unknown tool: %s"), *ToolName);
 	}
 
+	if (bCacheable)
+	{
+		if (!bCacheHit)
+		{
+			ResultCache.Store(ToolName, ArgumentsJson, Result, StartGeneration);
+		}
+	}
+	else if (!FUnrealGPTToolResultCache::IsNeutral(ToolName))
+	{
+		// Anything that is not a pure read may have changed what the cached results describe
+		ResultCache.Invalidate();
+	}
+
 	bLastToolWasPythonExecute = bIsPythonExecute;
 
-	if (!bIsSceneQuery)
+	if (bIsSceneQuery)
+	{
+		bLastSceneQueryFoundResults = !Result.IsEmpty() && Result != TEXT("[]") && Result.StartsWith(TEXT("["));
+		if (bLastSceneQueryFoundResults)
+		{
+			TSharedPtr<FJsonValue> JsonValue;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Result);
+			if (FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid())
+			{
+				const TArray<TSharedPtr<FJsonValue>>* JsonArray = nullptr;
+				if (JsonValue->Type == EJson::Array && JsonValue->TryGetArray(JsonArray))
+				{
+					bLastSceneQueryFoundResults = (JsonArray->Num() > 0);
+					if (bLastSceneQueryFoundResults)
+					{
+						UE_LOG(LogTemp, Log, TEXT("UnrealGPT: scene_query found %d results - will block subsequent python_execute"), JsonArray->Num());
+					}
+				}
+				else
+				{
+					bLastSceneQueryFoundResults = false;
+				}
+			}
+			else
+			{
+				bLastSceneQueryFoundResults = false;
+			}
+		}
+	}
+	else
 	{
 		bLastSceneQueryFoundResults = false;
 	}
@@ -157,3 +196,69 @@ FString UnrealGPTToolDispatcher::ExecuteToolCall(
 
 	return Result;
 }
+
+bool UnrealGPTToolDispatcher::IsAsyncTool(const FString& ToolName)
+{
+	return ToolName == TEXT("replicate_generate") || ToolName == TEXT("import_generated");
+}
+
+TFunction<void()> UnrealGPTToolDispatcher::StartAsyncTool(
+	const FString& ToolName,
+	const FString& ArgumentsJson,
+	TFunction<void(const FString&)> OnComplete,
+	TFunction<void(const FString&, float)> OnProgress)
+{
+	check(IsInGameThread());
+
+	// Generated files and imported assets change what the read-only tools would report
+	FUnrealGPTToolResultCache::Get().Invalidate();
+	OnComplete = [InnerOnComplete = MoveTemp(OnComplete)](const FString& Result)
+	{
+		FUnrealGPTToolResultCache::Get().Invalidate();
+		InnerOnComplete(Result);
+	};
+
+	if (ToolName == TEXT("replicate_generate"))
+	{
+		FOnUnrealGPTReplicateProgress Progress;
+		if (OnProgress)
+		{
+			Progress.BindLambda(MoveTemp(OnProgress));
+		}
+
+		// The client owns running batches; a weak handle is enough to cancel one
+		TWeakPtr<FUnrealGPTReplicateBatch> WeakBatch = UUnrealGPTReplicateClient::GenerateAsync(ArgumentsJson,
+			FOnUnrealGPTReplicateComplete::CreateLambda(MoveTemp(OnComplete)), MoveTemp(Progress));
+
+		return [WeakBatch]()
+		{
+			if (TSharedPtr<FUnrealGPTReplicateBatch> Batch = WeakBatch.Pin())
+			{
+				Batch->Cancel();
+			}
+		};
+	}
+
+	if (ToolName == TEXT("import_generated"))
+	{
+		FOnUnrealGPTImportProgress Progress;
+		if (OnProgress)
+		{
+			Progress.BindLambda(MoveTemp(OnProgress));
+		}
+
+		TWeakPtr<FUnrealGPTAssetImporter> WeakImporter = FUnrealGPTAssetImporter::ImportAsync(ArgumentsJson,
+			FOnUnrealGPTImportComplete::CreateLambda(MoveTemp(OnComplete)), MoveTemp(Progress));
+
+		return [WeakImporter]()
+		{
+			if (TSharedPtr<FUnrealGPTAssetImporter> Importer = WeakImporter.Pin())
+			{
+				Importer->Cancel();
+			}
+		};
+	}
+
+	OnComplete(FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Tool '%s' is not an async tool\"}"), *ToolName));
+	return []() {};
+}
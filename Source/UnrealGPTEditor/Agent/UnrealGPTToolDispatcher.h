@@ -5,10 +5,32 @@
 class UnrealGPTToolDispatcher
 {
 public:
+	/**
+	 * Run a synchronous tool. OnProgress receives a status line and a 0-1 fraction (negative when unknown)
+	 * from tools that report while they run (python_execute stdout and slow tasks).
+	 */
 	static FString ExecuteToolCall(
 		const FString& ToolName,
 		const FString& ArgumentsJson,
 		bool& bLastToolWasPythonExecute,
 		bool& bLastSceneQueryFoundResults,
-		TFunction<void(const FString&, const FString&)> BroadcastToolCall);
+		TFunction<void(const FString&, const FString&)> BroadcastToolCall,
+		TFunction<void(const FString&, float)> OnProgress = nullptr);
+
+	/** Tools that complete through a callback on the game thread instead of returning a result (replicate_generate, import_generated) */
+	static bool IsAsyncTool(const FString& ToolName);
+
+	/**
+	 * Start an async tool on the game thread. OnComplete receives the tool result, possibly before this returns;
+	 * OnProgress receives a status line and a 0-1 fraction (negative when unknown).
+	 *
+	 * The tool keeps itself alive until it completes or is cancelled, so callers need not hold anything.
+	 *
+	 * @return Cancels the tool without invoking OnComplete; safe to call after it finished
+	 */
+	static TFunction<void()> StartAsyncTool(
+		const FString& ToolName,
+		const FString& ArgumentsJson,
+		TFunction<void(const FString&)> OnComplete,
+		TFunction<void(const FString&, float)> OnProgress);
 };
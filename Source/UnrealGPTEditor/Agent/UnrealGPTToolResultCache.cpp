@@ -0,0 +1,139 @@
+#include "UnrealGPTToolResultCache.h"
+#include "UnrealGPTJsonHelpers.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+FUnrealGPTToolResultCache& FUnrealGPTToolResultCache::Get()
+{
+	static FUnrealGPTToolResultCache Instance;
+	return Instance;
+}
+
+bool FUnrealGPTToolResultCache::IsCacheable(const FString& ToolName)
+{
+	// viewport_screenshot is not here: camera moves do not advance the generation
+	return ToolName == TEXT("scene_query")
+		|| ToolName == TEXT("scene_overview")
+		|| ToolName == TEXT("get_actor")
+		|| ToolName == TEXT("check_placement")
+		|| ToolName == TEXT("reflection_query");
+}
+
+bool FUnrealGPTToolResultCache::IsNeutral(const FString& ToolName)
+{
+	// Screenshots depend on the camera, and searches on files and sites outside the editor
+	return ToolName == TEXT("viewport_screenshot")
+		|| ToolName == TEXT("file_search")
+		|| ToolName == TEXT("web_search");
+}
+
+FString FUnrealGPTToolResultCache::MakeKey(const FString& ToolName, const FString& ArgumentsJson)
+{
+	return ToolName + TEXT("\n") + UnrealGPTJsonHelpers::MakeCanonicalJson(ArgumentsJson);
+}
+
+void FUnrealGPTToolResultCache::RegisterEditorHooks()
+{
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FUnrealGPTToolResultCache::OnObjectChanged);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject* Object, FPropertyChangedEvent&)
+	{
+		OnObjectChanged(Object);
+	});
+
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor*) { Invalidate(); });
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddLambda([this](AActor*) { Invalidate(); });
+		ActorMovedHandle = GEngine->OnActorMoved().AddLambda([this](AActor*) { Invalidate(); });
+	}
+
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddLambda([this]() { Invalidate(); });
+	MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32) { Invalidate(); });
+
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetAddedHandle = AssetRegistry->OnAssetAdded().AddLambda([this](const FAssetData&) { Invalidate(); });
+		AssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddLambda([this](const FAssetData&) { Invalidate(); });
+		AssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddLambda([this](const FAssetData&, const FString&) { Invalidate(); });
+	}
+}
+
+void FUnrealGPTToolResultCache::UnregisterEditorHooks()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+	}
+
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	Entries.Empty();
+}
+
+bool FUnrealGPTToolResultCache::Lookup(const FString& ToolName, const FString& ArgumentsJson, FString& OutResult)
+{
+	if (Entries.Num() == 0)
+	{
+		return false;
+	}
+
+	const FString Key = MakeKey(ToolName, ArgumentsJson);
+	const FEntry* Entry = Entries.FindByPredicate([&Key](const FEntry& Candidate) { return Candidate.Key == Key; });
+	if (!Entry)
+	{
+		return false;
+	}
+
+	OutResult = Entry->Result;
+	return true;
+}
+
+void FUnrealGPTToolResultCache::Store(const FString& ToolName, const FString& ArgumentsJson, const FString& Result, uint64 StartGeneration)
+{
+	if (StartGeneration != Generation)
+	{
+		return;
+	}
+
+	FString Key = MakeKey(ToolName, ArgumentsJson);
+	Entries.RemoveAll([&Key](const FEntry& Entry) { return Entry.Key == Key; });
+	if (Entries.Num() >= MaxEntries)
+	{
+		Entries.RemoveAt(0);
+	}
+	Entries.Add({ MoveTemp(Key), Result });
+}
+
+void FUnrealGPTToolResultCache::Invalidate()
+{
+	++Generation;
+	Entries.Reset();
+}
+
+void FUnrealGPTToolResultCache::OnObjectChanged(UObject* Object)
+{
+	// Gizmos, previews and other transient objects are modified constantly and are never observed by the tools
+	if (Object && (Object->HasAnyFlags(RF_Transient) || Object->GetOutermost() == GetTransientPackage()))
+	{
+		return;
+	}
+	Invalidate();
+}
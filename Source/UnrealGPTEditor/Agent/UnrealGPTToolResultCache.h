@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UObject;
+
+/**
+ * Results of side-effect-free tools (scene_query, scene_overview, get_actor, check_placement, reflection_query)
+ * keyed by tool name, canonicalized arguments and the editor generation, so the model can repeat
+ * an observation without the level being scanned again.
+ *
+ * The generation advances whenever something a read could observe may have changed: objects
+ * modified or edited, actors added, deleted or moved, undo/redo, map changes, assets added,
+ * removed or renamed, and every tool call that is not read-only. Advancing it drops every entry,
+ * so a result is only ever returned for the exact state it was computed from. Game thread only.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTToolResultCache
+{
+public:
+	/** Entries kept before the oldest is dropped */
+	static constexpr int32 MaxEntries = 32;
+
+	static FUnrealGPTToolResultCache& Get();
+
+	/** Whether ToolName only reads editor state, so its result can be cached */
+	static bool IsCacheable(const FString& ToolName);
+
+	/** Whether ToolName changes nothing in the editor but is not worth caching; it neither stores nor invalidates */
+	static bool IsNeutral(const FString& ToolName);
+
+	/** Tool name and arguments with object keys sorted. Exposed for tests. */
+	static FString MakeKey(const FString& ToolName, const FString& ArgumentsJson);
+
+	/** Subscribe to the editor events that advance the generation; called by the module on startup */
+	void RegisterEditorHooks();
+	void UnregisterEditorHooks();
+
+	/** Result of an identical call made at the current generation, if any */
+	bool Lookup(const FString& ToolName, const FString& ArgumentsJson, FString& OutResult);
+
+	/**
+	 * Remember a result. Ignored if the generation moved since StartGeneration, since the call
+	 * itself (or something it triggered, like loading World Partition actors) changed the editor.
+	 */
+	void Store(const FString& ToolName, const FString& ArgumentsJson, const FString& Result, uint64 StartGeneration);
+
+	/** Advance the generation and drop every entry */
+	void Invalidate();
+
+	uint64 GetGeneration() const { return Generation; }
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	struct FEntry
+	{
+		FString Key;
+		FString Result;
+	};
+
+	FUnrealGPTToolResultCache() = default;
+
+	/** Invalidate for changes to anything but transient objects */
+	void OnObjectChanged(UObject* Object);
+
+	/** Oldest first */
+	TArray<FEntry> Entries;
+
+	uint64 Generation = 0;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle UndoRedoHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+};
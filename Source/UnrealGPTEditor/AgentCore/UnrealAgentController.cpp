@@ -2,6 +2,9 @@
 
 #include "UnrealAgentController.h"
 #include "UnrealGPTAgentClient.h"
+#include "UnrealGPTSettings.h"
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
 
 FAgentController::FAgentController()
 {
@@ -9,6 +12,7 @@ FAgentController::FAgentController()
 
 FAgentController::~FAgentController()
 {
+	EndGoalTransaction();
 }
 
 void FAgentController::Initialize(UUnrealGPTAgentClient* InAgentClient)
@@ -171,11 +175,50 @@ bool FAgentController::ShouldContinue() const
 	case EAgentState::Failed:
 		return false;
 
+	case EAgentState::Executing:
+		// Spinning cannot finish a step that waits on an async tool
+		return !Executor.IsExecuting() && CurrentIteration < MaxIterationsPerGoal;
+
 	default:
 		return CurrentIteration < MaxIterationsPerGoal;
 	}
 }
 
+bool FAgentController::NeedsTick() const
+{
+	if (bCancelRequested)
+	{
+		return false;
+	}
+
+	switch (CurrentState)
+	{
+	case EAgentState::Idle:
+		// Idle only does work when a goal is queued
+		return GoalManager.HasActiveGoals();
+
+	case EAgentState::WaitingForUser:
+	case EAgentState::Completed:
+	case EAgentState::Failed:
+		return false;
+
+	case EAgentState::Executing:
+		// Nothing to do while a step waits on an async tool
+		return !Executor.IsExecuting();
+
+	default:
+		return true;
+	}
+}
+
+void FAgentController::RequestWake()
+{
+	if (NeedsTick() && OnWakeRequested.IsBound())
+	{
+		OnWakeRequested.Execute();
+	}
+}
+
 // ==================== STATE ACCESS ====================
 
 FAgentGoal* FAgentController::GetCurrentGoal()
@@ -198,10 +241,14 @@ void FAgentController::SetState(EAgentState NewState)
 	UE_LOG(LogTemp, Log, TEXT("Agent state: %s -> %s"),
 		*StateToString(OldState), *StateToString(NewState));
 
+	UpdateGoalTransaction(NewState);
+
 	if (OnStateChanged.IsBound())
 	{
 		OnStateChanged.Execute(OldState, NewState);
 	}
+
+	RequestWake();
 }
 
 FString FAgentController::StateToString(EAgentState State)
@@ -290,6 +337,12 @@ void FAgentController::HandlePlanningState()
 
 void FAgentController::HandleExecutingState()
 {
+	// A step is waiting on an async tool; HandleStepResult wakes us when it reports
+	if (Executor.IsExecuting())
+	{
+		return;
+	}
+
 	CurrentIteration++;
 
 	if (!CurrentPlan.IsValid())
@@ -454,6 +507,8 @@ void FAgentController::CompleteGoal(const FAgentGoal& Goal, const FGoalEvaluatio
 		ActiveGoal->MarkCompleted();
 	}
 
+	// Each goal is its own undo entry, even when another one follows
+	EndGoalTransaction();
 	GoalManager.PopGoal();
 
 	if (OnProgress.IsBound())
@@ -485,6 +540,7 @@ void FAgentController::CompleteGoal(const FAgentGoal& Goal, const FGoalEvaluatio
 void FAgentController::FailGoal(FAgentGoal& Goal, const FString& Reason)
 {
 	Goal.MarkFailed(Reason);
+	EndGoalTransaction();
 	GoalManager.PopGoal();
 
 	if (OnGoalFailed.IsBound())
@@ -594,6 +650,9 @@ void FAgentController::HandleStepResult(const FStepResult& Result)
 	{
 		HandleFailure(Result);
 	}
+
+	// Step results may arrive asynchronously while the owner has stopped ticking
+	RequestWake();
 }
 
 void FAgentController::AdvancePlan(const FStepResult& Result)
@@ -767,3 +826,55 @@ void FAgentController::RefreshWorldModelIfNeeded()
 		WorldModelManager.RefreshFullScene();
 	}
 }
+
+// ==================== UNDO ====================
+
+void FAgentController::UpdateGoalTransaction(EAgentState NewState)
+{
+	// Only the states that run tools edit the level; planning and evaluation wait on the LLM,
+	// and holding the transaction open through them would keep undo from the user for no benefit
+	const bool bEditing = NewState == EAgentState::Executing || NewState == EAgentState::Recovering;
+
+	// Waiting on the LLM or the user, idle or finished: hand undo back to the user
+	if (!bEditing)
+	{
+		EndGoalTransaction();
+		return;
+	}
+
+	const FAgentGoal* Goal = GetCurrentGoal();
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	if (GoalTransactionIndex != INDEX_NONE || !Goal || !GEditor || !Settings || !Settings->bGroupGoalTransactions)
+	{
+		return;
+	}
+
+	GoalTransactionIndex = GEditor->BeginTransaction(FText::Format(
+		NSLOCTEXT("UnrealGPT", "GoalTransaction", "UnrealGPT: {0}"), FText::FromString(Goal->Description.Left(80))));
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT Agent: Grouping changes for goal '%s' into one undo entry"), *Goal->Description.Left(80));
+}
+
+void FAgentController::EndGoalTransaction()
+{
+	if (GoalTransactionIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// BeginTransaction returned the nesting depth ours was opened at. End whatever a tool left open inside it,
+	// then ours; if something already unwound below that depth, ours is gone and there is nothing to close.
+	UTransBuffer* TransBuffer = GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+	if (TransBuffer)
+	{
+		if (TransBuffer->ActiveCount > GoalTransactionIndex + 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UnrealGPT Agent: Closing %d transaction(s) left open inside the goal transaction"),
+				TransBuffer->ActiveCount - GoalTransactionIndex - 1);
+		}
+		while (TransBuffer->ActiveCount > GoalTransactionIndex)
+		{
+			GEditor->EndTransaction();
+		}
+	}
+	GoalTransactionIndex = INDEX_NONE;
+}
@@ -94,6 +94,19 @@ public:
 	 */
 	bool ShouldContinue() const;
 
+	/**
+	 * Check if the next Tick has work to do.
+	 * Idle without queued goals, WaitingForUser and the terminal states are quiescent;
+	 * owners can stop ticking until OnWakeRequested fires.
+	 */
+	bool NeedsTick() const;
+
+	/**
+	 * Ask the owner to resume ticking.
+	 * Called on transitions into working states; async completions should call it too.
+	 */
+	void RequestWake();
+
 	// ==================== STATE ACCESS ====================
 
 	/** Get current agent state */
@@ -140,6 +153,10 @@ public:
 	DECLARE_DELEGATE_TwoParams(FOnProgress, const FString& /*Message*/, float /*Percent*/);
 	FOnProgress OnProgress;
 
+	/** Called when the controller has work again after being quiescent */
+	DECLARE_DELEGATE(FOnWakeRequested);
+	FOnWakeRequested OnWakeRequested;
+
 	// ==================== CONFIGURATION ====================
 
 	/** Set maximum iterations per goal */
@@ -216,6 +233,16 @@ private:
 	/** Refresh world model if needed */
 	void RefreshWorldModelIfNeeded();
 
+	// ==================== UNDO ====================
+
+	/**
+	 * Open the goal transaction when entering Executing or Recovering and close it in any other state.
+	 * Transactions opened by tools meanwhile nest inside it, so each execution pass is one undo entry, and an object
+	 * modified by several steps is only snapshotted the first time.
+	 */
+	void UpdateGoalTransaction(EAgentState NewState);
+	void EndGoalTransaction();
+
 	// ==================== COMPONENTS ====================
 
 	UUnrealGPTAgentClient* AgentClient = nullptr;
@@ -238,6 +265,9 @@ private:
 	int32 CurrentIteration = 0;
 	int32 MaxIterationsPerGoal = 50;
 
+	/** Nesting depth GEditor->BeginTransaction returned for the open goal transaction, or INDEX_NONE */
+	int32 GoalTransactionIndex = INDEX_NONE;
+
 	// Flags
 	bool bCancelRequested = false;
 	bool bInitialized = false;
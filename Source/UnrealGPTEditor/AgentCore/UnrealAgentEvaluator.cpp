@@ -1,6 +1,7 @@
 // Copyright 2024-2026 UnrealGPT. All Rights Reserved.
 
 #include "UnrealAgentEvaluator.h"
+#include "UnrealGPTPlacementValidator.h"
 #include "Misc/FileHelper.h"
 #include "HAL/FileManager.h"
 
@@ -166,8 +167,9 @@ bool FAgentEvaluator::EvaluateOutcome(const FExpectedOutcome& Outcome, const FTo
 		}
 		else if (Expr.Contains(TEXT("IsAreaClear")))
 		{
-			// For now, assume area clear checks pass if no actors in result
-			return true;
+			// "WorldModel.IsAreaClear(Box(...))" or "WorldModel.IsAreaClear(Sphere(...))"; symbolic bounds pass
+			FUnrealGPTClearanceQuery Query;
+			return !FUnrealGPTPlacementValidator::ParseExpression(Expr, Query) || WorldModel.IsAreaClear(Query);
 		}
 	}
 
@@ -1,6 +1,7 @@
 // Copyright 2024-2026 UnrealGPT. All Rights Reserved.
 
 #include "UnrealAgentExecutor.h"
+#include "UnrealGPTPlacementValidator.h"
 #include "UnrealGPTToolDispatcher.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
@@ -10,6 +11,15 @@ FAgentExecutor::FAgentExecutor()
 {
 }
 
+FAgentExecutor::~FAgentExecutor()
+{
+	// The pending async tool holds a raw pointer to this executor in its completion
+	if (CancelAsyncTool)
+	{
+		CancelAsyncTool();
+	}
+}
+
 // ==================== STEP EXECUTION ====================
 
 FStepResult FAgentExecutor::ExecuteStep(FPlanStep& Step, FAgentWorldModel& WorldModel,
@@ -47,12 +57,25 @@ FStepResult FAgentExecutor::ExecuteStep(FPlanStep& Step, FAgentWorldModel& World
 	}
 
 	// 2. EXECUTE TOOL
+	if (UnrealGPTToolDispatcher::IsAsyncTool(Step.ToolName))
+	{
+		// Finishes in OnAsyncToolComplete, which fires OnStepComplete; IsExecuting() stays true until then
+		BeginAsyncTool(Step, WorldModel, GoalId, Result);
+		return bIsExecuting ? Result : LastResult;
+	}
+
 	double StartTime = FPlatformTime::Seconds();
 
 	Result.ToolResult = ExecuteTool(Step.ToolName, Step.ToolArguments);
 
 	Result.ToolResult.ExecutionTime = static_cast<float>(FPlatformTime::Seconds() - StartTime);
 
+	return FinishStep(Step, Result, WorldModel, GoalId);
+}
+
+FStepResult FAgentExecutor::FinishStep(FPlanStep& Step, FStepResult Result, FAgentWorldModel& WorldModel,
+	const FString& GoalId)
+{
 	// Fire tool result delegate
 	if (OnToolResult.IsBound())
 	{
@@ -215,6 +238,11 @@ TArray<FStepResult> FAgentExecutor::ExecuteSteps(TArray<FPlanStep>& Steps,
 		}
 
 		FStepResult Result = ExecuteStep(Step, WorldModel, GoalId);
+		if (bIsExecuting)
+		{
+			// Async tool step; the rest cannot run until it reports through OnStepComplete
+			break;
+		}
 		Results.Add(Result);
 
 		if (!Result.IsSuccess() && !bContinueOnError)
@@ -248,9 +276,62 @@ void FAgentExecutor::ExecuteStepAsync(FPlanStep& Step, FAgentWorldModel& WorldMo
 	});
 }
 
+void FAgentExecutor::BeginAsyncTool(FPlanStep& Step, FAgentWorldModel& WorldModel, const FString& GoalId,
+	const FStepResult& Result)
+{
+	AsyncToolStep = &Step;
+	AsyncToolWorldModel = &WorldModel;
+	AsyncToolGoalId = GoalId;
+	AsyncToolResult = Result;
+	AsyncToolStartTime = FPlatformTime::Seconds();
+
+	// Completes synchronously if the arguments are rejected or every output is cached, in which case
+	// the completion handler has already moved on (possibly to another async step)
+	const uint32 Serial = ++AsyncToolSerial;
+	TFunction<void()> CancelTool = UnrealGPTToolDispatcher::StartAsyncTool(Step.ToolName, ArgsToJson(Step.ToolArguments),
+		[this](const FString& ResultJson) { OnAsyncToolComplete(ResultJson); },
+		nullptr);
+	if (Serial == AsyncToolSerial && AsyncToolStep == &Step)
+	{
+		CancelAsyncTool = MoveTemp(CancelTool);
+	}
+}
+
+void FAgentExecutor::OnAsyncToolComplete(const FString& ResultJson)
+{
+	FPlanStep* Step = AsyncToolStep;
+	FAgentWorldModel* WorldModel = AsyncToolWorldModel;
+	AsyncToolStep = nullptr;
+	AsyncToolWorldModel = nullptr;
+	CancelAsyncTool.Reset();
+
+	if (!Step || !WorldModel)
+	{
+		bIsExecuting = false;
+		return;
+	}
+
+	FStepResult Result = AsyncToolResult;
+	Result.ToolResult = ParseToolResult(Step->ToolName, ResultJson);
+	Result.ToolResult.ExecutionTime = static_cast<float>(FPlatformTime::Seconds() - AsyncToolStartTime);
+
+	FinishStep(*Step, Result, *WorldModel, AsyncToolGoalId);
+}
+
 void FAgentExecutor::Cancel()
 {
 	bCancelRequested = true;
+
+	// Abandon a step waiting on an async tool; its result will never be reported
+	if (CancelAsyncTool)
+	{
+		TFunction<void()> CancelPending = MoveTemp(CancelAsyncTool);
+		CancelAsyncTool.Reset();
+		CancelPending();
+		AsyncToolStep = nullptr;
+		AsyncToolWorldModel = nullptr;
+		bIsExecuting = false;
+	}
 }
 
 // ==================== PRIVATE: TOOL EXECUTION BRIDGE ====================
@@ -471,9 +552,10 @@ bool FAgentExecutor::EvaluateCheckExpression(const FString& Expression, const FA
 	}
 	else if (Expression.Contains(TEXT("IsAreaClear")))
 	{
-		// "WorldModel.IsAreaClear(Bounds)" - would need bounds parsing
-		// For now, return true (assume area is clear)
-		return true;
+		// "WorldModel.IsAreaClear(Box(x, y, z, ex, ey, ez))" or "WorldModel.IsAreaClear(Sphere(x, y, z, r))"
+		// Symbolic bounds cannot be checked and do not block
+		FUnrealGPTClearanceQuery Query;
+		return !FUnrealGPTPlacementValidator::ParseExpression(Expression, Query) || WorldModel.IsAreaClear(Query);
 	}
 	else if (Expression.Contains(TEXT("CanModifyActor")))
 	{
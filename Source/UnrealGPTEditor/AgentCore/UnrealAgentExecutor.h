@@ -24,6 +24,7 @@ class UNREALGPTEDITOR_API FAgentExecutor
 {
 public:
 	FAgentExecutor();
+	~FAgentExecutor();
 
 	/** Set the tool dispatcher (connects to your existing tool execution) */
 	void SetAgentClient(UUnrealGPTAgentClient* InClient) { AgentClient = InClient; }
@@ -39,6 +40,9 @@ public:
 	 * 2. Execute tool
 	 * 3. Update world model
 	 * 4. Verify outcomes
+	 *
+	 * Steps whose tool completes asynchronously (replicate_generate) return while IsExecuting()
+	 * is still true; their result is delivered through OnStepComplete on a later frame.
 	 */
 	FStepResult ExecuteStep(FPlanStep& Step, FAgentWorldModel& WorldModel,
 		const FString& GoalId = TEXT(""));
@@ -116,6 +120,19 @@ private:
 	 */
 	FString ExecuteToolInternal(const FString& ToolName, const FString& ArgsJson);
 
+	/**
+	 * Steps 3-5 of ExecuteStep once the tool has produced its result.
+	 */
+	FStepResult FinishStep(FPlanStep& Step, FStepResult Result, FAgentWorldModel& WorldModel,
+		const FString& GoalId);
+
+	/**
+	 * Start an async tool; the step finishes in OnAsyncToolComplete.
+	 */
+	void BeginAsyncTool(FPlanStep& Step, FAgentWorldModel& WorldModel, const FString& GoalId,
+		const FStepResult& Result);
+	void OnAsyncToolComplete(const FString& ResultJson);
+
 	// ==================== PRECONDITION EVALUATION ====================
 
 	/**
@@ -127,7 +144,7 @@ private:
 	 * Parse and evaluate a precondition check expression.
 	 * Examples:
 	 * - "WorldModel.FindActor('ActorId') != null"
-	 * - "WorldModel.IsAreaClear(Bounds)"
+	 * - "WorldModel.IsAreaClear(Box(x, y, z, ex, ey, ez))"
 	 * - "WorldModel.CanModifyActor('ActorId')"
 	 */
 	bool EvaluateCheckExpression(const FString& Expression, const FAgentWorldModel& WorldModel);
@@ -159,4 +176,15 @@ private:
 	FPlanStep* CurrentStep = nullptr;
 	FAgentWorldModel* CurrentWorldModel = nullptr;
 	FString CurrentGoalId;
+
+	/** Step waiting on an async tool */
+	FPlanStep* AsyncToolStep = nullptr;
+	FAgentWorldModel* AsyncToolWorldModel = nullptr;
+	FString AsyncToolGoalId;
+	FStepResult AsyncToolResult;
+	double AsyncToolStartTime = 0.0;
+
+	/** Only cancels the tool; it stays alive on its own until OnAsyncToolComplete runs */
+	TFunction<void()> CancelAsyncTool;
+	uint32 AsyncToolSerial = 0;
 };
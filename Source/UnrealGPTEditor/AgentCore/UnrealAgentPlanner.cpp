@@ -2,6 +2,7 @@
 
 #include "UnrealAgentPlanner.h"
 #include "UnrealAgentLLMInterface.h"
+#include "UnrealGPTPlacementValidator.h"
 
 FAgentPlanner::FAgentPlanner()
 {
@@ -127,7 +128,68 @@ FAgentPlan FAgentPlanner::CreatePlanProgrammatically(const FAgentGoal& Goal,
 
 FPlanValidation FAgentPlanner::ValidatePlan(const FAgentPlan& Plan)
 {
-	return FAgentPlanValidator::ValidatePlan(Plan);
+	FPlanValidation Validation = FAgentPlanValidator::ValidatePlan(Plan);
+	if (Validation.IsValid())
+	{
+		ValidatePlacements(Plan, Validation);
+	}
+	return Validation;
+}
+
+void FAgentPlanner::ValidatePlacements(const FAgentPlan& Plan, FPlanValidation& Validation) const
+{
+	TArray<FUnrealGPTClearanceQuery> Queries;
+	TArray<TPair<int32, const FStepPrecondition*>> Sources;
+	for (int32 i = Plan.CurrentStepIndex; i < Plan.Steps.Num(); i++)
+	{
+		for (const FStepPrecondition& Precondition : Plan.Steps[i].Preconditions)
+		{
+			FUnrealGPTClearanceQuery Query;
+			if (!FUnrealGPTPlacementValidator::ParseExpression(Precondition.CheckExpression, Query))
+			{
+				continue;
+			}
+
+			// A volume without size cannot be checked, and passing it would hide a broken plan
+			if (Query.Extent.GetMin() <= 0.0)
+			{
+				Validation.bValid = false;
+				Validation.Errors.Add(FString::Printf(TEXT("Step %d: %s has a volume with no size"), i + 1, *Precondition.Description));
+				continue;
+			}
+
+			Queries.Add(Query);
+			Sources.Emplace(i, &Precondition);
+		}
+	}
+
+	// Without an editor world the preconditions are still checked step by step during execution
+	TArray<FUnrealGPTClearanceResult> Results;
+	if (Queries.Num() == 0 || !FUnrealGPTPlacementValidator::Get().Validate(Queries, Results))
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < Results.Num(); i++)
+	{
+		if (Results[i].bClear)
+		{
+			continue;
+		}
+
+		const FStepPrecondition& Precondition = *Sources[i].Value;
+		const FString Message = FString::Printf(TEXT("Step %d: %s is blocked by %s"),
+			Sources[i].Key + 1, *Precondition.Description, *FString::Join(Results[i].Blockers, TEXT(", ")));
+		if (Precondition.bBlocksExecution)
+		{
+			Validation.bValid = false;
+			Validation.Errors.Add(Message);
+		}
+		else
+		{
+			Validation.Warnings.Add(Message);
+		}
+	}
 }
 
 FAgentPlan FAgentPlanner::ValidateAndFixPlan(const FAgentPlan& Plan, const FAgentWorldModel& WorldModel)
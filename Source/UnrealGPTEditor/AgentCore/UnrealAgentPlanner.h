@@ -49,7 +49,7 @@ public:
 	// ==================== PLAN VALIDATION ====================
 
 	/**
-	 * Validate a plan before execution.
+	 * Validate a plan before execution, including the placements of its pending steps.
 	 */
 	FPlanValidation ValidatePlan(const FAgentPlan& Plan);
 
@@ -170,6 +170,13 @@ private:
 	 */
 	void AddPreconditionsFromWorldModel(FPlanStep& Step, const FAgentWorldModel& WorldModel);
 
+	/**
+	 * Check the IsAreaClear(Box(...)/Sphere(...)) preconditions of all pending steps in one batch,
+	 * so a plan whose placements overlap existing geometry fails before anything is spawned.
+	 * Blocking preconditions become errors, the rest warnings.
+	 */
+	void ValidatePlacements(const FAgentPlan& Plan, FPlanValidation& Validation) const;
+
 	// ==================== PATTERN RECOGNITION ====================
 
 	/** Known goal patterns for programmatic planning */
@@ -148,7 +148,7 @@ struct UNREALGPTEDITOR_API FStepPrecondition
 
 	/**
 	 * Check to perform against world model.
-	 * Example: "WorldModel.IsAreaClear(TargetBounds)"
+	 * Example: "WorldModel.IsAreaClear(Box(0, 0, 100, 50, 50, 100))"
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString CheckExpression;
@@ -1,6 +1,7 @@
 // Copyright 2024-2026 UnrealGPT. All Rights Reserved.
 
 #include "UnrealAgentWorldModel.h"
+#include "UnrealGPTPlacementValidator.h"
 #include "UnrealGPTSceneContext.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
@@ -97,6 +98,18 @@ int32 FAgentWorldModel::CountActors(const FActorQuery& Query) const
 
 bool FAgentWorldModel::IsAreaClear(const FBox& Bounds) const
 {
+	return IsAreaClear(FUnrealGPTClearanceQuery::Box(Bounds));
+}
+
+bool FAgentWorldModel::IsAreaClear(const FUnrealGPTClearanceQuery& Query) const
+{
+	TArray<FUnrealGPTClearanceResult> Results;
+	if (FUnrealGPTPlacementValidator::Get().Validate(MakeArrayView(&Query, 1), Results))
+	{
+		return Results[0].bClear;
+	}
+
+	const FBox Bounds = FBox::BuildAABB(Query.Center, Query.bSphere ? FVector(Query.Extent.X) : Query.Extent);
 	for (const auto& Pair : KnownActors)
 	{
 		const FActorState& Actor = Pair.Value;
@@ -6,6 +6,8 @@
 #include "UnrealAgentTypes.h"
 #include "UnrealAgentWorldModel.generated.h"
 
+struct FUnrealGPTClearanceQuery;
+
 /**
  * Cached state of an actor in the world model.
  *
@@ -351,6 +353,12 @@ struct UNREALGPTEDITOR_API FAgentWorldModel
 	/** Check if an area is clear (no actors in bounds) */
 	bool IsAreaClear(const FBox& Bounds) const;
 
+	/**
+	 * Check a box or sphere against the collision of the editor world, falling back to the
+	 * bounds of the known actors when no editor world can be queried.
+	 */
+	bool IsAreaClear(const FUnrealGPTClearanceQuery& Query) const;
+
 	/** Get actors in area */
 	TArray<FActorState> GetActorsInArea(const FBox& Bounds) const;
 
@@ -124,12 +124,13 @@ FAgentMessage UnrealGPTConversationState::CreateAssistantToolCallMessage(const F
 	return Message;
 }
 
-FAgentMessage UnrealGPTConversationState::CreateToolMessage(const FString& Content, const FString& ToolCallId)
+FAgentMessage UnrealGPTConversationState::CreateToolMessage(const FString& Content, const FString& ToolCallId, const FString& ToolName)
 {
 	FAgentMessage Message;
 	Message.Role = TEXT("tool");
 	Message.Content = Content;
 	Message.ToolCallId = ToolCallId;
+	Message.ToolName = ToolName;
 	return Message;
 }
 
@@ -19,6 +19,6 @@ public:
 	static FAgentMessage CreateUserMessage(const FString& Content);
 	static FAgentMessage CreateAssistantMessage(const FString& Content);
 	static FAgentMessage CreateAssistantToolCallMessage(const FString& Content, const TArray<FString>& ToolCallIds, const FString& ToolCallsJson);
-	static FAgentMessage CreateToolMessage(const FString& Content, const FString& ToolCallId);
+	static FAgentMessage CreateToolMessage(const FString& Content, const FString& ToolCallId, const FString& ToolName = FString());
 	static void AppendMessage(TArray<FAgentMessage>& ConversationHistory, const FAgentMessage& Message);
 };
@@ -1,8 +1,32 @@
 #include "UnrealGPTRequestBuilder.h"
 #include "UnrealGPTAgentClient.h"
 #include "UnrealGPTConversationState.h"
+#include "UnrealGPTResultCompactor.h"
 #include "Serialization/JsonSerializer.h"
 
+namespace
+{
+	/**
+	 * Largest result size that lets every result fit in TotalBudget: results below it are sent whole
+	 * and the larger ones share what they leave. MAX_int32 when everything fits.
+	 */
+	int32 GetSharedResultCap(TArray<int32> Sizes, int32 TotalBudget)
+	{
+		Sizes.Sort();
+		int32 Remaining = TotalBudget;
+		for (int32 Index = 0; Index < Sizes.Num(); ++Index)
+		{
+			const int32 Share = Remaining / (Sizes.Num() - Index);
+			if (Sizes[Index] > Share)
+			{
+				return Share;
+			}
+			Remaining -= Sizes[Index];
+		}
+		return MAX_int32;
+	}
+}
+
 FString UnrealGPTRequestBuilder::GetImageMimeType(const FString& ImageData)
 {
 	return ImageData.StartsWith(TEXT("/9j/")) ? TEXT("image/jpeg") : TEXT("image/png");
@@ -169,21 +193,31 @@ TArray<TSharedPtr<FJsonValue>> UnrealGPTRequestBuilder::BuildInputItems(
 
 void UnrealGPTRequestBuilder::AppendFunctionCallOutputs(TArray<TSharedPtr<FJsonValue>>& MessagesArray, const TArray<FAgentMessage>& ToolResultsToInclude, int32 MaxToolResultSize)
 {
+	// Every call needs its output, so results over the shared budget are compacted instead of dropped
+	TArray<int32> Sizes;
+	Sizes.Reserve(ToolResultsToInclude.Num());
+	for (const FAgentMessage& ToolResult : ToolResultsToInclude)
+	{
+		Sizes.Add(ToolResult.Content.Len());
+	}
+	const int32 Cap = GetSharedResultCap(Sizes, MaxToolResultSize * 5);
+
 	int32 TotalSize = 0;
 	for (const FAgentMessage& ToolResult : ToolResultsToInclude)
 	{
-		const int32 ResultSize = ToolResult.Content.Len();
-		if (TotalSize + ResultSize > MaxToolResultSize * 5)
+		FString Output = ToolResult.Content;
+		if (Output.Len() > Cap)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Skipping tool result (size: %d) to prevent context overflow. Total size: %d"),
-				ResultSize, TotalSize);
-			continue;
+			UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Compacting tool result (size: %d) to %d chars to prevent context overflow"),
+				Output.Len(), FMath::Max(Cap, UnrealGPTResultCompactor::MinBudget));
+			Output = UnrealGPTResultCompactor::Compact(ToolResult.ToolName, Output, Cap);
 		}
 
+		const int32 ResultSize = Output.Len();
 		TSharedPtr<FJsonObject> FunctionResultObj = MakeShareable(new FJsonObject);
 		FunctionResultObj->SetStringField(TEXT("type"), TEXT("function_call_output"));
 		FunctionResultObj->SetStringField(TEXT("call_id"), ToolResult.ToolCallId);
-		FunctionResultObj->SetStringField(TEXT("output"), ToolResult.Content);
+		FunctionResultObj->SetStringField(TEXT("output"), MoveTemp(Output));
 
 		MessagesArray.Add(MakeShareable(new FJsonValueObject(FunctionResultObj)));
 		TotalSize += ResultSize;
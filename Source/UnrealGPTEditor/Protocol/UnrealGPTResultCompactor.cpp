@@ -0,0 +1,272 @@
+#include "UnrealGPTResultCompactor.h"
+#include "UnrealGPTToolResultProcessor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace UnrealGPTResultCompaction
+{
+	/** Limits of one compaction pass; passes go from loose to tight until the result fits */
+	struct FLimits
+	{
+		/** Items kept per array */
+		int32 MaxItems;
+
+		/** Deepest object or array that is expanded; the root is at depth 0 */
+		int32 MaxDepth;
+
+		/** Characters kept per string value */
+		int32 MaxStringLen;
+	};
+
+	static const FLimits Passes[] =
+	{
+		{ 50, 8, 4000 },
+		{ 20, 6, 2000 },
+		{ 10, 4, 800 },
+		{ 5, 3, 300 },
+		{ 2, 2, 120 },
+		{ 0, 1, 60 },
+	};
+
+	/** Classes named in the entry that stands in for omitted array items */
+	static const int32 MaxOmittedClasses = 8;
+
+	/** Item fields omitted items are counted by, in order of preference */
+	static const TCHAR* const ClassFields[] = { TEXT("class"), TEXT("type"), TEXT("kind") };
+
+	/** Characters of the message kept by the last-resort summary */
+	static const int32 FallbackMessageLen = 200;
+
+	using FCondensedWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	static FString Serialize(const TSharedPtr<FJsonValue>& Value)
+	{
+		FString Output;
+		TSharedRef<FCondensedWriter> Writer = FCondensedWriterFactory::Create(&Output);
+		FJsonSerializer::Serialize(Value, FString(), Writer);
+		return Output;
+	}
+
+	static bool IsContainer(const TSharedPtr<FJsonValue>& Value)
+	{
+		return Value.IsValid() && (Value->Type == EJson::Object || Value->Type == EJson::Array);
+	}
+
+	/** Stand-in for a container below the depth limit */
+	static TSharedPtr<FJsonValue> Describe(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (Value->Type == EJson::Array)
+		{
+			return MakeShared<FJsonValueString>(FString::Printf(TEXT("[%d items]"), Value->AsArray().Num()));
+		}
+		return MakeShared<FJsonValueString>(FString::Printf(TEXT("{%d fields}"), Value->AsObject()->Values.Num()));
+	}
+
+	/** {"omitted": N, "omitted_classes": {...}} for the items of Items from FirstOmitted on */
+	static TSharedPtr<FJsonValue> MakeOmittedEntry(const TArray<TSharedPtr<FJsonValue>>& Items, int32 FirstOmitted)
+	{
+		TMap<FString, int32> ClassCounts;
+		for (int32 Index = FirstOmitted; Index < Items.Num(); ++Index)
+		{
+			const TSharedPtr<FJsonObject>* ItemObj = nullptr;
+			if (!Items[Index].IsValid() || !Items[Index]->TryGetObject(ItemObj))
+			{
+				continue;
+			}
+
+			for (const TCHAR* ClassField : ClassFields)
+			{
+				FString ClassName;
+				if ((*ItemObj)->TryGetStringField(ClassField, ClassName))
+				{
+					ClassCounts.FindOrAdd(ClassName)++;
+					break;
+				}
+			}
+		}
+
+		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("omitted"), Items.Num() - FirstOmitted);
+		if (ClassCounts.Num() > 0)
+		{
+			ClassCounts.ValueSort([](int32 A, int32 B) { return A > B; });
+			TSharedPtr<FJsonObject> Classes = MakeShared<FJsonObject>();
+			int32 Listed = 0;
+			for (const TPair<FString, int32>& Pair : ClassCounts)
+			{
+				if (Listed++ >= MaxOmittedClasses)
+				{
+					break;
+				}
+				Classes->SetNumberField(Pair.Key, Pair.Value);
+			}
+			Entry->SetObjectField(TEXT("omitted_classes"), Classes);
+		}
+		return MakeShared<FJsonValueObject>(Entry);
+	}
+
+	/** Copy of Value within Limits; Value itself is shared with the parsed result and left untouched */
+	static TSharedPtr<FJsonValue> CompactValue(const TSharedPtr<FJsonValue>& Value, const FLimits& Limits, int32 Depth)
+	{
+		if (!Value.IsValid())
+		{
+			return Value;
+		}
+
+		switch (Value->Type)
+		{
+			case EJson::String:
+			{
+				const FString String = Value->AsString();
+				return String.Len() > Limits.MaxStringLen ? MakeShared<FJsonValueString>(UnrealGPTResultCompactor::KeepHeadAndTail(String, Limits.MaxStringLen)) : Value;
+			}
+
+			case EJson::Array:
+			{
+				const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+				const int32 NumKept = FMath::Min(Items.Num(), Limits.MaxItems);
+
+				TArray<TSharedPtr<FJsonValue>> Kept;
+				Kept.Reserve(NumKept + 1);
+				for (int32 Index = 0; Index < NumKept; ++Index)
+				{
+					Kept.Add(IsContainer(Items[Index]) && Depth + 1 > Limits.MaxDepth ? Describe(Items[Index]) : CompactValue(Items[Index], Limits, Depth + 1));
+				}
+				if (NumKept < Items.Num())
+				{
+					Kept.Add(MakeOmittedEntry(Items, NumKept));
+				}
+				return MakeShared<FJsonValueArray>(Kept);
+			}
+
+			case EJson::Object:
+			{
+				TSharedPtr<FJsonObject> Compacted = MakeShared<FJsonObject>();
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+				{
+					Compacted->SetField(Field.Key, IsContainer(Field.Value) && Depth + 1 > Limits.MaxDepth ? Describe(Field.Value) : CompactValue(Field.Value, Limits, Depth + 1));
+				}
+				return MakeShared<FJsonValueObject>(Compacted);
+			}
+
+			default:
+				return Value;
+		}
+	}
+
+	static FString GetHint(const FString& ToolName)
+	{
+		if (ToolName == TEXT("scene_query"))
+		{
+			return TEXT("Use format=\"table\", fewer fields, or a smaller max_results with offset.");
+		}
+		if (ToolName == TEXT("python_execute"))
+		{
+			return TEXT("Put only what you need in result['details'] and print less.");
+		}
+		return TEXT("Request less detail or page through the results.");
+	}
+
+	/** Record in the result itself that it was compacted; root arrays are wrapped as {"items": [...]} */
+	static TSharedPtr<FJsonValue> AddMarker(const TSharedPtr<FJsonValue>& Compacted, const FString& ToolName, int32 OriginalLength)
+	{
+		TSharedPtr<FJsonObject> Marker = MakeShared<FJsonObject>();
+		Marker->SetNumberField(TEXT("original_length"), OriginalLength);
+		Marker->SetStringField(TEXT("hint"), GetHint(ToolName));
+
+		TSharedPtr<FJsonObject> Root;
+		if (Compacted->Type == EJson::Object)
+		{
+			Root = Compacted->AsObject();
+		}
+		else
+		{
+			Root = MakeShared<FJsonObject>();
+			Root->SetField(TEXT("items"), Compacted);
+		}
+		Root->SetObjectField(TEXT("compacted"), Marker);
+		return MakeShared<FJsonValueObject>(Root);
+	}
+}
+
+FString UnrealGPTResultCompactor::Compact(const FString& ToolName, const FString& Result, int32 MaxSize)
+{
+	using namespace UnrealGPTResultCompaction;
+
+	if (Result.Len() <= MaxSize)
+	{
+		return Result;
+	}
+
+	const int32 Budget = FMath::Max(MaxSize, MinBudget);
+	if (Result.Len() <= Budget)
+	{
+		return Result;
+	}
+
+	// Tables know which rows can go and how to keep paging consistent
+	FString Fitted = Result;
+	if (UnrealGPTToolResultProcessor::FitTableToBudget(Fitted, Budget))
+	{
+		return Fitted;
+	}
+
+	TSharedPtr<FJsonValue> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Result);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !IsContainer(Root))
+	{
+		return KeepHeadAndTail(Result, Budget);
+	}
+
+	for (const FLimits& Limits : Passes)
+	{
+		FString Compacted = Serialize(AddMarker(CompactValue(Root, Limits, 0), ToolName, Result.Len()));
+		if (Compacted.Len() <= Budget)
+		{
+			UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Compacted %s result from %d to %d chars (items %d, depth %d)"),
+				*ToolName, Result.Len(), Compacted.Len(), Limits.MaxItems, Limits.MaxDepth);
+			return Compacted;
+		}
+	}
+
+	// Too many top-level fields for any pass: keep just the outcome
+	TSharedPtr<FJsonObject> Summary = MakeShared<FJsonObject>();
+	if (Root->Type == EJson::Object)
+	{
+		FString Status, Message;
+		if (Root->AsObject()->TryGetStringField(TEXT("status"), Status))
+		{
+			Summary->SetStringField(TEXT("status"), Status.Left(FallbackMessageLen));
+		}
+		if (Root->AsObject()->TryGetStringField(TEXT("message"), Message))
+		{
+			Summary->SetStringField(TEXT("message"), KeepHeadAndTail(Message, FallbackMessageLen));
+		}
+	}
+	return Serialize(AddMarker(MakeShared<FJsonValueObject>(Summary), ToolName, Result.Len()));
+}
+
+FString UnrealGPTResultCompactor::KeepHeadAndTail(const FString& Text, int32 MaxSize)
+{
+	if (Text.Len() <= MaxSize)
+	{
+		return Text;
+	}
+
+	// Room for the marker, whose count has at most 10 digits
+	static const int32 MarkerReserve = 40;
+	const int32 Kept = MaxSize - MarkerReserve;
+	if (Kept <= 0)
+	{
+		return Text.Left(MaxSize);
+	}
+
+	// Errors and final output are usually at the end, so the tail gets as much room as the head
+	const int32 HeadLen = Kept / 2;
+	const int32 TailLen = Kept - HeadLen;
+	return Text.Left(HeadLen) + FString::Printf(TEXT("\n[... %d chars omitted ...]\n"), Text.Len() - Kept) + Text.Right(TailLen);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Shrinks tool results to a character budget without cutting them mid-value, so the model
+ * always gets something it can parse.
+ *
+ * - Table-format scene results lose trailing rows (UnrealGPTToolResultProcessor::FitTableToBudget).
+ * - JSON results are rebuilt with progressively tighter limits until they fit: long arrays keep
+ *   their first items plus an {"omitted", "omitted_classes"} entry counting the rest by class,
+ *   objects below a depth are replaced by a short description, and long strings (such as the
+ *   Python stdout in logs.stdout) keep their head and tail.
+ * - Plain text keeps its head and tail.
+ */
+class UNREALGPTEDITOR_API UnrealGPTResultCompactor
+{
+public:
+	/** Smallest budget a result is compacted to; below this only the fallback summary fits */
+	static constexpr int32 MinBudget = 512;
+
+	/**
+	 * Return Result unchanged if it fits in MaxSize characters, or else a compacted version that does.
+	 * @param ToolName - Tool that produced the result, for tool-specific hints; may be empty
+	 */
+	static FString Compact(const FString& ToolName, const FString& Result, int32 MaxSize);
+
+	/** Keep the first and last characters of Text with an omission marker between them, within MaxSize */
+	static FString KeepHeadAndTail(const FString& Text, int32 MaxSize);
+};
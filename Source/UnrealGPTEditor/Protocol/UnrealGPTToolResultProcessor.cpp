@@ -1,4 +1,25 @@
 #include "UnrealGPTToolResultProcessor.h"
+#include "UnrealGPTResultCompactor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UnrealGPTSceneTable.h"
+
+namespace
+{
+	const TCHAR* const ResultFileSeparator = TEXT("\n__RESULT_FILE__\n");
+
+	/** Scratch files older than this are removed the first time the directory is used in an editor session */
+	const FTimespan ScratchFileMaxAge = FTimespan::FromDays(7.0);
+
+	/** Marker of a table-format scene result, as written by FUnrealGPTSceneTable::FWriter */
+	const TCHAR* const TableFormatMarker = TEXT("\"format\":\"table\"");
+}
 
 FProcessedToolResult UnrealGPTToolResultProcessor::ProcessResult(
 	const FString& ToolName,
@@ -7,6 +28,7 @@ FProcessedToolResult UnrealGPTToolResultProcessor::ProcessResult(
 {
 	FProcessedToolResult Output;
 	Output.ResultForHistory = ToolResult;
+	Output.ResultForDisplay = ToolResult;
 
 	const bool bIsScreenshot = (ToolName == TEXT("viewport_screenshot"));
 	const FString ImageSeparator = TEXT("\n__IMAGE_BASE64__\n");
@@ -30,6 +52,12 @@ FProcessedToolResult UnrealGPTToolResultProcessor::ProcessResult(
 		}
 	}
 
+	// Screenshots are decoded by the UI image cache; everything else that is this large goes through the file viewer
+	if (!bIsScreenshot && ToolResult.Len() > MaxInlineDisplaySize)
+	{
+		Output.ResultForDisplay = SpillToScratchFile(ToolName, ToolResult);
+	}
+
 	if (Output.ResultForHistory.Len() > MaxToolResultSize)
 	{
 		const bool bIsBase64Image = Output.ResultForHistory.StartsWith(TEXT("iVBORw0KGgo")) || Output.ResultForHistory.StartsWith(TEXT("/9j/"));
@@ -41,12 +69,167 @@ FProcessedToolResult UnrealGPTToolResultProcessor::ProcessResult(
 		}
 		else
 		{
-			Output.ResultForHistory = Output.ResultForHistory.Left(MaxToolResultSize) +
-				TEXT("\n\n[Result truncated - original length: ") + FString::FromInt(ToolResult.Len()) +
-				TEXT(" characters.]");
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Truncated large tool result (%d chars) to prevent context overflow"), ToolResult.Len());
+			// Tables drop rows, JSON is summarized and pruned, text keeps its head and tail; all stay parseable
+			Output.ResultForHistory = UnrealGPTResultCompactor::Compact(ToolName, Output.ResultForHistory, MaxToolResultSize);
+			UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Compacted large tool result (%d chars) to %d chars to prevent context overflow"),
+				ToolResult.Len(), Output.ResultForHistory.Len());
 		}
 	}
 
 	return Output;
 }
+
+bool UnrealGPTToolResultProcessor::FitTableToBudget(FString& InOutResult, int32 MaxSize)
+{
+	if (!InOutResult.Contains(TableFormatMarker, ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> ResultObj;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InOutResult);
+	const TArray<TSharedPtr<FJsonValue>>* GroupsPtr = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, ResultObj) || !ResultObj.IsValid() || !ResultObj->TryGetArrayField(TEXT("groups"), GroupsPtr))
+	{
+		return false;
+	}
+
+	// Rows are dropped from the end, so the kept ones still match summary.offset for paging
+	TArray<TSharedPtr<FJsonValue>> Groups = *GroupsPtr;
+	int32 NumDropped = 0;
+	FString Fitted;
+	for (;;)
+	{
+		ResultObj->SetArrayField(TEXT("groups"), Groups);
+		if (NumDropped > 0)
+		{
+			ResultObj->SetNumberField(TEXT("truncated_rows"), NumDropped);
+		}
+
+		Fitted.Reset();
+		TSharedRef<FUnrealGPTSceneTable::FWriter> Writer = FUnrealGPTSceneTable::FWriterFactory::Create(&Fitted);
+		FJsonSerializer::Serialize(ResultObj.ToSharedRef(), Writer);
+		if (Fitted.Len() <= MaxSize || Groups.Num() == 0)
+		{
+			break;
+		}
+
+		// Drop about as many characters as we are over, and at least one row
+		int32 Excess = Fitted.Len() - MaxSize;
+		while (Excess > 0 && Groups.Num() > 0)
+		{
+			const TSharedPtr<FJsonObject> Group = Groups.Last()->AsObject();
+			TArray<TSharedPtr<FJsonValue>> Rows = Group.IsValid() ? Group->GetArrayField(TEXT("rows")) : TArray<TSharedPtr<FJsonValue>>();
+			if (Rows.Num() <= 1)
+			{
+				Excess -= 64 + (Rows.Num() > 0 ? Rows[0]->AsString().Len() : 0);
+				NumDropped += Rows.Num();
+				Groups.Pop();
+				continue;
+			}
+
+			// The parsed tree is ours, so trim the group in place
+			Excess -= Rows.Last()->AsString().Len() + 3;
+			Rows.Pop();
+			NumDropped++;
+			Group->SetArrayField(TEXT("rows"), Rows);
+		}
+	}
+
+	if (Fitted.Len() > MaxSize)
+	{
+		return false;
+	}
+
+	// Serialized again so the counts describe the rows that are left: returned/has_more tell a
+	// scene_query to page on from the first missing row, included_actors covers the compact summary
+	bool bRecounted = false;
+	const TSharedPtr<FJsonObject>* SummaryPtr = nullptr;
+	int32 IncludedActors = 0;
+	if (NumDropped > 0 && ResultObj->TryGetObjectField(TEXT("summary"), SummaryPtr))
+	{
+		int32 Returned = 0;
+		(*SummaryPtr)->TryGetNumberField(TEXT("returned"), Returned);
+		(*SummaryPtr)->SetNumberField(TEXT("returned"), FMath::Max(0, Returned - NumDropped));
+		(*SummaryPtr)->SetBoolField(TEXT("has_more"), true);
+		bRecounted = true;
+	}
+	else if (NumDropped > 0 && ResultObj->TryGetNumberField(TEXT("included_actors"), IncludedActors))
+	{
+		ResultObj->SetNumberField(TEXT("included_actors"), FMath::Max(0, IncludedActors - NumDropped));
+		bRecounted = true;
+	}
+
+	if (bRecounted)
+	{
+		Fitted.Reset();
+		TSharedRef<FUnrealGPTSceneTable::FWriter> Writer = FUnrealGPTSceneTable::FWriterFactory::Create(&Fitted);
+		FJsonSerializer::Serialize(ResultObj.ToSharedRef(), Writer);
+	}
+
+	InOutResult = MoveTemp(Fitted);
+	return true;
+}
+
+bool UnrealGPTToolResultProcessor::ParseSpilledResult(const FString& DisplayResult, FString& OutPreview, FString& OutFilePath)
+{
+	const int32 SeparatorIndex = DisplayResult.Find(ResultFileSeparator, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if (SeparatorIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutPreview = DisplayResult.Left(SeparatorIndex);
+	OutFilePath = DisplayResult.Mid(SeparatorIndex + FCString::Strlen(ResultFileSeparator)).TrimStartAndEnd();
+	return !OutFilePath.IsEmpty();
+}
+
+FString UnrealGPTToolResultProcessor::GetScratchDirectory()
+{
+	const FString ScratchDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealGPT"), TEXT("Scratch"));
+
+	// Thread-safe one-time prune; the directory is first used from whichever thread spills a result
+	static const bool bPruned = [&ScratchDir]()
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		TArray<FString> OldFiles;
+		FileManager.IterateDirectoryStat(*ScratchDir, [&OldFiles](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData) -> bool
+		{
+			if (!StatData.bIsDirectory && FDateTime::UtcNow() - StatData.ModificationTime > ScratchFileMaxAge)
+			{
+				OldFiles.Add(FilenameOrDirectory);
+			}
+			return true;
+		});
+
+		for (const FString& OldFile : OldFiles)
+		{
+			FileManager.Delete(*OldFile, false, false, true);
+		}
+		return true;
+	}();
+	(void)bPruned;
+
+	return ScratchDir;
+}
+
+FString UnrealGPTToolResultProcessor::SpillToScratchFile(const FString& ToolName, const FString& ToolResult)
+{
+	const FString ScratchDir = GetScratchDirectory();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.DirectoryExists(*ScratchDir) && !PlatformFile.CreateDirectoryTree(*ScratchDir))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to create scratch directory: %s"), *ScratchDir);
+		return ToolResult;
+	}
+
+	const FString FilePath = FPaths::Combine(ScratchDir, FString::Printf(TEXT("%s_%s.txt"), *ToolName, *FGuid::NewGuid().ToString(EGuidFormats::Digits)));
+	if (!FFileHelper::SaveStringToFile(ToolResult, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to spill tool result to %s"), *FilePath);
+		return ToolResult;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Spilled %d char tool result to %s"), ToolResult.Len(), *FilePath);
+	return ToolResult.Left(SpillPreviewSize) + ResultFileSeparator + FPaths::ConvertRelativePathToFull(FilePath);
+}
@@ -6,13 +6,40 @@ struct FProcessedToolResult
 {
 	FString ResultForHistory;
 	TArray<FString> Images;
+
+	/** Result for the UI and the session: the raw result, or a spill reference when it was too large to keep inline */
+	FString ResultForDisplay;
 };
 
-class UnrealGPTToolResultProcessor
+class UNREALGPTEDITOR_API UnrealGPTToolResultProcessor
 {
 public:
+	/** Results longer than this (in characters) are written to a scratch file instead of being passed to the UI */
+	static constexpr int32 MaxInlineDisplaySize = 256 * 1024;
+
+	/** Characters of a spilled result kept inline as a preview */
+	static constexpr int32 SpillPreviewSize = 4 * 1024;
+
 	static FProcessedToolResult ProcessResult(
 		const FString& ToolName,
 		const FString& ToolResult,
 		int32 MaxToolResultSize);
+
+	/** Split a display result of the form {preview}\n__RESULT_FILE__\n{path}; false if the result is inline */
+	static bool ParseSpilledResult(const FString& DisplayResult, FString& OutPreview, FString& OutFilePath);
+
+	/** Saved/UnrealGPT/Scratch */
+	static FString GetScratchDirectory();
+
+	/**
+	 * Shrink a table-format scene result (see FUnrealGPTSceneTable) to MaxSize characters by dropping
+	 * whole rows from the end and updating summary.returned/has_more, or included_actors of a compact
+	 * scene summary, so it stays valid JSON.
+	 * Returns false, leaving the result untouched, if it is not a table or cannot be made to fit.
+	 */
+	static bool FitTableToBudget(FString& InOutResult, int32 MaxSize);
+
+private:
+	/** Write the result to a UTF-8 scratch file and return the spill reference, or the result itself on failure */
+	static FString SpillToScratchFile(const FString& ToolName, const FString& ToolResult);
 };
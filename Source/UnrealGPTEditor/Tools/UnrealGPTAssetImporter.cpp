@@ -0,0 +1,342 @@
+#include "UnrealGPTAssetImporter.h"
+#include "UnrealGPTGenerationCache.h"
+#include "AssetToolsModule.h"
+#include "AssetImportTask.h"
+#include "FileHelpers.h"
+#include "InterchangeManager.h"
+#include "InterchangeResultsContainer.h"
+#include "InterchangeSourceData.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace UnrealGPTAssetImporter
+{
+	/** Folder for files that do not live under the project's Content directory */
+	static const TCHAR* FallbackDestination = TEXT("/Game/UnrealGPT/Imported");
+
+	static FString MakeErrorJson(const FString& Message)
+	{
+		TSharedPtr<FJsonObject> ErrorObj = MakeShareable(new FJsonObject);
+		ErrorObj->SetStringField(TEXT("status"), TEXT("error"));
+		ErrorObj->SetStringField(TEXT("message"), Message);
+
+		FString ErrorJson;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ErrorJson);
+		FJsonSerializer::Serialize(ErrorObj.ToSharedRef(), Writer);
+		return ErrorJson;
+	}
+}
+
+TArray<TSharedRef<FUnrealGPTAssetImporter>> FUnrealGPTAssetImporter::ActiveImports;
+
+FUnrealGPTAssetImporter::FUnrealGPTAssetImporter(FOnUnrealGPTImportComplete InOnComplete, FOnUnrealGPTImportProgress InOnProgress, bool bInSave)
+	: OnComplete(MoveTemp(InOnComplete))
+	, OnProgress(MoveTemp(InOnProgress))
+	, bSave(bInSave)
+{
+}
+
+TSharedPtr<FUnrealGPTAssetImporter> FUnrealGPTAssetImporter::ImportAsync(const FString& ArgumentsJson, FOnUnrealGPTImportComplete OnComplete,
+	FOnUnrealGPTImportProgress OnProgress)
+{
+	check(IsInGameThread());
+
+	TSharedPtr<FJsonObject> ArgsObj;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgumentsJson);
+	if (!(FJsonSerializer::Deserialize(Reader, ArgsObj) && ArgsObj.IsValid()))
+	{
+		OnComplete.ExecuteIfBound(UnrealGPTAssetImporter::MakeErrorJson(TEXT("Failed to parse import_generated arguments")));
+		return nullptr;
+	}
+
+	TArray<FString> FilePaths;
+	if (!ArgsObj->TryGetStringArrayField(TEXT("files"), FilePaths))
+	{
+		// A single path is a common enough mistake to accept
+		FString SinglePath;
+		if (ArgsObj->TryGetStringField(TEXT("files"), SinglePath) && !SinglePath.IsEmpty())
+		{
+			FilePaths.Add(SinglePath);
+		}
+	}
+	FilePaths.RemoveAll([](const FString& Path) { return Path.TrimStartAndEnd().IsEmpty(); });
+	if (FilePaths.Num() == 0)
+	{
+		OnComplete.ExecuteIfBound(UnrealGPTAssetImporter::MakeErrorJson(TEXT("Missing required field: files")));
+		return nullptr;
+	}
+
+	FString Destination;
+	ArgsObj->TryGetStringField(TEXT("destination_path"), Destination);
+	if (!Destination.IsEmpty() && !FPackageName::IsValidLongPackageName(Destination))
+	{
+		OnComplete.ExecuteIfBound(UnrealGPTAssetImporter::MakeErrorJson(
+			FString::Printf(TEXT("Invalid destination_path '%s'; expected a content folder such as /Game/Generated"), *Destination)));
+		return nullptr;
+	}
+
+	bool bSave = true;
+	ArgsObj->TryGetBoolField(TEXT("save"), bSave);
+
+	TSharedRef<FUnrealGPTAssetImporter> Importer = MakeShared<FUnrealGPTAssetImporter>(MoveTemp(OnComplete), MoveTemp(OnProgress), bSave);
+	for (const FString& FilePath : FilePaths)
+	{
+		FFileImport& File = Importer->Files.AddDefaulted_GetRef();
+		File.SourcePath = FPaths::ConvertRelativePathToFull(FilePath);
+		File.Destination = Destination.IsEmpty() ? GetDefaultDestination(File.SourcePath) : Destination;
+	}
+
+	ActiveImports.Add(Importer);
+	Importer->Start();
+
+	if (!ActiveImports.Contains(Importer))
+	{
+		return nullptr;
+	}
+	return Importer;
+}
+
+void FUnrealGPTAssetImporter::Cancel()
+{
+	TSharedRef<FUnrealGPTAssetImporter> KeepAlive = AsShared();
+	bCancelled = true;
+	OnComplete.Unbind();
+	OnProgress.Unbind();
+	ActiveImports.Remove(KeepAlive);
+}
+
+void FUnrealGPTAssetImporter::CancelAll()
+{
+	const TArray<TSharedRef<FUnrealGPTAssetImporter>> Imports = ActiveImports;
+	for (const TSharedRef<FUnrealGPTAssetImporter>& Import : Imports)
+	{
+		Import->Cancel();
+	}
+}
+
+FString FUnrealGPTAssetImporter::GetDefaultDestination(const FString& FilePath)
+{
+	// Files staged under Content (e.g. Content/UnrealGPT/Generated/Images) become assets in the matching folder
+	const FString Folder = FPaths::GetPath(FPaths::ConvertRelativePathToFull(FilePath));
+	const FString ContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+
+	FString PackagePath;
+	if (FPaths::IsUnderDirectory(Folder, ContentDir) && FPackageName::TryConvertFilenameToLongPackageName(Folder, PackagePath))
+	{
+		return PackagePath;
+	}
+	return UnrealGPTAssetImporter::FallbackDestination;
+}
+
+void FUnrealGPTAssetImporter::Start()
+{
+	TSharedRef<FUnrealGPTAssetImporter> KeepAlive = AsShared();
+
+	TArray<int32> AssetToolsFiles;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		if (!FPaths::FileExists(Files[Index].SourcePath))
+		{
+			OnFileImported(Index, TArray<FString>(), FString::Printf(TEXT("File not found: %s"), *Files[Index].SourcePath));
+		}
+		else if (!StartInterchangeImport(Index))
+		{
+			AssetToolsFiles.Add(Index);
+		}
+	}
+
+	if (AssetToolsFiles.Num() > 0)
+	{
+		ImportWithAssetTools(AssetToolsFiles);
+	}
+}
+
+bool FUnrealGPTAssetImporter::StartInterchangeImport(int32 Index)
+{
+	UInterchangeManager& InterchangeManager = UInterchangeManager::GetInterchangeManager();
+	UE::Interchange::FScopedSourceData ScopedSourceData(Files[Index].SourcePath);
+	if (!InterchangeManager.CanTranslateSourceData(ScopedSourceData.GetSourceData()))
+	{
+		return false;
+	}
+
+	FImportAssetParameters ImportParameters;
+	ImportParameters.bIsAutomated = true;
+
+	UE::Interchange::FAssetImportResultRef ImportResult =
+		InterchangeManager.ImportAssetAsync(Files[Index].Destination, ScopedSourceData.GetSourceData(), ImportParameters);
+
+	TWeakPtr<FUnrealGPTAssetImporter> WeakThis = AsShared();
+	auto HandleDone = [WeakThis, Index](UE::Interchange::FImportResult& Result)
+	{
+		TArray<FString> AssetPaths;
+		for (const UObject* Object : Result.GetImportedObjects())
+		{
+			if (Object)
+			{
+				AssetPaths.Add(Object->GetPathName());
+			}
+		}
+
+		FString Error;
+		if (AssetPaths.Num() == 0)
+		{
+			Error = TEXT("Interchange produced no assets");
+			if (const UInterchangeResultsContainer* Results = Result.GetResults())
+			{
+				for (const UInterchangeResult* Message : Results->GetResults())
+				{
+					if (Message && Message->GetResultType() == EInterchangeResultType::Error)
+					{
+						Error = Message->GetText().ToString();
+						break;
+					}
+				}
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Index, AssetPaths = MoveTemp(AssetPaths), Error = MoveTemp(Error)]()
+		{
+			if (TSharedPtr<FUnrealGPTAssetImporter> Importer = WeakThis.Pin())
+			{
+				Importer->OnFileImported(Index, AssetPaths, Error);
+			}
+		});
+	};
+
+	ImportResult->OnDone(HandleDone);
+
+	// Imports rejected up front are already done and never fire the callback
+	if (ImportResult->GetStatus() == UE::Interchange::FImportResult::EStatus::Done)
+	{
+		HandleDone(ImportResult.Get());
+	}
+	return true;
+}
+
+void FUnrealGPTAssetImporter::ImportWithAssetTools(const TArray<int32>& Indices)
+{
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+
+	TArray<UAssetImportTask*> Tasks;
+	for (const int32 Index : Indices)
+	{
+		UAssetImportTask* Task = NewObject<UAssetImportTask>();
+		Task->Filename = Files[Index].SourcePath;
+		Task->DestinationPath = Files[Index].Destination;
+		Task->bAutomated = true;
+		Task->bReplaceExisting = true;
+		Task->bSave = false;
+		Tasks.Add(Task);
+	}
+
+	// The legacy factories have no async path; one call for all of them at least shares the overhead
+	AssetTools.ImportAssetTasks(Tasks);
+
+	for (int32 TaskIndex = 0; TaskIndex < Tasks.Num(); ++TaskIndex)
+	{
+		TArray<FString> AssetPaths;
+		for (const FString& ObjectPath : Tasks[TaskIndex]->ImportedObjectPaths)
+		{
+			AssetPaths.Add(ObjectPath);
+		}
+		OnFileImported(Indices[TaskIndex], AssetPaths, AssetPaths.Num() > 0 ? FString() : TEXT("Unsupported file type or import failed"));
+	}
+}
+
+void FUnrealGPTAssetImporter::OnFileImported(int32 Index, const TArray<FString>& AssetPaths, const FString& Error)
+{
+	FFileImport& File = Files[Index];
+	if (bCancelled || File.bDone)
+	{
+		return;
+	}
+
+	File.bDone = true;
+	File.AssetPaths = AssetPaths;
+	File.Error = Error;
+	++NumDone;
+
+	if (AssetPaths.Num() > 0)
+	{
+		FUnrealGPTGenerationCache::Get().RecordImportedAsset(File.SourcePath, AssetPaths[0]);
+	}
+
+	OnProgress.ExecuteIfBound(
+		FString::Printf(TEXT("Imported %d of %d: %s"), NumDone, Files.Num(), *FPaths::GetCleanFilename(File.SourcePath)),
+		static_cast<float>(NumDone) / Files.Num());
+
+	if (NumDone == Files.Num())
+	{
+		Finish();
+	}
+}
+
+void FUnrealGPTAssetImporter::Finish()
+{
+	TSharedRef<FUnrealGPTAssetImporter> KeepAlive = AsShared();
+	ActiveImports.Remove(KeepAlive);
+
+	TArray<UPackage*> Packages;
+	TArray<TSharedPtr<FJsonValue>> ImportsArray;
+	int32 NumImported = 0;
+	int32 NumAssets = 0;
+	for (const FFileImport& File : Files)
+	{
+		TSharedPtr<FJsonObject> ImportObj = MakeShareable(new FJsonObject);
+		ImportObj->SetStringField(TEXT("local_path"), File.SourcePath);
+
+		TArray<TSharedPtr<FJsonValue>> AssetValues;
+		for (const FString& AssetPath : File.AssetPaths)
+		{
+			AssetValues.Add(MakeShareable(new FJsonValueString(AssetPath)));
+
+			if (UPackage* Package = FindPackage(nullptr, *FPackageName::ObjectPathToPackageName(AssetPath)))
+			{
+				Packages.AddUnique(Package);
+			}
+		}
+		ImportObj->SetArrayField(TEXT("asset_paths"), AssetValues);
+
+		if (!File.Error.IsEmpty())
+		{
+			ImportObj->SetStringField(TEXT("error"), File.Error);
+		}
+		else
+		{
+			++NumImported;
+			NumAssets += File.AssetPaths.Num();
+		}
+		ImportsArray.Add(MakeShareable(new FJsonValueObject(ImportObj)));
+	}
+
+	// One save for the whole batch instead of one per asset
+	bool bSaved = false;
+	if (bSave && Packages.Num() > 0)
+	{
+		OnProgress.ExecuteIfBound(FString::Printf(TEXT("Saving %d package(s)"), Packages.Num()), 1.0f);
+		bSaved = UEditorLoadingAndSavingUtils::SavePackages(Packages, true);
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject);
+	ResultObj->SetStringField(TEXT("status"), NumImported > 0 ? TEXT("success") : TEXT("error"));
+	ResultObj->SetStringField(
+		TEXT("message"),
+		FString::Printf(TEXT("Imported %d of %d file(s) as %d asset(s)."), NumImported, Files.Num(), NumAssets));
+
+	TSharedPtr<FJsonObject> DetailsObj = MakeShareable(new FJsonObject);
+	DetailsObj->SetArrayField(TEXT("imports"), ImportsArray);
+	DetailsObj->SetBoolField(TEXT("saved"), bSaved);
+	ResultObj->SetObjectField(TEXT("details"), DetailsObj);
+
+	FString ResultJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(ResultObj.ToSharedRef(), Writer);
+
+	OnComplete.ExecuteIfBound(ResultJson);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_DELEGATE_OneParam(FOnUnrealGPTImportComplete, const FString& /*ResultJson*/);
+
+/** Human-readable status and completed fraction (0-1) */
+DECLARE_DELEGATE_TwoParams(FOnUnrealGPTImportProgress, const FString& /*Status*/, float /*Fraction*/);
+
+/**
+ * Imports generated files (textures, meshes, audio) for the import_generated tool without
+ * stalling the editor. Formats Interchange can translate are queued on its asynchronous
+ * pipeline; anything else goes through one batched AssetTools import. Packages are left dirty
+ * while files come in and written by a single save once the last import lands.
+ *
+ * Instances keep themselves alive until they finish. Game thread only.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTAssetImporter : public TSharedFromThis<FUnrealGPTAssetImporter>
+{
+public:
+	/**
+	 * @param ArgumentsJson - JSON string with:
+	 *   - files (required): Local paths of the files to import, e.g. details.files[].local_path of replicate_generate
+	 *   - destination_path: Content folder such as "/Game/Generated" (default: mirrors the file's folder under Content)
+	 *   - save: Save the imported packages when done (default: true)
+	 * @param OnComplete - Receives the JSON result once every file is imported or has failed.
+	 *   Invoked on the game thread; immediately if the arguments are invalid.
+	 * @param OnProgress - Invoked as each file lands
+	 *
+	 * @return The running import, or null if it finished before returning
+	 */
+	static TSharedPtr<FUnrealGPTAssetImporter> ImportAsync(const FString& ArgumentsJson, FOnUnrealGPTImportComplete OnComplete,
+		FOnUnrealGPTImportProgress OnProgress = FOnUnrealGPTImportProgress());
+
+	/** Stop reporting; imports already queued still finish, but nothing is saved and the delegate is not invoked */
+	void Cancel();
+
+	/** Cancel every running import */
+	static void CancelAll();
+
+	/** Content folder a file is imported into when no destination is given. Exposed for tests. */
+	static FString GetDefaultDestination(const FString& FilePath);
+
+	FUnrealGPTAssetImporter(FOnUnrealGPTImportComplete InOnComplete, FOnUnrealGPTImportProgress InOnProgress, bool bInSave);
+
+private:
+	struct FFileImport
+	{
+		FString SourcePath;
+		FString Destination;
+		TArray<FString> AssetPaths;
+		FString Error;
+		bool bDone = false;
+	};
+
+	void Start();
+
+	/** Returns false if Interchange has no translator for the file */
+	bool StartInterchangeImport(int32 Index);
+
+	/** Import the given files in one synchronous AssetTools call */
+	void ImportWithAssetTools(const TArray<int32>& Indices);
+
+	void OnFileImported(int32 Index, const TArray<FString>& AssetPaths, const FString& Error);
+	void Finish();
+
+	FOnUnrealGPTImportComplete OnComplete;
+	FOnUnrealGPTImportProgress OnProgress;
+	bool bSave = true;
+	bool bCancelled = false;
+
+	TArray<FFileImport> Files;
+	int32 NumDone = 0;
+
+	/** Imports that have not finished yet */
+	static TArray<TSharedRef<FUnrealGPTAssetImporter>> ActiveImports;
+};
@@ -0,0 +1,391 @@
+#include "UnrealGPTGenerationCache.h"
+#include "UnrealGPTSettings.h"
+#include "UnrealGPTJsonHelpers.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+namespace UnrealGPTGenerationCache
+{
+	static const int32 IndexVersion = 1;
+}
+
+FUnrealGPTGenerationCache& FUnrealGPTGenerationCache::Get()
+{
+	static FUnrealGPTGenerationCache Instance;
+	return Instance;
+}
+
+FUnrealGPTGenerationCache::FUnrealGPTGenerationCache()
+{
+	LoadIndex();
+}
+
+bool FUnrealGPTGenerationCache::IsEnabled()
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	return Settings && Settings->ReplicateCacheQuotaMB > 0;
+}
+
+FString FUnrealGPTGenerationCache::MakeKey(const FString& CreateUrl, const FString& RequestBody)
+{
+	const FTCHARToUTF8 Utf8(*(CreateUrl + TEXT("\n") + UnrealGPTJsonHelpers::MakeCanonicalJson(RequestBody)));
+	uint8 Digest[FSHA1::DigestSize];
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Digest);
+	return BytesToHex(Digest, FSHA1::DigestSize);
+}
+
+void FUnrealGPTGenerationCache::Lookup(const FString& Key, TFunction<void(bool bHit, const TArray<FCachedFile>& Files)> OnComplete)
+{
+	check(IsInGameThread());
+
+	const int32 Index = Entries.IndexOfByPredicate([&Key](const FEntry& Entry) { return Entry.Key == Key; });
+	if (Index == INDEX_NONE)
+	{
+		OnComplete(false, TArray<FCachedFile>());
+		return;
+	}
+
+	// The asset registry is game thread only, so imported assets are checked before the files
+	for (const FEntryFile& File : Entries[Index].Files)
+	{
+		if (!File.ImportedAsset.IsEmpty() && !IsImportedAssetCurrent(File))
+		{
+			UE_LOG(LogTemp, Log, TEXT("UnrealGPT: %s was deleted or reimported; treating generation cache entry %s as a miss"), *File.ImportedAsset, *Key);
+			OnComplete(false, TArray<FCachedFile>());
+			return;
+		}
+	}
+
+	// Outputs can be tens of megabytes, so checking and restoring them stays off the game thread
+	Async(EAsyncExecution::ThreadPool, [Key, Files = Entries[Index].Files, EntryDir = GetCacheDir() / Key, OnComplete = MoveTemp(OnComplete)]() mutable
+	{
+		IFileManager& FileManager = IFileManager::Get();
+
+		bool bComplete = true;
+		bool bRestored = true;
+		for (const FEntryFile& File : Files)
+		{
+			const FString CachedPath = EntryDir / File.CachedFile;
+			if (FileManager.FileSize(*CachedPath) != File.Bytes)
+			{
+				bComplete = false;
+				break;
+			}
+
+			// Restore outputs that were moved or deleted from the staging folder since
+			if (FileManager.FileSize(*File.OriginalPath) != File.Bytes
+				&& FileManager.Copy(*File.OriginalPath, *CachedPath) != COPY_OK)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to restore cached output to %s"), *File.OriginalPath);
+				bRestored = false;
+				break;
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Key, Files = MoveTemp(Files), OnComplete = MoveTemp(OnComplete), bComplete, bRestored]()
+		{
+			FUnrealGPTGenerationCache& Cache = FUnrealGPTGenerationCache::Get();
+			const int32 Index = Cache.Entries.IndexOfByPredicate([&Key](const FEntry& Entry) { return Entry.Key == Key; });
+
+			if (!bComplete)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Generation cache entry %s is incomplete; dropping it"), *Key);
+				if (Index != INDEX_NONE)
+				{
+					Cache.RemoveEntry(Index);
+					Cache.SaveIndex();
+				}
+				OnComplete(false, TArray<FCachedFile>());
+				return;
+			}
+
+			// The cached copy is intact but could not be put back; a fresh prediction will overwrite the entry
+			if (!bRestored)
+			{
+				OnComplete(false, TArray<FCachedFile>());
+				return;
+			}
+
+			// An entry evicted while the files were checked still answers this lookup; its outputs are in place
+			if (Index != INDEX_NONE)
+			{
+				Cache.Entries[Index].LastUsed = FDateTime::UtcNow();
+				Cache.SaveIndex();
+			}
+
+			TArray<FCachedFile> CachedFiles;
+			for (const FEntryFile& File : Files)
+			{
+				FCachedFile& Cached = CachedFiles.AddDefaulted_GetRef();
+				Cached.LocalPath = File.OriginalPath;
+				Cached.ImportedAsset = File.ImportedAsset;
+			}
+			OnComplete(true, CachedFiles);
+		});
+	});
+}
+
+bool FUnrealGPTGenerationCache::IsImportedAssetCurrent(const FEntryFile& File)
+{
+	const FString PackageName = FPackageName::ObjectPathToPackageName(File.ImportedAsset);
+
+	TArray<FAssetData> Assets;
+	IAssetRegistry::GetChecked().GetAssetsByPackageName(FName(*PackageName), Assets);
+	if (Assets.Num() == 0)
+	{
+		return false;
+	}
+
+	// The import data tag lists the source files; an asset reimported from something else is stale
+	FString ImportData;
+	if (Assets[0].GetTagValue(FName(TEXT("AssetImportData")), ImportData) && !ImportData.IsEmpty())
+	{
+		return ImportData.Contains(FPaths::GetCleanFilename(File.OriginalPath));
+	}
+	return true;
+}
+
+void FUnrealGPTGenerationCache::Store(const FString& Key, const TArray<FString>& LocalPaths)
+{
+	check(IsInGameThread());
+
+	if (LocalPaths.Num() == 0 || !IsEnabled())
+	{
+		return;
+	}
+
+	const FString EntryDir = GetCacheDir() / Key;
+
+	// Outputs can be tens of megabytes (video, meshes), so copy them off the game thread
+	Async(EAsyncExecution::ThreadPool, [Key, LocalPaths, EntryDir]()
+	{
+		IFileManager& FileManager = IFileManager::Get();
+
+		FEntry Entry;
+		Entry.Key = Key;
+		for (const FString& LocalPath : LocalPaths)
+		{
+			FEntryFile& File = Entry.Files.AddDefaulted_GetRef();
+			File.OriginalPath = FPaths::ConvertRelativePathToFull(LocalPath);
+			File.CachedFile = FPaths::GetCleanFilename(LocalPath);
+
+			if (FileManager.Copy(*(EntryDir / File.CachedFile), *File.OriginalPath) != COPY_OK)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to cache generated output %s"), *LocalPath);
+				FileManager.DeleteDirectory(*EntryDir, false, true);
+				return;
+			}
+			File.Bytes = FileManager.FileSize(*(EntryDir / File.CachedFile));
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Entry = MoveTemp(Entry)]() mutable
+		{
+			FUnrealGPTGenerationCache& Cache = FUnrealGPTGenerationCache::Get();
+			Cache.AddEntry(MoveTemp(Entry));
+			Cache.EvictToQuota();
+			Cache.SaveIndex();
+		});
+	});
+}
+
+void FUnrealGPTGenerationCache::RecordImportedAsset(const FString& LocalPath, const FString& AssetPath)
+{
+	check(IsInGameThread());
+
+	const FString FullPath = FPaths::ConvertRelativePathToFull(LocalPath);
+	for (FEntry& Entry : Entries)
+	{
+		for (FEntryFile& File : Entry.Files)
+		{
+			if (File.OriginalPath == FullPath)
+			{
+				File.ImportedAsset = AssetPath;
+				SaveIndex();
+				return;
+			}
+		}
+	}
+}
+
+FString FUnrealGPTGenerationCache::GetCacheDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealGPT"), TEXT("GenerationCache"));
+}
+
+FString FUnrealGPTGenerationCache::GetIndexPath()
+{
+	return GetCacheDir() / TEXT("Index.json");
+}
+
+void FUnrealGPTGenerationCache::LoadIndex()
+{
+	Entries.Reset();
+	TotalBytes = 0;
+
+	FString IndexJson;
+	if (!FFileHelper::LoadFileToString(IndexJson, *GetIndexPath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> IndexObj;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(IndexJson);
+	int32 Version = 0;
+	if (!FJsonSerializer::Deserialize(Reader, IndexObj) || !IndexObj.IsValid()
+		|| !IndexObj->TryGetNumberField(TEXT("version"), Version) || Version != UnrealGPTGenerationCache::IndexVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Ignoring unreadable generation cache index %s"), *GetIndexPath());
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* EntryValues = nullptr;
+	if (!IndexObj->TryGetArrayField(TEXT("entries"), EntryValues))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& EntryValue : *EntryValues)
+	{
+		const TSharedPtr<FJsonObject>* EntryObj = nullptr;
+		if (!EntryValue.IsValid() || !EntryValue->TryGetObject(EntryObj))
+		{
+			continue;
+		}
+
+		FEntry Entry;
+		FString LastUsed;
+		(*EntryObj)->TryGetStringField(TEXT("key"), Entry.Key);
+		(*EntryObj)->TryGetStringField(TEXT("last_used"), LastUsed);
+		FDateTime::ParseIso8601(*LastUsed, Entry.LastUsed);
+
+		const TArray<TSharedPtr<FJsonValue>>* FileValues = nullptr;
+		if ((*EntryObj)->TryGetArrayField(TEXT("files"), FileValues))
+		{
+			for (const TSharedPtr<FJsonValue>& FileValue : *FileValues)
+			{
+				const TSharedPtr<FJsonObject>* FileObj = nullptr;
+				if (!FileValue.IsValid() || !FileValue->TryGetObject(FileObj))
+				{
+					continue;
+				}
+
+				FEntryFile& File = Entry.Files.AddDefaulted_GetRef();
+				(*FileObj)->TryGetStringField(TEXT("original_path"), File.OriginalPath);
+				(*FileObj)->TryGetStringField(TEXT("cached_file"), File.CachedFile);
+				(*FileObj)->TryGetStringField(TEXT("imported_asset"), File.ImportedAsset);
+				(*FileObj)->TryGetNumberField(TEXT("bytes"), File.Bytes);
+			}
+		}
+
+		if (!Entry.Key.IsEmpty() && Entry.Files.Num() > 0)
+		{
+			AddEntry(MoveTemp(Entry));
+		}
+	}
+}
+
+void FUnrealGPTGenerationCache::SaveIndex() const
+{
+	TArray<TSharedPtr<FJsonValue>> EntryValues;
+	for (const FEntry& Entry : Entries)
+	{
+		TArray<TSharedPtr<FJsonValue>> FileValues;
+		for (const FEntryFile& File : Entry.Files)
+		{
+			TSharedPtr<FJsonObject> FileObj = MakeShareable(new FJsonObject);
+			FileObj->SetStringField(TEXT("original_path"), File.OriginalPath);
+			FileObj->SetStringField(TEXT("cached_file"), File.CachedFile);
+			if (!File.ImportedAsset.IsEmpty())
+			{
+				FileObj->SetStringField(TEXT("imported_asset"), File.ImportedAsset);
+			}
+			FileObj->SetNumberField(TEXT("bytes"), static_cast<double>(File.Bytes));
+			FileValues.Add(MakeShareable(new FJsonValueObject(FileObj)));
+		}
+
+		TSharedPtr<FJsonObject> EntryObj = MakeShareable(new FJsonObject);
+		EntryObj->SetStringField(TEXT("key"), Entry.Key);
+		EntryObj->SetStringField(TEXT("last_used"), Entry.LastUsed.ToIso8601());
+		EntryObj->SetArrayField(TEXT("files"), FileValues);
+		EntryValues.Add(MakeShareable(new FJsonValueObject(EntryObj)));
+	}
+
+	TSharedPtr<FJsonObject> IndexObj = MakeShareable(new FJsonObject);
+	IndexObj->SetNumberField(TEXT("version"), UnrealGPTGenerationCache::IndexVersion);
+	IndexObj->SetArrayField(TEXT("entries"), EntryValues);
+
+	FString IndexJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&IndexJson);
+	FJsonSerializer::Serialize(IndexObj.ToSharedRef(), Writer);
+
+	if (!FFileHelper::SaveStringToFile(IndexJson, *GetIndexPath()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to write generation cache index %s"), *GetIndexPath());
+	}
+}
+
+void FUnrealGPTGenerationCache::AddEntry(FEntry&& Entry)
+{
+	if (Entry.LastUsed == FDateTime())
+	{
+		Entry.LastUsed = FDateTime::UtcNow();
+	}
+
+	// A repeated store of the same key replaces the older entry's bookkeeping; the files are the same
+	const int32 Existing = Entries.IndexOfByPredicate([&Entry](const FEntry& Other) { return Other.Key == Entry.Key; });
+	if (Existing != INDEX_NONE)
+	{
+		TotalBytes -= GetEntryBytes(Entries[Existing]);
+		Entries.RemoveAt(Existing);
+	}
+
+	TotalBytes += GetEntryBytes(Entry);
+	Entries.Add(MoveTemp(Entry));
+}
+
+void FUnrealGPTGenerationCache::RemoveEntry(int32 Index)
+{
+	TotalBytes -= GetEntryBytes(Entries[Index]);
+	IFileManager::Get().DeleteDirectory(*(GetCacheDir() / Entries[Index].Key), false, true);
+	Entries.RemoveAt(Index);
+}
+
+void FUnrealGPTGenerationCache::EvictToQuota()
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	const int64 QuotaBytes = static_cast<int64>(FMath::Max(0, Settings->ReplicateCacheQuotaMB)) * 1024 * 1024;
+
+	while (TotalBytes > QuotaBytes && Entries.Num() > 0)
+	{
+		int32 Oldest = 0;
+		for (int32 Index = 1; Index < Entries.Num(); ++Index)
+		{
+			if (Entries[Index].LastUsed < Entries[Oldest].LastUsed)
+			{
+				Oldest = Index;
+			}
+		}
+
+		UE_LOG(LogTemp, Verbose, TEXT("UnrealGPT: Evicting generation cache entry %s"), *Entries[Oldest].Key);
+		RemoveEntry(Oldest);
+	}
+}
+
+int64 FUnrealGPTGenerationCache::GetEntryBytes(const FEntry& Entry)
+{
+	int64 Bytes = 0;
+	for (const FEntryFile& File : Entry.Files)
+	{
+		Bytes += File.Bytes;
+	}
+	return Bytes;
+}
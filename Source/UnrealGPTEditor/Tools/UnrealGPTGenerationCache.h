@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Local cache of Replicate outputs keyed by a hash of the canonicalized prediction input
+ * (endpoint, model version and input fields), so an identical seeded request returns the
+ * earlier files instantly instead of creating a new prediction.
+ *
+ * Each entry keeps its own copy of the downloaded files under Saved/UnrealGPT/GenerationCache,
+ * so files moved or deleted from the Content staging folder can be restored, along with the
+ * asset path they were imported to, if any. Entries are evicted least-recently-used first once
+ * the cache exceeds the "Generation Cache Quota" setting. Game thread only.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTGenerationCache
+{
+public:
+	struct FCachedFile
+	{
+		/** Where the output lives in the staging folder */
+		FString LocalPath;
+
+		/** Package path of the asset it was imported as, or empty */
+		FString ImportedAsset;
+	};
+
+	static FUnrealGPTGenerationCache& Get();
+
+	/** Whether caching is enabled by settings (quota > 0) */
+	static bool IsEnabled();
+
+	/** SHA1 of the create URL and the request body with object keys sorted. Exposed for tests. */
+	static FString MakeKey(const FString& CreateUrl, const FString& RequestBody);
+
+	/**
+	 * Look up a finished generation. OnComplete receives whether it hit and the files, on the game thread;
+	 * immediately when there is no entry. The cached copies are checked and outputs missing from the
+	 * staging folder copied back on a worker thread. An entry whose cached copy is gone is dropped, and
+	 * one whose imported asset was deleted or reimported from another file is reported as a miss.
+	 */
+	void Lookup(const FString& Key, TFunction<void(bool bHit, const TArray<FCachedFile>& Files)> OnComplete);
+
+	/** Copy downloaded outputs into the cache on a worker thread, then evict down to the quota */
+	void Store(const FString& Key, const TArray<FString>& LocalPaths);
+
+	/** Remember the asset a cached output was imported as, so later hits can reuse it */
+	void RecordImportedAsset(const FString& LocalPath, const FString& AssetPath);
+
+	/** Total bytes of cached files */
+	int64 GetTotalBytes() const { return TotalBytes; }
+
+private:
+	struct FEntryFile
+	{
+		FString OriginalPath;
+		FString CachedFile;
+		FString ImportedAsset;
+		int64 Bytes = 0;
+	};
+
+	struct FEntry
+	{
+		FString Key;
+		TArray<FEntryFile> Files;
+		FDateTime LastUsed;
+	};
+
+	FUnrealGPTGenerationCache();
+
+	static FString GetCacheDir();
+	static FString GetIndexPath();
+
+	void LoadIndex();
+	void SaveIndex() const;
+
+	void AddEntry(FEntry&& Entry);
+	void RemoveEntry(int32 Index);
+
+	/** Drop least recently used entries until the cache fits the quota */
+	void EvictToQuota();
+
+	static int64 GetEntryBytes(const FEntry& Entry);
+
+	/** Whether the asset a file was imported as still exists and was imported from that file */
+	static bool IsImportedAssetCurrent(const FEntryFile& File);
+
+	TArray<FEntry> Entries;
+	int64 TotalBytes = 0;
+};
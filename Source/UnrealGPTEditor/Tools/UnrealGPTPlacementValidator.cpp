@@ -0,0 +1,372 @@
+#include "UnrealGPTPlacementValidator.h"
+#include "UnrealGPTJsonHelpers.h"
+#include "UnrealGPTToolResultCache.h"
+#include "CollisionQueryParams.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "LandscapeProxy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace UnrealGPTPlacementValidation
+{
+	/** Half size a query is grown to, for flat bounds from Box(); a zero-size shape would be treated as a line or point */
+	static const double MinExtent = 0.5;
+
+	static const TCHAR* const VectorFields[] = { TEXT("x"), TEXT("y"), TEXT("z") };
+	static const TCHAR* const RotatorFields[] = { TEXT("pitch"), TEXT("yaw"), TEXT("roll") };
+
+	/** Read {x, y, z} style objects; missing components are left at zero unless all are required */
+	static bool ReadComponents(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, const TCHAR* const (&Names)[3], bool bRequireAll, FVector& OutValue)
+	{
+		const TSharedPtr<FJsonObject>* ComponentsObj = nullptr;
+		if (!Object->TryGetObjectField(Field, ComponentsObj) || !ComponentsObj)
+		{
+			return false;
+		}
+
+		OutValue = FVector::ZeroVector;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (!(*ComponentsObj)->TryGetNumberField(Names[Axis], OutValue[Axis]) && bRequireAll)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Numbers between the parentheses that follow Start, e.g. "1, -2.5, 3)" */
+	static bool ParseArguments(const FString& Text, int32 Start, TArray<double>& OutValues)
+	{
+		const int32 Close = Text.Find(TEXT(")"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start);
+		if (Close == INDEX_NONE)
+		{
+			return false;
+		}
+
+		TArray<FString> Parts;
+		Text.Mid(Start, Close - Start).ParseIntoArray(Parts, TEXT(","), false);
+		for (FString& Part : Parts)
+		{
+			Part.TrimStartAndEndInline();
+			if (Part.IsEmpty() || !Part.IsNumeric())
+			{
+				return false;
+			}
+			OutValues.Add(FCString::Atod(*Part));
+		}
+		return true;
+	}
+}
+
+FUnrealGPTClearanceQuery FUnrealGPTClearanceQuery::Box(const FBox& Bounds)
+{
+	FUnrealGPTClearanceQuery Query;
+	Bounds.GetCenterAndExtents(Query.Center, Query.Extent);
+	return Query;
+}
+
+FUnrealGPTClearanceQuery FUnrealGPTClearanceQuery::Sphere(const FVector& Center, double Radius)
+{
+	FUnrealGPTClearanceQuery Query;
+	Query.Center = Center;
+	Query.Extent = FVector(Radius);
+	Query.bSphere = true;
+	return Query;
+}
+
+FUnrealGPTPlacementValidator& FUnrealGPTPlacementValidator::Get()
+{
+	static FUnrealGPTPlacementValidator Instance;
+	return Instance;
+}
+
+FString FUnrealGPTPlacementValidator::CheckPlacements(const FString& ArgumentsJson)
+{
+	using namespace UnrealGPTPlacementValidation;
+
+	TSharedPtr<FJsonObject> ArgsObj;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgumentsJson);
+	if (!(FJsonSerializer::Deserialize(Reader, ArgsObj) && ArgsObj.IsValid()))
+	{
+		return UnrealGPTJsonHelpers::MakeErrorResult(TEXT("Failed to parse check_placement arguments"));
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* PlacementsArray = nullptr;
+	if (!ArgsObj->TryGetArrayField(TEXT("placements"), PlacementsArray) || PlacementsArray->Num() == 0)
+	{
+		return UnrealGPTJsonHelpers::MakeErrorResult(TEXT("Missing required field: placements"));
+	}
+	if (PlacementsArray->Num() > MaxQueries)
+	{
+		return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("At most %d placements can be checked per call; got %d"), MaxQueries, PlacementsArray->Num()));
+	}
+
+	bool bIgnoreLandscape = true;
+	ArgsObj->TryGetBoolField(TEXT("ignore_landscape"), bIgnoreLandscape);
+
+	TArray<FUnrealGPTClearanceQuery> Queries;
+	Queries.Reserve(PlacementsArray->Num());
+	for (int32 Index = 0; Index < PlacementsArray->Num(); ++Index)
+	{
+		const TSharedPtr<FJsonObject>* PlacementObj = nullptr;
+		if (!(*PlacementsArray)[Index].IsValid() || !(*PlacementsArray)[Index]->TryGetObject(PlacementObj))
+		{
+			return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("Placement %d is not an object"), Index));
+		}
+
+		FUnrealGPTClearanceQuery& Query = Queries.AddDefaulted_GetRef();
+		Query.bIgnoreLandscape = bIgnoreLandscape;
+		if (!ReadComponents(*PlacementObj, TEXT("location"), VectorFields, true, Query.Center))
+		{
+			return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("Placement %d needs a location {x, y, z}"), Index));
+		}
+
+		double Radius = 0.0;
+		if ((*PlacementObj)->TryGetNumberField(TEXT("radius"), Radius))
+		{
+			if (Radius <= 0.0)
+			{
+				return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("Placement %d has a radius of %g; it must be positive"), Index, Radius));
+			}
+			Query.bSphere = true;
+			Query.Extent = FVector(Radius);
+		}
+		else if (!ReadComponents(*PlacementObj, TEXT("extent"), VectorFields, true, Query.Extent))
+		{
+			return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("Placement %d needs an extent {x, y, z} or a radius"), Index));
+		}
+		else if (Query.Extent.GetMin() <= 0.0)
+		{
+			return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("Placement %d has an extent of (%g, %g, %g); every half size must be positive"),
+				Index, Query.Extent.X, Query.Extent.Y, Query.Extent.Z));
+		}
+
+		FVector Rotation;
+		if (ReadComponents(*PlacementObj, TEXT("rotation"), RotatorFields, false, Rotation))
+		{
+			Query.Rotation = FRotator(Rotation.X, Rotation.Y, Rotation.Z);
+		}
+
+		(*PlacementObj)->TryGetStringField(TEXT("ignore"), Query.IgnoreActor);
+	}
+
+	TArray<FUnrealGPTClearanceResult> Results;
+	if (!Get().Validate(Queries, Results))
+	{
+		return UnrealGPTJsonHelpers::MakeErrorResult(TEXT("No editor world with a physics scene is open"));
+	}
+
+	// Only blocked placements are listed, so checking hundreds of clear ones stays small
+	TArray<TSharedPtr<FJsonValue>> BlockedArray;
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		if (Results[Index].bClear)
+		{
+			continue;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> BlockersArray;
+		for (const FString& Blocker : Results[Index].Blockers)
+		{
+			BlockersArray.Add(MakeShared<FJsonValueString>(Blocker));
+		}
+
+		TSharedPtr<FJsonObject> BlockedObj = MakeShared<FJsonObject>();
+		BlockedObj->SetNumberField(TEXT("index"), Index);
+		BlockedObj->SetArrayField(TEXT("blockers"), BlockersArray);
+		BlockedArray.Add(MakeShared<FJsonValueObject>(BlockedObj));
+	}
+
+	TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+	Details->SetNumberField(TEXT("checked"), Results.Num());
+	Details->SetNumberField(TEXT("clear"), Results.Num() - BlockedArray.Num());
+	Details->SetArrayField(TEXT("blocked"), BlockedArray);
+
+	const FString Message = BlockedArray.Num() == 0
+		? FString::Printf(TEXT("All %d placements are clear"), Results.Num())
+		: FString::Printf(TEXT("%d of %d placements overlap existing geometry"), BlockedArray.Num(), Results.Num());
+	return UnrealGPTJsonHelpers::MakeSuccessResult(Message, Details);
+}
+
+bool FUnrealGPTPlacementValidator::ParseExpression(const FString& Expression, FUnrealGPTClearanceQuery& OutQuery)
+{
+	const int32 CallStart = Expression.Find(TEXT("IsAreaClear("));
+	if (CallStart == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FString Volume = Expression.Mid(CallStart + FCString::Strlen(TEXT("IsAreaClear("))).TrimStart();
+	const bool bSphere = Volume.StartsWith(TEXT("Sphere("));
+	if (!bSphere && !Volume.StartsWith(TEXT("Box(")))
+	{
+		// Symbolic bounds such as "TargetBounds" have nothing to query
+		return false;
+	}
+
+	TArray<double> Values;
+	if (!UnrealGPTPlacementValidation::ParseArguments(Volume, Volume.Find(TEXT("(")) + 1, Values) || Values.Num() != (bSphere ? 4 : 6))
+	{
+		return false;
+	}
+
+	OutQuery = FUnrealGPTClearanceQuery();
+	OutQuery.Center = FVector(Values[0], Values[1], Values[2]);
+	OutQuery.Extent = bSphere ? FVector(Values[3]) : FVector(Values[3], Values[4], Values[5]);
+	OutQuery.bSphere = bSphere;
+	return true;
+}
+
+bool FUnrealGPTPlacementValidator::Validate(TConstArrayView<FUnrealGPTClearanceQuery> Queries, TArray<FUnrealGPTClearanceResult>& OutResults)
+{
+	return Validate(GEditor ? GEditor->GetEditorWorldContext().World() : nullptr, Queries, OutResults);
+}
+
+bool FUnrealGPTPlacementValidator::Validate(UWorld* World, TConstArrayView<FUnrealGPTClearanceQuery> Queries, TArray<FUnrealGPTClearanceResult>& OutResults)
+{
+	using namespace UnrealGPTPlacementValidation;
+
+	OutResults.Reset();
+	if (!World || !World->GetPhysicsScene())
+	{
+		return false;
+	}
+
+	SyncGeneration(World);
+	OutResults.SetNum(Queries.Num());
+
+	// Distinct queries the cache cannot answer; plans often repeat a volume across steps
+	TArray<int32> Misses;
+	TMap<FUnrealGPTClearanceQuery, int32> MissIndexByQuery;
+	TArray<int32> MissIndexByQueryIndex;
+	MissIndexByQueryIndex.Init(INDEX_NONE, Queries.Num());
+	for (int32 Index = 0; Index < Queries.Num(); ++Index)
+	{
+		if (const FUnrealGPTClearanceResult* Cached = Entries.Find(Queries[Index]))
+		{
+			OutResults[Index] = *Cached;
+			continue;
+		}
+
+		int32& MissIndex = MissIndexByQuery.FindOrAdd(Queries[Index], INDEX_NONE);
+		if (MissIndex == INDEX_NONE)
+		{
+			MissIndex = Misses.Add(Index);
+		}
+		MissIndexByQueryIndex[Index] = MissIndex;
+	}
+
+	if (Misses.Num() == 0)
+	{
+		return true;
+	}
+
+	// Ignored actors are resolved in one pass over the level for the whole batch
+	TMap<FString, AActor*> IgnoredActors;
+	for (int32 QueryIndex : Misses)
+	{
+		if (!Queries[QueryIndex].IgnoreActor.IsEmpty())
+		{
+			IgnoredActors.Add(Queries[QueryIndex].IgnoreActor, nullptr);
+		}
+	}
+	if (IgnoredActors.Num() > 0)
+	{
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			AActor* Actor = *It;
+			if (AActor** ById = IgnoredActors.Find(Actor->GetName()))
+			{
+				*ById = Actor;
+			}
+			else if (AActor** ByLabel = IgnoredActors.Find(Actor->GetActorLabel()))
+			{
+				if (!*ByLabel)
+				{
+					*ByLabel = Actor;
+				}
+			}
+		}
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Overlap queries and the actors they resolve are game thread work, so the batch runs here in order
+	TArray<TArray<AActor*>> MissBlockers;
+	MissBlockers.SetNum(Misses.Num());
+	TArray<FOverlapResult> Overlaps;
+	for (int32 MissIndex = 0; MissIndex < Misses.Num(); ++MissIndex)
+	{
+		const FUnrealGPTClearanceQuery& Query = Queries[Misses[MissIndex]];
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(UnrealGPTPlacement), false);
+		if (AActor* const* Ignored = IgnoredActors.Find(Query.IgnoreActor); Ignored && *Ignored)
+		{
+			Params.AddIgnoredActor(*Ignored);
+		}
+
+		const FVector Extent = Query.Extent.ComponentMax(FVector(MinExtent));
+		const FCollisionShape Shape = Query.bSphere ? FCollisionShape::MakeSphere(Extent.X) : FCollisionShape::MakeBox(Extent);
+
+		Overlaps.Reset();
+		World->OverlapMultiByChannel(Overlaps, Query.Center, Query.Rotation.Quaternion(), ECC_WorldDynamic, Shape, Params);
+
+		TArray<AActor*>& Blockers = MissBlockers[MissIndex];
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			AActor* Actor = Overlap.GetActor();
+			if (!Overlap.bBlockingHit || !Actor || (Query.bIgnoreLandscape && Actor->IsA<ALandscapeProxy>()))
+			{
+				continue;
+			}
+			Blockers.AddUnique(Actor);
+		}
+	}
+
+	if (Entries.Num() + Misses.Num() > MaxEntries)
+	{
+		Entries.Reset();
+	}
+
+	TArray<FUnrealGPTClearanceResult> MissResults;
+	MissResults.SetNum(Misses.Num());
+	for (int32 MissIndex = 0; MissIndex < Misses.Num(); ++MissIndex)
+	{
+		FUnrealGPTClearanceResult& Result = MissResults[MissIndex];
+		const TArray<AActor*>& Blockers = MissBlockers[MissIndex];
+		Result.bClear = Blockers.Num() == 0;
+		for (int32 BlockerIndex = 0; BlockerIndex < FMath::Min(Blockers.Num(), MaxBlockers); ++BlockerIndex)
+		{
+			Result.Blockers.Add(Blockers[BlockerIndex]->GetActorLabel());
+		}
+		Entries.Add(Queries[Misses[MissIndex]], Result);
+	}
+
+	for (int32 Index = 0; Index < Queries.Num(); ++Index)
+	{
+		if (MissIndexByQueryIndex[Index] != INDEX_NONE)
+		{
+			OutResults[Index] = MissResults[MissIndexByQueryIndex[Index]];
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Checked %d placements with %d overlap queries in %.1f ms"),
+		Queries.Num(), Misses.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+void FUnrealGPTPlacementValidator::SyncGeneration(UWorld* World)
+{
+	const uint64 Generation = FUnrealGPTToolResultCache::Get().GetGeneration();
+	if (CachedWorld.Get() != World || CachedGeneration != Generation)
+	{
+		Entries.Reset();
+		CachedWorld = World;
+		CachedGeneration = Generation;
+	}
+}
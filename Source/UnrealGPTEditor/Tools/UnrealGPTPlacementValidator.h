@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/** A volume that should be free of blocking geometry before something is placed in it */
+struct UNREALGPTEDITOR_API FUnrealGPTClearanceQuery
+{
+	FVector Center = FVector::ZeroVector;
+
+	/** Half size of a box; X is the radius of a sphere */
+	FVector Extent = FVector::ZeroVector;
+
+	/** Orientation of a box */
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	bool bSphere = false;
+
+	/** Id or label of an actor that does not count as a blocker, such as the one being moved */
+	FString IgnoreActor;
+
+	/** Landscapes do not block, since placements usually rest on them */
+	bool bIgnoreLandscape = true;
+
+	static FUnrealGPTClearanceQuery Box(const FBox& Bounds);
+	static FUnrealGPTClearanceQuery Sphere(const FVector& Center, double Radius);
+
+	bool operator==(const FUnrealGPTClearanceQuery& Other) const
+	{
+		return Center == Other.Center && Extent == Other.Extent && Rotation == Other.Rotation
+			&& bSphere == Other.bSphere && IgnoreActor == Other.IgnoreActor && bIgnoreLandscape == Other.bIgnoreLandscape;
+	}
+
+	friend uint32 GetTypeHash(const FUnrealGPTClearanceQuery& Query)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Query.Center), GetTypeHash(Query.Extent));
+		Hash = HashCombine(Hash, GetTypeHash(FVector(Query.Rotation.Pitch, Query.Rotation.Yaw, Query.Rotation.Roll)));
+		Hash = HashCombine(Hash, GetTypeHash(Query.IgnoreActor));
+		return HashCombine(Hash, (Query.bSphere ? 1u : 0u) | (Query.bIgnoreLandscape ? 2u : 0u));
+	}
+};
+
+struct FUnrealGPTClearanceResult
+{
+	bool bClear = true;
+
+	/** Labels of the blocking actors, at most FUnrealGPTPlacementValidator::MaxBlockers */
+	TArray<FString> Blockers;
+};
+
+/**
+ * Checks whether proposed placements overlap existing geometry, for the check_placement tool and
+ * the IsAreaClear preconditions of agent plans.
+ *
+ * A batch of box and sphere queries is run as overlap tests against the physics scene of the
+ * editor world, so hundreds of placements are checked in one call before anything is spawned;
+ * repeated volumes are queried once. Only components that block the WorldDynamic channel count,
+ * which leaves out triggers and actors without collision.
+ *
+ * Results are cached until the FUnrealGPTToolResultCache generation advances, i.e. until
+ * anything in the editor changes. Game thread only.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTPlacementValidator
+{
+public:
+	/** Blockers reported per query */
+	static constexpr int32 MaxBlockers = 8;
+
+	/** Queries accepted by one check_placement call */
+	static constexpr int32 MaxQueries = 1000;
+
+	/** Cached results kept before the cache is dropped */
+	static constexpr int32 MaxEntries = 4096;
+
+	static FUnrealGPTPlacementValidator& Get();
+
+	/**
+	 * check_placement entry point.
+	 * @param ArgumentsJson - JSON with a placements array of {location, extent or radius, rotation, ignore} and optional ignore_landscape
+	 */
+	static FString CheckPlacements(const FString& ArgumentsJson);
+
+	/**
+	 * Parse the volume of a plan precondition such as "WorldModel.IsAreaClear(Box(x, y, z, ex, ey, ez))"
+	 * or "WorldModel.IsAreaClear(Sphere(x, y, z, r))"; false if it names no literal volume.
+	 * Sizes are returned as written, so callers must reject a non-positive extent or radius.
+	 */
+	static bool ParseExpression(const FString& Expression, FUnrealGPTClearanceQuery& OutQuery);
+
+	/**
+	 * Fill OutResults with one result per query, in order.
+	 * @return false, leaving OutResults empty, if World is null or has no physics scene to query
+	 */
+	bool Validate(UWorld* World, TConstArrayView<FUnrealGPTClearanceQuery> Queries, TArray<FUnrealGPTClearanceResult>& OutResults);
+
+	/** Validate against the editor world */
+	bool Validate(TConstArrayView<FUnrealGPTClearanceQuery> Queries, TArray<FUnrealGPTClearanceResult>& OutResults);
+
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	FUnrealGPTPlacementValidator() = default;
+
+	/** Drop the cache if the world or the editor generation changed since it was filled */
+	void SyncGeneration(UWorld* World);
+
+	TMap<FUnrealGPTClearanceQuery, FUnrealGPTClearanceResult> Entries;
+
+	TWeakObjectPtr<UWorld> CachedWorld;
+	uint64 CachedGeneration = 0;
+};
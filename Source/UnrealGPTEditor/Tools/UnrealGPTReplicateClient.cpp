@@ -1,35 +1,1371 @@
 #include "UnrealGPTReplicateClient.h"
 #include "UnrealGPTSettings.h"
+#include "UnrealGPTGenerationCache.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonReader.h"
-#include "Http.h"
+#include "Async/Async.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/Guid.h"
-#include "HAL/PlatformProcess.h"
+#include "Misc/SecureHash.h"
+#include "Misc/Base64.h"
+#include "HAL/FileManager.h"
 
-FString UUnrealGPTReplicateClient::Generate(const FString& ArgumentsJson)
+namespace UnrealGPTReplicate
 {
-	UUnrealGPTSettings* Settings = GetMutableDefault<UUnrealGPTSettings>();
+	/** Replicate holds the create request open for up to this long and returns the finished prediction if it is done by then */
+	static const int32 CreateWaitSeconds = 60;
+
+	/** Overall budget from creation to the last download */
+	static const double MaxGenerationSeconds = 300.0;
+
+	static const float MinPollDelay = 0.25f;
+	static const float MaxPollDelay = 5.0f;
+
+	/** Outputs fetched at once; Replicate predictions rarely return more than a handful */
+	static const int32 MaxConcurrentDownloads = 3;
+	static const int32 MaxDownloadAttempts = 3;
+
+	/** A download stalled this long is dropped and resumed */
+	static const float DownloadActivityTimeout = 30.0f;
+
+	static const double ProgressReportInterval = 0.1;
+
+	/** Predictions a single replicate_generate call may request */
+	static const int32 MaxBatchSize = 16;
+
+	static bool IsTerminalStatus(const FString& Status)
+	{
+		return Status == TEXT("succeeded") || Status == TEXT("failed") || Status == TEXT("canceled");
+	}
+
+	static bool ParseJsonObject(const FString& Json, TSharedPtr<FJsonObject>& OutObject)
+	{
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		return FJsonSerializer::Deserialize(Reader, OutObject) && OutObject.IsValid();
+	}
+
+	/** Last "NN%" progress figure in the prediction logs (tqdm and most model loggers print these), or -1 */
+	static float ParseLastProgressPercent(const FString& Logs)
+	{
+		const int32 SearchStart = FMath::Max(0, Logs.Len() - 512);
+		for (int32 Index = Logs.Len() - 1; Index >= SearchStart; --Index)
+		{
+			if (Logs[Index] != TEXT('%'))
+			{
+				continue;
+			}
+
+			int32 DigitsStart = Index;
+			while (DigitsStart > SearchStart && (FChar::IsDigit(Logs[DigitsStart - 1]) || Logs[DigitsStart - 1] == TEXT('.')))
+			{
+				--DigitsStart;
+			}
+
+			if (DigitsStart < Index)
+			{
+				const float Percent = FCString::Atof(*Logs.Mid(DigitsStart, Index - DigitsStart));
+				if (Percent >= 0.0f && Percent <= 100.0f)
+				{
+					return Percent;
+				}
+			}
+		}
+		return -1.0f;
+	}
+
+	/** Base64 MD5 from "x-goog-hash: crc32c=...,md5=..." or "Content-MD5" */
+	static FString GetExpectedMD5(const FHttpResponsePtr& Response)
+	{
+		const FString GoogHash = Response->GetHeader(TEXT("x-goog-hash"));
+		TArray<FString> Hashes;
+		GoogHash.ParseIntoArray(Hashes, TEXT(","));
+		for (FString& Hash : Hashes)
+		{
+			Hash.TrimStartAndEndInline();
+			if (Hash.StartsWith(TEXT("md5="), ESearchCase::IgnoreCase))
+			{
+				return Hash.Mid(4);
+			}
+		}
+		return Response->GetHeader(TEXT("Content-MD5")).TrimStartAndEnd();
+	}
+
+	/** Full entity size: the "/total" of a 206 Content-Range, or Content-Length plus the resume offset */
+	static int64 GetTotalBytes(const FHttpResponsePtr& Response, int64 ResumeOffset)
+	{
+		const FString ContentRange = Response->GetHeader(TEXT("Content-Range"));
+		int32 SlashIndex = INDEX_NONE;
+		if (ContentRange.FindLastChar(TEXT('/'), SlashIndex))
+		{
+			const FString Total = ContentRange.Mid(SlashIndex + 1);
+			if (!Total.IsEmpty() && Total.IsNumeric())
+			{
+				return FCString::Atoi64(*Total);
+			}
+		}
+
+		const FString ContentLength = Response->GetHeader(TEXT("Content-Length"));
+		if (!ContentLength.IsEmpty() && ContentLength.IsNumeric())
+		{
+			return ResumeOffset + FCString::Atoi64(*ContentLength);
+		}
+		return -1;
+	}
+
+	/** Same shape as a fresh prediction's result, for outputs served from the generation cache */
+	static FString MakeCachedResultJson(const FString& OutputKind, const TArray<FUnrealGPTGenerationCache::FCachedFile>& Files)
+	{
+		TArray<TSharedPtr<FJsonValue>> FilesArray;
+		for (const FUnrealGPTGenerationCache::FCachedFile& File : Files)
+		{
+			TSharedPtr<FJsonObject> FileObj = MakeShareable(new FJsonObject);
+			FileObj->SetStringField(TEXT("local_path"), File.LocalPath);
+			FileObj->SetStringField(TEXT("mime_type"), FPaths::GetExtension(File.LocalPath));
+			FileObj->SetStringField(TEXT("description"), TEXT("Cached output of an identical earlier Replicate prediction"));
+			if (!File.ImportedAsset.IsEmpty())
+			{
+				FileObj->SetStringField(TEXT("imported_asset"), File.ImportedAsset);
+			}
+			FilesArray.Add(MakeShareable(new FJsonValueObject(FileObj)));
+		}
+
+		TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject);
+		ResultObj->SetStringField(TEXT("status"), TEXT("success"));
+		ResultObj->SetStringField(
+			TEXT("message"),
+			FString::Printf(TEXT("Reused %d cached file(s) from an identical earlier Replicate prediction."), FilesArray.Num()));
+
+		TSharedPtr<FJsonObject> DetailsObj = MakeShareable(new FJsonObject);
+		DetailsObj->SetStringField(TEXT("provider"), TEXT("replicate"));
+		DetailsObj->SetStringField(TEXT("output_kind"), OutputKind);
+		DetailsObj->SetArrayField(TEXT("files"), FilesArray);
+		DetailsObj->SetBoolField(TEXT("cached"), true);
+		ResultObj->SetObjectField(TEXT("details"), DetailsObj);
+
+		FString ResultJson;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+		FJsonSerializer::Serialize(ResultObj.ToSharedRef(), Writer);
+		return ResultJson;
+	}
+
+	/** local_path of every file in a successful prediction result */
+	static TArray<FString> GetResultFiles(const FString& ResultJson)
+	{
+		TArray<FString> Paths;
+		TSharedPtr<FJsonObject> ResultObj;
+		FString Status;
+		if (!ParseJsonObject(ResultJson, ResultObj) || !ResultObj->TryGetStringField(TEXT("status"), Status) || Status != TEXT("success"))
+		{
+			return Paths;
+		}
+
+		const TSharedPtr<FJsonObject>* DetailsObj = nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+		if (ResultObj->TryGetObjectField(TEXT("details"), DetailsObj) && (*DetailsObj)->TryGetArrayField(TEXT("files"), Files))
+		{
+			for (const TSharedPtr<FJsonValue>& FileValue : *Files)
+			{
+				const TSharedPtr<FJsonObject>* FileObj = nullptr;
+				FString LocalPath;
+				if (FileValue.IsValid() && FileValue->TryGetObject(FileObj) && (*FileObj)->TryGetStringField(TEXT("local_path"), LocalPath))
+				{
+					Paths.Add(LocalPath);
+				}
+			}
+		}
+		return Paths;
+	}
+
+	static FString FileMD5Base64(const FString& Path)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+		if (!Reader)
+		{
+			return FString();
+		}
+
+		FMD5 Md5;
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(1024 * 1024);
+		int64 Remaining = Reader->TotalSize();
+		while (Remaining > 0)
+		{
+			const int64 ChunkSize = FMath::Min<int64>(Remaining, Buffer.Num());
+			Reader->Serialize(Buffer.GetData(), ChunkSize);
+			Md5.Update(Buffer.GetData(), ChunkSize);
+			Remaining -= ChunkSize;
+		}
+
+		uint8 Digest[16];
+		Md5.Final(Digest);
+		return FBase64::Encode(Digest, UE_ARRAY_COUNT(Digest));
+	}
+}
+
+// ==================== GENERATION STATE MACHINE ====================
+
+FUnrealGPTReplicateGeneration::FUnrealGPTReplicateGeneration(const FString& InCreateUrl, const FString& InCreateBody, const FString& InAuthToken,
+	const FString& InOutputKind, FOnUnrealGPTReplicateComplete InOnComplete, FOnUnrealGPTReplicateProgress InOnProgress)
+	: CreateUrl(InCreateUrl)
+	, CreateBody(InCreateBody)
+	, AuthToken(InAuthToken)
+	, OutputKind(InOutputKind)
+	, OnComplete(MoveTemp(InOnComplete))
+	, OnProgress(MoveTemp(InOnProgress))
+{
+}
+
+void FUnrealGPTReplicateGeneration::Start()
+{
+	check(IsInGameThread());
+
+	StartTime = FPlatformTime::Seconds();
+	Stage = EStage::Creating;
+
+	// Long-poll the create call: fast models finish inside the wait and need no polling at all
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(CreateUrl, TEXT("POST"), UnrealGPTReplicate::CreateWaitSeconds + 15.0f);
+	Request->SetHeader(TEXT("Prefer"), FString::Printf(TEXT("wait=%d"), UnrealGPTReplicate::CreateWaitSeconds));
+	Request->SetContentAsString(CreateBody);
+	Request->OnProcessRequestComplete().BindSP(this, &FUnrealGPTReplicateGeneration::OnCreateResponse);
+
+	ActiveRequest = Request;
+	Request->ProcessRequest();
+
+	ReportProgress(TEXT("Creating prediction"), -1.0f);
+}
+
+void FUnrealGPTReplicateGeneration::Cancel()
+{
+	if (Stage == EStage::Finished)
+	{
+		return;
+	}
+
+	TSharedRef<FUnrealGPTReplicateGeneration> KeepAlive = AsShared();
+	const bool bPredictionRunning = Stage == EStage::Creating || Stage == EStage::Polling;
+	Stage = EStage::Finished;
+
+	if (ActiveRequest.IsValid())
+	{
+		ActiveRequest->OnProcessRequestComplete().Unbind();
+		ActiveRequest->CancelRequest();
+		ActiveRequest.Reset();
+	}
+
+	if (PollTimerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PollTimerHandle);
+		PollTimerHandle.Reset();
+	}
+
+	for (FDownload& Download : Downloads)
+	{
+		if (Download.Request.IsValid())
+		{
+			Download.Request->OnProcessRequestComplete().Unbind();
+			Download.Request->OnRequestProgress64().Unbind();
+			Download.Request->CancelRequest();
+			Download.Request.Reset();
+		}
+		if (Download.RetryHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(Download.RetryHandle);
+			Download.RetryHandle.Reset();
+		}
+		Download.Writer.Reset();
+		if (!Download.bFinished)
+		{
+			// May still be open by the cancelled request, in which case it is left behind
+			IFileManager::Get().Delete(*Download.PartPath, false, false, true);
+		}
+	}
+
+	if (bPredictionRunning)
+	{
+		SendRemoteCancel();
+	}
+
+	UUnrealGPTReplicateClient::ActiveGenerations.Remove(KeepAlive);
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Replicate generation cancelled"));
+
+	UUnrealGPTReplicateClient::StartQueuedGenerations();
+}
+
+float FUnrealGPTReplicateGeneration::ComputePollDelay(const FString& PredictionStatus, const FString& Logs, double SecondsInStatus, float PreviousDelay)
+{
+	using namespace UnrealGPTReplicate;
+
+	if (PredictionStatus == TEXT("starting"))
+	{
+		// Cold boots take tens of seconds and report nothing until they finish; back off steadily
+		return FMath::Clamp(PreviousDelay > 0.0f ? PreviousDelay * 1.5f : 1.0f, 1.0f, MaxPollDelay);
+	}
+
+	if (PredictionStatus == TEXT("processing"))
+	{
+		// With reported progress, aim to poll about halfway through the estimated remaining time
+		const float Percent = ParseLastProgressPercent(Logs);
+		if (Percent > 0.0f && Percent < 100.0f)
+		{
+			const double Remaining = SecondsInStatus * (100.0 - Percent) / Percent;
+			return FMath::Clamp(static_cast<float>(Remaining * 0.5), MinPollDelay, MaxPollDelay);
+		}
+		if (Percent >= 100.0f)
+		{
+			return MinPollDelay;
+		}
+
+		// Otherwise assume the job is about as far from done as it has been running
+		return FMath::Clamp(static_cast<float>(SecondsInStatus * 0.25), 0.5f, MaxPollDelay);
+	}
+
+	return 1.0f;
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FUnrealGPTReplicateGeneration::CreateRequest(const FString& Url, const FString& Verb, float TimeoutSeconds) const
+{
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Url);
+	Request->SetVerb(Verb);
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	// Replicate HTTP API expects Bearer tokens: Authorization: Bearer <token>
+	Request->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *AuthToken));
+	if (TimeoutSeconds > 0.0f)
+	{
+		Request->SetTimeout(TimeoutSeconds);
+	}
+	return Request;
+}
+
+void FUnrealGPTReplicateGeneration::OnCreateResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	ActiveRequest.Reset();
+	if (Stage != EStage::Creating)
+	{
+		return;
+	}
+
+	const FString Content = Response.IsValid() ? Response->GetContentAsString() : FString();
+	if (!bWasSuccessful || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	{
+		Fail(FString::Printf(TEXT("Failed to create Replicate prediction: %s"), Content.IsEmpty() ? TEXT("no response") : *Content));
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Prediction;
+	if (!UnrealGPTReplicate::ParseJsonObject(Content, Prediction))
+	{
+		Fail(TEXT("Failed to parse Replicate create prediction response"));
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* UrlsObj = nullptr;
+	if (Prediction->TryGetObjectField(TEXT("urls"), UrlsObj) && UrlsObj && UrlsObj->IsValid())
+	{
+		(*UrlsObj)->TryGetStringField(TEXT("get"), PollUrl);
+		(*UrlsObj)->TryGetStringField(TEXT("cancel"), CancelUrl);
+	}
+
+	FString Status;
+	Prediction->TryGetStringField(TEXT("status"), Status);
+	if (PollUrl.IsEmpty() && !UnrealGPTReplicate::IsTerminalStatus(Status))
+	{
+		Fail(TEXT("Replicate response did not include a poll URL"));
+		return;
+	}
+
+	Stage = EStage::Polling;
+	HandlePrediction(Prediction);
+}
+
+void FUnrealGPTReplicateGeneration::OnPollResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	ActiveRequest.Reset();
+	if (Stage != EStage::Polling)
+	{
+		return;
+	}
+
+	const FString Content = Response.IsValid() ? Response->GetContentAsString() : FString();
+	if (!bWasSuccessful || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	{
+		Fail(FString::Printf(TEXT("Failed while polling Replicate prediction: %s"), Content.IsEmpty() ? TEXT("no response") : *Content));
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Prediction;
+	if (!UnrealGPTReplicate::ParseJsonObject(Content, Prediction))
+	{
+		Fail(TEXT("Failed to parse Replicate poll response"));
+		return;
+	}
+
+	HandlePrediction(Prediction);
+}
+
+bool FUnrealGPTReplicateGeneration::OnPollTimer(float DeltaTime)
+{
+	PollTimerHandle.Reset();
+	if (Stage != EStage::Polling)
+	{
+		return false;
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(PollUrl, TEXT("GET"), 60.0f);
+	Request->OnProcessRequestComplete().BindSP(this, &FUnrealGPTReplicateGeneration::OnPollResponse);
+	ActiveRequest = Request;
+	Request->ProcessRequest();
+
+	return false; // One-shot
+}
+
+void FUnrealGPTReplicateGeneration::HandlePrediction(const TSharedPtr<FJsonObject>& Prediction)
+{
+	FString Status;
+	Prediction->TryGetStringField(TEXT("status"), Status);
+
+	if (Status == TEXT("succeeded"))
+	{
+		const FString StagingFolder = UUnrealGPTReplicateClient::GetStagingFolder(OutputKind);
+		IFileManager::Get().MakeDirectory(*StagingFolder, true);
+
+		for (const FString& Uri : UUnrealGPTReplicateClient::CollectOutputUris(Prediction))
+		{
+			// Signed delivery URLs carry a query string after the file name
+			FString UriPath = Uri;
+			int32 QueryIndex = INDEX_NONE;
+			if (UriPath.FindChar(TEXT('?'), QueryIndex))
+			{
+				UriPath.LeftInline(QueryIndex);
+			}
+
+			FString Ext = FPaths::GetExtension(UriPath);
+			if (Ext.IsEmpty())
+			{
+				Ext = TEXT("dat");
+			}
+
+			FDownload& Download = Downloads.AddDefaulted_GetRef();
+			Download.Uri = Uri;
+			Download.SavePath = StagingFolder / (FGuid::NewGuid().ToString() + TEXT(".") + Ext);
+			Download.PartPath = Download.SavePath + TEXT(".part");
+		}
+
+		Stage = EStage::Downloading;
+		PumpDownloads();
+		return;
+	}
+
+	if (Status == TEXT("failed") || Status == TEXT("canceled"))
+	{
+		FString ErrorMsg;
+		Prediction->TryGetStringField(TEXT("error"), ErrorMsg);
+		CancelUrl.Empty(); // Nothing left to cancel remotely
+		Fail(FString::Printf(TEXT("Replicate prediction %s: %s"), *Status, *ErrorMsg));
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - StartTime > UnrealGPTReplicate::MaxGenerationSeconds)
+	{
+		Fail(TEXT("Replicate prediction polling timed out"));
+		return;
+	}
+
+	if (Status != LastStatus)
+	{
+		LastStatus = Status;
+		LastStatusChangeTime = Now;
+		PollDelay = 0.0f;
+	}
+
+	FString Logs;
+	Prediction->TryGetStringField(TEXT("logs"), Logs);
+	PollDelay = ComputePollDelay(Status, Logs, Now - LastStatusChangeTime, PollDelay);
+	SchedulePoll(PollDelay);
+
+	if (Status == TEXT("starting"))
+	{
+		ReportProgress(TEXT("Starting model"), -1.0f);
+	}
+	else
+	{
+		const float Percent = UnrealGPTReplicate::ParseLastProgressPercent(Logs);
+		ReportProgress(TEXT("Generating"), Percent >= 0.0f ? Percent / 100.0f : -1.0f);
+	}
+}
+
+void FUnrealGPTReplicateGeneration::SchedulePoll(float DelaySeconds)
+{
+	PollTimerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &FUnrealGPTReplicateGeneration::OnPollTimer),
+		DelaySeconds);
+}
+
+void FUnrealGPTReplicateGeneration::PumpDownloads()
+{
+	using namespace UnrealGPTReplicate;
+
+	while (Stage == EStage::Downloading && NumActiveDownloads < MaxConcurrentDownloads && NextDownload < Downloads.Num())
+	{
+		++NumActiveDownloads;
+		StartDownload(NextDownload++);
+	}
+
+	if (Stage == EStage::Downloading && NumActiveDownloads == 0 && NextDownload >= Downloads.Num())
+	{
+		Succeed();
+	}
+}
+
+void FUnrealGPTReplicateGeneration::StartDownload(int32 Index)
+{
+	FDownload& Download = Downloads[Index];
+	++Download.Attempts;
+	Download.BytesReceived = 0;
+
+	// Bytes kept from an earlier attempt are resumed rather than fetched again
+	Download.ResumeOffset = FMath::Max<int64>(0, IFileManager::Get().FileSize(*Download.PartPath));
+
+	FArchive* Writer = IFileManager::Get().CreateFileWriter(*Download.PartPath, Download.ResumeOffset > 0 ? FILEWRITE_Append : FILEWRITE_None);
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Cannot write %s"), *Download.PartPath);
+		FinishDownload(Index, false);
+		return;
+	}
+	Download.Writer = MakeShareable(Writer);
+
+	// Replicate file URLs may require the same Bearer token.
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(Download.Uri, TEXT("GET"), 0.0f);
+	Request->SetActivityTimeout(UnrealGPTReplicate::DownloadActivityTimeout);
+	if (Download.ResumeOffset > 0)
+	{
+		Request->SetHeader(TEXT("Range"), FString::Printf(TEXT("bytes=%lld-"), Download.ResumeOffset));
+	}
+
+	// The body is written to the .part file as it arrives instead of being buffered in memory
+	Request->SetResponseBodyReceiveStream(Download.Writer.ToSharedRef());
+	Request->OnRequestProgress64().BindSP(this, &FUnrealGPTReplicateGeneration::OnDownloadProgress, Index);
+	Request->OnProcessRequestComplete().BindSP(this, &FUnrealGPTReplicateGeneration::OnDownloadResponse, Index);
+
+	Download.Request = Request;
+	Request->ProcessRequest();
+}
+
+void FUnrealGPTReplicateGeneration::OnDownloadProgress(FHttpRequestPtr Request, uint64 BytesSent, uint64 BytesReceived, int32 Index)
+{
+	FDownload& Download = Downloads[Index];
+	Download.BytesReceived = static_cast<int64>(BytesReceived);
+
+	if (Download.TotalBytes < 0 && Request.IsValid())
+	{
+		FHttpResponsePtr Response = Request->GetResponse();
+		if (Response.IsValid())
+		{
+			Download.TotalBytes = UnrealGPTReplicate::GetTotalBytes(Response, Download.ResumeOffset);
+		}
+	}
+
+	ReportDownloadProgress(false);
+}
+
+void FUnrealGPTReplicateGeneration::OnDownloadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int32 Index)
+{
+	FDownload& Download = Downloads[Index];
+	Download.Request.Reset();
+	if (Download.Writer.IsValid())
+	{
+		Download.Writer->Close();
+		Download.Writer.Reset();
+	}
+
+	if (Stage != EStage::Downloading)
+	{
+		return;
+	}
+
+	const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+	if (Response.IsValid())
+	{
+		const FString ExpectedMD5 = UnrealGPTReplicate::GetExpectedMD5(Response);
+		if (!ExpectedMD5.IsEmpty())
+		{
+			Download.ExpectedMD5 = ExpectedMD5;
+		}
+	}
+
+	// A server that ignores Range sends the whole file again, which was appended to the partial one
+	const bool bRangeIgnored = Download.ResumeOffset > 0 && ResponseCode == EHttpResponseCodes::Ok;
+
+	if (!bWasSuccessful || (ResponseCode != EHttpResponseCodes::Ok && ResponseCode != EHttpResponseCodes::PartialContent) || bRangeIgnored)
+	{
+		const bool bClientError = ResponseCode >= 400 && ResponseCode < 500
+			&& ResponseCode != EHttpResponseCodes::RequestTimeout && ResponseCode != EHttpResponseCodes::TooManyRequests;
+		if (bClientError)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to download Replicate output %s (HTTP %d)"), *Download.Uri, ResponseCode);
+			FinishDownload(Index, false);
+			return;
+		}
+
+		// Error bodies were streamed into the file too; a 200/206 that dropped mid-body keeps its bytes
+		const bool bRestartFromZero = bRangeIgnored
+			|| (ResponseCode != 0 && ResponseCode != EHttpResponseCodes::Ok && ResponseCode != EHttpResponseCodes::PartialContent);
+		RetryOrAbandonDownload(Index, bRestartFromZero, FString::Printf(TEXT("HTTP %d"), ResponseCode));
+		return;
+	}
+
+	Download.TotalBytes = UnrealGPTReplicate::GetTotalBytes(Response, Download.ResumeOffset);
+
+	// Hash large outputs off the game thread, then move the file into place
+	TWeakPtr<FUnrealGPTReplicateGeneration> WeakThis = AsShared();
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Index, PartPath = Download.PartPath, SavePath = Download.SavePath,
+		TotalBytes = Download.TotalBytes, ExpectedMD5 = Download.ExpectedMD5]()
+	{
+		bool bVerified = true;
+		bool bRetryable = true;
+		FString Error;
+
+		const int64 FileSize = IFileManager::Get().FileSize(*PartPath);
+		if (TotalBytes >= 0 && FileSize != TotalBytes)
+		{
+			bVerified = false;
+			Error = FString::Printf(TEXT("size %lld, expected %lld"), FileSize, TotalBytes);
+		}
+		else if (!ExpectedMD5.IsEmpty() && UnrealGPTReplicate::FileMD5Base64(PartPath) != ExpectedMD5)
+		{
+			bVerified = false;
+			Error = TEXT("MD5 mismatch");
+		}
+		else if (!IFileManager::Get().Move(*SavePath, *PartPath, true, true))
+		{
+			bVerified = false;
+			bRetryable = false;
+			Error = TEXT("could not rename the downloaded file");
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Index, bVerified, bRetryable, Error]()
+		{
+			if (TSharedPtr<FUnrealGPTReplicateGeneration> This = WeakThis.Pin())
+			{
+				This->OnDownloadVerified(Index, bVerified, bRetryable, Error);
+			}
+		});
+	});
+}
+
+void FUnrealGPTReplicateGeneration::OnDownloadVerified(int32 Index, bool bVerified, bool bRetryable, const FString& Error)
+{
+	if (Stage != EStage::Downloading)
+	{
+		return;
+	}
+
+	if (bVerified)
+	{
+		FinishDownload(Index, true);
+	}
+	else if (bRetryable)
+	{
+		RetryOrAbandonDownload(Index, true, Error);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to save Replicate output %s: %s"), *Downloads[Index].Uri, *Error);
+		FinishDownload(Index, false);
+	}
+}
+
+void FUnrealGPTReplicateGeneration::RetryOrAbandonDownload(int32 Index, bool bRestartFromZero, const FString& Error)
+{
+	FDownload& Download = Downloads[Index];
+	if (bRestartFromZero)
+	{
+		IFileManager::Get().Delete(*Download.PartPath, false, false, true);
+		Download.TotalBytes = -1;
+		Download.ExpectedMD5.Empty();
+	}
+
+	if (Download.Attempts >= UnrealGPTReplicate::MaxDownloadAttempts)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Giving up on Replicate output %s after %d attempts (%s)"), *Download.Uri, Download.Attempts, *Error);
+		FinishDownload(Index, false);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Retrying Replicate output %s (%s)"), *Download.Uri, *Error);
+	Download.RetryHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &FUnrealGPTReplicateGeneration::OnDownloadRetryTimer, Index),
+		static_cast<float>(Download.Attempts));
+}
+
+bool FUnrealGPTReplicateGeneration::OnDownloadRetryTimer(float DeltaTime, int32 Index)
+{
+	Downloads[Index].RetryHandle.Reset();
+	if (Stage == EStage::Downloading)
+	{
+		StartDownload(Index);
+	}
+	return false; // One-shot
+}
+
+void FUnrealGPTReplicateGeneration::FinishDownload(int32 Index, bool bSucceeded)
+{
+	FDownload& Download = Downloads[Index];
+	Download.bFinished = true;
+	Download.bSucceeded = bSucceeded;
+	if (!bSucceeded)
+	{
+		IFileManager::Get().Delete(*Download.PartPath, false, false, true);
+	}
+
+	--NumActiveDownloads;
+	ReportDownloadProgress(true);
+	PumpDownloads();
+}
+
+void FUnrealGPTReplicateGeneration::ReportDownloadProgress(bool bForce)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (!bForce && Now - LastProgressReportTime < UnrealGPTReplicate::ProgressReportInterval)
+	{
+		return;
+	}
+	LastProgressReportTime = Now;
+
+	int64 Received = 0;
+	int64 Total = 0;
+	bool bTotalKnown = true;
+	int32 NumFinished = 0;
+	for (const FDownload& Download : Downloads)
+	{
+		if (Download.bFinished)
+		{
+			++NumFinished;
+			continue;
+		}
+		Received += Download.ResumeOffset + Download.BytesReceived;
+		if (Download.TotalBytes >= 0)
+		{
+			Total += Download.TotalBytes;
+		}
+		else
+		{
+			bTotalKnown = false;
+		}
+	}
+
+	const double MB = 1024.0 * 1024.0;
+	FString Status = FString::Printf(TEXT("Downloading %d/%d file(s): %.1f MB"), NumFinished, Downloads.Num(), Received / MB);
+	float Fraction = -1.0f;
+	if (bTotalKnown && Total > 0)
+	{
+		Status += FString::Printf(TEXT(" of %.1f MB"), Total / MB);
+		Fraction = static_cast<float>(Received) / static_cast<float>(Total);
+	}
+	else if (NumFinished == Downloads.Num())
+	{
+		Fraction = 1.0f;
+	}
+
+	ReportProgress(Status, Fraction);
+}
+
+void FUnrealGPTReplicateGeneration::ReportProgress(const FString& Status, float Fraction)
+{
+	OnProgress.ExecuteIfBound(Status, Fraction);
+}
+
+void FUnrealGPTReplicateGeneration::Succeed()
+{
+	TArray<TSharedPtr<FJsonValue>> FilesArray;
+	int32 NumFailed = 0;
+	for (const FDownload& Download : Downloads)
+	{
+		if (!Download.bSucceeded)
+		{
+			++NumFailed;
+			continue;
+		}
+
+		const FString& LocalPath = Download.SavePath;
+		TSharedPtr<FJsonObject> FileObj = MakeShareable(new FJsonObject);
+		FileObj->SetStringField(TEXT("local_path"), LocalPath);
+		FileObj->SetStringField(TEXT("mime_type"), FPaths::GetExtension(LocalPath));
+		FileObj->SetStringField(TEXT("description"), TEXT("Downloaded output from Replicate prediction"));
+		FilesArray.Add(MakeShareable(new FJsonValueObject(FileObj)));
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject);
+	ResultObj->SetStringField(TEXT("status"), TEXT("success"));
+
+	const int32 NumFiles = FilesArray.Num();
+	ResultObj->SetStringField(
+		TEXT("message"),
+		FString::Printf(TEXT("Replicate prediction succeeded with %d downloaded file(s)."), NumFiles));
+
+	TSharedPtr<FJsonObject> DetailsObj = MakeShareable(new FJsonObject);
+	DetailsObj->SetStringField(TEXT("provider"), TEXT("replicate"));
+	DetailsObj->SetStringField(TEXT("output_kind"), OutputKind);
+	DetailsObj->SetArrayField(TEXT("files"), FilesArray);
+	if (NumFailed > 0)
+	{
+		DetailsObj->SetNumberField(TEXT("failed_downloads"), NumFailed);
+	}
+	DetailsObj->SetNumberField(TEXT("elapsed_seconds"), FPlatformTime::Seconds() - StartTime);
+
+	ResultObj->SetObjectField(TEXT("details"), DetailsObj);
+
+	FString ResultJsonString;
+	{
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJsonString);
+		FJsonSerializer::Serialize(ResultObj.ToSharedRef(), Writer);
+	}
+
+	Finish(ResultJsonString);
+}
+
+void FUnrealGPTReplicateGeneration::Fail(const FString& Message)
+{
+	UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: %s"), *Message);
+
+	// A prediction we stopped following would otherwise keep running (and billing) on Replicate
+	SendRemoteCancel();
+	Finish(UUnrealGPTReplicateClient::MakeErrorJson(Message));
+}
+
+void FUnrealGPTReplicateGeneration::Finish(const FString& ResultJson)
+{
+	TSharedRef<FUnrealGPTReplicateGeneration> KeepAlive = AsShared();
+	Stage = EStage::Finished;
+	UUnrealGPTReplicateClient::ActiveGenerations.Remove(KeepAlive);
+
+	// Hand the freed slot on before the completion delegate, which may queue more work of its own
+	UUnrealGPTReplicateClient::StartQueuedGenerations();
+
+	OnComplete.ExecuteIfBound(ResultJson);
+}
+
+void FUnrealGPTReplicateGeneration::SendRemoteCancel()
+{
+	if (CancelUrl.IsEmpty())
+	{
+		return;
+	}
+
+	// Fire and forget: nobody is waiting for the answer
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(CancelUrl, TEXT("POST"), 30.0f);
+	Request->ProcessRequest();
+	CancelUrl.Empty();
+}
+
+// ==================== BATCH ====================
+
+TArray<TSharedRef<FUnrealGPTReplicateBatch>> FUnrealGPTReplicateBatch::ActiveBatches;
+
+FUnrealGPTReplicateBatch::FUnrealGPTReplicateBatch(TArray<FUnrealGPTReplicateRequest> InRequests, const FString& InCreateUrl, const FString& InOutputKind,
+	FOnUnrealGPTReplicateComplete InOnComplete, FOnUnrealGPTReplicateProgress InOnProgress)
+	: CreateUrl(InCreateUrl)
+	, OutputKind(InOutputKind)
+	, OnComplete(MoveTemp(InOnComplete))
+	, OnProgress(MoveTemp(InOnProgress))
+{
+	Items.Reserve(InRequests.Num());
+	for (FUnrealGPTReplicateRequest& Request : InRequests)
+	{
+		Items.AddDefaulted_GetRef().Request = MoveTemp(Request);
+	}
+}
+
+void FUnrealGPTReplicateBatch::Start()
+{
+	check(IsInGameThread());
+
+	TSharedRef<FUnrealGPTReplicateBatch> Self = AsShared();
+
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		// Without a seed the model picks a random one, so only seeded requests are reproducible
+		if (Items[Index].Request.Seed.IsSet() && FUnrealGPTGenerationCache::IsEnabled())
+		{
+			// A miss with no entry answers at once and queues the prediction like the unseeded ones
+			Items[Index].CacheKey = FUnrealGPTGenerationCache::MakeKey(CreateUrl, Items[Index].Request.Body);
+			FUnrealGPTGenerationCache::Get().Lookup(Items[Index].CacheKey,
+				[Self, Index](bool bHit, const TArray<FUnrealGPTGenerationCache::FCachedFile>& CachedFiles)
+				{
+					Self->OnCacheLookup(Index, bHit, CachedFiles);
+				});
+			continue;
+		}
+
+		QueueItem(Index);
+	}
+
+	if (Items.Num() > 1)
+	{
+		OnProgress.ExecuteIfBound(FString::Printf(TEXT("Queued %d predictions"), Items.Num()), 0.0f);
+	}
+
+	UUnrealGPTReplicateClient::StartQueuedGenerations();
+}
+
+void FUnrealGPTReplicateBatch::QueueItem(int32 Index)
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	TSharedRef<FUnrealGPTReplicateBatch> Self = AsShared();
+
+	// The delegates only hold the batch weakly; ActiveBatches keeps it alive until it completes
+	TSharedRef<FUnrealGPTReplicateGeneration> Generation = MakeShared<FUnrealGPTReplicateGeneration>(
+		CreateUrl, Items[Index].Request.Body, Settings->ReplicateApiToken, OutputKind,
+		FOnUnrealGPTReplicateComplete::CreateSP(Self, &FUnrealGPTReplicateBatch::OnItemComplete, Index),
+		FOnUnrealGPTReplicateProgress::CreateSP(Self, &FUnrealGPTReplicateBatch::OnItemProgress, Index));
+
+	Items[Index].Generation = Generation;
+	UUnrealGPTReplicateClient::EnqueueGeneration(Generation);
+}
+
+void FUnrealGPTReplicateBatch::OnCacheLookup(int32 Index, bool bHit, const TArray<FUnrealGPTGenerationCache::FCachedFile>& CachedFiles)
+{
+	if (bCancelled || Items[Index].bDone)
+	{
+		return;
+	}
+
+	if (!bHit)
+	{
+		QueueItem(Index);
+		UUnrealGPTReplicateClient::StartQueuedGenerations();
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Replicate generation cache hit for prediction %d"), Index);
+	Items[Index].ResultJson = UnrealGPTReplicate::MakeCachedResultJson(OutputKind, CachedFiles);
+	Items[Index].bDone = true;
+	++NumDone;
+
+	if (NumDone < Items.Num())
+	{
+		OnItemProgress(Index, TEXT("Reused cached output"), 1.0f);
+		return;
+	}
+
+	CompleteIfDone();
+}
+
+void FUnrealGPTReplicateBatch::Cancel()
+{
+	TSharedRef<FUnrealGPTReplicateBatch> KeepAlive = AsShared();
+	bCancelled = true;
+	ActiveBatches.Remove(KeepAlive);
+
+	// Queued predictions first, so cancelling a running one does not start another of ours in its slot
+	for (const bool bQueuedPass : { true, false })
+	{
+		for (FItem& Item : Items)
+		{
+			if (Item.Generation.IsValid() && (Item.Generation->GetStage() == FUnrealGPTReplicateGeneration::EStage::Queued) == bQueuedPass)
+			{
+				TSharedPtr<FUnrealGPTReplicateGeneration> Generation = MoveTemp(Item.Generation);
+				Generation->Cancel();
+			}
+		}
+	}
+}
+
+void FUnrealGPTReplicateBatch::CancelAll()
+{
+	const TArray<TSharedRef<FUnrealGPTReplicateBatch>> Batches = ActiveBatches;
+	for (const TSharedRef<FUnrealGPTReplicateBatch>& Batch : Batches)
+	{
+		Batch->Cancel();
+	}
+}
+
+void FUnrealGPTReplicateBatch::OnItemComplete(int32 Index, const FString& ResultJson)
+{
+	TSharedRef<FUnrealGPTReplicateBatch> KeepAlive = AsShared();
+
+	FItem& Item = Items[Index];
+	if (bCancelled || Item.bDone)
+	{
+		return;
+	}
+
+	Item.ResultJson = ResultJson;
+	Item.bDone = true;
+	Item.Generation.Reset();
+	++NumDone;
+
+	if (!Item.CacheKey.IsEmpty())
+	{
+		FUnrealGPTGenerationCache::Get().Store(Item.CacheKey, UnrealGPTReplicate::GetResultFiles(ResultJson));
+	}
+
+	if (NumDone < Items.Num())
+	{
+		OnItemProgress(Index, TEXT("Finished"), 1.0f);
+		return;
+	}
+
+	CompleteIfDone();
+}
+
+void FUnrealGPTReplicateBatch::CompleteIfDone()
+{
+	if (bCancelled || NumDone < Items.Num())
+	{
+		return;
+	}
+
+	TSharedRef<FUnrealGPTReplicateBatch> KeepAlive = AsShared();
+	ActiveBatches.Remove(KeepAlive);
+
+	TArray<FUnrealGPTReplicateRequest> Requests;
+	TArray<FString> Results;
+	for (const FItem& Finished : Items)
+	{
+		Requests.Add(Finished.Request);
+		Results.Add(Finished.ResultJson);
+	}
+
+	OnComplete.ExecuteIfBound(BuildBatchResult(Requests, Results, OutputKind));
+}
+
+void FUnrealGPTReplicateBatch::OnItemProgress(int32 Index, const FString& Status, float Fraction)
+{
+	if (bCancelled)
+	{
+		return;
+	}
+
+	if (Items.Num() == 1)
+	{
+		OnProgress.ExecuteIfBound(Status, Fraction);
+		return;
+	}
+
+	Items[Index].Status = Status;
+	Items[Index].Fraction = Fraction;
+
+	// Predictions without a known fraction count as not started
+	float Total = 0.0f;
+	for (const FItem& Item : Items)
+	{
+		Total += Item.bDone ? 1.0f : FMath::Clamp(Item.Fraction, 0.0f, 1.0f);
+	}
+
+	OnProgress.ExecuteIfBound(
+		FString::Printf(TEXT("%d of %d predictions finished - #%d: %s"), NumDone, Items.Num(), Index + 1, *Status),
+		Total / Items.Num());
+}
+
+FString FUnrealGPTReplicateBatch::BuildBatchResult(const TArray<FUnrealGPTReplicateRequest>& Requests, const TArray<FString>& Results, const FString& OutputKind)
+{
+	if (Results.Num() == 1)
+	{
+		return Results[0];
+	}
+
+	TArray<TSharedPtr<FJsonValue>> FilesArray;
+	TArray<TSharedPtr<FJsonValue>> PredictionsArray;
+	int32 NumSucceeded = 0;
+
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		const FUnrealGPTReplicateRequest* Request = Requests.IsValidIndex(Index) ? &Requests[Index] : nullptr;
+
+		FString Status = TEXT("error");
+		FString Message;
+		TSharedPtr<FJsonObject> ResultObj;
+		if (UnrealGPTReplicate::ParseJsonObject(Results[Index], ResultObj))
+		{
+			ResultObj->TryGetStringField(TEXT("status"), Status);
+			ResultObj->TryGetStringField(TEXT("message"), Message);
+		}
+		else
+		{
+			Message = TEXT("Unreadable prediction result");
+		}
+
+		TSharedPtr<FJsonObject> PredictionObj = MakeShareable(new FJsonObject);
+		PredictionObj->SetNumberField(TEXT("index"), Index);
+		if (Request)
+		{
+			PredictionObj->SetStringField(TEXT("prompt"), Request->Prompt);
+			if (Request->Seed.IsSet())
+			{
+				PredictionObj->SetNumberField(TEXT("seed"), static_cast<double>(Request->Seed.GetValue()));
+			}
+		}
+		PredictionObj->SetStringField(TEXT("status"), Status);
+		PredictionObj->SetStringField(TEXT("message"), Message);
+		PredictionsArray.Add(MakeShareable(new FJsonValueObject(PredictionObj)));
+
+		if (Status != TEXT("success"))
+		{
+			continue;
+		}
+		++NumSucceeded;
+
+		// Tag each file with the prediction it came from so the model can tell variations apart
+		const TSharedPtr<FJsonObject>* DetailsObj = nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+		if (ResultObj->TryGetObjectField(TEXT("details"), DetailsObj) && (*DetailsObj)->TryGetArrayField(TEXT("files"), Files))
+		{
+			for (const TSharedPtr<FJsonValue>& FileValue : *Files)
+			{
+				const TSharedPtr<FJsonObject>* FileObj = nullptr;
+				if (!FileValue.IsValid() || !FileValue->TryGetObject(FileObj))
+				{
+					continue;
+				}
+
+				(*FileObj)->SetNumberField(TEXT("prediction_index"), Index);
+				if (Request)
+				{
+					(*FileObj)->SetStringField(TEXT("prompt"), Request->Prompt);
+					if (Request->Seed.IsSet())
+					{
+						(*FileObj)->SetNumberField(TEXT("seed"), static_cast<double>(Request->Seed.GetValue()));
+					}
+				}
+				FilesArray.Add(FileValue);
+			}
+		}
+	}
+
+	TSharedPtr<FJsonObject> BatchObj = MakeShareable(new FJsonObject);
+	BatchObj->SetStringField(TEXT("status"), NumSucceeded > 0 ? TEXT("success") : TEXT("error"));
+	BatchObj->SetStringField(
+		TEXT("message"),
+		FString::Printf(TEXT("%d of %d Replicate predictions succeeded with %d downloaded file(s)."), NumSucceeded, Results.Num(), FilesArray.Num()));
+
+	TSharedPtr<FJsonObject> DetailsObj = MakeShareable(new FJsonObject);
+	DetailsObj->SetStringField(TEXT("provider"), TEXT("replicate"));
+	DetailsObj->SetStringField(TEXT("output_kind"), OutputKind);
+	DetailsObj->SetArrayField(TEXT("files"), FilesArray);
+	DetailsObj->SetArrayField(TEXT("predictions"), PredictionsArray);
+	BatchObj->SetObjectField(TEXT("details"), DetailsObj);
+
+	FString BatchJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&BatchJson);
+	FJsonSerializer::Serialize(BatchObj.ToSharedRef(), Writer);
+	return BatchJson;
+}
+
+// ==================== CLIENT ====================
+
+TArray<TSharedRef<FUnrealGPTReplicateGeneration>> UUnrealGPTReplicateClient::ActiveGenerations;
+
+TSharedPtr<FUnrealGPTReplicateBatch> UUnrealGPTReplicateClient::GenerateAsync(const FString& ArgumentsJson, FOnUnrealGPTReplicateComplete OnComplete,
+	FOnUnrealGPTReplicateProgress OnProgress)
+{
+	check(IsInGameThread());
+
+	FString ApiUrl;
+	TArray<FUnrealGPTReplicateRequest> Requests;
+	FString OutputKind;
+	FString ErrorJson;
+	if (!BuildCreateRequests(ArgumentsJson, ApiUrl, Requests, OutputKind, ErrorJson))
+	{
+		OnComplete.ExecuteIfBound(ErrorJson);
+		return nullptr;
+	}
+
+	TSharedRef<FUnrealGPTReplicateBatch> Batch = MakeShared<FUnrealGPTReplicateBatch>(
+		MoveTemp(Requests), ApiUrl, OutputKind, MoveTemp(OnComplete), MoveTemp(OnProgress));
+	FUnrealGPTReplicateBatch::ActiveBatches.Add(Batch);
+	Batch->Start();
+
+	if (!FUnrealGPTReplicateBatch::ActiveBatches.Contains(Batch))
+	{
+		return nullptr;
+	}
+	return Batch;
+}
+
+void UUnrealGPTReplicateClient::EnqueueGeneration(const TSharedRef<FUnrealGPTReplicateGeneration>& Generation)
+{
+	ActiveGenerations.Add(Generation);
+}
+
+void UUnrealGPTReplicateClient::StartQueuedGenerations()
+{
+	check(IsInGameThread());
+
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	const int32 MaxRunning = FMath::Max(1, Settings->ReplicateMaxConcurrentPredictions);
+
+	int32 NumRunning = 0;
+	TArray<TSharedRef<FUnrealGPTReplicateGeneration>> ToStart;
+	for (const TSharedRef<FUnrealGPTReplicateGeneration>& Generation : ActiveGenerations)
+	{
+		if (Generation->GetStage() != FUnrealGPTReplicateGeneration::EStage::Queued)
+		{
+			++NumRunning;
+		}
+		else if (NumRunning + ToStart.Num() < MaxRunning)
+		{
+			ToStart.Add(Generation);
+		}
+	}
+
+	// Start outside the loop; Start only issues a request, but keep the list stable regardless
+	for (const TSharedRef<FUnrealGPTReplicateGeneration>& Generation : ToStart)
+	{
+		if (Generation->GetStage() == FUnrealGPTReplicateGeneration::EStage::Queued)
+		{
+			Generation->Start();
+		}
+	}
+}
+
+void UUnrealGPTReplicateClient::CancelAll()
+{
+	FUnrealGPTReplicateBatch::CancelAll();
+
+	// Cancel removes each generation from the list; cancel queued ones first so none is started in between
+	const TArray<TSharedRef<FUnrealGPTReplicateGeneration>> Generations = ActiveGenerations;
+	for (const TSharedRef<FUnrealGPTReplicateGeneration>& Generation : Generations)
+	{
+		if (Generation->GetStage() == FUnrealGPTReplicateGeneration::EStage::Queued)
+		{
+			Generation->Cancel();
+		}
+	}
+	for (const TSharedRef<FUnrealGPTReplicateGeneration>& Generation : Generations)
+	{
+		Generation->Cancel();
+	}
+}
+
+int32 UUnrealGPTReplicateClient::GetNumActiveGenerations()
+{
+	return ActiveGenerations.Num();
+}
+
+FString UUnrealGPTReplicateClient::MakeErrorJson(const FString& Message)
+{
+	TSharedPtr<FJsonObject> ErrorObj = MakeShareable(new FJsonObject);
+	ErrorObj->SetStringField(TEXT("status"), TEXT("error"));
+	ErrorObj->SetStringField(TEXT("message"), Message);
+
+	FString ErrorJson;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ErrorJson);
+	FJsonSerializer::Serialize(ErrorObj.ToSharedRef(), Writer);
+	return ErrorJson;
+}
+
+bool UUnrealGPTReplicateClient::BuildCreateRequests(const FString& ArgumentsJson, FString& OutUrl, TArray<FUnrealGPTReplicateRequest>& OutRequests, FString& OutOutputKind, FString& OutErrorJson)
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
 
 	if (!Settings || !Settings->bEnableReplicateTool || Settings->ReplicateApiToken.IsEmpty())
 	{
-		return TEXT("{\"status\":\"error\",\"message\":\"Replicate tool is not enabled or API token is missing in settings\"}");
+		OutErrorJson = MakeErrorJson(TEXT("Replicate tool is not enabled or API token is missing in settings"));
+		return false;
 	}
 
 	TSharedPtr<FJsonObject> ArgsObj;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgumentsJson);
 	if (!(FJsonSerializer::Deserialize(Reader, ArgsObj) && ArgsObj.IsValid()))
 	{
-		return TEXT("{\"status\":\"error\",\"message\":\"Failed to parse replicate_generate arguments\"}");
+		OutErrorJson = MakeErrorJson(TEXT("Failed to parse replicate_generate arguments"));
+		return false;
 	}
 
+	// Batch mode: one prediction per entry of 'prompts' or 'seeds', each repeated 'count' times without seeds
 	FString Prompt;
-	if (!(ArgsObj->TryGetStringField(TEXT("prompt"), Prompt) && !Prompt.IsEmpty()))
+	ArgsObj->TryGetStringField(TEXT("prompt"), Prompt);
+
+	TArray<FString> Prompts;
+	ArgsObj->TryGetStringArrayField(TEXT("prompts"), Prompts);
+	if (Prompts.ContainsByPredicate([](const FString& Entry) { return Entry.TrimStartAndEnd().IsEmpty(); }))
+	{
+		OutErrorJson = MakeErrorJson(TEXT("'prompts' contains an empty prompt"));
+		return false;
+	}
+
+	TArray<TOptional<int64>> Seeds;
+	const TArray<TSharedPtr<FJsonValue>>* SeedValues = nullptr;
+	if (ArgsObj->TryGetArrayField(TEXT("seeds"), SeedValues) && SeedValues)
+	{
+		for (const TSharedPtr<FJsonValue>& SeedValue : *SeedValues)
+		{
+			double SeedNumber = 0.0;
+			if (!SeedValue.IsValid() || !SeedValue->TryGetNumber(SeedNumber))
+			{
+				OutErrorJson = MakeErrorJson(TEXT("'seeds' must be an array of integers"));
+				return false;
+			}
+			Seeds.Add(static_cast<int64>(SeedNumber));
+		}
+	}
+
+	int32 Count = 1;
+	const bool bHasCount = ArgsObj->TryGetNumberField(TEXT("count"), Count);
+	if (bHasCount && Count < 1)
+	{
+		OutErrorJson = MakeErrorJson(TEXT("'count' must be at least 1"));
+		return false;
+	}
+	if (Seeds.Num() > 0 && Count > 1)
+	{
+		OutErrorJson = MakeErrorJson(TEXT("'count' cannot be combined with 'seeds'; each seed already makes one prediction"));
+		return false;
+	}
+
+	if (Prompts.Num() > 0)
+	{
+		// Seeds pair up with prompts by position, so a seed without a prompt would be lost
+		if (Seeds.Num() > 0 && Seeds.Num() != Prompts.Num())
+		{
+			OutErrorJson = MakeErrorJson(FString::Printf(TEXT("'seeds' pairs with 'prompts' by position, so it needs one seed per prompt (got %d seeds for %d prompts)"), Seeds.Num(), Prompts.Num()));
+			return false;
+		}
+	}
+	else if (!Prompt.IsEmpty())
 	{
-		return TEXT("{\"status\":\"error\",\"message\":\"Missing required field: prompt\"}");
+		Prompts.Add(Prompt);
+	}
+	else
+	{
+		OutErrorJson = MakeErrorJson(TEXT("Missing required field: prompt (or prompts)"));
+		return false;
+	}
+
+	// Checked before building, so a huge count does not allocate first
+	const int64 NumPredictions = Seeds.Num() > 0 ? Seeds.Num() : static_cast<int64>(Prompts.Num()) * Count;
+	if (NumPredictions > UnrealGPTReplicate::MaxBatchSize)
+	{
+		OutErrorJson = MakeErrorJson(FString::Printf(TEXT("Too many predictions requested (%lld); the limit per call is %d"), NumPredictions, UnrealGPTReplicate::MaxBatchSize));
+		return false;
+	}
+
+	if (Seeds.Num() > 0)
+	{
+		// A single 'prompt' is shared by every seed; 'prompts' pair up by position
+		for (int32 Index = 0; Index < Seeds.Num(); ++Index)
+		{
+			FUnrealGPTReplicateRequest& Request = OutRequests.AddDefaulted_GetRef();
+			Request.Prompt = Prompts[Prompts.Num() == 1 ? 0 : Index];
+			Request.Seed = Seeds[Index];
+		}
+	}
+	else
+	{
+		for (const FString& Entry : Prompts)
+		{
+			for (int32 Variation = 0; Variation < Count; ++Variation)
+			{
+				FUnrealGPTReplicateRequest& Request = OutRequests.AddDefaulted_GetRef();
+				Request.Prompt = Entry;
+			}
+		}
 	}
 
 	FString OutputKind;
@@ -99,29 +1435,8 @@ FString UUnrealGPTReplicateClient::Generate(const FString& ArgumentsJson)
 	// instead of sending an invalid request to Replicate.
 	if (Version.IsEmpty())
 	{
-		return TEXT("{\"status\":\"error\",\"message\":\"Replicate prediction requires a model identifier. Configure a default model (owner/name slug or version id) in UnrealGPT settings or pass 'version' explicitly in replicate_generate arguments.\"}");
-	}
-
-	// Build Replicate prediction request body.
-	TSharedPtr<FJsonObject> RequestObj = MakeShareable(new FJsonObject);
-
-	TSharedPtr<FJsonObject> InputObj = MakeShareable(new FJsonObject);
-	InputObj->SetStringField(TEXT("prompt"), Prompt);
-
-	// For image generation, request PNG output directly from the model where supported.
-	// Many Replicate image models accept an 'output_format' parameter; models that do not
-	// simply ignore unknown fields, so this is safe as a default.
-	if (OutputKind == TEXT("image"))
-	{
-		InputObj->SetStringField(TEXT("output_format"), TEXT("png"));
-	}
-
-	RequestObj->SetObjectField(TEXT("input"), InputObj);
-
-	FString RequestBody;
-	{
-		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-		FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
+		OutErrorJson = MakeErrorJson(TEXT("Replicate prediction requires a model identifier. Configure a default model (owner/name slug or version id) in UnrealGPT settings or pass 'version' explicitly in replicate_generate arguments."));
+		return false;
 	}
 
 	FString ApiUrl = Settings->ReplicateApiUrl.IsEmpty()
@@ -140,279 +1455,93 @@ FString UUnrealGPTReplicateClient::Generate(const FString& ArgumentsJson)
 	{
 		ApiUrl = FString::Printf(TEXT("https://api.replicate.com/v1/models/%s/predictions"), *Version);
 	}
-	else
-	{
-		// For the unified predictions endpoint, send the identifier as the 'version' field.
-		RequestObj->SetStringField(TEXT("version"), Version);
-		// Re-serialize with version field
-		RequestBody.Empty();
-		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-		FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
-	}
-
-	// 1) Create prediction
-	FString CreateResponse;
-	if (!PerformHttpRequest(ApiUrl, TEXT("POST"), RequestBody, Settings->ReplicateApiToken, CreateResponse, 60))
-	{
-		return FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Failed to create Replicate prediction: %s\"}"), *CreateResponse);
-	}
-
-	TSharedPtr<FJsonObject> CreateObj;
-	{
-		TSharedRef<TJsonReader<>> CreateReader = TJsonReaderFactory<>::Create(CreateResponse);
-		if (!(FJsonSerializer::Deserialize(CreateReader, CreateObj) && CreateObj.IsValid()))
-		{
-			return TEXT("{\"status\":\"error\",\"message\":\"Failed to parse Replicate create prediction response\"}");
-		}
-	}
-
-	FString PollUrl;
-	{
-		const TSharedPtr<FJsonObject>* UrlsObj = nullptr;
-		if (CreateObj->TryGetObjectField(TEXT("urls"), UrlsObj) && UrlsObj && UrlsObj->IsValid())
-		{
-			(*UrlsObj)->TryGetStringField(TEXT("get"), PollUrl);
-		}
-	}
 
-	if (PollUrl.IsEmpty())
+	// Build Replicate prediction request bodies.
+	for (FUnrealGPTReplicateRequest& Request : OutRequests)
 	{
-		return TEXT("{\"status\":\"error\",\"message\":\"Replicate response did not include a poll URL\"}");
-	}
+		TSharedPtr<FJsonObject> RequestObj = MakeShareable(new FJsonObject);
 
-	// 2) Poll prediction until it completes
-	FString FinalResponse;
-	TSharedPtr<FJsonObject> FinalObj;
-	const int32 MaxPollSeconds = 300;
-	const double PollStart = FPlatformTime::Seconds();
-	while (true)
-	{
-		if (!PerformHttpRequest(PollUrl, TEXT("GET"), FString(), Settings->ReplicateApiToken, FinalResponse, 60))
-		{
-			return FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Failed while polling Replicate prediction: %s\"}"), *FinalResponse);
-		}
+		TSharedPtr<FJsonObject> InputObj = MakeShareable(new FJsonObject);
+		InputObj->SetStringField(TEXT("prompt"), Request.Prompt);
 
-		TSharedRef<TJsonReader<>> FinalReader = TJsonReaderFactory<>::Create(FinalResponse);
-		if (!(FJsonSerializer::Deserialize(FinalReader, FinalObj) && FinalObj.IsValid()))
+		if (Request.Seed.IsSet())
 		{
-			return TEXT("{\"status\":\"error\",\"message\":\"Failed to parse Replicate poll response\"}");
+			InputObj->SetNumberField(TEXT("seed"), static_cast<double>(Request.Seed.GetValue()));
 		}
 
-		FString PredStatus;
-		FinalObj->TryGetStringField(TEXT("status"), PredStatus);
-
-		if (PredStatus == TEXT("succeeded"))
+		// For image generation, request PNG output directly from the model where supported.
+		// Many Replicate image models accept an 'output_format' parameter; models that do not
+		// simply ignore unknown fields, so this is safe as a default.
+		if (OutputKind == TEXT("image"))
 		{
-			break;
+			InputObj->SetStringField(TEXT("output_format"), TEXT("png"));
 		}
 
-		if (PredStatus == TEXT("failed") || PredStatus == TEXT("canceled"))
-		{
-			FString ErrorMsg;
-			FinalObj->TryGetStringField(TEXT("error"), ErrorMsg);
-			return FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Replicate prediction %s: %s\"}"), *PredStatus, *ErrorMsg);
-		}
+		RequestObj->SetObjectField(TEXT("input"), InputObj);
 
-		if (FPlatformTime::Seconds() - PollStart > MaxPollSeconds)
+		// For the unified predictions endpoint, send the identifier as the 'version' field.
+		if (!bUseOfficialModelsEndpoint)
 		{
-			return TEXT("{\"status\":\"error\",\"message\":\"Replicate prediction polling timed out\"}");
+			RequestObj->SetStringField(TEXT("version"), Version);
 		}
 
-		FPlatformProcess::Sleep(0.5f);
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Request.Body);
+		FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
 	}
 
-	// 3) Extract output URIs
+	OutUrl = ApiUrl;
+	OutOutputKind = OutputKind;
+	return true;
+}
+
+TArray<FString> UUnrealGPTReplicateClient::CollectOutputUris(const TSharedPtr<FJsonObject>& Prediction)
+{
 	TArray<FString> OutputUris;
 
 	// Prefer the 'output' field if present.
+	const TArray<TSharedPtr<FJsonValue>>* OutputArray = nullptr;
+	if (Prediction->TryGetArrayField(TEXT("output"), OutputArray) && OutputArray)
+	{
+		for (const TSharedPtr<FJsonValue>& Val : *OutputArray)
+		{
+			CollectUrisFromJsonValue(Val, OutputUris);
+		}
+	}
+	else
 	{
-		const TArray<TSharedPtr<FJsonValue>>* OutputArray = nullptr;
-		if (FinalObj->TryGetArrayField(TEXT("output"), OutputArray) && OutputArray)
+		const TSharedPtr<FJsonObject>* OutputObj = nullptr;
+		if (Prediction->TryGetObjectField(TEXT("output"), OutputObj) && OutputObj && OutputObj->IsValid())
 		{
-			for (const TSharedPtr<FJsonValue>& Val : *OutputArray)
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*OutputObj)->Values)
 			{
-				CollectUrisFromJsonValue(Val, OutputUris);
+				CollectUrisFromJsonValue(Pair.Value, OutputUris);
 			}
 		}
 		else
 		{
-			const TSharedPtr<FJsonObject>* OutputObj = nullptr;
-			if (FinalObj->TryGetObjectField(TEXT("output"), OutputObj) && OutputObj && OutputObj->IsValid())
-			{
-				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*OutputObj)->Values)
-				{
-					CollectUrisFromJsonValue(Pair.Value, OutputUris);
-				}
-			}
-			else
+			FString OutputStr;
+			if (Prediction->TryGetStringField(TEXT("output"), OutputStr) &&
+				(OutputStr.StartsWith(TEXT("http://")) || OutputStr.StartsWith(TEXT("https://"))))
 			{
-				FString OutputStr;
-				if (FinalObj->TryGetStringField(TEXT("output"), OutputStr) &&
-					(OutputStr.StartsWith(TEXT("http://")) || OutputStr.StartsWith(TEXT("https://"))))
-				{
-					OutputUris.AddUnique(OutputStr);
-				}
+				OutputUris.AddUnique(OutputStr);
 			}
 		}
 	}
 
 	// As a fallback, scan the entire response object for HTTPS URLs if we didn't find any in 'output'.
+	// The 'urls' block only holds API endpoints, never outputs.
 	if (OutputUris.Num() == 0)
 	{
-		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : FinalObj->Values)
-		{
-			CollectUrisFromJsonValue(Pair.Value, OutputUris);
-		}
-	}
-
-	// 4) Download any output files and build result JSON.
-	TArray<TSharedPtr<FJsonValue>> FilesArray;
-	for (const FString& Uri : OutputUris)
-	{
-		const FString LocalPath = DownloadFile(Uri, OutputKind, Settings->ReplicateApiToken);
-		if (!LocalPath.IsEmpty())
-		{
-			TSharedPtr<FJsonObject> FileObj = MakeShareable(new FJsonObject);
-			FileObj->SetStringField(TEXT("local_path"), LocalPath);
-			FileObj->SetStringField(TEXT("mime_type"), FPaths::GetExtension(LocalPath));
-			FileObj->SetStringField(TEXT("description"), TEXT("Downloaded output from Replicate prediction"));
-			FilesArray.Add(MakeShareable(new FJsonValueObject(FileObj)));
-		}
-	}
-
-	TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject);
-	ResultObj->SetStringField(TEXT("status"), TEXT("success"));
-
-	const int32 NumFiles = FilesArray.Num();
-	ResultObj->SetStringField(
-		TEXT("message"),
-		FString::Printf(TEXT("Replicate prediction succeeded with %d downloaded file(s)."), NumFiles));
-
-	TSharedPtr<FJsonObject> DetailsObj = MakeShareable(new FJsonObject);
-	DetailsObj->SetStringField(TEXT("provider"), TEXT("replicate"));
-	DetailsObj->SetStringField(TEXT("output_kind"), OutputKind);
-	DetailsObj->SetArrayField(TEXT("files"), FilesArray);
-
-	ResultObj->SetObjectField(TEXT("details"), DetailsObj);
-
-	FString ResultJsonString;
-	{
-		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJsonString);
-		FJsonSerializer::Serialize(ResultObj.ToSharedRef(), Writer);
-	}
-
-	return ResultJsonString;
-}
-
-bool UUnrealGPTReplicateClient::PerformHttpRequest(const FString& Url, const FString& Verb, const FString& Body,
-	const FString& AuthToken, FString& OutResponse, int32 TimeoutSeconds)
-{
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(Url);
-	Request->SetVerb(Verb);
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	// Replicate HTTP API expects Bearer tokens: Authorization: Bearer <token>
-	Request->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *AuthToken));
-
-	if (!Body.IsEmpty())
-	{
-		Request->SetContentAsString(Body);
-	}
-
-	bool bRequestComplete = false;
-	bool bSuccess = false;
-
-	Request->OnProcessRequestComplete().BindLambda(
-		[&](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bConnected)
-		{
-			if (bConnected && Res.IsValid() && Res->GetResponseCode() >= 200 && Res->GetResponseCode() < 300)
-			{
-				OutResponse = Res->GetContentAsString();
-				bSuccess = true;
-			}
-			else if (Res.IsValid())
-			{
-				OutResponse = Res->GetContentAsString();
-			}
-			bRequestComplete = true;
-		});
-
-	Request->ProcessRequest();
-
-	const double StartTime = FPlatformTime::Seconds();
-	while (!bRequestComplete)
-	{
-		FPlatformProcess::Sleep(0.01f);
-		if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Prediction->Values)
 		{
-			Request->CancelRequest();
-			OutResponse = TEXT("{\"error\":\"Request timed out\"}");
-			return false;
-		}
-	}
-
-	return bSuccess;
-}
-
-FString UUnrealGPTReplicateClient::DownloadFile(const FString& Uri, const FString& OutputKind, const FString& AuthToken)
-{
-	TArray<uint8> Content;
-
-	// Try HTTP download.
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(Uri);
-	Request->SetVerb(TEXT("GET"));
-	// Replicate file URLs may require the same Bearer token.
-	Request->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *AuthToken));
-
-	bool bComplete = false;
-
-	Request->OnProcessRequestComplete().BindLambda(
-		[&](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bSuccess)
-		{
-			if (bSuccess && Res.IsValid() && Res->GetResponseCode() == 200)
+			if (Pair.Key != TEXT("urls"))
 			{
-				Content = Res->GetContent();
+				CollectUrisFromJsonValue(Pair.Value, OutputUris);
 			}
-			bComplete = true;
-		});
-
-	Request->ProcessRequest();
-
-	const double StartTime = FPlatformTime::Seconds();
-	while (!bComplete)
-	{
-		FPlatformProcess::Sleep(0.01f);
-		if (FPlatformTime::Seconds() - StartTime > 120.0)
-		{
-			Request->CancelRequest();
-			break;
 		}
 	}
 
-	if (Content.Num() == 0)
-	{
-		return FString();
-	}
-
-	FString Ext = FPaths::GetExtension(Uri);
-	if (Ext.IsEmpty())
-	{
-		Ext = TEXT("dat");
-	}
-
-	const FString Filename = FGuid::NewGuid().ToString() + TEXT(".") + Ext;
-	const FString SavePath = GetStagingFolder(OutputKind) / Filename;
-
-	// Ensure directory exists
-	IFileManager::Get().MakeDirectory(*FPaths::GetPath(SavePath), true);
-
-	if (FFileHelper::SaveArrayToFile(Content, *SavePath))
-	{
-		return SavePath;
-	}
-
-	return FString();
+	return OutputUris;
 }
 
 FString UUnrealGPTReplicateClient::GetStagingFolder(const FString& OutputKind)
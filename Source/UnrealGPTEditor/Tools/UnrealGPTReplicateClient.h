@@ -2,10 +2,224 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Http.h"
+#include "Containers/Ticker.h"
+#include "UnrealGPTGenerationCache.h"
 #include "UnrealGPTReplicateClient.generated.h"
 
 class UUnrealGPTSettings;
 
+DECLARE_DELEGATE_OneParam(FOnUnrealGPTReplicateComplete, const FString& /*ResultJson*/);
+
+/** Human-readable stage and completed fraction (0-1, or negative when unknown) */
+DECLARE_DELEGATE_TwoParams(FOnUnrealGPTReplicateProgress, const FString& /*Status*/, float /*Fraction*/);
+
+/** One prediction requested by a replicate_generate call */
+struct FUnrealGPTReplicateRequest
+{
+	FString Prompt;
+	TOptional<int64> Seed;
+
+	/** Serialized create-prediction body */
+	FString Body;
+};
+
+/**
+ * One Replicate prediction driven entirely by HTTP completion callbacks and ticker timers on the
+ * game thread: create (long-polling with "Prefer: wait") -> poll -> download -> complete.
+ * No thread ever waits on it. Instances are owned by UUnrealGPTReplicateClient until they finish
+ * or are cancelled.
+ *
+ * Outputs are downloaded a few at a time, streamed straight into a .part file next to their final
+ * path, resumed with Range requests after a dropped connection, and checked against the reported
+ * size (and MD5 when the server sends one) before being renamed into place.
+ *
+ * Generations start out Queued; the client starts them as slots free up under
+ * UUnrealGPTSettings::ReplicateMaxConcurrentPredictions.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTReplicateGeneration : public TSharedFromThis<FUnrealGPTReplicateGeneration>
+{
+public:
+	enum class EStage : uint8
+	{
+		Queued,
+		Creating,
+		Polling,
+		Downloading,
+		Finished
+	};
+
+	FUnrealGPTReplicateGeneration(const FString& InCreateUrl, const FString& InCreateBody, const FString& InAuthToken,
+		const FString& InOutputKind, FOnUnrealGPTReplicateComplete InOnComplete, FOnUnrealGPTReplicateProgress InOnProgress);
+
+	void Start();
+
+	/** Abort any request in flight and cancel the prediction on Replicate; the completion delegate is not invoked */
+	void Cancel();
+
+	EStage GetStage() const { return Stage; }
+
+	/** Seconds to wait before the next poll, given the latest prediction state. Exposed for tests. */
+	static float ComputePollDelay(const FString& PredictionStatus, const FString& Logs, double SecondsInStatus, float PreviousDelay);
+
+private:
+	struct FDownload
+	{
+		FString Uri;
+		FString SavePath;
+		FString PartPath;
+
+		TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request;
+		TSharedPtr<FArchive> Writer;
+		FTSTicker::FDelegateHandle RetryHandle;
+
+		/** Bytes already on disk when the current attempt started */
+		int64 ResumeOffset = 0;
+		int64 BytesReceived = 0;
+
+		/** Full size of the file, or -1 until a response reports it */
+		int64 TotalBytes = -1;
+
+		/** Base64 MD5 from x-goog-hash or Content-MD5, if the server sent one */
+		FString ExpectedMD5;
+
+		int32 Attempts = 0;
+		bool bFinished = false;
+		bool bSucceeded = false;
+	};
+
+	/** TimeoutSeconds <= 0 leaves only the activity timeout, for long downloads */
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FString& Url, const FString& Verb, float TimeoutSeconds) const;
+
+	void OnCreateResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	void OnPollResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	bool OnPollTimer(float DeltaTime);
+
+	/** Route a parsed prediction to the next stage */
+	void HandlePrediction(const TSharedPtr<FJsonObject>& Prediction);
+	void SchedulePoll(float DelaySeconds);
+
+	/** Start queued downloads up to the concurrency limit; succeeds once all have finished */
+	void PumpDownloads();
+	void StartDownload(int32 Index);
+	void OnDownloadProgress(FHttpRequestPtr Request, uint64 BytesSent, uint64 BytesReceived, int32 Index);
+	void OnDownloadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int32 Index);
+	void OnDownloadVerified(int32 Index, bool bVerified, bool bRetryable, const FString& Error);
+	bool OnDownloadRetryTimer(float DeltaTime, int32 Index);
+
+	/** Retry after a delay if attempts remain, otherwise give up on this output */
+	void RetryOrAbandonDownload(int32 Index, bool bRestartFromZero, const FString& Error);
+	void FinishDownload(int32 Index, bool bSucceeded);
+	void ReportDownloadProgress(bool bForce);
+
+	void ReportProgress(const FString& Status, float Fraction);
+
+	void Succeed();
+	void Fail(const FString& Message);
+	void Finish(const FString& ResultJson);
+
+	/** Tell Replicate to stop a prediction we no longer want so it stops billing */
+	void SendRemoteCancel();
+
+	FString CreateUrl;
+	FString CreateBody;
+	FString AuthToken;
+	FString OutputKind;
+	FOnUnrealGPTReplicateComplete OnComplete;
+	FOnUnrealGPTReplicateProgress OnProgress;
+
+	EStage Stage = EStage::Queued;
+
+	FString PollUrl;
+	FString CancelUrl;
+
+	/** Request in flight, if any; only one is outstanding at a time */
+	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> ActiveRequest;
+
+	FTSTicker::FDelegateHandle PollTimerHandle;
+
+	double StartTime = 0.0;
+	FString LastStatus;
+	double LastStatusChangeTime = 0.0;
+	float PollDelay = 0.0f;
+
+	TArray<FDownload> Downloads;
+	int32 NextDownload = 0;
+	int32 NumActiveDownloads = 0;
+	double LastProgressReportTime = 0.0;
+};
+
+/**
+ * All predictions of one replicate_generate call (several prompts, several seeds, or one prompt
+ * repeated), run under the client's concurrency limit and reported as a single tool result once
+ * every prediction has finished. A single-prediction batch reports its prediction's result unchanged.
+ *
+ * Seeded predictions are looked up in FUnrealGPTGenerationCache first and only sent to Replicate on a miss.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTReplicateBatch : public TSharedFromThis<FUnrealGPTReplicateBatch>
+{
+	friend class UUnrealGPTReplicateClient;
+
+public:
+	FUnrealGPTReplicateBatch(TArray<FUnrealGPTReplicateRequest> InRequests, const FString& InCreateUrl, const FString& InOutputKind,
+		FOnUnrealGPTReplicateComplete InOnComplete, FOnUnrealGPTReplicateProgress InOnProgress);
+
+	/** Queue every prediction with the client, once its generation cache lookup missed if it has a seed */
+	void Start();
+
+	/** Cancel every prediction still queued or running; the completion delegate is not invoked */
+	void Cancel();
+
+	/** Cancel every batch that has not finished yet */
+	static void CancelAll();
+
+	int32 Num() const { return Items.Num(); }
+
+	/** Combine per-prediction results into one tool result. Exposed for tests. */
+	static FString BuildBatchResult(const TArray<FUnrealGPTReplicateRequest>& Requests, const TArray<FString>& Results, const FString& OutputKind);
+
+private:
+	struct FItem
+	{
+		FUnrealGPTReplicateRequest Request;
+
+		/** Reset once the prediction finishes */
+		TSharedPtr<FUnrealGPTReplicateGeneration> Generation;
+
+		/** Generation cache key, for requests whose output is reproducible (explicit seed) */
+		FString CacheKey;
+
+		FString ResultJson;
+		FString Status;
+		float Fraction = 0.0f;
+		bool bDone = false;
+	};
+
+	/** Create the prediction for an item and queue it with the client */
+	void QueueItem(int32 Index);
+
+	/** Finish an item from the generation cache, or queue its prediction on a miss */
+	void OnCacheLookup(int32 Index, bool bHit, const TArray<FUnrealGPTGenerationCache::FCachedFile>& CachedFiles);
+
+	void OnItemComplete(int32 Index, const FString& ResultJson);
+
+	/** Report the combined result once every prediction is done */
+	void CompleteIfDone();
+	void OnItemProgress(int32 Index, const FString& Status, float Fraction);
+
+	FString CreateUrl;
+	FString OutputKind;
+	FOnUnrealGPTReplicateComplete OnComplete;
+	FOnUnrealGPTReplicateProgress OnProgress;
+
+	TArray<FItem> Items;
+	int32 NumDone = 0;
+	bool bCancelled = false;
+
+	/** Batches that have not finished yet; callers may drop the pointer GenerateAsync returns */
+	static TArray<TSharedRef<FUnrealGPTReplicateBatch>> ActiveBatches;
+};
+
 /**
  * Static utility class for interacting with the Replicate API.
  * Handles image, audio, video, and 3D model generation.
@@ -17,44 +231,50 @@ class UNREALGPTEDITOR_API UUnrealGPTReplicateClient : public UObject
 {
 	GENERATED_BODY()
 
+	friend class FUnrealGPTReplicateGeneration;
+	friend class FUnrealGPTReplicateBatch;
+
 public:
 	/**
-	 * Generate content using the Replicate API.
+	 * Generate content using the Replicate API. Must be called on the game thread.
 	 *
 	 * @param ArgumentsJson - JSON string with generation parameters:
-	 *   - prompt (required): The generation prompt
+	 *   - prompt: The generation prompt (required unless 'prompts' is given)
+	 *   - prompts: Batch of prompts, one prediction each
+	 *   - seeds: Batch of seeds, one prediction each; paired with 'prompts' by position, so both must be the same length
+	 *   - count: Number of predictions of each prompt; cannot be combined with 'seeds'
 	 *   - output_kind: "image", "video", "audio", "3d" (default: "image")
 	 *   - output_subkind: For audio - "sfx", "music", "speech"
 	 *   - version: Specific Replicate model version (optional, uses defaults from settings)
+	 * @param OnComplete - Receives a JSON string with status, message, and details including downloaded
+	 *   file paths. Invoked on the game thread; immediately if the arguments are invalid.
+	 * @param OnProgress - Optional stage and download progress updates, throttled, on the game thread
 	 *
-	 * @return JSON string with status, message, and details including downloaded file paths
+	 * @return The running batch, or null if it failed or finished before returning. The client keeps
+	 *   the batch alive until it completes or is cancelled, so callers only need a weak pointer to cancel it.
 	 */
-	static FString Generate(const FString& ArgumentsJson);
+	static TSharedPtr<FUnrealGPTReplicateBatch> GenerateAsync(const FString& ArgumentsJson, FOnUnrealGPTReplicateComplete OnComplete,
+		FOnUnrealGPTReplicateProgress OnProgress = FOnUnrealGPTReplicateProgress());
+
+	/** Cancel every running batch and generation without invoking their completion delegates */
+	static void CancelAll();
+
+	/** Number of generations queued or running */
+	static int32 GetNumActiveGenerations();
+
+	/** Build the create-prediction URL and one body per requested prediction, or return false with an error result */
+	static bool BuildCreateRequests(const FString& ArgumentsJson, FString& OutUrl, TArray<FUnrealGPTReplicateRequest>& OutRequests,
+		FString& OutOutputKind, FString& OutErrorJson);
 
 private:
-	/**
-	 * Perform a blocking HTTP request.
-	 *
-	 * @param Url - The URL to request
-	 * @param Verb - HTTP verb (GET, POST)
-	 * @param Body - Request body for POST requests
-	 * @param AuthToken - Bearer token for authorization
-	 * @param OutResponse - Output response body
-	 * @param TimeoutSeconds - Request timeout
-	 * @return true if request succeeded (2xx status)
-	 */
-	static bool PerformHttpRequest(const FString& Url, const FString& Verb, const FString& Body,
-		const FString& AuthToken, FString& OutResponse, int32 TimeoutSeconds);
+	/** Queue a generation; it starts once fewer than the configured number of predictions are running */
+	static void EnqueueGeneration(const TSharedRef<FUnrealGPTReplicateGeneration>& Generation);
 
-	/**
-	 * Download a file from a URL to the staging folder.
-	 *
-	 * @param Uri - The URL to download from
-	 * @param OutputKind - Type of output (image, audio, video, 3d) for folder selection
-	 * @param AuthToken - Bearer token for authorization
-	 * @return Local file path if successful, empty string otherwise
-	 */
-	static FString DownloadFile(const FString& Uri, const FString& OutputKind, const FString& AuthToken);
+	/** Start queued generations in order while slots are free */
+	static void StartQueuedGenerations();
+
+	/** {"status":"error","message":...} with proper escaping */
+	static FString MakeErrorJson(const FString& Message);
 
 	/**
 	 * Get the appropriate staging folder for a given output kind.
@@ -72,4 +292,10 @@ private:
 	 * @param OutUris - Output array of found URIs
 	 */
 	static void CollectUrisFromJsonValue(const TSharedPtr<FJsonValue>& JsonValue, TArray<FString>& OutUris);
+
+	/** Output URIs of a succeeded prediction, preferring its 'output' field */
+	static TArray<FString> CollectOutputUris(const TSharedPtr<FJsonObject>& Prediction);
+
+	/** Generations that have not finished yet, in queue order; they keep themselves alive through this list */
+	static TArray<TSharedRef<FUnrealGPTReplicateGeneration>> ActiveGenerations;
 };
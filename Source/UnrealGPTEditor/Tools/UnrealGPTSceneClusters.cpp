@@ -0,0 +1,446 @@
+#include "UnrealGPTSceneClusters.h"
+#include "UnrealGPTSceneSnapshot.h"
+#include "UnrealGPTSceneTable.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace UnrealGPTSceneClusters
+{
+	static const int32 MinGridSize = 2;
+	static const int32 MaxGridSize = 8;
+	static const int32 MaxDepth = 8;
+	static const int32 MaxListedLimit = 200;
+
+	/** Classes named per cell; the rest are only counted */
+	static const int32 ClassesPerCell = 4;
+
+	/** Largest actors whose labels are reported per cell */
+	static const int32 NotablePerCell = 3;
+
+	/** Actors handled by one ParallelFor task */
+	static const int32 ActorsPerTask = 4096;
+
+	struct FCellStats
+	{
+		int32 Count = 0;
+
+		/** Unloaded World Partition actors among Count */
+		int32 Unloaded = 0;
+
+		/** Box spanned by the actor locations; actor bounds would let a landscape or sky sphere swallow the cell */
+		FBox Extent = FBox(ForceInit);
+
+		TMap<FName, int32> ClassCounts;
+
+		/** (XY size, actor index) of the largest actors, largest first */
+		TArray<TPair<double, int32>> Notable;
+
+		void AddNotable(double Size, int32 ActorIndex)
+		{
+			// Ties go to the earlier actor so results do not depend on how work was split
+			int32 Insert = 0;
+			while (Insert < Notable.Num()
+				&& (Notable[Insert].Key > Size || (Notable[Insert].Key == Size && Notable[Insert].Value < ActorIndex)))
+			{
+				Insert++;
+			}
+
+			if (Insert < NotablePerCell)
+			{
+				Notable.Insert(TPair<double, int32>(Size, ActorIndex), Insert);
+				if (Notable.Num() > NotablePerCell)
+				{
+					Notable.Pop();
+				}
+			}
+		}
+
+		void Add(const FUnrealGPTActorRecord& Record, int32 ActorIndex)
+		{
+			Count++;
+			Unloaded += Record.bLoaded ? 0 : 1;
+			Extent += Record.Location;
+			ClassCounts.FindOrAdd(Record.ClassName)++;
+
+			if (Record.Bounds.IsValid)
+			{
+				const FVector Size = Record.Bounds.GetSize();
+				AddNotable(FMath::Max(Size.X, Size.Y), ActorIndex);
+			}
+		}
+
+		void Merge(const FCellStats& Other)
+		{
+			Count += Other.Count;
+			Unloaded += Other.Unloaded;
+			Extent += Other.Extent;
+			for (const TPair<FName, int32>& Pair : Other.ClassCounts)
+			{
+				ClassCounts.FindOrAdd(Pair.Key) += Pair.Value;
+			}
+			for (const TPair<double, int32>& Entry : Other.Notable)
+			{
+				AddNotable(Entry.Key, Entry.Value);
+			}
+		}
+	};
+
+	/** Results of one ParallelFor task */
+	struct FTaskResult
+	{
+		TArray<FCellStats> Cells;
+		TArray<int32> Members;
+	};
+
+	static int32 GetCellIndex(double Value, double Min, double Size, int32 GridSize)
+	{
+		if (Size <= UE_KINDA_SMALL_NUMBER)
+		{
+			return 0;
+		}
+		return FMath::Clamp(FMath::FloorToInt32((Value - Min) / Size * GridSize), 0, GridSize - 1);
+	}
+
+	static FBox2D GetSubRegion(const FBox2D& Region, const FIntPoint& Cell, int32 GridSize)
+	{
+		const FVector2D CellSize = Region.GetSize() / static_cast<double>(GridSize);
+		const FVector2D Min = Region.Min + FVector2D(Cell.X * CellSize.X, Cell.Y * CellSize.Y);
+		return FBox2D(Min, Min + CellSize);
+	}
+
+	/** Grid coordinate of a cell id; digits only, since IsNumeric would let "1.5" and "-1" through */
+	static bool ParseCellIndex(const FString& Text, int32 GridSize, int32& OutIndex)
+	{
+		if (Text.IsEmpty() || Text.Len() > 2)
+		{
+			return false;
+		}
+
+		OutIndex = 0;
+		for (const TCHAR Char : Text)
+		{
+			if (!FChar::IsDigit(Char))
+			{
+				return false;
+			}
+			OutIndex = OutIndex * 10 + (Char - TEXT('0'));
+		}
+		return OutIndex < GridSize;
+	}
+
+	static FString MakeChildId(const FString& ParentId, int32 X, int32 Y)
+	{
+		const FString Id = FString::Printf(TEXT("%d_%d"), X, Y);
+		return ParentId.IsEmpty() ? Id : ParentId + TEXT("/") + Id;
+	}
+
+	template <class WriterType>
+	static void WriteRounded(WriterType& Writer, const TCHAR* Name, const FVector& Value)
+	{
+		Writer.WriteArrayStart(Name);
+		Writer.WriteValue(FMath::RoundToDouble(Value.X));
+		Writer.WriteValue(FMath::RoundToDouble(Value.Y));
+		Writer.WriteValue(FMath::RoundToDouble(Value.Z));
+		Writer.WriteArrayEnd();
+	}
+
+	static FString MakeError(const FString& Message)
+	{
+		FString Output;
+		TSharedRef<FUnrealGPTSceneTable::FWriter> Writer = FUnrealGPTSceneTable::FWriterFactory::Create(&Output);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("status"), FString(TEXT("error")));
+		Writer->WriteValue(TEXT("message"), Message);
+		Writer->WriteObjectEnd();
+		Writer->Close();
+		return Output;
+	}
+}
+
+FString FUnrealGPTSceneClusters::QueryOverview(const FString& ArgumentsJson)
+{
+	FOptions Options;
+
+	TSharedPtr<FJsonObject> ArgsObj;
+	if (!ArgumentsJson.IsEmpty())
+	{
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgumentsJson);
+		FJsonSerializer::Deserialize(Reader, ArgsObj);
+	}
+
+	if (ArgsObj.IsValid())
+	{
+		ArgsObj->TryGetStringField(TEXT("cell"), Options.CellId);
+		ArgsObj->TryGetNumberField(TEXT("grid_size"), Options.GridSize);
+		ArgsObj->TryGetNumberField(TEXT("max_listed"), Options.MaxListedActors);
+		ArgsObj->TryGetStringField(TEXT("class_contains"), Options.ClassContains);
+		ArgsObj->TryGetBoolField(TEXT("include_unloaded"), Options.bIncludeUnloaded);
+	}
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return UnrealGPTSceneClusters::MakeError(TEXT("No editor world is open"));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FUnrealGPTSceneSnapshot Snapshot = FUnrealGPTSceneSnapshot::Capture(World, EUnrealGPTSnapshotFields::Bounds, Options.bIncludeUnloaded);
+	const double CaptureTime = FPlatformTime::Seconds();
+
+	FString Result = Summarize(Snapshot, Options);
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: scene_overview of %d actors: capture %.1f ms, summary %.1f ms"),
+		Snapshot.Num(), (CaptureTime - StartTime) * 1000.0, (FPlatformTime::Seconds() - CaptureTime) * 1000.0);
+	return Result;
+}
+
+bool FUnrealGPTSceneClusters::ParseCellId(const FString& CellId, int32 GridSize, TArray<FIntPoint>& OutPath)
+{
+	OutPath.Reset();
+
+	TArray<FString> Segments;
+	CellId.ParseIntoArray(Segments, TEXT("/"), true);
+	if (Segments.Num() > UnrealGPTSceneClusters::MaxDepth)
+	{
+		return false;
+	}
+
+	for (const FString& Segment : Segments)
+	{
+		FString XText, YText;
+		FIntPoint Cell;
+		if (!Segment.Split(TEXT("_"), &XText, &YText)
+			|| !UnrealGPTSceneClusters::ParseCellIndex(XText, GridSize, Cell.X)
+			|| !UnrealGPTSceneClusters::ParseCellIndex(YText, GridSize, Cell.Y))
+		{
+			OutPath.Reset();
+			return false;
+		}
+		OutPath.Add(Cell);
+	}
+	return true;
+}
+
+FString FUnrealGPTSceneClusters::Summarize(const FUnrealGPTSceneSnapshot& Snapshot, const FOptions& Options)
+{
+	using namespace UnrealGPTSceneClusters;
+
+	const int32 GridSize = FMath::Clamp(Options.GridSize, MinGridSize, MaxGridSize);
+	const int32 MaxListed = FMath::Clamp(Options.MaxListedActors, 0, MaxListedLimit);
+
+	TArray<FIntPoint> Path;
+	if (!ParseCellId(Options.CellId, GridSize, Path))
+	{
+		return MakeError(FString::Printf(TEXT("Invalid cell '%s': expected an id such as \"1_2\" or \"1_2/0_3\" from a previous scene_overview with the same grid_size"), *Options.CellId));
+	}
+
+	TArray<FString> PathIds;
+	for (const FIntPoint& Cell : Path)
+	{
+		PathIds.Add(FString::Printf(TEXT("%d_%d"), Cell.X, Cell.Y));
+	}
+	const FString CellId = FString::Join(PathIds, TEXT("/"));
+
+	const TArray<FUnrealGPTActorRecord>& Actors = Snapshot.Actors;
+	const int32 NumTasks = FMath::DivideAndRoundUp(Actors.Num(), ActorsPerTask);
+
+	// Pass 1: extent of the whole level, over every actor so cell ids do not change with the class filter
+	TArray<FBox2D> TaskExtents;
+	TArray<TSet<FName>> TaskClasses;
+	TaskExtents.Init(FBox2D(ForceInit), NumTasks);
+	TaskClasses.SetNum(NumTasks);
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		const int32 End = FMath::Min((TaskIndex + 1) * ActorsPerTask, Actors.Num());
+		for (int32 Index = TaskIndex * ActorsPerTask; Index < End; ++Index)
+		{
+			TaskExtents[TaskIndex] += FVector2D(Actors[Index].Location);
+			TaskClasses[TaskIndex].Add(Actors[Index].ClassName);
+		}
+	});
+
+	FBox2D LevelRegion(ForceInit);
+	TSet<FName> IncludedClasses;
+	for (int32 TaskIndex = 0; TaskIndex < NumTasks; ++TaskIndex)
+	{
+		LevelRegion += TaskExtents[TaskIndex];
+		for (const FName& ClassName : TaskClasses[TaskIndex])
+		{
+			if (Options.ClassContains.IsEmpty() || ClassName.ToString().Contains(Options.ClassContains, ESearchCase::IgnoreCase))
+			{
+				IncludedClasses.Add(ClassName);
+			}
+		}
+	}
+
+	if (!LevelRegion.bIsValid)
+	{
+		LevelRegion = FBox2D(FVector2D::ZeroVector, FVector2D::ZeroVector);
+	}
+
+	// Regions[i] is the area Path[i] is a cell of; the last one is the requested cell
+	TArray<FBox2D> Regions = { LevelRegion };
+	for (const FIntPoint& Cell : Path)
+	{
+		Regions.Add(GetSubRegion(Regions.Last(), Cell, GridSize));
+	}
+	const FBox2D& Region = Regions.Last();
+	const FVector2D RegionSize = Region.GetSize();
+
+	// Pass 2: bucket the actors of the requested cell into its sub-cells
+	TArray<FTaskResult> TaskResults;
+	TaskResults.SetNum(NumTasks);
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		FTaskResult& TaskResult = TaskResults[TaskIndex];
+		TaskResult.Cells.SetNum(GridSize * GridSize);
+
+		const int32 End = FMath::Min((TaskIndex + 1) * ActorsPerTask, Actors.Num());
+		for (int32 Index = TaskIndex * ActorsPerTask; Index < End; ++Index)
+		{
+			const FUnrealGPTActorRecord& Record = Actors[Index];
+			if (!IncludedClasses.Contains(Record.ClassName))
+			{
+				continue;
+			}
+
+			// Same index math at every level, so actors on a cell edge stay in the cell the parent summary counted them in
+			bool bInCell = true;
+			for (int32 Level = 0; Level < Path.Num() && bInCell; ++Level)
+			{
+				const FVector2D LevelSize = Regions[Level].GetSize();
+				bInCell = GetCellIndex(Record.Location.X, Regions[Level].Min.X, LevelSize.X, GridSize) == Path[Level].X
+					&& GetCellIndex(Record.Location.Y, Regions[Level].Min.Y, LevelSize.Y, GridSize) == Path[Level].Y;
+			}
+			if (!bInCell)
+			{
+				continue;
+			}
+
+			const int32 X = GetCellIndex(Record.Location.X, Region.Min.X, RegionSize.X, GridSize);
+			const int32 Y = GetCellIndex(Record.Location.Y, Region.Min.Y, RegionSize.Y, GridSize);
+			TaskResult.Cells[Y * GridSize + X].Add(Record, Index);
+			TaskResult.Members.Add(Index);
+		}
+	});
+
+	// Merge in task order, which keeps members in snapshot order
+	TArray<FCellStats> Cells;
+	Cells.SetNum(GridSize * GridSize);
+	TArray<int32> Members;
+	int32 UnloadedMatched = 0;
+	for (FTaskResult& TaskResult : TaskResults)
+	{
+		for (int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex)
+		{
+			Cells[CellIndex].Merge(TaskResult.Cells[CellIndex]);
+			UnloadedMatched += TaskResult.Cells[CellIndex].Unloaded;
+		}
+		Members.Append(TaskResult.Members);
+	}
+
+	FString Output;
+	TSharedRef<FUnrealGPTSceneTable::FWriter> Writer = FUnrealGPTSceneTable::FWriterFactory::Create(&Output);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("status"), FString(TEXT("ok")));
+	Writer->WriteValue(TEXT("cell"), CellId.IsEmpty() ? FString(TEXT("level")) : CellId);
+	Writer->WriteValue(TEXT("grid_size"), static_cast<double>(GridSize));
+	Writer->WriteValue(TEXT("total_actors"), static_cast<double>(Actors.Num()));
+	Writer->WriteValue(TEXT("matched"), static_cast<double>(Members.Num()));
+	if (UnloadedMatched > 0)
+	{
+		Writer->WriteValue(TEXT("unloaded_matched"), static_cast<double>(UnloadedMatched));
+	}
+	WriteRounded(*Writer, TEXT("region_min"), FVector(Region.Min, 0.0));
+	WriteRounded(*Writer, TEXT("region_max"), FVector(Region.Max, 0.0));
+
+	Writer->WriteArrayStart(TEXT("cells"));
+	for (int32 Y = 0; Y < GridSize; ++Y)
+	{
+		for (int32 X = 0; X < GridSize; ++X)
+		{
+			FCellStats& Cell = Cells[Y * GridSize + X];
+			if (Cell.Count == 0)
+			{
+				continue;
+			}
+
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("id"), MakeChildId(CellId, X, Y));
+			Writer->WriteValue(TEXT("count"), static_cast<double>(Cell.Count));
+			if (Cell.Unloaded > 0)
+			{
+				Writer->WriteValue(TEXT("unloaded"), static_cast<double>(Cell.Unloaded));
+			}
+			WriteRounded(*Writer, TEXT("min"), Cell.Extent.Min);
+			WriteRounded(*Writer, TEXT("max"), Cell.Extent.Max);
+
+			Cell.ClassCounts.ValueSort([](int32 A, int32 B) { return A > B; });
+			Writer->WriteObjectStart(TEXT("classes"));
+			int32 NumNamed = 0;
+			for (const TPair<FName, int32>& Pair : Cell.ClassCounts)
+			{
+				if (NumNamed++ >= ClassesPerCell)
+				{
+					break;
+				}
+				Writer->WriteValue(Pair.Key.ToString(), static_cast<double>(Pair.Value));
+			}
+			Writer->WriteObjectEnd();
+			if (Cell.ClassCounts.Num() > ClassesPerCell)
+			{
+				Writer->WriteValue(TEXT("other_classes"), static_cast<double>(Cell.ClassCounts.Num() - ClassesPerCell));
+			}
+
+			if (Cell.Notable.Num() > 0)
+			{
+				Writer->WriteArrayStart(TEXT("largest"));
+				for (const TPair<double, int32>& Entry : Cell.Notable)
+				{
+					Writer->WriteValue(Snapshot.Labels[Entry.Value]);
+				}
+				Writer->WriteArrayEnd();
+			}
+			Writer->WriteObjectEnd();
+		}
+	}
+	Writer->WriteArrayEnd();
+
+	if (Members.Num() > 0 && Members.Num() <= MaxListed)
+	{
+		// Unloaded actors are marked so the agent knows to load them (scene_query with load) before editing
+		TArray<FString> Columns = { TEXT("id"), TEXT("label"), TEXT("x"), TEXT("y"), TEXT("z") };
+		if (UnloadedMatched > 0)
+		{
+			Columns.Add(TEXT("loaded"));
+		}
+
+		FUnrealGPTSceneTable Table(Columns, 0);
+		for (const int32 Index : Members)
+		{
+			Table.BeginRow(Actors[Index].ClassName.ToString());
+			Table.AddCell(Actors[Index].Name.ToString());
+			Table.AddCell(Snapshot.Labels[Index]);
+			Table.AddVector(Actors[Index].Location);
+			if (UnloadedMatched > 0)
+			{
+				Table.AddCell(Actors[Index].bLoaded ? TEXT("1") : TEXT("0"));
+			}
+		}
+
+		Writer->WriteObjectStart(TEXT("actors"));
+		Table.Write(*Writer);
+		Writer->WriteObjectEnd();
+	}
+	else if (Members.Num() > MaxListed)
+	{
+		Writer->WriteValue(TEXT("hint"), FString(TEXT("Pass a cell id as 'cell' to subdivide it; actors are listed once a cell holds few enough.")));
+	}
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return Output;
+}
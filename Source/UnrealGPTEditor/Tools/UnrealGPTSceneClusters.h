@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FUnrealGPTSceneSnapshot;
+
+/**
+ * Whole-level overview for the scene_overview tool. Actors are bucketed into a GridSize x GridSize
+ * grid over the XY extent of the level, and each non-empty cell reports its actor count, the box
+ * spanned by its actor locations, a class histogram and its largest actors by label. Passing a
+ * cell id ("1_2", then "1_2/0_3", ...) subdivides that cell the same way, and once a cell holds
+ * few enough actors they are listed as table rows.
+ *
+ * Summaries are computed from a FUnrealGPTSceneSnapshot with ParallelFor, so the game thread
+ * only pays for the snapshot copy.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTSceneClusters
+{
+public:
+	struct FOptions
+	{
+		/** Cell to subdivide; empty for the whole level */
+		FString CellId;
+
+		int32 GridSize = 4;
+
+		/** List the actors themselves when the cell holds at most this many */
+		int32 MaxListedActors = 40;
+
+		/** Only count actors whose class contains this substring (case-insensitive) */
+		FString ClassContains;
+
+		/** Also count the unloaded actors of World Partition maps */
+		bool bIncludeUnloaded = true;
+	};
+
+	/**
+	 * scene_overview entry point: snapshot the editor world and summarize it.
+	 * @param ArgumentsJson - JSON with optional cell, grid_size, max_listed, class_contains and include_unloaded
+	 */
+	static FString QueryOverview(const FString& ArgumentsJson);
+
+	/** Summarize a captured snapshot. Exposed for tests. */
+	static FString Summarize(const FUnrealGPTSceneSnapshot& Snapshot, const FOptions& Options);
+
+	/** Parse a cell id of the form "ix_iy/ix_iy/..." into grid coordinates; false if malformed or out of range */
+	static bool ParseCellId(const FString& CellId, int32 GridSize, TArray<FIntPoint>& OutPath);
+};
@@ -1,4 +1,6 @@
 #include "UnrealGPTSceneContext.h"
+#include "UnrealGPTSceneSnapshot.h"
+#include "UnrealGPTWorldPartition.h"
 #include "LevelEditor.h"
 #include "Editor.h"
 #include "Engine/World.h"
@@ -22,6 +24,7 @@
 #include "RenderCommandFence.h"
 #include "LevelEditorViewport.h"
 #include "SLevelViewport.h"
+#include "Async/ParallelFor.h"
 
 FString UUnrealGPTSceneContext::CaptureViewportScreenshot()
 {
@@ -416,15 +419,275 @@ bool UUnrealGPTSceneContext::CaptureViewportToImage(TArray<uint8>& OutImageData,
 	return true;
 }
 
+namespace UnrealGPTSceneJson
+{
+	/** Rough size of one serialized actor, used to reserve the output buffer up front */
+	static const int32 EstimatedCharsPerActor = 640;
+	static const int32 EstimatedCharsPerCompactActor = 160;
+
+	/** Never reserve more than this many characters ahead of time, however large the page */
+	static const int32 MaxReservedChars = 8 * 1024 * 1024;
+
+	static void ReserveOutput(FString& Output, int32 NumActors, int32 CharsPerActor)
+	{
+		Output.Reserve(static_cast<int32>(FMath::Min<int64>(static_cast<int64>(NumActors) * CharsPerActor + 256, MaxReservedChars)));
+	}
+
+	/** Classes listed in the unloaded summary of World Partition maps */
+	static const int32 MaxUnloadedClasses = 10;
+
+	/** Count of the unloaded actors of a World Partition map and their most common classes; nothing for other maps */
+	template <typename WriterType>
+	static void WriteUnloadedSummary(WriterType& Writer, UWorld* World)
+	{
+		if (!FUnrealGPTWorldPartition::IsPartitioned(World))
+		{
+			return;
+		}
+
+		TArray<FUnrealGPTActorDesc> Unloaded;
+		FUnrealGPTWorldPartition::GetUnloadedActors(World, Unloaded);
+
+		TMap<FName, int32> ClassCounts;
+		for (const FUnrealGPTActorDesc& Desc : Unloaded)
+		{
+			ClassCounts.FindOrAdd(Desc.ClassName)++;
+		}
+		ClassCounts.ValueSort([](int32 A, int32 B) { return A > B; });
+
+		Writer.WriteValue(TEXT("unloaded_actors"), static_cast<double>(Unloaded.Num()));
+		Writer.WriteObjectStart(TEXT("unloaded_classes"));
+		int32 Listed = 0;
+		for (const TPair<FName, int32>& Pair : ClassCounts)
+		{
+			if (Listed++ >= MaxUnloadedClasses)
+			{
+				break;
+			}
+			Writer.WriteValue(Pair.Key.ToString(), static_cast<double>(Pair.Value));
+		}
+		Writer.WriteObjectEnd();
+	}
+
+	// Numbers go through WriteValue(double), as FJsonSerializer writes FJsonValueNumber, so the text is unchanged
+	static void WriteXYZ(TJsonWriter<>& Writer, const TCHAR* Name, const FVector& Value)
+	{
+		Writer.WriteObjectStart(Name);
+		Writer.WriteValue(TEXT("x"), static_cast<double>(Value.X));
+		Writer.WriteValue(TEXT("y"), static_cast<double>(Value.Y));
+		Writer.WriteValue(TEXT("z"), static_cast<double>(Value.Z));
+		Writer.WriteObjectEnd();
+	}
+
+	static void WriteRotation(TJsonWriter<>& Writer, const TCHAR* Name, const FRotator& Value)
+	{
+		Writer.WriteObjectStart(Name);
+		Writer.WriteValue(TEXT("pitch"), static_cast<double>(Value.Pitch));
+		Writer.WriteValue(TEXT("yaw"), static_cast<double>(Value.Yaw));
+		Writer.WriteValue(TEXT("roll"), static_cast<double>(Value.Roll));
+		Writer.WriteObjectEnd();
+	}
+
+	static FString MobilityToString(EComponentMobility::Type Mobility)
+	{
+		switch (Mobility)
+		{
+			case EComponentMobility::Static: return TEXT("Static");
+			case EComponentMobility::Stationary: return TEXT("Stationary");
+			case EComponentMobility::Movable: return TEXT("Movable");
+			default: return TEXT("Unknown");
+		}
+	}
+}
+
+namespace UnrealGPTSceneQuery
+{
+	/** Actors filtered by one ParallelFor task */
+	static const int32 ActorsPerTask = 2048;
+
+	/** Indentation of the objects in the "actors" array of the pretty-printed scene_query output */
+	static const int32 RowIndentLevel = 2;
+
+	/** Results of one ParallelFor task */
+	struct FTaskResult
+	{
+		/** Snapshot indices of the matching actors, in snapshot order */
+		TArray<int32> Matches;
+		TMap<FName, int32> ClassCounts;
+		int32 NumUnloaded = 0;
+	};
+
+	/** Simple substring filter (case-insensitive); an empty filter matches everything */
+	static bool Matches(const FString& Source, const FString& Substr)
+	{
+		return Substr.IsEmpty() || Source.Contains(Substr, ESearchCase::IgnoreCase);
+	}
+
+	/** Snapshot fields the requested scene_query fields are written from */
+	static EUnrealGPTSnapshotFields GetSnapshotFields(const TSet<FString>& Fields)
+	{
+		EUnrealGPTSnapshotFields SnapshotFields = EUnrealGPTSnapshotFields::None;
+		if (Fields.Contains(TEXT("rotation")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::Rotation;
+		}
+		if (Fields.Contains(TEXT("scale")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::Scale;
+		}
+		if (Fields.Contains(TEXT("bounds")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::Bounds;
+		}
+		if (Fields.Contains(TEXT("components")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::Components;
+		}
+		if (Fields.Contains(TEXT("tags")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::Tags;
+		}
+		if (Fields.Contains(TEXT("folder")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::Folder;
+		}
+		if (Fields.Contains(TEXT("parent")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::Parent;
+		}
+		if (Fields.Contains(TEXT("data_layers")))
+		{
+			SnapshotFields |= EUnrealGPTSnapshotFields::DataLayers;
+		}
+		return SnapshotFields;
+	}
+
+	/** One scene_query actor object; reads only the snapshot, so rows can be written on worker threads */
+	static void WriteActor(TJsonWriter<>& Writer, const FUnrealGPTSceneSnapshot& Snapshot, int32 Index, const TSet<FString>& Fields)
+	{
+		const FUnrealGPTActorRecord& Record = Snapshot.Actors[Index];
+
+		// Minimal by default
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("id"), Record.Name.ToString());   // Stable unique identifier
+		Writer.WriteValue(TEXT("label"), Snapshot.Labels[Index]); // User-friendly display name
+		Writer.WriteValue(TEXT("class"), Record.ClassName.ToString());
+
+		// Unloaded actors only have what their descriptor stores; the bounds center stands in for the location
+		if (!Record.bLoaded)
+		{
+			Writer.WriteValue(TEXT("loaded"), false);
+		}
+
+		if (Fields.Contains(TEXT("location")) && (Record.bLoaded || Record.Bounds.IsValid))
+		{
+			UnrealGPTSceneJson::WriteXYZ(Writer, TEXT("location"), Record.Location);
+		}
+
+		if (Record.bLoaded && Fields.Contains(TEXT("rotation")))
+		{
+			UnrealGPTSceneJson::WriteRotation(Writer, TEXT("rotation"), Record.Rotation);
+		}
+
+		if (Record.bLoaded && Fields.Contains(TEXT("scale")))
+		{
+			UnrealGPTSceneJson::WriteXYZ(Writer, TEXT("scale"), Record.Scale);
+		}
+
+		// Actors without any component get a point at their location
+		if (Fields.Contains(TEXT("bounds")) && (Record.bLoaded || Record.Bounds.IsValid))
+		{
+			Writer.WriteObjectStart(TEXT("bounds"));
+			UnrealGPTSceneJson::WriteXYZ(Writer, TEXT("origin"), Record.Bounds.IsValid ? Record.Bounds.GetCenter() : Record.Location);
+			UnrealGPTSceneJson::WriteXYZ(Writer, TEXT("extent"), Record.Bounds.IsValid ? Record.Bounds.GetExtent() : FVector::ZeroVector);
+			Writer.WriteObjectEnd();
+		}
+
+		if (!Record.bLoaded)
+		{
+			if (Fields.Contains(TEXT("data_layers")))
+			{
+				Writer.WriteArrayStart(TEXT("data_layers"));
+				for (const int32 DataLayer : Snapshot.GetDataLayers(Record))
+				{
+					Writer.WriteValue(Snapshot.DataLayerNames[DataLayer]);
+				}
+				Writer.WriteArrayEnd();
+			}
+			Writer.WriteObjectEnd();
+			return;
+		}
+
+		// Optional: root component info and static mesh path
+		if (Fields.Contains(TEXT("components")))
+		{
+			if (!Record.RootClassName.IsNone())
+			{
+				Writer.WriteObjectStart(TEXT("root_component"));
+				Writer.WriteValue(TEXT("class"), Record.RootClassName.ToString());
+				Writer.WriteValue(TEXT("mobility"), UnrealGPTSceneJson::MobilityToString(static_cast<EComponentMobility::Type>(Record.Mobility)));
+				Writer.WriteObjectEnd();
+			}
+
+			if (Record.MeshPath.IsValid())
+			{
+				Writer.WriteValue(TEXT("static_mesh_path"), Record.MeshPath.ToString());
+			}
+		}
+
+		// Optional: tags
+		if (Fields.Contains(TEXT("tags")))
+		{
+			Writer.WriteArrayStart(TEXT("tags"));
+			for (const int32 Tag : Snapshot.GetTags(Record))
+			{
+				Writer.WriteValue(Snapshot.TagNames[Tag].ToString());
+			}
+			Writer.WriteArrayEnd();
+		}
+
+		// Optional: folder path
+		if (Fields.Contains(TEXT("folder")))
+		{
+			Writer.WriteValue(TEXT("folder_path"), Record.FolderPath.ToString());
+		}
+
+		// Optional: parent attachment
+		if (Fields.Contains(TEXT("parent")) && Record.ParentIndex != INDEX_NONE)
+		{
+			Writer.WriteValue(TEXT("parent_actor"), Snapshot.Labels[Record.ParentIndex]);
+		}
+
+		// Optional: data layers
+		if (Fields.Contains(TEXT("data_layers")))
+		{
+			Writer.WriteArrayStart(TEXT("data_layers"));
+			for (const int32 DataLayer : Snapshot.GetDataLayers(Record))
+			{
+				Writer.WriteValue(Snapshot.DataLayerNames[DataLayer]);
+			}
+			Writer.WriteArrayEnd();
+		}
+
+		Writer.WriteObjectEnd();
+	}
+}
+
 FString UUnrealGPTSceneContext::GetSceneSummary(int32 PageSize, int32 PageIndex)
 {
-	UWorld* World = GEditor->GetEditorWorldContext().World();
+	return GetSceneSummaryForWorld(GEditor->GetEditorWorldContext().World(), PageSize, PageIndex);
+}
+
+FString UUnrealGPTSceneContext::GetSceneSummaryForWorld(UWorld* World, int32 PageSize, int32 PageIndex)
+{
 	if (!World)
 	{
 		return TEXT("{}");
 	}
 
-	TArray<TSharedPtr<FJsonValue>> ActorsArray;
+	// Counts precede the actors in the output, so find the page first and stream it afterwards
+	TArray<AActor*> PageActors;
+	PageActors.Reserve(FMath::Clamp(PageSize, 0, 4096));
 	int32 ActorCount = 0;
 	int32 StartIndex = PageIndex * PageSize;
 	int32 EndIndex = StartIndex + PageSize;
@@ -439,31 +702,35 @@ FString UUnrealGPTSceneContext::GetSceneSummary(int32 PageSize, int32 PageIndex)
 
 		if (ActorCount >= StartIndex && ActorCount < EndIndex)
 		{
-			TSharedPtr<FJsonObject> ActorJson = SerializeActor(Actor);
-			if (ActorJson.IsValid())
-			{
-				ActorsArray.Add(MakeShareable(new FJsonValueObject(ActorJson)));
-			}
+			PageActors.Add(Actor);
 		}
 
 		ActorCount++;
 	}
 
-	TSharedPtr<FJsonObject> SummaryJson = MakeShareable(new FJsonObject);
-	SummaryJson->SetNumberField(TEXT("total_actors"), ActorCount);
-	SummaryJson->SetNumberField(TEXT("page_size"), PageSize);
-	SummaryJson->SetNumberField(TEXT("page_index"), PageIndex);
-	SummaryJson->SetNumberField(TEXT("actors_on_page"), ActorsArray.Num());
-	SummaryJson->SetArrayField(TEXT("actors"), ActorsArray);
-
 	FString OutputString;
+	UnrealGPTSceneJson::ReserveOutput(OutputString, PageActors.Num(), UnrealGPTSceneJson::EstimatedCharsPerActor);
+
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(SummaryJson.ToSharedRef(), Writer);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("total_actors"), static_cast<double>(ActorCount));
+	UnrealGPTSceneJson::WriteUnloadedSummary(*Writer, World);
+	Writer->WriteValue(TEXT("page_size"), static_cast<double>(PageSize));
+	Writer->WriteValue(TEXT("page_index"), static_cast<double>(PageIndex));
+	Writer->WriteValue(TEXT("actors_on_page"), static_cast<double>(PageActors.Num()));
+	Writer->WriteArrayStart(TEXT("actors"));
+	for (AActor* Actor : PageActors)
+	{
+		SerializeActor(*Writer, Actor);
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
 
 	return OutputString;
 }
 
-FString UUnrealGPTSceneContext::GetCompactSceneSummary(int32 MaxActors)
+FString UUnrealGPTSceneContext::GetCompactSceneSummary(int32 MaxActors, bool bTableFormat)
 {
 	UWorld* World = GEditor->GetEditorWorldContext().World();
 	if (!World)
@@ -471,50 +738,65 @@ FString UUnrealGPTSceneContext::GetCompactSceneSummary(int32 MaxActors)
 		return TEXT("{}");
 	}
 
-	TArray<TSharedPtr<FJsonValue>> ActorsArray;
-	int32 ActorCount = 0;
-	int32 IncludedCount = 0;
+	// Names, classes, locations and labels are all the compact form needs, and only for the
+	// MaxActors actors included in detail; the rest are just counted
+	const FUnrealGPTSceneSnapshot Snapshot = FUnrealGPTSceneSnapshot::Capture(World, EUnrealGPTSnapshotFields::None, false, MaxActors);
+	const int32 ActorCount = Snapshot.TotalActors;
 
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	TArray<int32> IncludedActors;
+	IncludedActors.Reserve(Snapshot.Num());
+	for (int32 Index = 0; Index < Snapshot.Num(); ++Index)
 	{
-		AActor* Actor = *ActorItr;
-		if (!Actor || Actor->IsPendingKillPending())
-		{
-			continue;
-		}
-
-		ActorCount++;
-
-		// Only include up to MaxActors in detail
-		if (IncludedCount < MaxActors)
-		{
-			// Compact serialization: just name, label, class, and location (no components)
-			TSharedPtr<FJsonObject> ActorJson = MakeShareable(new FJsonObject);
-			ActorJson->SetStringField(TEXT("name"), Actor->GetName());
-			ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
-			ActorJson->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+		IncludedActors.Add(Index);
+	}
 
-			// Location only (no rotation/scale to save tokens)
-			const FVector Location = Actor->GetActorLocation();
-			TSharedPtr<FJsonObject> LocationJson = MakeShareable(new FJsonObject);
-			LocationJson->SetNumberField(TEXT("x"), FMath::RoundToInt(Location.X));
-			LocationJson->SetNumberField(TEXT("y"), FMath::RoundToInt(Location.Y));
-			LocationJson->SetNumberField(TEXT("z"), FMath::RoundToInt(Location.Z));
-			ActorJson->SetObjectField(TEXT("location"), LocationJson);
+	FString OutputString;
+	UnrealGPTSceneJson::ReserveOutput(OutputString, IncludedActors.Num(), UnrealGPTSceneJson::EstimatedCharsPerCompactActor);
 
-			ActorsArray.Add(MakeShareable(new FJsonValueObject(ActorJson)));
-			IncludedCount++;
-		}
+	if (bTableFormat)
+	{
+		// Whole units, as in the JSON form
+		const FUnrealGPTSceneTable Table = BuildActorTable(Snapshot, IncludedActors, TSet<FString>{ FString(TEXT("location")) }, 0);
+
+		TSharedRef<FUnrealGPTSceneTable::FWriter> TableWriter = FUnrealGPTSceneTable::FWriterFactory::Create(&OutputString);
+		TableWriter->WriteObjectStart();
+		TableWriter->WriteValue(TEXT("total_actors"), static_cast<double>(ActorCount));
+		TableWriter->WriteValue(TEXT("included_actors"), static_cast<double>(IncludedActors.Num()));
+		UnrealGPTSceneJson::WriteUnloadedSummary(*TableWriter, World);
+		Table.Write(*TableWriter);
+		TableWriter->WriteObjectEnd();
+		TableWriter->Close();
+		return OutputString;
 	}
 
-	TSharedPtr<FJsonObject> SummaryJson = MakeShareable(new FJsonObject);
-	SummaryJson->SetNumberField(TEXT("total_actors"), ActorCount);
-	SummaryJson->SetNumberField(TEXT("included_actors"), IncludedCount);
-	SummaryJson->SetArrayField(TEXT("actors"), ActorsArray);
-
-	FString OutputString;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(SummaryJson.ToSharedRef(), Writer);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("total_actors"), static_cast<double>(ActorCount));
+	Writer->WriteValue(TEXT("included_actors"), static_cast<double>(IncludedActors.Num()));
+	UnrealGPTSceneJson::WriteUnloadedSummary(*Writer, World);
+	Writer->WriteArrayStart(TEXT("actors"));
+	for (const int32 Index : IncludedActors)
+	{
+		const FUnrealGPTActorRecord& Record = Snapshot.Actors[Index];
+
+		// Compact serialization: just name, label, class, and location (no components)
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Record.Name.ToString());
+		Writer->WriteValue(TEXT("label"), Snapshot.Labels[Index]);
+		Writer->WriteValue(TEXT("class"), Record.ClassName.ToString());
+
+		// Location only (no rotation/scale to save tokens)
+		Writer->WriteObjectStart(TEXT("location"));
+		Writer->WriteValue(TEXT("x"), static_cast<double>(FMath::RoundToInt(Record.Location.X)));
+		Writer->WriteValue(TEXT("y"), static_cast<double>(FMath::RoundToInt(Record.Location.Y)));
+		Writer->WriteValue(TEXT("z"), static_cast<double>(FMath::RoundToInt(Record.Location.Z)));
+		Writer->WriteObjectEnd();
+
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
 
 	return OutputString;
 }
@@ -524,17 +806,18 @@ FString UUnrealGPTSceneContext::QueryScene(const FString& ArgumentsJson)
 	UWorld* World = GEditor->GetEditorWorldContext().World();
 	if (!World)
 	{
-		TSharedPtr<FJsonObject> ErrorResult = MakeShareable(new FJsonObject);
-		TSharedPtr<FJsonObject> SummaryObj = MakeShareable(new FJsonObject);
-		SummaryObj->SetNumberField(TEXT("total_matched"), 0);
-		SummaryObj->SetNumberField(TEXT("returned"), 0);
-		SummaryObj->SetBoolField(TEXT("has_more"), false);
-		ErrorResult->SetObjectField(TEXT("summary"), SummaryObj);
-		ErrorResult->SetArrayField(TEXT("actors"), TArray<TSharedPtr<FJsonValue>>());
-
 		FString OutputString;
 		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-		FJsonSerializer::Serialize(ErrorResult.ToSharedRef(), Writer);
+		Writer->WriteObjectStart();
+		Writer->WriteObjectStart(TEXT("summary"));
+		Writer->WriteValue(TEXT("total_matched"), 0.0);
+		Writer->WriteValue(TEXT("returned"), 0.0);
+		Writer->WriteValue(TEXT("has_more"), false);
+		Writer->WriteObjectEnd();
+		Writer->WriteArrayStart(TEXT("actors"));
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
 		return OutputString;
 	}
 
@@ -566,11 +849,22 @@ FString UUnrealGPTSceneContext::QueryScene(const FString& ArgumentsJson)
 		return Value;
 	};
 
+	auto GetBoolArg = [&ArgsObj](const FString& Key, bool bDefaultValue) -> bool
+	{
+		bool bValue = bDefaultValue;
+		if (ArgsObj.IsValid())
+		{
+			ArgsObj->TryGetBoolField(Key, bValue);
+		}
+		return bValue;
+	};
+
 	// Filter parameters
 	const FString ClassContains = GetStringArg(TEXT("class_contains"));
 	const FString LabelContains = GetStringArg(TEXT("label_contains"));
 	const FString NameContains = GetStringArg(TEXT("name_contains"));
 	const FString ComponentClassContains = GetStringArg(TEXT("component_class_contains"));
+	const FString DataLayerContains = GetStringArg(TEXT("data_layer_contains"));
 	const int32 MaxResults = FMath::Max(1, GetIntArg(TEXT("max_results"), 20));
 	const int32 Offset = FMath::Max(0, GetIntArg(TEXT("offset"), 0));
 
@@ -589,252 +883,382 @@ FString UUnrealGPTSceneContext::QueryScene(const FString& ArgumentsJson)
 		}
 	}
 
-	// Check which fields are requested
-	const bool bIncludeLocation = RequestedFields.Contains(TEXT("location"));
-	const bool bIncludeRotation = RequestedFields.Contains(TEXT("rotation"));
-	const bool bIncludeScale = RequestedFields.Contains(TEXT("scale"));
-	const bool bIncludeBounds = RequestedFields.Contains(TEXT("bounds"));
-	const bool bIncludeComponents = RequestedFields.Contains(TEXT("components"));
-	const bool bIncludeTags = RequestedFields.Contains(TEXT("tags"));
-	const bool bIncludeFolder = RequestedFields.Contains(TEXT("folder"));
-	const bool bIncludeParent = RequestedFields.Contains(TEXT("parent"));
+	// "table": one header and "|"-separated rows instead of an object per actor
+	const bool bTableFormat = GetStringArg(TEXT("format")).Equals(TEXT("table"), ESearchCase::IgnoreCase);
+	const int32 Precision = GetIntArg(TEXT("precision"), FUnrealGPTSceneTable::GetDefaultPrecision());
 
-	// First pass: collect all matching actors and count classes
-	TArray<AActor*> MatchingActors;
-	TMap<FString, int32> ClassCounts;
+	// World Partition maps: unloaded actors are searched through their descriptors, and only loaded on request
+	const bool bPartitioned = FUnrealGPTWorldPartition::IsPartitioned(World);
+	const bool bIncludeUnloaded = bPartitioned && GetBoolArg(TEXT("include_unloaded"), true);
+	const bool bLoadMatches = bPartitioned && GetBoolArg(TEXT("load"), false);
 
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	// Loading comes first so the loaded actors are captured with the others
+	int32 LoadedOnDemand = 0;
+	if (bLoadMatches && ComponentClassContains.IsEmpty())
 	{
-		AActor* Actor = *ActorItr;
-		if (!Actor || Actor->IsPendingKillPending())
+		TArray<FUnrealGPTActorDesc> Unloaded;
+		FUnrealGPTWorldPartition::GetUnloadedActors(World, Unloaded);
+
+		TArray<FGuid> Guids;
+		for (const FUnrealGPTActorDesc& Desc : Unloaded)
 		{
-			continue;
+			if (UnrealGPTSceneQuery::Matches(Desc.ClassName.ToString(), ClassContains)
+				&& UnrealGPTSceneQuery::Matches(Desc.Label, LabelContains)
+				&& UnrealGPTSceneQuery::Matches(Desc.Name.ToString(), NameContains)
+				&& (DataLayerContains.IsEmpty() || Desc.DataLayers.ContainsByPredicate([&](const FString& DataLayer) { return UnrealGPTSceneQuery::Matches(DataLayer, DataLayerContains); })))
+			{
+				Guids.Add(Desc.Guid);
+			}
 		}
+		LoadedOnDemand = FUnrealGPTWorldPartition::LoadActors(World, Guids).Num();
+	}
 
-		const FString ClassName = Actor->GetClass()->GetName();
-		const FString Label = Actor->GetActorLabel();
-		const FString Name = Actor->GetName();
+	// Capture phase: the only part that touches the world; copy just what the filters and fields need
+	EUnrealGPTSnapshotFields CaptureFields = UnrealGPTSceneQuery::GetSnapshotFields(RequestedFields);
+	if (!ComponentClassContains.IsEmpty())
+	{
+		CaptureFields |= EUnrealGPTSnapshotFields::ComponentClasses;
+	}
+	if (!DataLayerContains.IsEmpty())
+	{
+		CaptureFields |= EUnrealGPTSnapshotFields::DataLayers;
+	}
 
-		// Apply simple substring filters (case-insensitive)
-		auto MatchesFilter = [](const FString& Source, const FString& Substr) -> bool
-		{
-			return Substr.IsEmpty() || Source.Contains(Substr, ESearchCase::IgnoreCase);
-		};
+	const double StartTime = FPlatformTime::Seconds();
+	const FUnrealGPTSceneSnapshot Snapshot = FUnrealGPTSceneSnapshot::Capture(World, CaptureFields, bIncludeUnloaded);
+	const double CaptureTime = FPlatformTime::Seconds();
 
-		if (!MatchesFilter(ClassName, ClassContains))
-		{
-			continue;
-		}
-		if (!MatchesFilter(Label, LabelContains))
-		{
-			continue;
-		}
-		if (!MatchesFilter(Name, NameContains))
-		{
-			continue;
-		}
+	// Filter in parallel; task results are merged in order, so loaded matches still page before unloaded ones
+	TBitArray<> DataLayerMatches(false, Snapshot.DataLayerNames.Num());
+	for (int32 Index = 0; Index < Snapshot.DataLayerNames.Num(); ++Index)
+	{
+		DataLayerMatches[Index] = UnrealGPTSceneQuery::Matches(Snapshot.DataLayerNames[Index], DataLayerContains);
+	}
+
+	const int32 NumTasks = FMath::DivideAndRoundUp(Snapshot.Num(), UnrealGPTSceneQuery::ActorsPerTask);
+	TArray<UnrealGPTSceneQuery::FTaskResult> TaskResults;
+	TaskResults.SetNum(NumTasks);
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		UnrealGPTSceneQuery::FTaskResult& TaskResult = TaskResults[TaskIndex];
+
+		// Class names repeat across thousands of actors; test each once per task
+		TMap<FName, bool> ClassMatches;
+		TMap<FName, bool> ComponentClassMatches;
 
-		// Optional component class filter
-		if (!ComponentClassContains.IsEmpty())
+		const int32 End = FMath::Min((TaskIndex + 1) * UnrealGPTSceneQuery::ActorsPerTask, Snapshot.Num());
+		for (int32 Index = TaskIndex * UnrealGPTSceneQuery::ActorsPerTask; Index < End; ++Index)
 		{
-			bool bHasMatchingComponent = false;
-			TArray<UActorComponent*> Components;
-			Actor->GetComponents(Components);
-			for (UActorComponent* Component : Components)
+			const FUnrealGPTActorRecord& Record = Snapshot.Actors[Index];
+
+			const bool* bClassMatches = ClassMatches.Find(Record.ClassName);
+			if (!bClassMatches)
 			{
-				if (Component && Component->GetClass()->GetName().Contains(ComponentClassContains, ESearchCase::IgnoreCase))
-				{
-					bHasMatchingComponent = true;
-					break;
-				}
+				bClassMatches = &ClassMatches.Add(Record.ClassName, UnrealGPTSceneQuery::Matches(Record.ClassName.ToString(), ClassContains));
 			}
-
-			if (!bHasMatchingComponent)
+			if (!*bClassMatches)
 			{
 				continue;
 			}
-		}
+			if (!UnrealGPTSceneQuery::Matches(Snapshot.Labels[Index], LabelContains))
+			{
+				continue;
+			}
+			if (!NameContains.IsEmpty() && !UnrealGPTSceneQuery::Matches(Record.Name.ToString(), NameContains))
+			{
+				continue;
+			}
+			if (!DataLayerContains.IsEmpty() && !Snapshot.GetDataLayers(Record).ContainsByPredicate([&](int32 DataLayer) { return DataLayerMatches[DataLayer]; }))
+			{
+				continue;
+			}
+
+			// Descriptors carry no components, so a component filter only matches loaded actors
+			if (!ComponentClassContains.IsEmpty())
+			{
+				const bool bHasMatchingComponent = Snapshot.GetComponentClasses(Record).ContainsByPredicate([&](const FName& ComponentClass)
+				{
+					const bool* bKnown = ComponentClassMatches.Find(ComponentClass);
+					return bKnown ? *bKnown : ComponentClassMatches.Add(ComponentClass, UnrealGPTSceneQuery::Matches(ComponentClass.ToString(), ComponentClassContains));
+				});
+				if (!bHasMatchingComponent)
+				{
+					continue;
+				}
+			}
 
-		// Actor matches all filters
-		MatchingActors.Add(Actor);
+			TaskResult.Matches.Add(Index);
+			TaskResult.ClassCounts.FindOrAdd(Record.ClassName)++;
+			TaskResult.NumUnloaded += Record.bLoaded ? 0 : 1;
+		}
+	});
 
-		// Count class occurrences for summary
-		int32& Count = ClassCounts.FindOrAdd(ClassName);
-		Count++;
+	TArray<int32> Matches;
+	TMap<FName, int32> ClassCounts;
+	int32 NumUnloadedMatched = 0;
+	for (const UnrealGPTSceneQuery::FTaskResult& TaskResult : TaskResults)
+	{
+		Matches.Append(TaskResult.Matches);
+		for (const TPair<FName, int32>& Pair : TaskResult.ClassCounts)
+		{
+			ClassCounts.FindOrAdd(Pair.Key) += Pair.Value;
+		}
+		NumUnloadedMatched += TaskResult.NumUnloaded;
 	}
 
-	const int32 TotalMatched = MatchingActors.Num();
+	const int32 TotalMatched = Matches.Num();
+
+	// Build top_classes (sorted by count, top 5); the summary is written before the actors
+	ClassCounts.ValueSort([](int32 A, int32 B) { return A > B; });
+	TArray<FString> TopClasses;
+	for (const auto& Pair : ClassCounts)
+	{
+		if (TopClasses.Num() >= 5) break;
+		TopClasses.Add(FString::Printf(TEXT("%s (%d)"), *Pair.Key.ToString(), Pair.Value));
+	}
 
-	// Second pass: build results for the requested page
-	TArray<TSharedPtr<FJsonValue>> ResultsArray;
 	const int32 StartIndex = FMath::Min(Offset, TotalMatched);
 	const int32 EndIndex = FMath::Min(Offset + MaxResults, TotalMatched);
+	const TArrayView<const int32> PageIndices = MakeArrayView(Matches).Slice(StartIndex, EndIndex - StartIndex);
 
-	for (int32 i = StartIndex; i < EndIndex; ++i)
-	{
-		AActor* Actor = MatchingActors[i];
-		const FString ClassName = Actor->GetClass()->GetName();
-		const FString Label = Actor->GetActorLabel();
-		const FString Id = Actor->GetName(); // Internal name is the stable unique identifier
-
-		// Build JSON object for this actor - minimal by default
-		TSharedPtr<FJsonObject> ActorJson = MakeShareable(new FJsonObject);
-		ActorJson->SetStringField(TEXT("id"), Id);       // Stable unique identifier
-		ActorJson->SetStringField(TEXT("label"), Label); // User-friendly display name
-		ActorJson->SetStringField(TEXT("class"), ClassName);
+	FString OutputString;
+	UnrealGPTSceneJson::ReserveOutput(OutputString, PageIndices.Num(),
+		(RequestedFields.Contains(TEXT("components")) || RequestedFields.Contains(TEXT("bounds"))) && !bTableFormat ? UnrealGPTSceneJson::EstimatedCharsPerActor : UnrealGPTSceneJson::EstimatedCharsPerCompactActor);
 
-		// Optional: location
-		if (bIncludeLocation)
+	// Shared by both formats; the table is written condensed, the JSON form keeps its pretty printing
+	auto WriteHeader = [&](auto& HeaderWriter)
+	{
+		HeaderWriter.WriteObjectStart();
+		HeaderWriter.WriteValue(TEXT("status"), FString(TEXT("ok")));  // Add status for agent executor compatibility
+
+		HeaderWriter.WriteObjectStart(TEXT("summary"));
+		HeaderWriter.WriteValue(TEXT("total_matched"), static_cast<double>(TotalMatched));
+		HeaderWriter.WriteValue(TEXT("returned"), static_cast<double>(EndIndex - StartIndex));
+		HeaderWriter.WriteValue(TEXT("offset"), static_cast<double>(Offset));
+		HeaderWriter.WriteValue(TEXT("has_more"), EndIndex < TotalMatched);
+		if (bPartitioned)
 		{
-			const FVector Location = Actor->GetActorLocation();
-			TSharedPtr<FJsonObject> LocationJson = MakeShareable(new FJsonObject);
-			LocationJson->SetNumberField(TEXT("x"), Location.X);
-			LocationJson->SetNumberField(TEXT("y"), Location.Y);
-			LocationJson->SetNumberField(TEXT("z"), Location.Z);
-			ActorJson->SetObjectField(TEXT("location"), LocationJson);
+			HeaderWriter.WriteValue(TEXT("unloaded_matched"), static_cast<double>(NumUnloadedMatched));
 		}
-
-		// Optional: rotation
-		if (bIncludeRotation)
+		if (bLoadMatches)
 		{
-			const FRotator Rotation = Actor->GetActorRotation();
-			TSharedPtr<FJsonObject> RotationJson = MakeShareable(new FJsonObject);
-			RotationJson->SetNumberField(TEXT("pitch"), Rotation.Pitch);
-			RotationJson->SetNumberField(TEXT("yaw"), Rotation.Yaw);
-			RotationJson->SetNumberField(TEXT("roll"), Rotation.Roll);
-			ActorJson->SetObjectField(TEXT("rotation"), RotationJson);
+			HeaderWriter.WriteValue(TEXT("loaded_on_demand"), static_cast<double>(LoadedOnDemand));
 		}
-
-		// Optional: scale
-		if (bIncludeScale)
+		HeaderWriter.WriteArrayStart(TEXT("top_classes"));
+		for (const FString& TopClass : TopClasses)
 		{
-			const FVector Scale = Actor->GetActorScale3D();
-			TSharedPtr<FJsonObject> ScaleJson = MakeShareable(new FJsonObject);
-			ScaleJson->SetNumberField(TEXT("x"), Scale.X);
-			ScaleJson->SetNumberField(TEXT("y"), Scale.Y);
-			ScaleJson->SetNumberField(TEXT("z"), Scale.Z);
-			ActorJson->SetObjectField(TEXT("scale"), ScaleJson);
+			HeaderWriter.WriteValue(TopClass);
 		}
+		HeaderWriter.WriteArrayEnd();
+		HeaderWriter.WriteObjectEnd();
+	};
 
-		// Optional: bounding box
-		if (bIncludeBounds)
+	if (bTableFormat)
+	{
+		const FUnrealGPTSceneTable Table = BuildActorTable(Snapshot, PageIndices, RequestedFields, Precision);
+
+		TSharedRef<FUnrealGPTSceneTable::FWriter> TableWriter = FUnrealGPTSceneTable::FWriterFactory::Create(&OutputString);
+		WriteHeader(*TableWriter);
+		Table.Write(*TableWriter);
+		TableWriter->WriteObjectEnd();
+		TableWriter->Close();
+	}
+	else
+	{
+		// Rows are serialized in parallel at the indentation they end up at, then spliced into the array
+		TArray<FString> Rows;
+		Rows.SetNum(PageIndices.Num());
+		ParallelFor(PageIndices.Num(), [&](int32 Row)
 		{
-			FVector Origin, Extent;
-			Actor->GetActorBounds(false, Origin, Extent);
+			TSharedRef<TJsonWriter<>> RowWriter = TJsonWriterFactory<>::Create(&Rows[Row], UnrealGPTSceneQuery::RowIndentLevel);
+			UnrealGPTSceneQuery::WriteActor(*RowWriter, Snapshot, PageIndices[Row], RequestedFields);
+			RowWriter->Close();
+		});
 
-			TSharedPtr<FJsonObject> BoundsJson = MakeShareable(new FJsonObject);
-			TSharedPtr<FJsonObject> OriginJson = MakeShareable(new FJsonObject);
-			OriginJson->SetNumberField(TEXT("x"), Origin.X);
-			OriginJson->SetNumberField(TEXT("y"), Origin.Y);
-			OriginJson->SetNumberField(TEXT("z"), Origin.Z);
-			BoundsJson->SetObjectField(TEXT("origin"), OriginJson);
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+		WriteHeader(*Writer);
+		Writer->WriteArrayStart(TEXT("actors"));
+		for (const FString& Row : Rows)
+		{
+			Writer->WriteRawJSONValue(Row);
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+	}
 
-			TSharedPtr<FJsonObject> ExtentJson = MakeShareable(new FJsonObject);
-			ExtentJson->SetNumberField(TEXT("x"), Extent.X);
-			ExtentJson->SetNumberField(TEXT("y"), Extent.Y);
-			ExtentJson->SetNumberField(TEXT("z"), Extent.Z);
-			BoundsJson->SetObjectField(TEXT("extent"), ExtentJson);
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: scene_query over %d actors: capture %.1f ms, filter and serialize %.1f ms"),
+		Snapshot.Num(), (CaptureTime - StartTime) * 1000.0, (FPlatformTime::Seconds() - CaptureTime) * 1000.0);
+	return OutputString;
+}
 
-			ActorJson->SetObjectField(TEXT("bounds"), BoundsJson);
-		}
+FUnrealGPTSceneTable UUnrealGPTSceneContext::BuildActorTable(const FUnrealGPTSceneSnapshot& Snapshot, TArrayView<const int32> Indices, const TSet<FString>& Fields, int32 Precision)
+{
+	const bool bIncludeLocation = Fields.Contains(TEXT("location"));
+	const bool bIncludeRotation = Fields.Contains(TEXT("rotation"));
+	const bool bIncludeScale = Fields.Contains(TEXT("scale"));
+	const bool bIncludeBounds = Fields.Contains(TEXT("bounds"));
+	const bool bIncludeComponents = Fields.Contains(TEXT("components"));
+	const bool bIncludeTags = Fields.Contains(TEXT("tags"));
+	const bool bIncludeFolder = Fields.Contains(TEXT("folder"));
+	const bool bIncludeParent = Fields.Contains(TEXT("parent"));
+	const bool bIncludeDataLayers = Fields.Contains(TEXT("data_layers"));
+	const bool bHasUnloaded = Indices.ContainsByPredicate([&Snapshot](int32 Index) { return !Snapshot.Actors[Index].bLoaded; });
+
+	// Same order as the fields of the JSON format; "@" columns hold legend indices
+	TArray<FString> Columns = { TEXT("id"), TEXT("label") };
+	if (bIncludeLocation)
+	{
+		Columns.Append({ TEXT("x"), TEXT("y"), TEXT("z") });
+	}
+	if (bIncludeRotation)
+	{
+		Columns.Append({ TEXT("pitch"), TEXT("yaw"), TEXT("roll") });
+	}
+	if (bIncludeScale)
+	{
+		Columns.Append({ TEXT("sx"), TEXT("sy"), TEXT("sz") });
+	}
+	if (bIncludeBounds)
+	{
+		Columns.Append({ TEXT("bx"), TEXT("by"), TEXT("bz"), TEXT("ex"), TEXT("ey"), TEXT("ez") });
+	}
+	if (bIncludeComponents)
+	{
+		Columns.Append({ TEXT("root@"), TEXT("mobility"), TEXT("mesh@") });
+	}
+	if (bIncludeTags)
+	{
+		Columns.Add(TEXT("tags"));
+	}
+	if (bIncludeFolder)
+	{
+		Columns.Add(TEXT("folder"));
+	}
+	if (bIncludeParent)
+	{
+		Columns.Add(TEXT("parent"));
+	}
+	if (bIncludeDataLayers)
+	{
+		Columns.Add(TEXT("layers"));
+	}
+	if (bHasUnloaded)
+	{
+		Columns.Add(TEXT("loaded"));
+	}
 
-		// Optional: root component info and static mesh path
-		if (bIncludeComponents)
+	FUnrealGPTSceneTable Table(Columns, Precision);
+	for (const int32 Index : Indices)
+	{
+		const FUnrealGPTActorRecord& Record = Snapshot.Actors[Index];
+		Table.BeginRow(Record.ClassName.ToString());
+		Table.AddCell(Record.Name.ToString());
+		Table.AddCell(Snapshot.Labels[Index]);
+
+		// Descriptors store no transform or components; their cells stay empty and the bounds center stands in for the location
+		const int32 NumEmpty = (bIncludeRotation ? 3 : 0) + (bIncludeScale ? 3 : 0);
+		auto AddEmptyCells = [&Table](int32 Count)
 		{
-			USceneComponent* RootComp = Actor->GetRootComponent();
-			if (RootComp)
+			for (int32 Cell = 0; Cell < Count; ++Cell)
 			{
-				TSharedPtr<FJsonObject> RootCompJson = MakeShareable(new FJsonObject);
-				RootCompJson->SetStringField(TEXT("class"), RootComp->GetClass()->GetName());
+				Table.AddCell(FString());
+			}
+		};
 
-				// Mobility
-				FString MobilityStr;
-				switch (RootComp->Mobility)
-				{
-					case EComponentMobility::Static: MobilityStr = TEXT("Static"); break;
-					case EComponentMobility::Stationary: MobilityStr = TEXT("Stationary"); break;
-					case EComponentMobility::Movable: MobilityStr = TEXT("Movable"); break;
-					default: MobilityStr = TEXT("Unknown"); break;
-				}
-				RootCompJson->SetStringField(TEXT("mobility"), MobilityStr);
+		if (bIncludeLocation)
+		{
+			if (Record.bLoaded || Record.Bounds.IsValid)
+			{
+				Table.AddVector(Record.Location);
+			}
+			else
+			{
+				AddEmptyCells(3);
+			}
+		}
 
-				ActorJson->SetObjectField(TEXT("root_component"), RootCompJson);
+		if (!Record.bLoaded)
+		{
+			AddEmptyCells(NumEmpty);
+		}
+		else
+		{
+			if (bIncludeRotation)
+			{
+				Table.AddNumber(Record.Rotation.Pitch);
+				Table.AddNumber(Record.Rotation.Yaw);
+				Table.AddNumber(Record.Rotation.Roll);
 			}
 
-			// Look for StaticMeshComponent and get mesh asset path
-			TArray<UActorComponent*> Components;
-			Actor->GetComponents(Components);
-			for (UActorComponent* Component : Components)
+			if (bIncludeScale)
 			{
-				if (UStaticMeshComponent* SMC = Cast<UStaticMeshComponent>(Component))
-				{
-					if (UStaticMesh* Mesh = SMC->GetStaticMesh())
-					{
-						ActorJson->SetStringField(TEXT("static_mesh_path"), Mesh->GetPathName());
-						break; // Just get the first one
-					}
-				}
+				Table.AddVector(Record.Scale);
 			}
 		}
 
-		// Optional: tags
+		if (bIncludeBounds)
+		{
+			if (Record.Bounds.IsValid)
+			{
+				Table.AddVector(Record.Bounds.GetCenter());
+				Table.AddVector(Record.Bounds.GetExtent());
+			}
+			else if (Record.bLoaded)
+			{
+				Table.AddVector(Record.Location);
+				Table.AddVector(FVector::ZeroVector);
+			}
+			else
+			{
+				AddEmptyCells(6);
+			}
+		}
+
+		if (bIncludeComponents)
+		{
+			Table.AddInterned(Record.RootClassName.IsNone() ? FString() : Record.RootClassName.ToString());
+			Table.AddCell(Record.RootClassName.IsNone() ? FString() : UnrealGPTSceneJson::MobilityToString(static_cast<EComponentMobility::Type>(Record.Mobility)));
+			Table.AddInterned(Record.MeshPath.IsValid() ? Record.MeshPath.ToString() : FString());
+		}
+
 		if (bIncludeTags)
 		{
-			TArray<TSharedPtr<FJsonValue>> TagsArray;
-			for (const FName& Tag : Actor->Tags)
+			TArray<FString> Tags;
+			for (const int32 Tag : Snapshot.GetTags(Record))
 			{
-				TagsArray.Add(MakeShareable(new FJsonValueString(Tag.ToString())));
+				Tags.Add(Snapshot.TagNames[Tag].ToString());
 			}
-			ActorJson->SetArrayField(TEXT("tags"), TagsArray);
+			Table.AddCell(FString::Join(Tags, TEXT(";")));
 		}
 
-		// Optional: folder path
 		if (bIncludeFolder)
 		{
-			ActorJson->SetStringField(TEXT("folder_path"), Actor->GetFolderPath().ToString());
+			Table.AddCell(Record.bLoaded ? Record.FolderPath.ToString() : FString());
 		}
 
-		// Optional: parent attachment
 		if (bIncludeParent)
 		{
-			if (AActor* ParentActor = Actor->GetAttachParentActor())
+			Table.AddCell(Record.ParentIndex != INDEX_NONE ? Snapshot.Labels[Record.ParentIndex] : FString());
+		}
+
+		if (bIncludeDataLayers)
+		{
+			TArray<FString> DataLayers;
+			for (const int32 DataLayer : Snapshot.GetDataLayers(Record))
 			{
-				ActorJson->SetStringField(TEXT("parent_actor"), ParentActor->GetActorLabel());
+				DataLayers.Add(Snapshot.DataLayerNames[DataLayer]);
 			}
+			Table.AddCell(FString::Join(DataLayers, TEXT(";")));
 		}
 
-		ResultsArray.Add(MakeShareable(new FJsonValueObject(ActorJson)));
-	}
-
-	// Build top_classes array (sorted by count, top 5)
-	ClassCounts.ValueSort([](int32 A, int32 B) { return A > B; });
-	TArray<TSharedPtr<FJsonValue>> TopClassesArray;
-	int32 ClassIndex = 0;
-	for (const auto& Pair : ClassCounts)
-	{
-		if (ClassIndex >= 5) break;
-		TopClassesArray.Add(MakeShareable(new FJsonValueString(FString::Printf(TEXT("%s (%d)"), *Pair.Key, Pair.Value))));
-		ClassIndex++;
+		if (bHasUnloaded)
+		{
+			Table.AddCell(Record.bLoaded ? TEXT("1") : TEXT("0"));
+		}
 	}
 
-	// Build summary object
-	TSharedPtr<FJsonObject> SummaryObj = MakeShareable(new FJsonObject);
-	SummaryObj->SetNumberField(TEXT("total_matched"), TotalMatched);
-	SummaryObj->SetNumberField(TEXT("returned"), ResultsArray.Num());
-	SummaryObj->SetNumberField(TEXT("offset"), Offset);
-	SummaryObj->SetBoolField(TEXT("has_more"), EndIndex < TotalMatched);
-	SummaryObj->SetArrayField(TEXT("top_classes"), TopClassesArray);
-
-	// Build final result object
-	TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject);
-	ResultObj->SetStringField(TEXT("status"), TEXT("ok"));  // Add status for agent executor compatibility
-	ResultObj->SetObjectField(TEXT("summary"), SummaryObj);
-	ResultObj->SetArrayField(TEXT("actors"), ResultsArray);
-
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(ResultObj.ToSharedRef(), Writer);
-	return OutputString;
+	return Table;
 }
 
 FString UUnrealGPTSceneContext::GetSelectedActorsSummary()
@@ -842,99 +1266,67 @@ FString UUnrealGPTSceneContext::GetSelectedActorsSummary()
 	TArray<AActor*> SelectedActors;
 	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(SelectedActors);
 
-	TArray<TSharedPtr<FJsonValue>> ActorsArray;
+	FString OutputString;
+	UnrealGPTSceneJson::ReserveOutput(OutputString, SelectedActors.Num(), UnrealGPTSceneJson::EstimatedCharsPerActor);
 
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("selected_count"), static_cast<double>(SelectedActors.Num()));
+	Writer->WriteArrayStart(TEXT("actors"));
 	for (AActor* Actor : SelectedActors)
 	{
 		if (Actor && !Actor->IsPendingKillPending())
 		{
-			TSharedPtr<FJsonObject> ActorJson = SerializeActor(Actor);
-			if (ActorJson.IsValid())
-			{
-				ActorsArray.Add(MakeShareable(new FJsonValueObject(ActorJson)));
-			}
+			SerializeActor(*Writer, Actor);
 		}
 	}
-
-	TSharedPtr<FJsonObject> SummaryJson = MakeShareable(new FJsonObject);
-	SummaryJson->SetNumberField(TEXT("selected_count"), SelectedActors.Num());
-	SummaryJson->SetArrayField(TEXT("actors"), ActorsArray);
-
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(SummaryJson.ToSharedRef(), Writer);
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
 
 	return OutputString;
 }
 
-TSharedPtr<FJsonObject> UUnrealGPTSceneContext::SerializeActor(AActor* Actor)
+void UUnrealGPTSceneContext::SerializeActor(TJsonWriter<>& Writer, AActor* Actor)
 {
 	if (!Actor)
 	{
-		return nullptr;
+		return;
 	}
 
-	TSharedPtr<FJsonObject> ActorJson = MakeShareable(new FJsonObject);
-	
-	ActorJson->SetStringField(TEXT("name"), Actor->GetName());
-	ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
-	ActorJson->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("name"), Actor->GetName());
+	Writer.WriteValue(TEXT("label"), Actor->GetActorLabel());
+	Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetName());
 
 	// Transform
-	FTransform Transform = Actor->GetActorTransform();
-	TSharedPtr<FJsonObject> LocationJson = MakeShareable(new FJsonObject);
-	LocationJson->SetNumberField(TEXT("x"), Transform.GetLocation().X);
-	LocationJson->SetNumberField(TEXT("y"), Transform.GetLocation().Y);
-	LocationJson->SetNumberField(TEXT("z"), Transform.GetLocation().Z);
-	ActorJson->SetObjectField(TEXT("location"), LocationJson);
-
-	TSharedPtr<FJsonObject> RotationJson = MakeShareable(new FJsonObject);
-	FRotator Rotation = Transform.GetRotation().Rotator();
-	RotationJson->SetNumberField(TEXT("pitch"), Rotation.Pitch);
-	RotationJson->SetNumberField(TEXT("yaw"), Rotation.Yaw);
-	RotationJson->SetNumberField(TEXT("roll"), Rotation.Roll);
-	ActorJson->SetObjectField(TEXT("rotation"), RotationJson);
-
-	TSharedPtr<FJsonObject> ScaleJson = MakeShareable(new FJsonObject);
-	FVector Scale = Transform.GetScale3D();
-	ScaleJson->SetNumberField(TEXT("x"), Scale.X);
-	ScaleJson->SetNumberField(TEXT("y"), Scale.Y);
-	ScaleJson->SetNumberField(TEXT("z"), Scale.Z);
-	ActorJson->SetObjectField(TEXT("scale"), ScaleJson);
+	const FTransform& Transform = Actor->GetActorTransform();
+	UnrealGPTSceneJson::WriteXYZ(Writer, TEXT("location"), Transform.GetLocation());
+	UnrealGPTSceneJson::WriteRotation(Writer, TEXT("rotation"), Transform.GetRotation().Rotator());
+	UnrealGPTSceneJson::WriteXYZ(Writer, TEXT("scale"), Transform.GetScale3D());
 
 	// Components
-	TArray<UActorComponent*> Components;
-	Actor->GetComponents(Components);
-
-	TArray<TSharedPtr<FJsonValue>> ComponentsArray;
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+	Writer.WriteArrayStart(TEXT("components"));
 	for (UActorComponent* Component : Components)
 	{
-		if (Component)
-		{
-			TSharedPtr<FJsonObject> ComponentJson = SerializeComponent(Component);
-			if (ComponentJson.IsValid())
-			{
-				ComponentsArray.Add(MakeShareable(new FJsonValueObject(ComponentJson)));
-			}
-		}
+		SerializeComponent(Writer, Component);
 	}
-	ActorJson->SetArrayField(TEXT("components"), ComponentsArray);
+	Writer.WriteArrayEnd();
 
-	return ActorJson;
+	Writer.WriteObjectEnd();
 }
 
-TSharedPtr<FJsonObject> UUnrealGPTSceneContext::SerializeComponent(UActorComponent* Component)
+void UUnrealGPTSceneContext::SerializeComponent(TJsonWriter<>& Writer, UActorComponent* Component)
 {
 	if (!Component)
 	{
-		return nullptr;
+		return;
 	}
 
-	TSharedPtr<FJsonObject> ComponentJson = MakeShareable(new FJsonObject);
-	ComponentJson->SetStringField(TEXT("name"), Component->GetName());
-	ComponentJson->SetStringField(TEXT("class"), Component->GetClass()->GetName());
-	ComponentJson->SetBoolField(TEXT("is_active"), Component->IsActive());
-
-	return ComponentJson;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("name"), Component->GetName());
+	Writer.WriteValue(TEXT("class"), Component->GetClass()->GetName());
+	Writer.WriteValue(TEXT("is_active"), Component->IsActive());
+	Writer.WriteObjectEnd();
 }
-
@@ -3,8 +3,12 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Engine/World.h"
+#include "Serialization/JsonWriter.h"
+#include "UnrealGPTSceneTable.h"
 #include "UnrealGPTSceneContext.generated.h"
 
+struct FUnrealGPTSceneSnapshot;
+
 UCLASS()
 class UNREALGPTEDITOR_API UUnrealGPTSceneContext : public UObject
 {
@@ -28,8 +32,14 @@ public:
 	/** Get a JSON summary of the current scene */
 	static FString GetSceneSummary(int32 PageSize = 100, int32 PageIndex = 0);
 
-	/** Get a compact JSON summary of the current scene (no component details, just actor names/classes/locations) */
-	static FString GetCompactSceneSummary(int32 MaxActors = 50);
+	/** GetSceneSummary for a given world rather than the editor world (e.g. a transient benchmark world) */
+	static FString GetSceneSummaryForWorld(UWorld* World, int32 PageSize, int32 PageIndex);
+
+	/**
+	 * Get a compact JSON summary of the current scene (no component details, just actor names/classes/locations)
+	 * @param bTableFormat - Encode the actors as an FUnrealGPTSceneTable instead of an array of objects
+	 */
+	static FString GetCompactSceneSummary(int32 MaxActors = 50, bool bTableFormat = false);
 
 	/** Generic scene query: filters actors/components based on simple criteria.
 	 *  ArgumentsJson is a JSON object with optional fields like:
@@ -37,7 +47,12 @@ public:
 	 *    - label_contains: substring to match in Actor label
 	 *    - name_contains: substring to match in Actor name
 	 *    - component_class_contains: substring to match in component class names
+	 *    - data_layer_contains: substring to match in the actor's data layer names
+	 *    - include_unloaded: also match unloaded World Partition actors by their descriptors (default true)
+	 *    - load: load the matched unloaded actors (at most FUnrealGPTWorldPartition::MaxLoadPerQuery)
 	 *    - max_results: maximum number of results to return (default 20)
+	 *    - format: "table" for the compact FUnrealGPTSceneTable encoding instead of an object per actor
+	 *    - precision: decimals kept by the table format (default: Scene Table Precision setting)
 	 */
 	static FString QueryScene(const FString& ArgumentsJson);
 
@@ -48,10 +63,16 @@ private:
 	/** Capture viewport using Slate rendering */
 	static bool CaptureViewportToImage(TArray<uint8>& OutImageData, int32& OutWidth, int32& OutHeight);
 
-	/** Serialize actor to JSON */
-	static TSharedPtr<FJsonObject> SerializeActor(AActor* Actor);
+	/** Write an actor as the next JSON object in Writer; nothing for a null actor */
+	static void SerializeActor(TJsonWriter<>& Writer, AActor* Actor);
+
+	/**
+	 * Encode the snapshot actors at Indices as table rows with the columns for the requested scene_query fields.
+	 * Unloaded actors leave the fields they lack empty, and add a trailing "loaded" column.
+	 */
+	static FUnrealGPTSceneTable BuildActorTable(const FUnrealGPTSceneSnapshot& Snapshot, TArrayView<const int32> Indices, const TSet<FString>& Fields, int32 Precision);
 
-	/** Serialize component to JSON */
-	static TSharedPtr<FJsonObject> SerializeComponent(UActorComponent* Component);
+	/** Write a component as the next JSON object in Writer; nothing for a null component */
+	static void SerializeComponent(TJsonWriter<>& Writer, UActorComponent* Component);
 };
 
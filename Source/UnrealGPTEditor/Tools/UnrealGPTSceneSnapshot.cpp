@@ -0,0 +1,206 @@
+#include "UnrealGPTSceneSnapshot.h"
+#include "UnrealGPTWorldPartition.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/StaticMesh.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Components/StaticMeshComponent.h"
+
+namespace UnrealGPTSceneSnapshot
+{
+	/** Index of Value in Names, adding it on first use */
+	template <typename NameType>
+	static int32 Intern(const NameType& Value, TArray<NameType>& Names, TMap<NameType, int32>& Indices)
+	{
+		if (const int32* Known = Indices.Find(Value))
+		{
+			return *Known;
+		}
+		const int32 Index = Names.Add(Value);
+		Indices.Add(Value, Index);
+		return Index;
+	}
+}
+
+FUnrealGPTSceneSnapshot FUnrealGPTSceneSnapshot::Capture(UWorld* World, EUnrealGPTSnapshotFields InFields, bool bIncludeUnloaded, int32 MaxActors)
+{
+	using namespace UnrealGPTSceneSnapshot;
+
+	FUnrealGPTSceneSnapshot Snapshot;
+	Snapshot.Fields = InFields;
+	if (!World)
+	{
+		return Snapshot;
+	}
+
+	const bool bRotation = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::Rotation);
+	const bool bScale = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::Scale);
+	const bool bBounds = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::Bounds);
+	const bool bComponents = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::Components);
+	const bool bComponentClasses = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::ComponentClasses);
+	const bool bTags = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::Tags);
+	const bool bFolder = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::Folder);
+	const bool bParent = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::Parent);
+	const bool bDataLayers = EnumHasAnyFlags(InFields, EUnrealGPTSnapshotFields::DataLayers);
+
+	MaxActors = FMath::Max(0, MaxActors);
+	const int32 ExpectedActors = FMath::Min(MaxActors, World->PersistentLevel ? World->PersistentLevel->Actors.Num() : 0);
+	Snapshot.Actors.Reserve(ExpectedActors);
+	Snapshot.Labels.Reserve(ExpectedActors);
+
+	TMap<FName, int32> TagLookup;
+	TMap<FString, int32> DataLayerLookup;
+
+	// Parents are resolved to indices once every actor has one
+	TMap<const AActor*, int32> ActorIndices;
+	TArray<const AActor*> Parents;
+
+	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	{
+		AActor* Actor = *ActorItr;
+		if (!Actor || Actor->IsPendingKillPending())
+		{
+			continue;
+		}
+
+		// Labels are copied strings, so actors past the limit are only counted
+		++Snapshot.TotalActors;
+		if (Snapshot.Actors.Num() >= MaxActors)
+		{
+			continue;
+		}
+
+		FUnrealGPTActorRecord& Record = Snapshot.Actors.AddDefaulted_GetRef();
+		Record.Name = Actor->GetFName();
+		Record.ClassName = Actor->GetClass()->GetFName();
+		Record.Location = Actor->GetActorLocation();
+
+		if (bRotation)
+		{
+			Record.Rotation = Actor->GetActorRotation();
+		}
+
+		if (bScale)
+		{
+			Record.Scale = Actor->GetActorScale3D();
+		}
+
+		if (bBounds)
+		{
+			FVector Origin, Extent;
+			Actor->GetActorBounds(false, Origin, Extent);
+			if (!Extent.IsNearlyZero())
+			{
+				Record.Bounds = FBox(Origin - Extent, Origin + Extent);
+			}
+		}
+
+		if (bComponents)
+		{
+			if (const USceneComponent* RootComp = Actor->GetRootComponent())
+			{
+				Record.RootClassName = RootComp->GetClass()->GetFName();
+				Record.Mobility = RootComp->Mobility;
+			}
+
+			TInlineComponentArray<UStaticMeshComponent*> MeshComponents(Actor);
+			for (const UStaticMeshComponent* SMC : MeshComponents)
+			{
+				if (const UStaticMesh* Mesh = SMC ? SMC->GetStaticMesh() : nullptr)
+				{
+					Record.MeshPath = FSoftObjectPath(Mesh);
+					break;
+				}
+			}
+		}
+
+		if (bComponentClasses)
+		{
+			Record.ComponentClasses.First = Snapshot.ComponentClassNames.Num();
+			for (const UActorComponent* Component : Actor->GetComponents())
+			{
+				if (Component)
+				{
+					Snapshot.ComponentClassNames.Add(Component->GetClass()->GetFName());
+				}
+			}
+			Record.ComponentClasses.Num = Snapshot.ComponentClassNames.Num() - Record.ComponentClasses.First;
+		}
+
+		if (bTags)
+		{
+			Record.Tags.First = Snapshot.TagIndices.Num();
+			for (const FName& Tag : Actor->Tags)
+			{
+				Snapshot.TagIndices.Add(Intern(Tag, Snapshot.TagNames, TagLookup));
+			}
+			Record.Tags.Num = Actor->Tags.Num();
+		}
+
+		if (bFolder)
+		{
+			Record.FolderPath = Actor->GetFolderPath();
+		}
+
+		if (bParent)
+		{
+			ActorIndices.Add(Actor, Snapshot.Actors.Num() - 1);
+			Parents.Add(Actor->GetAttachParentActor());
+		}
+
+		if (bDataLayers)
+		{
+			Record.DataLayers.First = Snapshot.DataLayerIndices.Num();
+			for (const FString& DataLayer : FUnrealGPTWorldPartition::GetDataLayers(Actor))
+			{
+				Snapshot.DataLayerIndices.Add(Intern(DataLayer, Snapshot.DataLayerNames, DataLayerLookup));
+			}
+			Record.DataLayers.Num = Snapshot.DataLayerIndices.Num() - Record.DataLayers.First;
+		}
+
+		Snapshot.Labels.Add(Actor->GetActorLabel());
+	}
+
+	for (int32 Index = 0; Index < Parents.Num(); ++Index)
+	{
+		if (const int32* ParentIndex = Parents[Index] ? ActorIndices.Find(Parents[Index]) : nullptr)
+		{
+			Snapshot.Actors[Index].ParentIndex = *ParentIndex;
+		}
+	}
+
+	if (bIncludeUnloaded)
+	{
+		TArray<FUnrealGPTActorDesc> Unloaded;
+		FUnrealGPTWorldPartition::GetUnloadedActors(World, Unloaded);
+		Snapshot.TotalActors += Unloaded.Num();
+		Unloaded.SetNum(FMath::Min(Unloaded.Num(), MaxActors - Snapshot.Actors.Num()));
+		Snapshot.Actors.Reserve(Snapshot.Actors.Num() + Unloaded.Num());
+		Snapshot.Labels.Reserve(Snapshot.Labels.Num() + Unloaded.Num());
+
+		for (FUnrealGPTActorDesc& Desc : Unloaded)
+		{
+			FUnrealGPTActorRecord& Record = Snapshot.Actors.AddDefaulted_GetRef();
+			Record.Name = Desc.Name;
+			Record.ClassName = Desc.ClassName;
+			Record.Bounds = Desc.Bounds;
+			Record.Location = Desc.Bounds.IsValid ? Desc.Bounds.GetCenter() : FVector::ZeroVector;
+			Record.bLoaded = false;
+
+			if (bDataLayers)
+			{
+				Record.DataLayers.First = Snapshot.DataLayerIndices.Num();
+				for (const FString& DataLayer : Desc.DataLayers)
+				{
+					Snapshot.DataLayerIndices.Add(Intern(DataLayer, Snapshot.DataLayerNames, DataLayerLookup));
+				}
+				Record.DataLayers.Num = Desc.DataLayers.Num();
+			}
+
+			Snapshot.Labels.Add(MoveTemp(Desc.Label));
+		}
+	}
+
+	return Snapshot;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class UWorld;
+
+/** Optional parts of an actor a snapshot copies; the name, class, location and label are always copied */
+enum class EUnrealGPTSnapshotFields : uint16
+{
+	None = 0,
+	Rotation = 1 << 0,
+	Scale = 1 << 1,
+	Bounds = 1 << 2,
+
+	/** Root component class and mobility, first static mesh */
+	Components = 1 << 3,
+
+	/** Classes of every component, for component filters */
+	ComponentClasses = 1 << 4,
+	Tags = 1 << 5,
+	Folder = 1 << 6,
+	Parent = 1 << 7,
+	DataLayers = 1 << 8,
+};
+ENUM_CLASS_FLAGS(EUnrealGPTSnapshotFields);
+
+/** Slice of one of the shared index arrays of a snapshot */
+struct FUnrealGPTSnapshotRange
+{
+	int32 First = 0;
+	int32 Num = 0;
+};
+
+/** Plain copy of the actor fields scene tools aggregate over; safe to read from any thread */
+struct FUnrealGPTActorRecord
+{
+	/** Actor->GetName(), the id used by the other tools */
+	FName Name;
+	FName ClassName;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FVector Scale = FVector::OneVector;
+
+	/** Bounds of all components, colliding or not; invalid for actors without any */
+	FBox Bounds = FBox(ForceInit);
+
+	/** Root component class (none without a root) and its EComponentMobility */
+	FName RootClassName;
+	uint8 Mobility = 0;
+
+	/** First static mesh of the actor, as a path so workers never touch the UObject */
+	FSoftObjectPath MeshPath;
+
+	FName FolderPath;
+
+	/** Index of the attach parent in the snapshot, or INDEX_NONE */
+	int32 ParentIndex = INDEX_NONE;
+
+	/** Into FUnrealGPTSceneSnapshot::TagIndices, ComponentClassNames and DataLayerIndices */
+	FUnrealGPTSnapshotRange Tags;
+	FUnrealGPTSnapshotRange ComponentClasses;
+	FUnrealGPTSnapshotRange DataLayers;
+
+	/** False for unloaded World Partition actors, whose location is their bounds center */
+	bool bLoaded = true;
+};
+
+/**
+ * Snapshot of the actors of a world, taken on the game thread in one pass that only copies
+ * fields. Everything after the capture (filtering, bucketing, sorting, counting, serializing)
+ * works on the snapshot and can run on worker threads.
+ */
+struct UNREALGPTEDITOR_API FUnrealGPTSceneSnapshot
+{
+	TArray<FUnrealGPTActorRecord> Actors;
+
+	/** Outliner labels, parallel to Actors; kept apart so the records stay trivially copyable */
+	TArray<FString> Labels;
+
+	/** Distinct tags, and the per-actor lists of indices into them */
+	TArray<FName> TagNames;
+	TArray<int32> TagIndices;
+
+	/** Component classes of each actor, one after the other */
+	TArray<FName> ComponentClassNames;
+
+	/** Distinct data layer short names, and the per-actor lists of indices into them */
+	TArray<FString> DataLayerNames;
+	TArray<int32> DataLayerIndices;
+
+	/** Fields that were captured */
+	EUnrealGPTSnapshotFields Fields = EUnrealGPTSnapshotFields::None;
+
+	/** Actors found, including the ones past MaxActors that were only counted */
+	int32 TotalActors = 0;
+
+	/**
+	 * Copy every live actor of World. Game thread only.
+	 * @param InFields - Optional parts to copy besides the name, class, location and label
+	 * @param bIncludeUnloaded - Also record the unloaded actors of a World Partition map, from their descriptors
+	 * @param MaxActors - Copy only the first MaxActors actors and count the rest in TotalActors
+	 */
+	static FUnrealGPTSceneSnapshot Capture(UWorld* World, EUnrealGPTSnapshotFields InFields = EUnrealGPTSnapshotFields::Bounds,
+		bool bIncludeUnloaded = false, int32 MaxActors = MAX_int32);
+
+	int32 Num() const { return Actors.Num(); }
+
+	TArrayView<const int32> GetTags(const FUnrealGPTActorRecord& Record) const { return MakeArrayView(TagIndices).Slice(Record.Tags.First, Record.Tags.Num); }
+	TArrayView<const FName> GetComponentClasses(const FUnrealGPTActorRecord& Record) const { return MakeArrayView(ComponentClassNames).Slice(Record.ComponentClasses.First, Record.ComponentClasses.Num); }
+	TArrayView<const int32> GetDataLayers(const FUnrealGPTActorRecord& Record) const { return MakeArrayView(DataLayerIndices).Slice(Record.DataLayers.First, Record.DataLayers.Num); }
+};
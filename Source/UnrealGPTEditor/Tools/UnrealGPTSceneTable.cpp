@@ -0,0 +1,132 @@
+#include "UnrealGPTSceneTable.h"
+#include "UnrealGPTSettings.h"
+
+namespace UnrealGPTSceneTableFormat
+{
+	static const int32 MaxPrecision = 6;
+}
+
+FUnrealGPTSceneTable::FUnrealGPTSceneTable(const TArray<FString>& InColumns, int32 InPrecision)
+	: Columns(InColumns)
+	, Precision(FMath::Clamp(InPrecision, 0, UnrealGPTSceneTableFormat::MaxPrecision))
+{
+}
+
+void FUnrealGPTSceneTable::BeginRow(const FString& ClassName)
+{
+	const int32 ClassIndex = Intern(ClassName);
+
+	// Consecutive actors of the same class share a group
+	if (Groups.Num() == 0 || Groups.Last().ClassIndex != ClassIndex)
+	{
+		FGroup& Group = Groups.AddDefaulted_GetRef();
+		Group.ClassIndex = ClassIndex;
+	}
+
+	Groups.Last().Rows.AddDefaulted();
+	bRowHasCells = false;
+	RowCount++;
+}
+
+void FUnrealGPTSceneTable::AddCell(const FString& Value)
+{
+	AppendSeparator();
+
+	FString& Row = Groups.Last().Rows.Last();
+	for (const TCHAR Char : Value)
+	{
+		// Backslashes are escaped too, so a value ending in "\" cannot escape the separator after it
+		if (Char == TEXT('\\'))
+		{
+			Row += TEXT("\\\\");
+		}
+		else if (Char == TEXT('|'))
+		{
+			Row += TEXT("\\|");
+		}
+		else if (Char == TEXT('\n') || Char == TEXT('\r'))
+		{
+			Row += TEXT(' ');
+		}
+		else
+		{
+			Row += Char;
+		}
+	}
+}
+
+void FUnrealGPTSceneTable::AddNumber(double Value)
+{
+	AppendSeparator();
+	Groups.Last().Rows.Last() += FormatNumber(Value, Precision);
+}
+
+void FUnrealGPTSceneTable::AddVector(const FVector& Value)
+{
+	AddNumber(Value.X);
+	AddNumber(Value.Y);
+	AddNumber(Value.Z);
+}
+
+void FUnrealGPTSceneTable::AddInterned(const FString& Value)
+{
+	AppendSeparator();
+	if (!Value.IsEmpty())
+	{
+		Groups.Last().Rows.Last().AppendInt(Intern(Value));
+	}
+}
+
+FString FUnrealGPTSceneTable::FormatNumber(double Value, int32 Precision)
+{
+	Precision = FMath::Clamp(Precision, 0, UnrealGPTSceneTableFormat::MaxPrecision);
+
+	FString Text = FString::Printf(TEXT("%.*f"), Precision, Value);
+	if (Precision > 0)
+	{
+		int32 End = Text.Len();
+		while (End > 0 && Text[End - 1] == TEXT('0'))
+		{
+			End--;
+		}
+		if (End > 0 && Text[End - 1] == TEXT('.'))
+		{
+			End--;
+		}
+		Text.LeftInline(End);
+	}
+
+	// Small negatives round to "-0"
+	if (Text == TEXT("-0"))
+	{
+		Text = TEXT("0");
+	}
+	return Text;
+}
+
+int32 FUnrealGPTSceneTable::GetDefaultPrecision()
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	return Settings ? Settings->SceneTablePrecision : 1;
+}
+
+int32 FUnrealGPTSceneTable::Intern(const FString& Value)
+{
+	if (const int32* Existing = LegendIndices.Find(Value))
+	{
+		return *Existing;
+	}
+
+	const int32 Index = Legend.Add(Value);
+	LegendIndices.Add(Value, Index);
+	return Index;
+}
+
+void FUnrealGPTSceneTable::AppendSeparator()
+{
+	if (bRowHasCells)
+	{
+		Groups.Last().Rows.Last() += TEXT('|');
+	}
+	bRowHasCells = true;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Token-efficient encoding of actor lists for scene_query (format "table") and the context summary.
+ *
+ * Instead of one JSON object per actor, rows are "|"-separated strings under a single header of
+ * column names. Class names (and any column whose name ends in "@") are interned into a legend
+ * and referenced by index, numbers are rounded to a fixed number of decimals, and consecutive
+ * actors of the same class share one group so the class is written once per run:
+ *
+ *   "format": "table",
+ *   "columns": ["id", "label", "x", "y", "z"],
+ *   "legend": ["StaticMeshActor", "PointLight"],
+ *   "groups": [ { "class": 0, "rows": ["StaticMeshActor_3|Rock|120|-40.5|0", ...] }, ... ]
+ *
+ * A "|" inside a value is written as "\|" and a "\" as "\\". Tables are meant to be written with a
+ * condensed writer (FUnrealGPTSceneTable::FWriter); pretty-printing would give back much of the saving.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTSceneTable
+{
+public:
+	using FWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	explicit FUnrealGPTSceneTable(const TArray<FString>& InColumns, int32 InPrecision = 1);
+
+	/** Start a row for an actor of the given class; cells are then appended in column order */
+	void BeginRow(const FString& ClassName);
+
+	void AddCell(const FString& Value);
+	void AddNumber(double Value);
+	void AddVector(const FVector& Value);
+
+	/** Cell holding the legend index of Value, for columns named with a trailing "@" */
+	void AddInterned(const FString& Value);
+
+	int32 NumRows() const { return RowCount; }
+
+	/** Write the format, columns, legend and groups fields into the currently open object */
+	template <class PrintPolicy>
+	void Write(TJsonWriter<TCHAR, PrintPolicy>& Writer) const
+	{
+		Writer.WriteValue(TEXT("format"), FString(TEXT("table")));
+
+		Writer.WriteArrayStart(TEXT("columns"));
+		for (const FString& Column : Columns)
+		{
+			Writer.WriteValue(Column);
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteArrayStart(TEXT("legend"));
+		for (const FString& Entry : Legend)
+		{
+			Writer.WriteValue(Entry);
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteArrayStart(TEXT("groups"));
+		for (const FGroup& Group : Groups)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("class"), static_cast<double>(Group.ClassIndex));
+			Writer.WriteArrayStart(TEXT("rows"));
+			for (const FString& Row : Group.Rows)
+			{
+				Writer.WriteValue(Row);
+			}
+			Writer.WriteArrayEnd();
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+	}
+
+	/** Value rounded to Precision decimals without trailing zeros ("12", "12.5", never "-0") */
+	static FString FormatNumber(double Value, int32 Precision);
+
+	/** Decimals used when a query does not ask for a precision */
+	static int32 GetDefaultPrecision();
+
+private:
+	struct FGroup
+	{
+		int32 ClassIndex = INDEX_NONE;
+		TArray<FString> Rows;
+	};
+
+	int32 Intern(const FString& Value);
+	void AppendSeparator();
+
+	TArray<FString> Columns;
+	int32 Precision = 1;
+
+	TArray<FString> Legend;
+	TMap<FString, int32> LegendIndices;
+
+	TArray<FGroup> Groups;
+	int32 RowCount = 0;
+	bool bRowHasCells = false;
+};
@@ -1,5 +1,6 @@
 #include "UnrealGPTToolExecutor.h"
 #include "UnrealGPTSceneContext.h"
+#include "UnrealGPTWorldPartition.h"
 #include "UnrealGPTJsonHelpers.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
@@ -10,6 +11,7 @@
 #include "Engine/StaticMesh.h"
 #include "Components/StaticMeshComponent.h"
 #include "EngineUtils.h"
+#include "Misc/ScopedSlowTask.h"
 #include "Engine/Selection.h"
 #include "GameFramework/Actor.h"
 #include "Misc/Paths.h"
@@ -41,9 +43,41 @@ namespace
 	}
 }
 
+namespace UnrealGPTPythonProgress
+{
+	/** Seconds between progress reports from the Python wrapper */
+	static const double ReportInterval = 0.1;
+
+	/** Characters of stdout the wrapper holds before reporting them without a line break */
+	static const int32 MaxPendingOutput = 4096;
+
+	/** Latest stdout lines forwarded while the script runs, and the characters kept of each */
+	static const int32 MaxLines = 12;
+	static const int32 MaxLineLen = 300;
+
+	/** State of the running python_execute call; game thread only */
+	struct FState
+	{
+		TFunction<void(const FString&, float)> OnProgress;
+		TArray<FString> Lines;
+		FString Status;
+		float Progress = -1.0f;
+		bool bRunning = false;
+		bool bCancelRequested = false;
+
+		/** Modal progress dialog shown for the duration of the script */
+		FScopedSlowTask* SlowTask = nullptr;
+
+		/** Progress the dialog has been advanced to */
+		float DialogProgress = 0.0f;
+	};
+
+	static FState State;
+}
+
 // ==================== PYTHON EXECUTION ====================
 
-FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
+FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code, TFunction<void(const FString&, float)> OnProgress)
 {
 	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: ExecutePythonCode ENTRY - Code length: %d chars"), Code.Len());
 
@@ -53,6 +87,11 @@ FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
 		return TEXT("Error: Python is not available in this Unreal Engine installation");
 	}
 
+	if (UnrealGPTPythonProgress::State.bRunning)
+	{
+		return UnrealGPTJsonHelpers::MakeErrorResult(TEXT("Another python_execute call is still running"));
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Python is available, preparing execution..."));
 
 	// Use a deterministic result file the Python wrapper can write to.
@@ -71,9 +110,57 @@ FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
 	// - runs user code inside try/except/finally (where the code can modify `result`)
 	// - writes the final `result` to ResultFilePath as JSON
 	FString WrappedCode;
-	WrappedCode += TEXT("import json, traceback, sys, io\n");
+	WrappedCode += TEXT("import json, traceback, sys, io, time\n");
 	WrappedCode += TEXT("import unreal\n\n");
 
+	// stdout goes to the final logs and, a line at a time, to the chat while the script runs.
+	// Every report updates the modal progress dialog, and raises KeyboardInterrupt once the user cancelled.
+	WrappedCode += TEXT("class _UnrealGPTOutput(io.TextIOBase):\n");
+	WrappedCode += TEXT("    def __init__(self):\n");
+	WrappedCode += TEXT("        self._captured = io.StringIO()\n");
+	WrappedCode += TEXT("        self._pending = \"\"\n");
+	WrappedCode += TEXT("        self.last_report = time.monotonic()\n");
+	WrappedCode += TEXT("    def writable(self):\n");
+	WrappedCode += TEXT("        return True\n");
+	WrappedCode += TEXT("    def write(self, text):\n");
+	WrappedCode += TEXT("        self._captured.write(text)\n");
+	WrappedCode += TEXT("        self._pending += text\n");
+	WrappedCode += FString::Printf(TEXT("        if (\"\\n\" in text or len(self._pending) > %d) and time.monotonic() - self.last_report >= %g:\n"),
+		UnrealGPTPythonProgress::MaxPendingOutput, UnrealGPTPythonProgress::ReportInterval);
+	WrappedCode += TEXT("            self.report()\n");
+	WrappedCode += TEXT("        return len(text)\n");
+	WrappedCode += TEXT("    def report(self, status=\"\", progress=-1.0):\n");
+	WrappedCode += FString::Printf(TEXT("        if len(self._pending) > %d:\n"), UnrealGPTPythonProgress::MaxPendingOutput);
+	WrappedCode += TEXT("            lines, self._pending = self._pending, \"\"\n");
+	WrappedCode += TEXT("        else:\n");
+	WrappedCode += TEXT("            lines, _, self._pending = self._pending.rpartition(\"\\n\")\n");
+	WrappedCode += TEXT("        self.last_report = time.monotonic()\n");
+	WrappedCode += TEXT("        if unreal.UnrealGPTToolExecutor.report_python_progress(lines, status, progress):\n");
+	WrappedCode += TEXT("            raise KeyboardInterrupt(\"Cancelled from UnrealGPT\")\n");
+	WrappedCode += TEXT("    def getvalue(self):\n");
+	WrappedCode += TEXT("        return self._captured.getvalue()\n\n");
+
+	// unreal.ScopedSlowTask is swapped for a wrapper that reports its progress the same way
+	WrappedCode += TEXT("_ScopedSlowTask = unreal.ScopedSlowTask\n");
+	WrappedCode += TEXT("class _UnrealGPTSlowTask(object):\n");
+	WrappedCode += TEXT("    def __init__(self, work=1.0, desc=\"\", enabled=True):\n");
+	WrappedCode += TEXT("        self._task = _ScopedSlowTask(work, desc, enabled)\n");
+	WrappedCode += TEXT("        self._work = max(float(work), 1e-6)\n");
+	WrappedCode += TEXT("        self._done = 0.0\n");
+	WrappedCode += TEXT("        self._desc = str(desc)\n");
+	WrappedCode += TEXT("    def __enter__(self):\n");
+	WrappedCode += TEXT("        self._task.__enter__()\n");
+	WrappedCode += TEXT("        return self\n");
+	WrappedCode += TEXT("    def __exit__(self, *args):\n");
+	WrappedCode += TEXT("        return self._task.__exit__(*args)\n");
+	WrappedCode += TEXT("    def __getattr__(self, name):\n");
+	WrappedCode += TEXT("        return getattr(self._task, name)\n");
+	WrappedCode += TEXT("    def enter_progress_frame(self, work=1.0, desc=\"\"):\n");
+	WrappedCode += TEXT("        self._task.enter_progress_frame(work, desc)\n");
+	WrappedCode += TEXT("        self._done += work\n");
+	WrappedCode += FString::Printf(TEXT("        if time.monotonic() - _stdout_capture.last_report >= %g:\n"), UnrealGPTPythonProgress::ReportInterval);
+	WrappedCode += TEXT("            _stdout_capture.report(str(desc) or self._desc, min(self._done / self._work, 1.0))\n\n");
+
 	// Standard envelope with all fields
 	WrappedCode += TEXT("# Standard result envelope - user code can update these fields\n");
 	WrappedCode += TEXT("result = {\n");
@@ -84,13 +171,14 @@ FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
 
 	// Internal state tracking (prefixed with underscore to avoid conflicts)
 	WrappedCode += TEXT("# Internal state - do not modify\n");
-	WrappedCode += TEXT("_stdout_capture = io.StringIO()\n");
+	WrappedCode += TEXT("_stdout_capture = _UnrealGPTOutput()\n");
 	WrappedCode += TEXT("_old_stdout = sys.stdout\n");
 	WrappedCode += TEXT("_transaction_id = -1\n");
 	WrappedCode += TEXT("_execution_error = None\n\n");
 
 	// Capture stdout
-	WrappedCode += TEXT("sys.stdout = _stdout_capture\n\n");
+	WrappedCode += TEXT("sys.stdout = _stdout_capture\n");
+	WrappedCode += TEXT("unreal.ScopedSlowTask = _UnrealGPTSlowTask\n\n");
 
 	// Begin Editor transaction for Undo support
 	WrappedCode += TEXT("# Begin Editor transaction for Undo support\n");
@@ -103,6 +191,15 @@ FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
 	WrappedCode += TEXT("try:\n");
 	WrappedCode += IndentedUserCode;
 	WrappedCode += TEXT("\n"); // Ensure newline after user code
+	WrappedCode += TEXT("except KeyboardInterrupt:\n");
+	WrappedCode += TEXT("    _execution_error = \"cancelled\"\n");
+	WrappedCode += TEXT("    result[\"status\"] = \"cancelled\"\n");
+	WrappedCode += TEXT("    result[\"message\"] = \"Cancelled by the user before the script finished.\"\n");
+	WrappedCode += TEXT("    if _transaction_id >= 0:\n");
+	WrappedCode += TEXT("        try:\n");
+	WrappedCode += TEXT("            unreal.SystemLibrary.cancel_transaction(_transaction_id)\n");
+	WrappedCode += TEXT("        except Exception:\n");
+	WrappedCode += TEXT("            pass\n");
 	WrappedCode += TEXT("except Exception as e:\n");
 	WrappedCode += TEXT("    _execution_error = e\n");
 	WrappedCode += TEXT("    result[\"status\"] = \"error\"\n");
@@ -120,6 +217,7 @@ FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
 	WrappedCode += TEXT("finally:\n");
 	WrappedCode += TEXT("    # Always restore stdout\n");
 	WrappedCode += TEXT("    sys.stdout = _old_stdout\n");
+	WrappedCode += TEXT("    unreal.ScopedSlowTask = _ScopedSlowTask\n");
 	WrappedCode += TEXT("    _captured_stdout = _stdout_capture.getvalue()\n\n");
 
 	// End transaction on success (outside try/finally to avoid issues)
@@ -159,10 +257,24 @@ FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
 	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Starting Python execution via IPythonScriptPlugin..."));
 	const double StartTime = FPlatformTime::Seconds();
 
+	// The script holds the game thread. The modal dialog keeps the editor from being used (closing tabs,
+	// PIE, map loads, saves) while it runs, and its cancel button is polled at each progress report.
+	// It only appears after half a second, so short scripts do not flash it and steal focus.
+	FScopedSlowTask SlowTask(1.0f, NSLOCTEXT("UnrealGPT", "RunningPython", "Running Python..."));
+	SlowTask.MakeDialogDelayed(0.5f, /*bShowCancelButton=*/true);
+
+	UnrealGPTPythonProgress::State = UnrealGPTPythonProgress::FState();
+	UnrealGPTPythonProgress::State.OnProgress = MoveTemp(OnProgress);
+	UnrealGPTPythonProgress::State.SlowTask = &SlowTask;
+	UnrealGPTPythonProgress::State.bRunning = true;
+
 	IPythonScriptPlugin::Get()->ExecPythonCommand(*WrappedCode);
 
+	const bool bCancelled = UnrealGPTPythonProgress::State.bCancelRequested;
+	UnrealGPTPythonProgress::State = UnrealGPTPythonProgress::FState();
+
 	const double EndTime = FPlatformTime::Seconds();
-	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Python execution completed in %.3f seconds"), EndTime - StartTime);
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Python execution %s in %.3f seconds"), bCancelled ? TEXT("cancelled") : TEXT("completed"), EndTime - StartTime);
 
 	// Try to read the JSON result back from disk so the agent can reason about it.
 	FString ResultJson;
@@ -196,6 +308,85 @@ FString UUnrealGPTToolExecutor::ExecutePythonCode(const FString& Code)
 		"details, and consider writing to the shared `result` dict for future runs.");
 }
 
+bool UUnrealGPTToolExecutor::IsPythonExecuting()
+{
+	return UnrealGPTPythonProgress::State.bRunning;
+}
+
+void UUnrealGPTToolExecutor::CancelPythonExecution()
+{
+	if (UnrealGPTPythonProgress::State.bRunning)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Cancelling python_execute at its next progress report"));
+		UnrealGPTPythonProgress::State.bCancelRequested = true;
+	}
+}
+
+bool UUnrealGPTToolExecutor::ReportPythonProgress(const FString& Output, const FString& Status, float Progress)
+{
+	using namespace UnrealGPTPythonProgress;
+
+	// Scripts run from the editor's own Python console have nobody to report to
+	if (!State.bRunning)
+	{
+		return false;
+	}
+
+	TArray<FString> NewLines;
+	Output.ParseIntoArrayLines(NewLines);
+	for (FString& Line : NewLines)
+	{
+		State.Lines.Add(Line.Len() > MaxLineLen ? Line.Left(MaxLineLen) + TEXT("...") : MoveTemp(Line));
+	}
+	if (State.Lines.Num() > MaxLines)
+	{
+		State.Lines.RemoveAt(0, State.Lines.Num() - MaxLines);
+	}
+
+	if (!Status.IsEmpty())
+	{
+		State.Status = Status;
+	}
+	if (Progress >= 0.0f)
+	{
+		State.Progress = Progress;
+	}
+
+	if (State.OnProgress)
+	{
+		FString Text = State.Status.IsEmpty() ? FString(TEXT("Running Python...")) : State.Status;
+		if (State.Lines.Num() > 0)
+		{
+			Text += TEXT("\n") + FString::Join(State.Lines, TEXT("\n"));
+		}
+		State.OnProgress(Text, State.Progress);
+	}
+
+	if (State.SlowTask)
+	{
+		const FText Message = FText::FromString(State.Status.IsEmpty()
+			? (State.Lines.Num() > 0 ? State.Lines.Last() : FString(TEXT("Running Python...")))
+			: State.Status);
+		if (State.Progress > State.DialogProgress)
+		{
+			State.SlowTask->EnterProgressFrame(State.Progress - State.DialogProgress, Message);
+			State.DialogProgress = State.Progress;
+		}
+		else
+		{
+			State.SlowTask->FrameMessage = Message;
+			State.SlowTask->TickProgress();
+		}
+
+		if (State.SlowTask->ShouldCancel())
+		{
+			State.bCancelRequested = true;
+		}
+	}
+
+	return State.bCancelRequested;
+}
+
 // ==================== VIEWPORT / SCENE ====================
 
 FString UUnrealGPTToolExecutor::GetViewportScreenshot(const FString& ArgumentsJson, FString& OutMetadataJson)
@@ -223,7 +414,7 @@ FString UUnrealGPTToolExecutor::GetSceneSummary(int32 PageSize)
 
 // ==================== HELPERS ====================
 
-AActor* UUnrealGPTToolExecutor::FindActorByIdOrLabel(const FString& Id, const FString& Label)
+AActor* UUnrealGPTToolExecutor::FindActorByIdOrLabel(const FString& Id, const FString& Label, bool bLoadUnloaded)
 {
 	if (!GEditor)
 	{
@@ -270,7 +461,8 @@ AActor* UUnrealGPTToolExecutor::FindActorByIdOrLabel(const FString& Id, const FS
 		}
 	}
 
-	return nullptr;
+	// On World Partition maps the actor may just be unloaded; load only that actor
+	return bLoadUnloaded ? FUnrealGPTWorldPartition::LoadActorByIdOrLabel(World, Id, Label) : nullptr;
 }
 
 // Legacy wrapper for backwards compatibility
@@ -383,9 +575,20 @@ FString UUnrealGPTToolExecutor::ExecuteGetActor(const FString& ArgumentsJson)
 		return TEXT("{\"status\":\"error\",\"message\":\"Must provide 'id' or 'label'\"}");
 	}
 
-	AActor* Actor = FindActorByIdOrLabel(Id, Label);
+	// A read: unloaded World Partition actors are only loaded when asked to
+	bool bLoad = false;
+	ArgsObj->TryGetBoolField(TEXT("load"), bLoad);
+
+	AActor* Actor = FindActorByIdOrLabel(Id, Label, bLoad);
 	if (!Actor)
 	{
+		FGuid UnloadedGuid;
+		UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+		if (!bLoad && FUnrealGPTWorldPartition::FindUnloadedActor(World, Id, Label, UnloadedGuid))
+		{
+			return FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Actor %s is not loaded (World Partition). Call again with load=true to load it.\"}"),
+				!Id.IsEmpty() ? *Id : *Label);
+		}
 		return FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Actor not found: %s\"}"),
 			!Id.IsEmpty() ? *Id : *Label);
 	}
@@ -486,7 +689,7 @@ FString UUnrealGPTToolExecutor::ExecuteSetActorTransform(const FString& Argument
 		return UnrealGPTJsonHelpers::MakeErrorResult(TEXT("Must provide 'id' or 'label'"));
 	}
 
-	AActor* Actor = FindActorByIdOrLabel(Id, Label);
+	AActor* Actor = FindActorByIdOrLabel(Id, Label, true);
 	if (!Actor)
 	{
 		return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("Actor not found: %s"), !Id.IsEmpty() ? *Id : *Label));
@@ -601,7 +804,7 @@ FString UUnrealGPTToolExecutor::ExecuteSelectActors(const FString& ArgumentsJson
 				continue;
 			}
 
-			AActor* Actor = FindActorByIdOrLabel(Id, TEXT(""));
+			AActor* Actor = FindActorByIdOrLabel(Id, TEXT(""), true);
 			if (Actor)
 			{
 				GEditor->SelectActor(Actor, true, true);
@@ -625,7 +828,7 @@ FString UUnrealGPTToolExecutor::ExecuteSelectActors(const FString& ArgumentsJson
 				continue;
 			}
 
-			AActor* Actor = FindActorByIdOrLabel(TEXT(""), Label);
+			AActor* Actor = FindActorByIdOrLabel(TEXT(""), Label, true);
 			if (Actor)
 			{
 				GEditor->SelectActor(Actor, true, true);
@@ -687,7 +890,7 @@ FString UUnrealGPTToolExecutor::ExecuteDuplicateActor(const FString& ArgumentsJs
 		return TEXT("{\"status\":\"error\",\"message\":\"Must provide 'id' or 'label'\"}");
 	}
 
-	AActor* SourceActor = FindActorByIdOrLabel(Id, Label);
+	AActor* SourceActor = FindActorByIdOrLabel(Id, Label, true);
 	if (!SourceActor)
 	{
 		return FString::Printf(TEXT("{\"status\":\"error\",\"message\":\"Actor not found: %s\"}"), !Id.IsEmpty() ? *Id : *Label);
@@ -782,7 +985,7 @@ FString UUnrealGPTToolExecutor::ExecuteSnapActorToGround(const FString& Argument
 		return UnrealGPTJsonHelpers::MakeErrorResult(TEXT("Must provide 'id' or 'label'"));
 	}
 
-	AActor* Actor = FindActorByIdOrLabel(Id, Label);
+	AActor* Actor = FindActorByIdOrLabel(Id, Label, true);
 	if (!Actor)
 	{
 		return UnrealGPTJsonHelpers::MakeErrorResult(FString::Printf(TEXT("Actor not found: %s"), !Id.IsEmpty() ? *Id : *Label));
@@ -902,7 +1105,7 @@ FString UUnrealGPTToolExecutor::ExecuteSetActorsRotation(const FString& Argument
 				continue;
 			}
 
-			AActor* Actor = FindActorByIdOrLabel(Id, TEXT(""));
+			AActor* Actor = FindActorByIdOrLabel(Id, TEXT(""), true);
 			if (Actor)
 			{
 				Actor->Modify();
@@ -934,7 +1137,7 @@ FString UUnrealGPTToolExecutor::ExecuteSetActorsRotation(const FString& Argument
 				continue;
 			}
 
-			AActor* Actor = FindActorByIdOrLabel(TEXT(""), Label);
+			AActor* Actor = FindActorByIdOrLabel(TEXT(""), Label, true);
 			if (Actor)
 			{
 				Actor->Modify();
@@ -16,8 +16,25 @@ class UNREALGPTEDITOR_API UUnrealGPTToolExecutor : public UObject
 public:
 	// ==================== PYTHON EXECUTION ====================
 
-	/** Execute Python code in the Unreal Editor context */
-	static FString ExecutePythonCode(const FString& Code);
+	/**
+	 * Execute Python code in the Unreal Editor context.
+	 * @param OnProgress - Receives the latest stdout lines and unreal.ScopedSlowTask progress (0-1, negative when unknown) while the script runs
+	 */
+	static FString ExecutePythonCode(const FString& Code, TFunction<void(const FString&, float)> OnProgress = nullptr);
+
+	/** Whether python_execute is running */
+	static bool IsPythonExecuting();
+
+	/** Raise KeyboardInterrupt in the running script at its next progress report */
+	static void CancelPythonExecution();
+
+	/**
+	 * Called by the python_execute wrapper with new stdout lines and slow task progress, at most every
+	 * few frames. Forwards them, updates the modal progress dialog, and returns true once the script
+	 * should stop (its cancel button was pressed or CancelPythonExecution was called).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UnrealGPT")
+	static bool ReportPythonProgress(const FString& Output, const FString& Status, float Progress);
 
 	// ==================== VIEWPORT / SCENE ====================
 
@@ -56,8 +73,10 @@ public:
 	 * Find actor by Id (internal name) or Label (display name).
 	 * Id takes priority - it's the stable unique identifier (Actor->GetName()).
 	 * Label is the user-friendly display name shown in Outliner (Actor->GetActorLabel()).
+	 * With bLoadUnloaded, unloaded World Partition actors are matched the same way and loaded on demand;
+	 * only tools that edit the actor, or were asked to load it, pass it, so reads stay free of side effects.
 	 */
-	static AActor* FindActorByIdOrLabel(const FString& Id, const FString& Label);
+	static AActor* FindActorByIdOrLabel(const FString& Id, const FString& Label, bool bLoadUnloaded = false);
 
 	/** Legacy wrapper - Find actor by label or name (backwards compatibility) */
 	static AActor* FindActorByLabelOrName(const FString& Label, const FString& Name);
@@ -68,8 +68,19 @@ TArray<FToolSchema> UnrealGPTToolSchemas::GetStandardToolSchemas(bool bEnablePyt
 			TEXT("- components: root_component info and static_mesh_path\n")
 			TEXT("- tags: actor tags array\n")
 			TEXT("- folder: folder path in outliner\n")
-			TEXT("- parent: parent actor if attached\n\n")
+			TEXT("- parent: parent actor if attached\n")
+			TEXT("- data_layers: names of the actor's data layers\n\n")
 			TEXT("Example: fields=\"location,rotation\" or fields=\"location,bounds,tags\"\n\n")
+			TEXT("Set format=\"table\" for large result sets. Instead of 'actors' it returns one header and compact rows:\n")
+			TEXT("  \"columns\": [\"id\", \"label\", \"x\", \"y\", \"z\"], \"legend\": [\"StaticMeshActor\", ...],\n")
+			TEXT("  \"groups\": [ { \"class\": 0, \"rows\": [\"StaticMeshActor_42|Bridge|120|-40.5|0\", ...] }, ... ]\n")
+			TEXT("Cells are '|'-separated in column order; 'class' and columns ending in '@' are indices into 'legend'. ")
+			TEXT("Columns: location=x,y,z rotation=pitch,yaw,roll scale=sx,sy,sz bounds=bx,by,bz,ex,ey,ez (origin, extent) ")
+			TEXT("components=root@,mobility,mesh@ tags (';'-separated) folder parent data_layers=layers (';'-separated).\n\n")
+			TEXT("World Partition levels: unloaded actors are matched too, from their descriptors, without loading anything. ")
+			TEXT("They come after the loaded ones with \"loaded\": false (a 'loaded' column of 0 in table format) and only have ")
+			TEXT("id, label, class, bounds, data layers and their bounds center as location. Set load=true to load just the matched actors. ")
+			TEXT("Tools that edit an actor by id load it on their own; get_actor only does with load=true.\n\n")
 			TEXT("IMPORTANT: Use the returned 'id' field for subsequent operations to avoid label collisions."));
 		SceneQuerySchema.AddParam(FToolParameter::String(TEXT("class_contains"),
 			TEXT("Optional substring to match in actor class names, e.g., 'DirectionalLight', 'StaticMeshActor'.")));
@@ -78,16 +89,69 @@ TArray<FToolSchema> UnrealGPTToolSchemas::GetStandardToolSchemas(bool bEnablePyt
 		SceneQuerySchema.AddParam(FToolParameter::String(TEXT("name_contains"),
 			TEXT("Optional substring to match in actor object names.")));
 		SceneQuerySchema.AddParam(FToolParameter::String(TEXT("component_class_contains"),
-			TEXT("Optional substring to match in component class names, e.g., 'DirectionalLightComponent'.")));
+			TEXT("Optional substring to match in component class names, e.g., 'DirectionalLightComponent'. Only loaded actors can match.")));
+		SceneQuerySchema.AddParam(FToolParameter::String(TEXT("data_layer_contains"),
+			TEXT("Optional substring to match in the names of the actor's data layers (World Partition levels).")));
+		SceneQuerySchema.AddParam(FToolParameter::Boolean(TEXT("include_unloaded"),
+			TEXT("Also match unloaded World Partition actors (default true). No effect on levels without World Partition.")));
+		SceneQuerySchema.AddParam(FToolParameter::Boolean(TEXT("load"),
+			TEXT("Load the matched unloaded actors, at most 200, so they can be edited (default false). Only those actors are loaded, not their region.")));
 		SceneQuerySchema.AddParam(FToolParameter::Integer(TEXT("max_results"),
 			TEXT("Maximum number of matching actors to return (default 20).")));
 		SceneQuerySchema.AddParam(FToolParameter::Integer(TEXT("offset"),
 			TEXT("Number of matching actors to skip for pagination (default 0).")));
 		SceneQuerySchema.AddParam(FToolParameter::String(TEXT("fields"),
-			TEXT("Comma-separated list of additional fields to include: location,rotation,scale,bounds,components,tags,folder,parent. Default: none (minimal output).")));
+			TEXT("Comma-separated list of additional fields to include: location,rotation,scale,bounds,components,tags,folder,parent,data_layers. Default: none (minimal output).")));
+		SceneQuerySchema.AddParam(FToolParameter::String(TEXT("format"),
+			TEXT("'json' (default) for an object per actor, or 'table' for header + rows, which uses far fewer tokens for many actors.")));
+		SceneQuerySchema.AddParam(FToolParameter::Integer(TEXT("precision"),
+			TEXT("Decimals kept for numbers in table format (0-6, default 1).")));
 		Schemas.Add(SceneQuerySchema);
 	}
 
+	// scene_overview - always enabled
+	{
+		FToolSchema OverviewSchema(TEXT("scene_overview"),
+			TEXT("Overview of the whole level in one call, for large levels where paging through scene_query would take many calls.\n\n")
+			TEXT("Actors are bucketed into a grid over the level's XY extent. Each non-empty cell returns:\n")
+			TEXT("  { \"id\": \"1_2\", \"count\": 812, \"min\": [x,y,z], \"max\": [x,y,z], \"classes\": {\"StaticMeshActor\": 700, ...}, ")
+			TEXT("\"other_classes\": 3, \"largest\": [\"Bridge\", ...] }\n")
+			TEXT("min/max span the actor locations in the cell; 'largest' are labels of its biggest actors.\n\n")
+			TEXT("Drill down by passing a cell id as 'cell': that cell is split into the same grid, with ids like \"1_2/0_3\". ")
+			TEXT("Once a cell holds at most max_listed actors they are listed as 'actors' in the scene_query table format. ")
+			TEXT("Then use scene_query or get_actor for details.\n\n")
+			TEXT("On World Partition levels unloaded actors are counted too; cells report how many as 'unloaded'."));
+		OverviewSchema.AddParam(FToolParameter::String(TEXT("cell"),
+			TEXT("Optional cell id from a previous scene_overview to subdivide, e.g. '1_2' or '1_2/0_3'. Omit for the whole level.")));
+		OverviewSchema.AddParam(FToolParameter::Integer(TEXT("grid_size"),
+			TEXT("Cells per side (2-8, default 4). Keep it the same while drilling down, as cell ids depend on it.")));
+		OverviewSchema.AddParam(FToolParameter::String(TEXT("class_contains"),
+			TEXT("Optional substring to only count actors of matching classes, e.g. 'Light'. Cell ids are unaffected.")));
+		OverviewSchema.AddParam(FToolParameter::Integer(TEXT("max_listed"),
+			TEXT("List the actors of the cell once it holds at most this many (default 40, up to 200).")));
+		OverviewSchema.AddParam(FToolParameter::Boolean(TEXT("include_unloaded"),
+			TEXT("Also count unloaded World Partition actors (default true).")));
+		Schemas.Add(OverviewSchema);
+	}
+
+	// check_placement - always enabled
+	{
+		FToolSchema PlacementSchema(TEXT("check_placement"),
+			TEXT("Check whether proposed placements overlap existing geometry before spawning or moving anything.\n\n")
+			TEXT("Each placement is a box {location, extent, rotation} or a sphere {location, radius}, tested against the collision ")
+			TEXT("of the level. Pass every placement of a layout in one call (up to 1000) rather than one call per placement.\n")
+			TEXT("Returns {checked, clear, blocked: [{index, blockers: [labels]}]}; only blocked placements are listed.\n\n")
+			TEXT("Landscapes are ignored by default, so objects resting on terrain are clear. Shrink the extent slightly or ")
+			TEXT("lift the box off the floor so an object resting on a mesh does not count the floor as a blocker."));
+		PlacementSchema.AddParam(FToolParameter::ObjectArray(TEXT("placements"),
+			TEXT("Placements to check: {\"location\": {x, y, z}, \"extent\": {x, y, z}} for a box (half size), or ")
+			TEXT("{\"location\": {x, y, z}, \"radius\": r} for a sphere. Optional \"rotation\" {pitch, yaw, roll} for boxes ")
+			TEXT("and \"ignore\": actor id or label that should not count, such as the actor being moved."), true));
+		PlacementSchema.AddParam(FToolParameter::Boolean(TEXT("ignore_landscape"),
+			TEXT("Whether landscapes are ignored (default true).")));
+		Schemas.Add(PlacementSchema);
+	}
+
 	// reflection_query - always enabled
 	{
 		FToolSchema ReflectionSchema(TEXT("reflection_query"),
@@ -105,11 +169,19 @@ TArray<FToolSchema> UnrealGPTToolSchemas::GetStandardToolSchemas(bool bEnablePyt
 		FToolSchema ReplicateSchema(TEXT("replicate_generate"),
 			TEXT("Generate content using Replicate (images, video, audio, or 3D files) via the Replicate HTTP API. ")
 			TEXT("Returns JSON with 'status', 'message', and 'details.files' containing local file paths for any downloaded outputs. ")
-			TEXT("After calling this, use python_execute (for example with the 'unrealgpt_mcp_import' helpers) to import the files as Unreal assets, ")
+			TEXT("Batch calls (prompts/seeds/count) also return 'details.predictions' and tag each file with its prediction index, prompt, and seed. ")
+			TEXT("After calling this, use import_generated to import the files as Unreal assets, ")
 			TEXT("then verify placement with scene_query and/or viewport_screenshot."));
 		ReplicateSchema.AddParam(FToolParameter::String(TEXT("prompt"),
 			TEXT("Text prompt describing what to generate (image, video, audio, or 3D asset). For example: ")
-			TEXT("'seamless square floral rock wall texture' or 'short ambient forest soundscape'."), true));
+			TEXT("'seamless square floral rock wall texture' or 'short ambient forest soundscape'. Required unless 'prompts' is given.")));
+		ReplicateSchema.AddParam(FToolParameter::StringArray(TEXT("prompts"),
+			TEXT("Optional batch of prompts, one prediction each (up to 16). Use this instead of calling the tool repeatedly: ")
+			TEXT("the predictions run concurrently and come back as a single result.")));
+		ReplicateSchema.AddParam(FToolParameter::IntegerArray(TEXT("seeds"),
+			TEXT("Optional seeds for variations. With 'prompt', runs one prediction per seed; with 'prompts', seeds pair up with prompts by position and must be as many as the prompts.")));
+		ReplicateSchema.AddParam(FToolParameter::Integer(TEXT("count"),
+			TEXT("Optional number of variations to generate of 'prompt', or of each entry of 'prompts' (default 1, up to 16 predictions in total). Not combined with 'seeds'.")));
 		ReplicateSchema.AddParam(FToolParameter::String(TEXT("version"),
 			TEXT("Optional Replicate model identifier. You can pass either a full version id or an 'owner/model' slug for official models (for example 'black-forest-labs/flux-dev').")));
 		ReplicateSchema.AddParam(FToolParameter::String(TEXT("output_kind"),
@@ -119,6 +191,18 @@ TArray<FToolSchema> UnrealGPTToolSchemas::GetStandardToolSchemas(bool bEnablePyt
 			TEXT("Optional sub-kind for audio or other outputs, e.g. 'sfx', 'music', or 'speech'. ")
 			TEXT("This is used to choose between SFX, music, and speech Replicate models configured in settings when 'version' is omitted.")));
 		Schemas.Add(ReplicateSchema);
+
+		FToolSchema ImportSchema(TEXT("import_generated"),
+			TEXT("Import generated files (textures, meshes, audio) as Unreal assets without blocking the editor. ")
+			TEXT("Pass every file of a replicate_generate result in one call: they are imported together and saved in a single batch. ")
+			TEXT("Returns JSON with 'status', 'message', and 'details.imports' listing each file's 'asset_paths' (or 'error')."));
+		ImportSchema.AddParam(FToolParameter::StringArray(TEXT("files"),
+			TEXT("Local file paths to import, e.g. the 'local_path' values from replicate_generate 'details.files'."), true));
+		ImportSchema.AddParam(FToolParameter::String(TEXT("destination_path"),
+			TEXT("Optional content folder for the new assets, e.g. '/Game/Generated/Rocks'. Defaults to the folder matching the file's staging location.")));
+		ImportSchema.AddParam(FToolParameter::Boolean(TEXT("save"),
+			TEXT("Optional. Save the imported assets when done (default true).")));
+		Schemas.Add(ImportSchema);
 	}
 
 	// ==================== ATOMIC EDITOR TOOLS ====================
@@ -147,6 +231,8 @@ TArray<FToolSchema> UnrealGPTToolSchemas::GetStandardToolSchemas(bool bEnablePyt
 			TEXT("Actor id (internal name from scene_query). Preferred - guaranteed unique.")));
 		GetActorSchema.AddParam(FToolParameter::String(TEXT("label"),
 			TEXT("Actor label (as shown in Outliner). Fallback if id not provided.")));
+		GetActorSchema.AddParam(FToolParameter::Boolean(TEXT("load"),
+			TEXT("Load the actor if it is an unloaded World Partition actor (default false). Without it, an unloaded actor is reported as not loaded.")));
 		Schemas.Add(GetActorSchema);
 	}
 
@@ -56,6 +56,20 @@ struct FToolParameter
 		Param.ArrayItemType = TEXT("string");
 		return Param;
 	}
+
+	static FToolParameter IntegerArray(const FString& Name, const FString& Desc, bool bRequired = false)
+	{
+		FToolParameter Param(Name, TEXT("array"), Desc, bRequired);
+		Param.ArrayItemType = TEXT("integer");
+		return Param;
+	}
+
+	static FToolParameter ObjectArray(const FString& Name, const FString& Desc, bool bRequired = false)
+	{
+		FToolParameter Param(Name, TEXT("array"), Desc, bRequired);
+		Param.ArrayItemType = TEXT("object");
+		return Param;
+	}
 };
 
 /**
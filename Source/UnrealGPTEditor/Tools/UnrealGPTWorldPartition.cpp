@@ -0,0 +1,249 @@
+#include "UnrealGPTWorldPartition.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/DataLayer/DataLayerInstance.h"
+#include "WorldPartition/DataLayer/DataLayerManager.h"
+
+namespace UnrealGPTWorldPartition
+{
+	/** Actors pinned by LoadActors, so they can be unpinned again; pins belong to one world */
+	struct FPinnedActors
+	{
+		TWeakObjectPtr<UWorld> World;
+		TSet<FGuid> Guids;
+	};
+
+	FPinnedActors& GetPinnedActors()
+	{
+		static FPinnedActors PinnedActors;
+		return PinnedActors;
+	}
+}
+
+bool FUnrealGPTWorldPartition::IsPartitioned(const UWorld* World)
+{
+	return World && World->GetWorldPartition() != nullptr;
+}
+
+void FUnrealGPTWorldPartition::GetUnloadedActors(UWorld* World, TArray<FUnrealGPTActorDesc>& OutDescs)
+{
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	if (!WorldPartition)
+	{
+		return;
+	}
+
+	// Descriptors name data layers by instance; resolve each to the short name the Outliner shows once
+	const UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(World);
+	TMap<FName, FString> DataLayerNames;
+	auto GetDataLayerName = [DataLayerManager, &DataLayerNames](const FName& InstanceName) -> const FString&
+	{
+		if (const FString* Known = DataLayerNames.Find(InstanceName))
+		{
+			return *Known;
+		}
+
+		const UDataLayerInstance* Instance = DataLayerManager ? DataLayerManager->GetDataLayerInstanceFromName(InstanceName) : nullptr;
+		return DataLayerNames.Add(InstanceName, Instance ? Instance->GetDataLayerShortName() : InstanceName.ToString());
+	};
+
+	FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, [&OutDescs, &GetDataLayerName](const FWorldPartitionActorDescInstance* DescInstance)
+	{
+		if (!DescInstance || DescInstance->IsLoaded())
+		{
+			return true;
+		}
+
+		FUnrealGPTActorDesc& Desc = OutDescs.AddDefaulted_GetRef();
+		Desc.Guid = DescInstance->GetGuid();
+		Desc.Name = DescInstance->GetActorName();
+		Desc.Label = DescInstance->GetActorLabel().IsNone() ? Desc.Name.ToString() : DescInstance->GetActorLabel().ToString();
+		Desc.Bounds = DescInstance->GetEditorBounds();
+
+		// Blueprint actors carry their generated class as the base class; native actors only have the native one
+		const FTopLevelAssetPath BaseClass = DescInstance->GetBaseClass();
+		if (BaseClass.IsValid())
+		{
+			Desc.ClassName = BaseClass.GetAssetName();
+		}
+		else if (const UClass* NativeClass = DescInstance->GetActorNativeClass())
+		{
+			Desc.ClassName = NativeClass->GetFName();
+		}
+
+		for (const FName& InstanceName : DescInstance->GetDataLayerInstanceNames().ToArray())
+		{
+			Desc.DataLayers.Add(GetDataLayerName(InstanceName));
+		}
+		return true;
+	});
+}
+
+TArray<AActor*> FUnrealGPTWorldPartition::LoadActors(UWorld* World, const TArray<FGuid>& ActorGuids)
+{
+	TArray<AActor*> Loaded;
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	if (!WorldPartition || ActorGuids.Num() == 0)
+	{
+		return Loaded;
+	}
+
+	TArray<FGuid> ToLoad(ActorGuids.GetData(), FMath::Min(ActorGuids.Num(), MaxLoadPerQuery));
+	if (ActorGuids.Num() > ToLoad.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Loading only the first %d of %d matched World Partition actors"), ToLoad.Num(), ActorGuids.Num());
+	}
+
+	// Pinned actors stay loaded until unpinned, like the ones the user pins; remember ours for UnpinLoadedActors
+	WorldPartition->PinActors(ToLoad);
+
+	UnrealGPTWorldPartition::FPinnedActors& Pinned = UnrealGPTWorldPartition::GetPinnedActors();
+	if (Pinned.World.Get() != World)
+	{
+		// Pins of a world that was closed went away with it
+		Pinned.World = World;
+		Pinned.Guids.Reset();
+	}
+	Pinned.Guids.Append(ToLoad);
+
+	for (const FGuid& Guid : ToLoad)
+	{
+		const FWorldPartitionActorDescInstance* DescInstance = WorldPartition->GetActorDescInstance(Guid);
+		if (AActor* Actor = DescInstance ? DescInstance->GetActor() : nullptr)
+		{
+			Loaded.Add(Actor);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Loaded %d World Partition actor(s) on demand"), Loaded.Num());
+	return Loaded;
+}
+
+bool FUnrealGPTWorldPartition::FindUnloadedActor(UWorld* World, const FString& Id, const FString& Label, FGuid& OutGuid)
+{
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	if (!WorldPartition)
+	{
+		return false;
+	}
+
+	// A name that was never created cannot be on any descriptor; FNAME_Find skips the scan for it
+	const FName IdName = Id.IsEmpty() ? NAME_None : FName(*Id, FNAME_Find);
+	const FName LabelName = Label.IsEmpty() ? NAME_None : FName(*Label, FNAME_Find);
+	if (IdName.IsNone() && LabelName.IsNone())
+	{
+		return false;
+	}
+
+	// Same priority as loaded actors: the unique id first, then the first label match
+	FGuid LabelMatch;
+	bool bIdMatched = false;
+	FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, [&](const FWorldPartitionActorDescInstance* DescInstance)
+	{
+		if (!DescInstance || DescInstance->IsLoaded())
+		{
+			return true;
+		}
+
+		if (!IdName.IsNone() && DescInstance->GetActorName() == IdName)
+		{
+			OutGuid = DescInstance->GetGuid();
+			bIdMatched = true;
+			return false;
+		}
+
+		if (!LabelName.IsNone() && !LabelMatch.IsValid())
+		{
+			const FName DescLabel = DescInstance->GetActorLabel().IsNone() ? DescInstance->GetActorName() : DescInstance->GetActorLabel();
+			if (DescLabel == LabelName)
+			{
+				LabelMatch = DescInstance->GetGuid();
+
+				// Without an id to look for, the first label match is the answer
+				return !IdName.IsNone();
+			}
+		}
+		return true;
+	});
+
+	if (bIdMatched)
+	{
+		return true;
+	}
+	if (LabelMatch.IsValid())
+	{
+		OutGuid = LabelMatch;
+		return true;
+	}
+	return false;
+}
+
+AActor* FUnrealGPTWorldPartition::LoadActorByIdOrLabel(UWorld* World, const FString& Id, const FString& Label)
+{
+	FGuid Guid;
+	if (!FindUnloadedActor(World, Id, Label, Guid))
+	{
+		return nullptr;
+	}
+
+	const TArray<AActor*> Loaded = LoadActors(World, { Guid });
+	return Loaded.Num() > 0 ? Loaded[0] : nullptr;
+}
+
+int32 FUnrealGPTWorldPartition::UnpinLoadedActors()
+{
+	UnrealGPTWorldPartition::FPinnedActors& Pinned = UnrealGPTWorldPartition::GetPinnedActors();
+	UWorld* World = Pinned.World.Get();
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	if (!WorldPartition)
+	{
+		Pinned.Guids.Reset();
+		return 0;
+	}
+
+	TArray<FGuid> ToUnpin;
+	for (auto It = Pinned.Guids.CreateIterator(); It; ++It)
+	{
+		const FWorldPartitionActorDescInstance* DescInstance = WorldPartition->GetActorDescInstance(*It);
+		const AActor* Actor = DescInstance ? DescInstance->GetActor() : nullptr;
+		if (Actor && Actor->GetPackage() && Actor->GetPackage()->IsDirty())
+		{
+			continue;
+		}
+
+		ToUnpin.Add(*It);
+		It.RemoveCurrent();
+	}
+
+	if (ToUnpin.Num() > 0)
+	{
+		WorldPartition->UnpinActors(ToUnpin);
+		UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Unpinned %d World Partition actor(s) loaded on demand; %d with unsaved changes stay pinned"),
+			ToUnpin.Num(), Pinned.Guids.Num());
+	}
+	return ToUnpin.Num();
+}
+
+int32 FUnrealGPTWorldPartition::GetNumPinned()
+{
+	return UnrealGPTWorldPartition::GetPinnedActors().Guids.Num();
+}
+
+TArray<FString> FUnrealGPTWorldPartition::GetDataLayers(const AActor* Actor)
+{
+	TArray<FString> Names;
+	if (Actor)
+	{
+		for (const UDataLayerInstance* DataLayer : Actor->GetDataLayerInstances())
+		{
+			if (DataLayer)
+			{
+				Names.Add(DataLayer->GetDataLayerShortName());
+			}
+		}
+	}
+	return Names;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+
+/** What scene tools know about an actor that is not loaded, read from its World Partition actor descriptor */
+struct FUnrealGPTActorDesc
+{
+	FGuid Guid;
+
+	/** Actor name, the id used by the other tools */
+	FName Name;
+	FString Label;
+	FName ClassName;
+
+	/** Editor bounds; their center stands in for the location, which descriptors do not store */
+	FBox Bounds = FBox(ForceInit);
+
+	/** Short names of the data layers the actor belongs to */
+	TArray<FString> DataLayers;
+};
+
+/**
+ * Lets scene tools see the unloaded part of World Partition maps. Queries read the actor
+ * descriptors World Partition keeps in memory for every actor, so searching a whole open world
+ * loads nothing. Matched actors can then be loaded one by one, by pinning them as the World
+ * Partition editor's "Pin" action does, instead of loading whole regions. Only tools that edit
+ * or explicitly ask to load call the Load functions; the pins are recorded so UnpinLoadedActors
+ * can release them. Game thread only.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTWorldPartition
+{
+public:
+	/** Most actors a single tool call may load */
+	static constexpr int32 MaxLoadPerQuery = 200;
+
+	/** Whether World uses World Partition, so some of its actors may be unloaded */
+	static bool IsPartitioned(const UWorld* World);
+
+	/** Descriptors of the actors of World that are not currently loaded */
+	static void GetUnloadedActors(UWorld* World, TArray<FUnrealGPTActorDesc>& OutDescs);
+
+	/** Load just these actors (at most MaxLoadPerQuery) and return the ones now loaded */
+	static TArray<AActor*> LoadActors(UWorld* World, const TArray<FGuid>& ActorGuids);
+
+	/**
+	 * Find an unloaded actor by id (exact name) or else label without loading it. Compares the names
+	 * straight from the descriptors, so a miss costs one pass and no allocations.
+	 */
+	static bool FindUnloadedActor(UWorld* World, const FString& Id, const FString& Label, FGuid& OutGuid);
+
+	/** Find an unloaded actor by id (exact name) or else label, and load it. Null if nothing matches. */
+	static AActor* LoadActorByIdOrLabel(UWorld* World, const FString& Id, const FString& Label);
+
+	/**
+	 * Unpin the actors LoadActors pinned, letting World Partition unload them again. Actors with
+	 * unsaved changes stay pinned so their edits are not thrown away.
+	 * @return Number of actors unpinned
+	 */
+	static int32 UnpinLoadedActors();
+
+	/** Actors LoadActors pinned that have not been unpinned */
+	static int32 GetNumPinned();
+
+	/** Short names of the data layers a loaded actor belongs to */
+	static TArray<FString> GetDataLayers(const AActor* Actor);
+};
@@ -0,0 +1,583 @@
+#include "UnrealGPTAudioEncoder.h"
+
+namespace
+{
+	/** Samples per FLAC frame (a standard block size, 256 ms at 16 kHz) */
+	constexpr int32 FLACBlockSize = 4096;
+
+	constexpr int32 MaxFixedOrder = 4;
+	constexpr int32 MaxPartitionOrder = 8;
+
+	/** Largest Rice parameter for the 4-bit (RICE) and 5-bit (RICE2) residual coding methods */
+	constexpr int32 MaxRiceParam = 14;
+	constexpr int32 MaxRice2Param = 30;
+
+	/** FIR taps per polyphase branch, multiplied by the decimation factor when downsampling */
+	constexpr int32 BaseTapsPerPhase = 16;
+	constexpr double KaiserBeta = 8.0;
+
+	/** Keeps the polyphase bank small for unusual rate pairs (e.g. 44.1 kHz -> 16 kHz is 160/441) */
+	constexpr int32 MaxInterpolationFactor = 1024;
+
+	int16 ToInt16(float Sample)
+	{
+		return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Sample * 32767.0f), -32768, 32767));
+	}
+
+	int32 GreatestCommonDivisor(int32 A, int32 B)
+	{
+		while (B != 0)
+		{
+			const int32 Remainder = A % B;
+			A = B;
+			B = Remainder;
+		}
+		return A;
+	}
+
+	/** Zeroth-order modified Bessel function of the first kind, for the Kaiser window */
+	double BesselI0(double X)
+	{
+		const double HalfX = X * 0.5;
+		double Sum = 1.0;
+		double Term = 1.0;
+		for (int32 K = 1; K < 64; ++K)
+		{
+			Term *= (HalfX / K) * (HalfX / K);
+			Sum += Term;
+			if (Term < Sum * 1e-12)
+			{
+				break;
+			}
+		}
+		return Sum;
+	}
+
+	/** MSB-first bit writer appending to a byte array */
+	class FBitWriter
+	{
+	public:
+		explicit FBitWriter(TArray<uint8>& InOut)
+			: Out(InOut)
+		{
+		}
+
+		void Write(uint32 Value, int32 NumBits)
+		{
+			check(NumBits >= 0 && NumBits <= 32);
+			if (NumBits == 0)
+			{
+				return;
+			}
+
+			Accumulator = (Accumulator << NumBits) | (static_cast<uint64>(Value) & ((static_cast<uint64>(1) << NumBits) - 1));
+			PendingBits += NumBits;
+			while (PendingBits >= 8)
+			{
+				PendingBits -= 8;
+				Out.Add(static_cast<uint8>(Accumulator >> PendingBits));
+			}
+		}
+
+		void WriteSigned(int32 Value, int32 NumBits)
+		{
+			Write(static_cast<uint32>(Value), NumBits);
+		}
+
+		/** Q zero bits followed by a one */
+		void WriteUnary(uint32 Q)
+		{
+			while (Q >= 32)
+			{
+				Write(0, 32);
+				Q -= 32;
+			}
+			Write(1, Q + 1);
+		}
+
+		void AlignToByte()
+		{
+			if (PendingBits > 0)
+			{
+				Write(0, 8 - PendingBits);
+			}
+		}
+
+		/** UTF-8-style variable length integer used for FLAC frame numbers */
+		void WriteUTF8(uint32 Value)
+		{
+			if (Value < 0x80)
+			{
+				Write(Value, 8);
+				return;
+			}
+
+			int32 NumBytes = 2;
+			while (NumBytes < 6 && Value >= (1u << (5 * NumBytes + 1)))
+			{
+				++NumBytes;
+			}
+
+			const uint32 Prefix = (0xFFu << (8 - NumBytes)) & 0xFFu;
+			Write(Prefix | (Value >> (6 * (NumBytes - 1))), 8);
+			for (int32 Index = NumBytes - 2; Index >= 0; --Index)
+			{
+				Write(0x80 | ((Value >> (6 * Index)) & 0x3F), 8);
+			}
+		}
+
+	private:
+		TArray<uint8>& Out;
+		uint64 Accumulator = 0;
+		int32 PendingBits = 0;
+	};
+
+	uint8 ComputeCRC8(const uint8* Data, int32 Length)
+	{
+		// Polynomial x^8 + x^2 + x + 1
+		uint8 Crc = 0;
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			Crc ^= Data[Index];
+			for (int32 Bit = 0; Bit < 8; ++Bit)
+			{
+				Crc = (Crc & 0x80) ? static_cast<uint8>((Crc << 1) ^ 0x07) : static_cast<uint8>(Crc << 1);
+			}
+		}
+		return Crc;
+	}
+
+	uint16 ComputeCRC16(const uint8* Data, int32 Length)
+	{
+		// Polynomial x^16 + x^15 + x^2 + 1
+		uint16 Crc = 0;
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			Crc ^= static_cast<uint16>(Data[Index]) << 8;
+			for (int32 Bit = 0; Bit < 8; ++Bit)
+			{
+				Crc = (Crc & 0x8000) ? static_cast<uint16>((Crc << 1) ^ 0x8005) : static_cast<uint16>(Crc << 1);
+			}
+		}
+		return Crc;
+	}
+
+	/** Residual of the fixed polynomial predictor of the given order at sample Index (Index >= Order) */
+	FORCEINLINE int32 FixedResidual(const int32* Samples, int32 Index, int32 Order)
+	{
+		switch (Order)
+		{
+		case 0: return Samples[Index];
+		case 1: return Samples[Index] - Samples[Index - 1];
+		case 2: return Samples[Index] - 2 * Samples[Index - 1] + Samples[Index - 2];
+		case 3: return Samples[Index] - 3 * Samples[Index - 1] + 3 * Samples[Index - 2] - Samples[Index - 3];
+		default: return Samples[Index] - 4 * Samples[Index - 1] + 6 * Samples[Index - 2] - 4 * Samples[Index - 3] + Samples[Index - 4];
+		}
+	}
+
+	FORCEINLINE uint32 ZigZag(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	/** Cheapest Rice parameter for a run of folded residuals and its cost in bits (excluding the parameter field) */
+	void ChooseRiceParam(const uint32* Folded, int32 Count, int32 MaxParam, int32& OutParam, uint64& OutBits)
+	{
+		uint64 Sum = 0;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Sum += Folded[Index];
+		}
+
+		// The optimum is close to log2(mean); check its neighbours exactly
+		int32 Estimate = 0;
+		if (Count > 0 && Sum > static_cast<uint64>(Count))
+		{
+			Estimate = static_cast<int32>(FMath::FloorLog2_64(Sum / Count));
+		}
+
+		OutParam = 0;
+		OutBits = MAX_uint64;
+		for (int32 Param = FMath::Max(0, Estimate - 1); Param <= FMath::Min(MaxParam, Estimate + 1); ++Param)
+		{
+			uint64 Bits = static_cast<uint64>(Count) * (Param + 1);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Bits += Folded[Index] >> Param;
+			}
+			if (Bits < OutBits)
+			{
+				OutBits = Bits;
+				OutParam = Param;
+			}
+		}
+	}
+
+	struct FResidualPlan
+	{
+		int32 PartitionOrder = 0;
+		bool bRice2 = false;
+		TArray<int32, TInlineAllocator<1 << MaxPartitionOrder>> Params;
+		uint64 Bits = MAX_uint64;
+	};
+
+	/** Pick the partition order and per-partition Rice parameters with the smallest encoding */
+	FResidualPlan PlanResidual(const uint32* Folded, int32 BlockSize, int32 PredictorOrder)
+	{
+		FResidualPlan Best;
+
+		for (int32 PartitionOrder = 0; PartitionOrder <= MaxPartitionOrder; ++PartitionOrder)
+		{
+			const int32 NumPartitions = 1 << PartitionOrder;
+			if (BlockSize % NumPartitions != 0 || (BlockSize >> PartitionOrder) <= PredictorOrder)
+			{
+				break;
+			}
+
+			FResidualPlan Plan;
+			Plan.PartitionOrder = PartitionOrder;
+			Plan.Bits = 2 + 4;
+
+			const int32 PartitionSize = BlockSize >> PartitionOrder;
+			int32 Offset = 0;
+			for (int32 Partition = 0; Partition < NumPartitions; ++Partition)
+			{
+				// The warm-up samples are not part of the residual
+				const int32 Count = Partition == 0 ? PartitionSize - PredictorOrder : PartitionSize;
+
+				int32 Param = 0;
+				uint64 PartitionBits = 0;
+				ChooseRiceParam(Folded + Offset, Count, MaxRice2Param, Param, PartitionBits);
+
+				Plan.Params.Add(Param);
+				Plan.bRice2 |= Param > MaxRiceParam;
+				Plan.Bits += PartitionBits;
+				Offset += Count;
+			}
+
+			Plan.Bits += static_cast<uint64>(NumPartitions) * (Plan.bRice2 ? 5 : 4);
+			if (Plan.Bits < Best.Bits)
+			{
+				Best = MoveTemp(Plan);
+			}
+		}
+
+		return Best;
+	}
+
+	void WriteFrame(FBitWriter& Writer, TArray<uint8>& Out, const int32* Samples, int32 BlockSize, uint32 FrameNumber)
+	{
+		const int32 FrameStart = Out.Num();
+
+		// Frame header
+		Writer.Write(0x3FFE, 14);		// Sync code
+		Writer.Write(0, 1);				// Reserved
+		Writer.Write(0, 1);				// Fixed block size stream
+		Writer.Write(0x7, 4);			// Block size: 16-bit (size - 1) at end of header
+		Writer.Write(0x0, 4);			// Sample rate: from STREAMINFO
+		Writer.Write(0x0, 4);			// Channel assignment: mono
+		Writer.Write(0x4, 3);			// 16 bits per sample
+		Writer.Write(0, 1);				// Reserved
+		Writer.WriteUTF8(FrameNumber);
+		Writer.Write(BlockSize - 1, 16);
+		Writer.Write(ComputeCRC8(Out.GetData() + FrameStart, Out.Num() - FrameStart), 8);
+
+		// Subframe header: zero pad bit, then type, then no wasted bits
+		bool bConstant = true;
+		for (int32 Index = 1; Index < BlockSize && bConstant; ++Index)
+		{
+			bConstant = Samples[Index] == Samples[0];
+		}
+
+		if (bConstant)
+		{
+			// Digital silence and DC collapse to a single sample
+			Writer.Write(0, 1);
+			Writer.Write(0x00, 6);
+			Writer.Write(0, 1);
+			Writer.WriteSigned(Samples[0], 16);
+		}
+		else
+		{
+			// Fixed predictor order with the smallest absolute residual sum
+			int32 BestOrder = 0;
+			uint64 BestSum = MAX_uint64;
+			for (int32 Order = 0; Order <= FMath::Min(MaxFixedOrder, BlockSize - 1); ++Order)
+			{
+				uint64 Sum = 0;
+				for (int32 Index = Order; Index < BlockSize; ++Index)
+				{
+					Sum += FMath::Abs(FixedResidual(Samples, Index, Order));
+				}
+				if (Sum < BestSum)
+				{
+					BestSum = Sum;
+					BestOrder = Order;
+				}
+			}
+
+			TArray<uint32> Folded;
+			Folded.SetNumUninitialized(BlockSize - BestOrder);
+			for (int32 Index = BestOrder; Index < BlockSize; ++Index)
+			{
+				Folded[Index - BestOrder] = ZigZag(FixedResidual(Samples, Index, BestOrder));
+			}
+
+			const FResidualPlan Plan = PlanResidual(Folded.GetData(), BlockSize, BestOrder);
+			const uint64 FixedBits = Plan.Bits + static_cast<uint64>(BestOrder) * 16;
+			const uint64 VerbatimBits = static_cast<uint64>(BlockSize) * 16;
+
+			if (FixedBits >= VerbatimBits)
+			{
+				Writer.Write(0, 1);
+				Writer.Write(0x01, 6);
+				Writer.Write(0, 1);
+				for (int32 Index = 0; Index < BlockSize; ++Index)
+				{
+					Writer.WriteSigned(Samples[Index], 16);
+				}
+			}
+			else
+			{
+				Writer.Write(0, 1);
+				Writer.Write(0x08 | BestOrder, 6);
+				Writer.Write(0, 1);
+				for (int32 Index = 0; Index < BestOrder; ++Index)
+				{
+					Writer.WriteSigned(Samples[Index], 16);
+				}
+
+				Writer.Write(Plan.bRice2 ? 1 : 0, 2);
+				Writer.Write(Plan.PartitionOrder, 4);
+
+				const int32 PartitionSize = BlockSize >> Plan.PartitionOrder;
+				int32 Offset = 0;
+				for (int32 Partition = 0; Partition < Plan.Params.Num(); ++Partition)
+				{
+					const int32 Param = Plan.Params[Partition];
+					const int32 Count = Partition == 0 ? PartitionSize - BestOrder : PartitionSize;
+
+					Writer.Write(Param, Plan.bRice2 ? 5 : 4);
+					for (int32 Index = Offset; Index < Offset + Count; ++Index)
+					{
+						Writer.WriteUnary(Folded[Index] >> Param);
+						Writer.Write(Folded[Index], Param);
+					}
+					Offset += Count;
+				}
+			}
+		}
+
+		// Frame footer
+		Writer.AlignToByte();
+		const uint16 Crc16 = ComputeCRC16(Out.GetData() + FrameStart, Out.Num() - FrameStart);
+		Writer.Write(Crc16, 16);
+	}
+}
+
+void UnrealGPTAudioEncoder::DownmixToMono(TConstArrayView<float> Interleaved, int32 NumChannels, TArray<float>& OutMono)
+{
+	if (NumChannels <= 1)
+	{
+		OutMono.Reset();
+		OutMono.Append(Interleaved.GetData(), Interleaved.Num());
+		return;
+	}
+
+	const int32 NumFrames = Interleaved.Num() / NumChannels;
+	const float Scale = 1.0f / NumChannels;
+
+	OutMono.SetNumUninitialized(NumFrames);
+	const float* Source = Interleaved.GetData();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		float Sum = 0.0f;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Sum += Source[Channel];
+		}
+		OutMono[Frame] = Sum * Scale;
+		Source += NumChannels;
+	}
+}
+
+void UnrealGPTAudioEncoder::Resample(TConstArrayView<float> Input, int32 InputRate, int32 OutputRate, TArray<float>& OutResampled)
+{
+	OutResampled.Reset();
+	if (Input.Num() == 0 || InputRate <= 0 || OutputRate <= 0)
+	{
+		return;
+	}
+
+	if (InputRate == OutputRate)
+	{
+		OutResampled.Append(Input.GetData(), Input.Num());
+		return;
+	}
+
+	// Output rate / input rate = L / M: upsample by L, filter, keep every M-th sample
+	const int32 Divisor = GreatestCommonDivisor(InputRate, OutputRate);
+	int32 L = OutputRate / Divisor;
+	int32 M = InputRate / Divisor;
+	if (L > MaxInterpolationFactor)
+	{
+		// Approximate exotic ratios; the pitch error is far below anything audible
+		M = FMath::Max(1, FMath::RoundToInt(static_cast<double>(M) * MaxInterpolationFactor / L));
+		L = MaxInterpolationFactor;
+	}
+
+	const int32 TapsPerPhase = BaseTapsPerPhase * FMath::Max(1, FMath::DivideAndRoundUp(M, L));
+	const int32 FilterLength = TapsPerPhase * L;
+
+	// Cutoff in cycles per upsampled sample, slightly under the lower of the two Nyquist rates
+	const double Cutoff = 0.45 / FMath::Max(L, M);
+	const double Center = (FilterLength - 1) * 0.5;
+	const double WindowNorm = 1.0 / BesselI0(KaiserBeta);
+
+	// Polyphase bank: branch P holds taps P, P + L, P + 2L, ...
+	TArray<float> Bank;
+	Bank.SetNumUninitialized(FilterLength);
+	TArray<double> PhaseGain;
+	PhaseGain.SetNumZeroed(L);
+
+	for (int32 Tap = 0; Tap < FilterLength; ++Tap)
+	{
+		const double X = Tap - Center;
+		const double Sinc = FMath::IsNearlyZero(X) ? 2.0 * Cutoff : FMath::Sin(2.0 * UE_DOUBLE_PI * Cutoff * X) / (UE_DOUBLE_PI * X);
+		const double R = FilterLength > 1 ? (2.0 * Tap) / (FilterLength - 1) - 1.0 : 0.0;
+		const double Window = BesselI0(KaiserBeta * FMath::Sqrt(FMath::Max(0.0, 1.0 - R * R))) * WindowNorm;
+		const double Coefficient = Sinc * Window;
+
+		const int32 Phase = Tap % L;
+		Bank[Phase * TapsPerPhase + Tap / L] = static_cast<float>(Coefficient);
+		PhaseGain[Phase] += Coefficient;
+	}
+
+	// Unity DC gain per branch avoids a ripple at the interpolation period
+	for (int32 Phase = 0; Phase < L; ++Phase)
+	{
+		const float Normalize = PhaseGain[Phase] != 0.0 ? static_cast<float>(1.0 / PhaseGain[Phase]) : 0.0f;
+		for (int32 Tap = 0; Tap < TapsPerPhase; ++Tap)
+		{
+			Bank[Phase * TapsPerPhase + Tap] *= Normalize;
+		}
+	}
+
+	const int64 InputLength = Input.Num();
+	const int64 OutputLength = InputLength * L / M;
+	const int64 Delay = FMath::RoundToInt(Center);
+	const float* Source = Input.GetData();
+
+	OutResampled.SetNumUninitialized(static_cast<int32>(OutputLength));
+	for (int64 Out = 0; Out < OutputLength; ++Out)
+	{
+		// Position in the (virtual) upsampled stream, shifted to compensate the filter delay
+		const int64 T = Out * M + Delay;
+		const int32 Phase = static_cast<int32>(T % L);
+		const int64 Base = T / L;
+		const float* Coefficients = Bank.GetData() + Phase * TapsPerPhase;
+
+		const int64 FirstTap = FMath::Max<int64>(0, Base - (InputLength - 1));
+		const int64 LastTap = FMath::Min<int64>(TapsPerPhase - 1, Base);
+
+		float Sum = 0.0f;
+		for (int64 Tap = FirstTap; Tap <= LastTap; ++Tap)
+		{
+			Sum += Coefficients[Tap] * Source[Base - Tap];
+		}
+		OutResampled[static_cast<int32>(Out)] = Sum;
+	}
+}
+
+void UnrealGPTAudioEncoder::AppendFLAC(TConstArrayView<float> Samples, int32 SampleRate, TArray<uint8>& Out)
+{
+	const int32 NumSamples = Samples.Num();
+	Out.Reserve(Out.Num() + GetMaxEncodedSize(NumSamples));
+
+	FBitWriter Writer(Out);
+
+	// "fLaC" marker and the STREAMINFO block (the only, and therefore last, metadata block)
+	Writer.Write(0x664C6143, 32);
+	Writer.Write(1, 1);
+	Writer.Write(0, 7);
+	Writer.Write(34, 24);
+	Writer.Write(FLACBlockSize, 16);	// Min block size
+	Writer.Write(FLACBlockSize, 16);	// Max block size
+	Writer.Write(0, 24);				// Min frame size (unknown)
+	Writer.Write(0, 24);				// Max frame size (unknown)
+	Writer.Write(SampleRate, 20);
+	Writer.Write(0, 3);					// Channels - 1
+	Writer.Write(15, 5);				// Bits per sample - 1
+	Writer.Write(0, 4);					// Total samples, upper 4 of 36 bits
+	Writer.Write(static_cast<uint32>(NumSamples), 32);
+	for (int32 Word = 0; Word < 4; ++Word)
+	{
+		Writer.Write(0, 32);			// MD5 (not computed)
+	}
+
+	TArray<int32> Block;
+	Block.SetNumUninitialized(FLACBlockSize);
+
+	uint32 FrameNumber = 0;
+	for (int32 Start = 0; Start < NumSamples; Start += FLACBlockSize)
+	{
+		const int32 BlockSize = FMath::Min(FLACBlockSize, NumSamples - Start);
+		for (int32 Index = 0; Index < BlockSize; ++Index)
+		{
+			Block[Index] = ToInt16(Samples[Start + Index]);
+		}
+		WriteFrame(Writer, Out, Block.GetData(), BlockSize, FrameNumber++);
+	}
+}
+
+void UnrealGPTAudioEncoder::AppendWAV(TConstArrayView<float> Samples, int32 SampleRate, TArray<uint8>& Out)
+{
+	const int32 NumSamples = Samples.Num();
+	const uint32 DataSize = static_cast<uint32>(NumSamples) * sizeof(int16);
+
+	auto WriteTag = [&Out](const char* Tag) { Out.Append(reinterpret_cast<const uint8*>(Tag), 4); };
+	auto WriteLE32 = [&Out](uint32 Value)
+	{
+		for (int32 Shift = 0; Shift < 32; Shift += 8)
+		{
+			Out.Add(static_cast<uint8>(Value >> Shift));
+		}
+	};
+	auto WriteLE16 = [&Out](uint16 Value)
+	{
+		Out.Add(static_cast<uint8>(Value));
+		Out.Add(static_cast<uint8>(Value >> 8));
+	};
+
+	Out.Reserve(Out.Num() + 44 + DataSize);
+	WriteTag("RIFF");
+	WriteLE32(36 + DataSize);
+	WriteTag("WAVE");
+	WriteTag("fmt ");
+	WriteLE32(16);
+	WriteLE16(1);						// PCM
+	WriteLE16(1);						// Mono
+	WriteLE32(SampleRate);
+	WriteLE32(SampleRate * sizeof(int16));
+	WriteLE16(sizeof(int16));
+	WriteLE16(16);
+	WriteTag("data");
+	WriteLE32(DataSize);
+
+	// Samples are converted straight into the output buffer
+	const int32 DataStart = Out.AddUninitialized(DataSize);
+	uint8* Dest = Out.GetData() + DataStart;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const uint16 Sample = static_cast<uint16>(ToInt16(Samples[Index]));
+		Dest[Index * 2] = static_cast<uint8>(Sample & 0xFF);
+		Dest[Index * 2 + 1] = static_cast<uint8>(Sample >> 8);
+	}
+}
+
+int64 UnrealGPTAudioEncoder::GetMaxEncodedSize(int32 NumSamples)
+{
+	// Verbatim 16-bit samples plus per-frame headers; FLAC falls back to verbatim frames, so this bounds both formats
+	const int64 NumFrames = NumSamples / FLACBlockSize + 1;
+	return 64 + static_cast<int64>(NumSamples) * sizeof(int16) + NumFrames * 32;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Prepares captured microphone audio for upload to a transcription endpoint.
+ *
+ * Speech models work at 16 kHz mono, so device audio (typically 48 kHz stereo) is downmixed,
+ * band-limited and resampled with a polyphase FIR before being encoded. FLAC encoding is
+ * lossless 16-bit with fixed predictors and partitioned Rice coding; all encoders append to a
+ * caller-owned buffer so the audio can be written straight into a request body.
+ */
+class UNREALGPTEDITOR_API UnrealGPTAudioEncoder
+{
+public:
+	/** Sample rate expected by speech-to-text models */
+	static constexpr int32 SpeechSampleRate = 16000;
+
+	/** Average interleaved channels into a single channel */
+	static void DownmixToMono(TConstArrayView<float> Interleaved, int32 NumChannels, TArray<float>& OutMono);
+
+	/** Rational-ratio polyphase resampler with a Kaiser-windowed sinc anti-aliasing filter */
+	static void Resample(TConstArrayView<float> Input, int32 InputRate, int32 OutputRate, TArray<float>& OutResampled);
+
+	/** Append a 16-bit mono FLAC stream */
+	static void AppendFLAC(TConstArrayView<float> Samples, int32 SampleRate, TArray<uint8>& Out);
+
+	/** Append a 16-bit mono PCM WAV file */
+	static void AppendWAV(TConstArrayView<float> Samples, int32 SampleRate, TArray<uint8>& Out);
+
+	/** Upper bound of the encoded size, for reserving request buffers */
+	static int64 GetMaxEncodedSize(int32 NumSamples);
+};
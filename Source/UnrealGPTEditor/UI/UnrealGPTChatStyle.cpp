@@ -0,0 +1,201 @@
+#include "UnrealGPTChatStyle.h"
+#include "UnrealGPTSyntaxHighlighter.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/Text/SRichTextBlock.h"
+#include "Styling/AppStyle.h"
+#include "Styling/CoreStyle.h"
+#include "Styling/SlateTypes.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+
+namespace UnrealGPTChatStyle
+{
+	// Helper to build a Geist-based Slate font from this plugin's Content/Fonts folder.
+	// Falls back to the default editor fonts if anything goes wrong.
+	FSlateFontInfo MakeGeistFont(int32 Size, bool bBold, bool bItalic)
+	{
+		static bool bInitialized = false;
+		static FString PluginContentDir;
+
+		if (!bInitialized)
+		{
+			if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealGPT")))
+			{
+				PluginContentDir = Plugin->GetContentDir();
+			}
+			bInitialized = true;
+		}
+
+		if (!PluginContentDir.IsEmpty())
+		{
+			FString FileName;
+			if (bBold && bItalic)
+			{
+				FileName = TEXT("Geist-BoldItalic.ttf");
+			}
+			else if (bBold)
+			{
+				FileName = TEXT("Geist-Bold.ttf");
+			}
+			else if (bItalic)
+			{
+				FileName = TEXT("Geist-RegularItalic.ttf");
+			}
+			else
+			{
+				FileName = TEXT("Geist-Regular.ttf");
+			}
+
+			const FString FontPath = FPaths::Combine(PluginContentDir, TEXT("Fonts/Geist/ttf"), FileName);
+			return FSlateFontInfo(FontPath, Size);
+		}
+
+		// Fallback to the standard editor fonts if the plugin content directory is not available.
+		if (bBold)
+		{
+			return FAppStyle::GetFontStyle("NormalFontBold");
+		}
+		if (bItalic)
+		{
+			return FAppStyle::GetFontStyle("NormalFontItalic");
+		}
+		return FAppStyle::GetFontStyle("NormalFont");
+	}
+
+	FSlateFontInfo GetUnrealGPTBodyFont()
+	{
+		return MakeGeistFont(10, false, false);
+	}
+
+	FSlateFontInfo GetUnrealGPTBodyBoldFont()
+	{
+		return MakeGeistFont(10, true, false);
+	}
+
+	FSlateFontInfo GetUnrealGPTSmallBodyFont()
+	{
+		return MakeGeistFont(8, false, false);
+	}
+
+	FSlateFontInfo GetUnrealGPTSmallBodyItalicFont()
+	{
+		return MakeGeistFont(8, false, true);
+	}
+
+	FSlateFontInfo GetUnrealGPTBodyItalicFont()
+	{
+		return MakeGeistFont(10, false, true);
+	}
+
+	// Borderless, transparent style shared by the read-only text boxes below.
+	// The style needs to live as long as the widgets, so it is created once and kept in a static.
+	static const FEditableTextBoxStyle* GetSelectableTextBoxStyle()
+	{
+		static TSharedPtr<FEditableTextBoxStyle> BaseStyle;
+		if (!BaseStyle.IsValid())
+		{
+			BaseStyle = MakeShareable(new FEditableTextBoxStyle(FCoreStyle::Get().GetWidgetStyle<FEditableTextBoxStyle>("NormalEditableTextBox")));
+			BaseStyle->SetBackgroundImageNormal(FSlateNoResource());
+			BaseStyle->SetBackgroundImageHovered(FSlateNoResource());
+			BaseStyle->SetBackgroundImageFocused(FSlateNoResource());
+			BaseStyle->SetBackgroundImageReadOnly(FSlateNoResource());
+			BaseStyle->SetPadding(FMargin(0.0f));
+			BaseStyle->SetBackgroundColor(FLinearColor::Transparent);
+			// Set scroll bar style to invisible/minimal to avoid visual clutter
+			BaseStyle->ScrollBarStyle.SetHorizontalBackgroundImage(FSlateNoResource());
+			BaseStyle->ScrollBarStyle.SetVerticalBackgroundImage(FSlateNoResource());
+		}
+		return BaseStyle.Get();
+	}
+
+	// Create a read-only, selectable/copyable text widget for displaying results.
+	// Uses SMultiLineEditableTextBox with IsReadOnly(true) to enable text selection and Ctrl+C copying.
+	TSharedRef<SMultiLineEditableTextBox> CreateSelectableTextWidget(const FString& Text, const FSlateFontInfo& Font, const FLinearColor& TextColor, bool bAutoWrap)
+	{
+		return SNew(SMultiLineEditableTextBox)
+			.Text(FText::FromString(Text))
+			.IsReadOnly(true)
+			.AutoWrapText(bAutoWrap)
+			.Style(GetSelectableTextBoxStyle())
+			.Font(Font)
+			.ForegroundColor(FSlateColor(TextColor))
+			.Padding(FMargin(0.0f))
+			.SelectAllTextWhenFocused(false)
+			.AllowContextMenu(true); // Enable right-click context menu for copy
+	}
+
+	// Same as CreateSelectableTextWidget, but laid out through the syntax highlighter's marshaller.
+	// Token spans come from the highlighter's cache, so rebuilding the widget does not re-tokenize.
+	TSharedRef<SMultiLineEditableTextBox> CreateCodeTextWidget(const FString& Code, EUnrealGPTSyntaxLanguage Language, bool bAutoWrap)
+	{
+		return SNew(SMultiLineEditableTextBox)
+			.Text(FText::FromString(Code))
+			.Marshaller(UnrealGPTSyntaxHighlighter::CreateMarshaller(Language))
+			.IsReadOnly(true)
+			.AutoWrapText(bAutoWrap)
+			.Style(GetSelectableTextBoxStyle())
+			.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+			.ForegroundColor(FSlateColor(FLinearColor(0.9f, 0.9f, 0.9f, 1.0f)))
+			.Padding(FMargin(0.0f))
+			.SelectAllTextWhenFocused(false)
+			.AllowContextMenu(true);
+	}
+
+	// Render a single chat line with inline markdown support using SRichTextBlock.
+	// Converts **bold** markers to rich text format for proper inline styling with word wrapping.
+	TSharedRef<SWidget> CreateInlineMarkdownTextWidget(const FString& Line)
+	{
+		// Convert **bold** markdown to rich text markup: **text** -> <RichTextBlock.Bold>text</>
+		FString RichText;
+		int32 Pos = 0;
+		const int32 Length = Line.Len();
+
+		while (Pos < Length)
+		{
+			const int32 Open = Line.Find(TEXT("**"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
+			if (Open == INDEX_NONE)
+			{
+				// No more bold markers; add the rest as normal text.
+				RichText += Line.Mid(Pos);
+				break;
+			}
+
+			// Add any normal text before the bold span.
+			if (Open > Pos)
+			{
+				RichText += Line.Mid(Pos, Open - Pos);
+			}
+
+			const int32 Close = Line.Find(TEXT("**"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Open + 2);
+			if (Close == INDEX_NONE)
+			{
+				// Unmatched '**' – treat the remainder as normal text including the markers.
+				RichText += Line.Mid(Open);
+				break;
+			}
+
+			// Extract the bold span between the markers and wrap with rich text tags.
+			const int32 BoldStart = Open + 2;
+			const int32 BoldLen = Close - BoldStart;
+			if (BoldLen > 0)
+			{
+				RichText += TEXT("<RichTextBlock.Bold>");
+				RichText += Line.Mid(BoldStart, BoldLen);
+				RichText += TEXT("</>");
+			}
+
+			Pos = Close + 2;
+		}
+
+		// Create a text style with our desired color and font
+		static FTextBlockStyle ChatTextStyle = FTextBlockStyle()
+			.SetFont(GetUnrealGPTBodyFont())
+			.SetColorAndOpacity(FSlateColor(FLinearColor(0.95f, 0.95f, 0.95f, 1.0f)));
+
+		return SNew(SRichTextBlock)
+			.Text(FText::FromString(RichText))
+			.AutoWrapText(true)
+			.DecoratorStyleSet(&FCoreStyle::Get())
+			.TextStyle(&ChatTextStyle);
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+
+enum class EUnrealGPTSyntaxLanguage : uint8;
+
+class SWidget;
+class SMultiLineEditableTextBox;
+
+/**
+ * Fonts and text widgets shared by the chat panel and its sub-widgets.
+ */
+namespace UnrealGPTChatStyle
+{
+	/** Build a Geist font from the plugin's Content/Fonts folder, falling back to the editor fonts */
+	FSlateFontInfo MakeGeistFont(int32 Size, bool bBold = false, bool bItalic = false);
+
+	FSlateFontInfo GetUnrealGPTBodyFont();
+	FSlateFontInfo GetUnrealGPTBodyBoldFont();
+	FSlateFontInfo GetUnrealGPTSmallBodyFont();
+	FSlateFontInfo GetUnrealGPTSmallBodyItalicFont();
+	FSlateFontInfo GetUnrealGPTBodyItalicFont();
+
+	/** Read-only text that can be selected and copied with Ctrl+C */
+	TSharedRef<SMultiLineEditableTextBox> CreateSelectableTextWidget(const FString& Text, const FSlateFontInfo& Font, const FLinearColor& TextColor = FLinearColor(0.9f, 0.9f, 0.9f, 1.0f), bool bAutoWrap = true);
+
+	/** Read-only, selectable monospace code with cached syntax highlighting */
+	TSharedRef<SMultiLineEditableTextBox> CreateCodeTextWidget(const FString& Code, EUnrealGPTSyntaxLanguage Language, bool bAutoWrap = false);
+
+	/** Single chat line with inline **bold** support */
+	TSharedRef<SWidget> CreateInlineMarkdownTextWidget(const FString& Line);
+}
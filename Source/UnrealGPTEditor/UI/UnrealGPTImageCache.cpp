@@ -0,0 +1,556 @@
+#include "UnrealGPTImageCache.h"
+#include "UnrealGPTSettings.h"
+#include "UnrealGPTStats.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SScaleBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformApplicationMisc.h"
+#include "Styling/AppStyle.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Engine/Texture2D.h"
+#include "TextureResource.h"
+#include "Rendering/DrawElements.h"
+#include "Async/Async.h"
+#include "Hash/CityHash.h"
+#include "Misc/Base64.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+
+/** Output of a worker-thread decode, handed back to the game thread for upload */
+struct FUnrealGPTDecodedImage
+{
+	/** BGRA8 pixels of the (possibly downscaled) image */
+	TArray<uint8> Pixels;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	FIntPoint SourceSize = FIntPoint::ZeroValue;
+	bool bSuccess = false;
+};
+
+namespace
+{
+	// Decode a base64 JPEG/PNG and downscale it to fit MaxSize (zero = keep original resolution).
+	// Runs on a worker thread, so it must not touch UObjects.
+	void DecodeChatImage(IImageWrapperModule& WrapperModule, const FString& ImageBase64, const FIntPoint& MaxSize, FUnrealGPTDecodedImage& Out)
+	{
+		TArray<uint8> Compressed;
+		if (!FBase64::Decode(ImageBase64, Compressed))
+		{
+			return;
+		}
+
+		const EImageFormat Format = WrapperModule.DetectImageFormat(Compressed.GetData(), Compressed.Num());
+		if (Format != EImageFormat::JPEG && Format != EImageFormat::PNG)
+		{
+			return;
+		}
+
+		TSharedPtr<IImageWrapper> ImageWrapper = WrapperModule.CreateImageWrapper(Format);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Compressed.GetData(), Compressed.Num()))
+		{
+			return;
+		}
+
+		TArray<uint8> Raw;
+		if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, Raw))
+		{
+			return;
+		}
+
+		const int32 Width = static_cast<int32>(ImageWrapper->GetWidth());
+		const int32 Height = static_cast<int32>(ImageWrapper->GetHeight());
+		if (Width <= 0 || Height <= 0 || Raw.Num() < Width * Height * 4)
+		{
+			return;
+		}
+
+		Out.SourceSize = FIntPoint(Width, Height);
+		Out.Size = Out.SourceSize;
+
+		if (MaxSize.X > 0 && MaxSize.Y > 0)
+		{
+			const float Scale = FMath::Min3(1.0f, static_cast<float>(MaxSize.X) / Width, static_cast<float>(MaxSize.Y) / Height);
+			Out.Size = FIntPoint(
+				FMath::Max(1, FMath::RoundToInt(Width * Scale)),
+				FMath::Max(1, FMath::RoundToInt(Height * Scale)));
+		}
+
+		if (Out.Size == Out.SourceSize)
+		{
+			Out.Pixels = MoveTemp(Raw);
+		}
+		else
+		{
+			// FColor is laid out as BGRA, matching the raw buffer
+			Out.Pixels.SetNumUninitialized(Out.Size.X * Out.Size.Y * 4);
+			FImageUtils::ImageResize(
+				Width, Height,
+				TArrayView<const FColor>(reinterpret_cast<const FColor*>(Raw.GetData()), Width * Height),
+				Out.Size.X, Out.Size.Y,
+				TArrayView<FColor>(reinterpret_cast<FColor*>(Out.Pixels.GetData()), Out.Size.X * Out.Size.Y),
+				false,		// sRGB data
+				false);		// Keep alpha
+		}
+
+		Out.bSuccess = true;
+	}
+
+	// Upload decoded pixels to a transient texture. Writes the mip directly instead of going through
+	// FImageUtils::CreateTexture2D, which builds source data and compresses on the game thread.
+	UTexture2D* CreateChatTexture(const FUnrealGPTDecodedImage& Decoded)
+	{
+		const FName TextureName = MakeUniqueObjectName(GetTransientPackage(), UTexture2D::StaticClass(), TEXT("UnrealGPTChatImage"));
+		UTexture2D* Texture = UTexture2D::CreateTransient(Decoded.Size.X, Decoded.Size.Y, PF_B8G8R8A8, TextureName);
+		if (!Texture || !Texture->GetPlatformData() || Texture->GetPlatformData()->Mips.Num() == 0)
+		{
+			return nullptr;
+		}
+
+		Texture->SRGB = true;
+		Texture->Filter = TF_Bilinear;
+
+		FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+		void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(MipData, Decoded.Pixels.GetData(), Decoded.Pixels.Num());
+		Mip.BulkData.Unlock();
+
+		Texture->UpdateResource();
+		return Texture;
+	}
+
+	/**
+	 * Draws a cached image. Slate evaluates attributes such as SImage::Image for widgets that are
+	 * scrolled out of view too, so the brush is only fetched (marking the image as used and
+	 * starting its decode) from OnPaint, which culled widgets never reach.
+	 */
+	class SUnrealGPTCachedImage : public SLeafWidget
+	{
+	public:
+		SLATE_BEGIN_ARGS(SUnrealGPTCachedImage) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, TWeakPtr<FUnrealGPTImageCache> InCache, uint64 InKey, EUnrealGPTImageResolution InResolution)
+		{
+			Cache = MoveTemp(InCache);
+			Key = InKey;
+			Resolution = InResolution;
+		}
+
+		virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+		{
+			TSharedPtr<FUnrealGPTImageCache> PinnedCache = Cache.Pin();
+			const FSlateBrush* Brush = PinnedCache.IsValid() ? PinnedCache->GetBrush(Key, Resolution) : nullptr;
+			if (Brush && Brush->DrawAs != ESlateBrushDrawType::NoDrawType)
+			{
+				const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+				FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Brush, DrawEffects,
+					InWidgetStyle.GetColorAndOpacityTint() * Brush->GetTint(InWidgetStyle));
+			}
+			return LayerId;
+		}
+
+	protected:
+		virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+		{
+			TSharedPtr<FUnrealGPTImageCache> PinnedCache = Cache.Pin();
+			return PinnedCache.IsValid() ? PinnedCache->GetImageSize(Key, Resolution) : FVector2D::ZeroVector;
+		}
+
+	private:
+		TWeakPtr<FUnrealGPTImageCache> Cache;
+		uint64 Key = 0;
+		EUnrealGPTImageResolution Resolution = EUnrealGPTImageResolution::Thumbnail;
+	};
+}
+
+FUnrealGPTImageCache::FUnrealGPTImageCache()
+{
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+}
+
+FUnrealGPTImageCache::~FUnrealGPTImageCache()
+{
+	Reset();
+}
+
+uint64 FUnrealGPTImageCache::AddImage(const FString& ImageBase64)
+{
+	const uint64 Key = CityHash64(reinterpret_cast<const char*>(*ImageBase64), ImageBase64.Len() * sizeof(TCHAR));
+
+	if (!Entries.Contains(Key))
+	{
+		FImageEntry& Entry = Entries.Add(Key);
+		Entry.Source = MakeShared<const FString, ESPMode::ThreadSafe>(ImageBase64);
+
+		for (FImageSlot* Slot : { &Entry.Thumbnail, &Entry.Full })
+		{
+			Slot->Brush = MakeShared<FSlateBrush>();
+			Slot->Brush->DrawAs = ESlateBrushDrawType::NoDrawType;
+			Slot->Brush->ImageType = ESlateBrushImageType::FullColor;
+		}
+	}
+
+	return Key;
+}
+
+TSharedRef<SWidget> FUnrealGPTImageCache::CreateThumbnailWidget(uint64 Key, const FVector2D& MaxDisplaySize)
+{
+	if (FImageEntry* Entry = Entries.Find(Key))
+	{
+		// Decode thumbnails at the physical pixel size of the panel so they stay sharp on high-DPI displays
+		const float DPIScale = FPlatformApplicationMisc::GetDPIScaleFactorAtPoint(0.0f, 0.0f);
+		Entry->ThumbnailMaxSize = Entry->ThumbnailMaxSize.ComponentMax(FIntPoint(
+			FMath::CeilToInt(MaxDisplaySize.X * DPIScale),
+			FMath::CeilToInt(MaxDisplaySize.Y * DPIScale)));
+	}
+
+	TWeakPtr<FUnrealGPTImageCache> WeakCache = AsShared();
+
+	return SNew(SButton)
+		.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+		.ContentPadding(0.0f)
+		.ToolTipText(NSLOCTEXT("UnrealGPT", "OpenImageTooltip", "Click to view at full resolution"))
+		.OnClicked_Lambda([WeakCache, Key]()
+		{
+			if (TSharedPtr<FUnrealGPTImageCache> Cache = WeakCache.Pin())
+			{
+				Cache->OpenFullResolution(Key);
+			}
+			return FReply::Handled();
+		})
+		[
+			SNew(SBox)
+			.WidthOverride_Lambda([WeakCache, Key, MaxDisplaySize]() -> FOptionalSize
+			{
+				TSharedPtr<FUnrealGPTImageCache> Cache = WeakCache.Pin();
+				return Cache.IsValid() ? Cache->GetDisplaySize(Key, MaxDisplaySize).X : FOptionalSize();
+			})
+			.HeightOverride_Lambda([WeakCache, Key, MaxDisplaySize]() -> FOptionalSize
+			{
+				TSharedPtr<FUnrealGPTImageCache> Cache = WeakCache.Pin();
+				return Cache.IsValid() ? Cache->GetDisplaySize(Key, MaxDisplaySize).Y : FOptionalSize();
+			})
+			[
+				SNew(SOverlay)
+
+				// Only painted (and therefore only decoded) while the thumbnail is on screen
+				+ SOverlay::Slot()
+				[
+					SNew(SUnrealGPTCachedImage, WeakCache, Key, EUnrealGPTImageResolution::Thumbnail)
+				]
+
+				+ SOverlay::Slot()
+				.HAlign(HAlign_Center)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text_Lambda([WeakCache, Key]()
+					{
+						TSharedPtr<FUnrealGPTImageCache> Cache = WeakCache.Pin();
+						return Cache.IsValid() && Cache->HasFailed(Key)
+							? NSLOCTEXT("UnrealGPT", "ImageDecodeFailed", "Failed to decode image")
+							: NSLOCTEXT("UnrealGPT", "ImageLoading", "Loading image...");
+					})
+					.Visibility_Lambda([WeakCache, Key]()
+					{
+						TSharedPtr<FUnrealGPTImageCache> Cache = WeakCache.Pin();
+						return Cache.IsValid() && Cache->IsResident(Key) ? EVisibility::Collapsed : EVisibility::HitTestInvisible;
+					})
+					.Font(FAppStyle::GetFontStyle("SmallFont"))
+					.ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f, 1.0f))
+				]
+			]
+		];
+}
+
+const FSlateBrush* FUnrealGPTImageCache::GetBrush(uint64 Key, EUnrealGPTImageResolution Resolution)
+{
+	FImageEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	FImageSlot& Slot = GetSlot(*Entry, Resolution);
+	Slot.LastUsedFrame = GFrameCounter;
+
+	if (!Slot.Texture)
+	{
+		RequestDecode(Key, Resolution);
+	}
+
+	return Slot.Brush.Get();
+}
+
+void FUnrealGPTImageCache::OpenFullResolution(uint64 Key)
+{
+	FImageEntry* Entry = Entries.Find(Key);
+	if (!Entry || Entry->Thumbnail.bFailed || Entry->Full.bFailed)
+	{
+		return;
+	}
+
+	// Pinned slots are never evicted, so an open viewer cannot thrash against the budget
+	Entry->Full.PinCount++;
+	RequestDecode(Key, EUnrealGPTImageResolution::Full);
+
+	FVector2D ClientSize(1280.0f, 720.0f);
+	if (Entry->SourceSize.X > 0 && Entry->SourceSize.Y > 0)
+	{
+		const float Scale = FMath::Min3(1.0f, 1600.0f / Entry->SourceSize.X, 1000.0f / Entry->SourceSize.Y);
+		ClientSize = FVector2D(Entry->SourceSize) * Scale;
+	}
+
+	TWeakPtr<FUnrealGPTImageCache> WeakCache = AsShared();
+
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(NSLOCTEXT("UnrealGPT", "ImageViewerTitle", "UnrealGPT Image"))
+		.ClientSize(ClientSize)
+		.SupportsMinimize(false)
+		[
+			SNew(SBorder)
+			.BorderImage(FAppStyle::GetBrush("Brushes.Panel"))
+			.Padding(0.0f)
+			[
+				SNew(SScaleBox)
+				.Stretch(EStretch::ScaleToFit)
+				[
+					SNew(SUnrealGPTCachedImage, WeakCache, Key, EUnrealGPTImageResolution::Full)
+				]
+			]
+		];
+
+	Window->SetOnWindowClosed(FOnWindowClosed::CreateLambda([WeakCache, Key](const TSharedRef<SWindow>&)
+	{
+		if (TSharedPtr<FUnrealGPTImageCache> Cache = WeakCache.Pin())
+		{
+			Cache->ReleaseFullResolution(Key);
+		}
+	}));
+
+	FSlateApplication::Get().AddWindow(Window);
+}
+
+void FUnrealGPTImageCache::Reset()
+{
+	for (TPair<uint64, FImageEntry>& Pair : Entries)
+	{
+		ReleaseSlot(Pair.Value.Thumbnail);
+		ReleaseSlot(Pair.Value.Full);
+	}
+
+	Entries.Empty();
+	ResidentBytes = 0;
+	++Generation;
+}
+
+FUnrealGPTImageCache::FImageSlot& FUnrealGPTImageCache::GetSlot(FImageEntry& Entry, EUnrealGPTImageResolution Resolution)
+{
+	return Resolution == EUnrealGPTImageResolution::Full ? Entry.Full : Entry.Thumbnail;
+}
+
+void FUnrealGPTImageCache::RequestDecode(uint64 Key, EUnrealGPTImageResolution Resolution)
+{
+	FImageEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	FImageSlot& Slot = GetSlot(*Entry, Resolution);
+	if (Slot.Texture || Slot.bLoading || Slot.bFailed)
+	{
+		return;
+	}
+	Slot.bLoading = true;
+
+	const FIntPoint MaxSize = Resolution == EUnrealGPTImageResolution::Thumbnail ? Entry->ThumbnailMaxSize : FIntPoint::ZeroValue;
+	TSharedPtr<const FString, ESPMode::ThreadSafe> Source = Entry->Source;
+	IImageWrapperModule* WrapperModule = ImageWrapperModule;
+	TWeakPtr<FUnrealGPTImageCache> WeakCache = AsShared();
+	const uint32 RequestGeneration = Generation;
+
+	Async(EAsyncExecution::ThreadPool, [WeakCache, WrapperModule, Source, MaxSize, Key, Resolution, RequestGeneration]()
+	{
+		TSharedRef<FUnrealGPTDecodedImage, ESPMode::ThreadSafe> Decoded = MakeShared<FUnrealGPTDecodedImage, ESPMode::ThreadSafe>();
+		{
+			UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_DecodeImage);
+			DecodeChatImage(*WrapperModule, *Source, MaxSize, *Decoded);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakCache, Decoded, Key, Resolution, RequestGeneration]()
+		{
+			// The widget (and its cache) may have been destroyed while decoding
+			if (TSharedPtr<FUnrealGPTImageCache> Cache = WeakCache.Pin())
+			{
+				Cache->OnDecodeFinished(Key, Resolution, RequestGeneration, *Decoded);
+			}
+		});
+	});
+}
+
+void FUnrealGPTImageCache::OnDecodeFinished(uint64 Key, EUnrealGPTImageResolution Resolution, uint32 RequestGeneration, const FUnrealGPTDecodedImage& Decoded)
+{
+	if (RequestGeneration != Generation)
+	{
+		return;
+	}
+
+	FImageEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	FImageSlot& Slot = GetSlot(*Entry, Resolution);
+	Slot.bLoading = false;
+
+	if (!Decoded.bSuccess)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to decode chat image (not a valid JPEG or PNG)"));
+		Slot.bFailed = true;
+		return;
+	}
+
+	Entry->SourceSize = Decoded.SourceSize;
+
+	// The viewer window was closed before the full-resolution decode finished
+	if (Resolution == EUnrealGPTImageResolution::Full && Slot.PinCount == 0)
+	{
+		return;
+	}
+
+	UTexture2D* Texture = CreateChatTexture(Decoded);
+	if (!Texture)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to create texture for chat image"));
+		Slot.bFailed = true;
+		return;
+	}
+
+	// Slate brushes hold raw pointers to textures, so keep them alive until evicted
+	Texture->AddToRoot();
+
+	Slot.Texture = Texture;
+	Slot.Bytes = Decoded.Pixels.Num();
+	Slot.Brush->SetResourceObject(Texture);
+	Slot.Brush->ImageSize = FVector2D(Decoded.Size);
+	Slot.Brush->DrawAs = ESlateBrushDrawType::Image;
+	ResidentBytes += Slot.Bytes;
+
+	EnforceBudget(&Slot);
+}
+
+void FUnrealGPTImageCache::ReleaseFullResolution(uint64 Key)
+{
+	FImageEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	Entry->Full.PinCount = FMath::Max(0, Entry->Full.PinCount - 1);
+	if (Entry->Full.PinCount == 0)
+	{
+		ReleaseSlot(Entry->Full);
+	}
+}
+
+void FUnrealGPTImageCache::ReleaseSlot(FImageSlot& Slot)
+{
+	if (Slot.Brush.IsValid())
+	{
+		Slot.Brush->SetResourceObject(nullptr);
+		Slot.Brush->DrawAs = ESlateBrushDrawType::NoDrawType;
+	}
+
+	if (Slot.Texture)
+	{
+		if (IsValid(Slot.Texture) && Slot.Texture->IsRooted())
+		{
+			Slot.Texture->RemoveFromRoot();
+		}
+		Slot.Texture = nullptr;
+		ResidentBytes -= Slot.Bytes;
+	}
+
+	Slot.Bytes = 0;
+}
+
+void FUnrealGPTImageCache::EnforceBudget(const FImageSlot* KeepSlot)
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	const int64 BudgetBytes = static_cast<int64>(FMath::Max(1, Settings->ImageCacheBudgetMB)) * 1024 * 1024;
+
+	while (ResidentBytes > BudgetBytes)
+	{
+		// Anything painted this frame or last frame is on screen; evicting it would only cause a re-decode
+		FImageSlot* Victim = nullptr;
+		for (TPair<uint64, FImageEntry>& Pair : Entries)
+		{
+			for (FImageSlot* Slot : { &Pair.Value.Thumbnail, &Pair.Value.Full })
+			{
+				if (!Slot->Texture || Slot == KeepSlot || Slot->PinCount > 0 || Slot->LastUsedFrame + 1 >= GFrameCounter)
+				{
+					continue;
+				}
+				if (!Victim || Slot->LastUsedFrame < Victim->LastUsedFrame)
+				{
+					Victim = Slot;
+				}
+			}
+		}
+
+		if (!Victim)
+		{
+			break;
+		}
+
+		ReleaseSlot(*Victim);
+	}
+}
+
+FVector2D FUnrealGPTImageCache::GetDisplaySize(uint64 Key, const FVector2D& MaxDisplaySize) const
+{
+	const FImageEntry* Entry = Entries.Find(Key);
+	if (!Entry || Entry->SourceSize.X <= 0 || Entry->SourceSize.Y <= 0)
+	{
+		return FVector2D(MaxDisplaySize.X * 0.5f, 48.0f);
+	}
+
+	const float Scale = FMath::Min3(1.0f,
+		static_cast<float>(MaxDisplaySize.X) / Entry->SourceSize.X,
+		static_cast<float>(MaxDisplaySize.Y) / Entry->SourceSize.Y);
+	return FVector2D(Entry->SourceSize) * Scale;
+}
+
+bool FUnrealGPTImageCache::IsResident(uint64 Key) const
+{
+	const FImageEntry* Entry = Entries.Find(Key);
+	return Entry && Entry->Thumbnail.Texture != nullptr;
+}
+
+bool FUnrealGPTImageCache::HasFailed(uint64 Key) const
+{
+	const FImageEntry* Entry = Entries.Find(Key);
+	return Entry && Entry->Thumbnail.bFailed;
+}
+
+FVector2D FUnrealGPTImageCache::GetImageSize(uint64 Key, EUnrealGPTImageResolution Resolution) const
+{
+	const FImageEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const FImageSlot& Slot = Resolution == EUnrealGPTImageResolution::Full ? Entry->Full : Entry->Thumbnail;
+	return Slot.Texture ? Slot.Brush->ImageSize : FVector2D(Entry->SourceSize);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Styling/SlateBrush.h"
+
+class SWidget;
+class UTexture2D;
+class IImageWrapperModule;
+struct FUnrealGPTDecodedImage;
+
+/** Which decoded representation of a chat image is requested */
+enum class EUnrealGPTImageResolution : uint8
+{
+	Thumbnail,	// Downscaled to the size it is displayed at in the chat panel
+	Full		// Original resolution, only decoded when the user opens the image
+};
+
+/**
+ * Bounded pool of textures for images shown in the chat panel.
+ *
+ * Images are registered as base64 JPEG/PNG data and decoded on worker threads the first time
+ * they are painted. Only the texture upload happens on the game thread. Resident textures are
+ * kept in an LRU pool capped by the "Image Cache Budget" setting; evicted images are decoded
+ * again when they scroll back into view.
+ */
+class FUnrealGPTImageCache : public TSharedFromThis<FUnrealGPTImageCache>
+{
+public:
+	FUnrealGPTImageCache();
+	~FUnrealGPTImageCache();
+
+	/** Register a base64-encoded image and return its key. Identical images share one entry. */
+	uint64 AddImage(const FString& ImageBase64);
+
+	/** Create a chat widget showing a thumbnail of a registered image. Clicking it opens the full-resolution view. */
+	TSharedRef<SWidget> CreateThumbnailWidget(uint64 Key, const FVector2D& MaxDisplaySize);
+
+	/**
+	 * Get the brush for an image and mark it as recently used.
+	 * Starts an async decode if the texture is not resident; the brush draws nothing until it arrives.
+	 * Returns nullptr for unknown keys. Only call it while painting the image, never from an attribute,
+	 * or off-screen images count as used and the pool can no longer evict them.
+	 */
+	const FSlateBrush* GetBrush(uint64 Key, EUnrealGPTImageResolution Resolution);
+
+	/** Pixel size of the resident texture, or the source size until it is decoded; does not mark the image as used */
+	FVector2D GetImageSize(uint64 Key, EUnrealGPTImageResolution Resolution) const;
+
+	/** Open an image at full resolution in a separate window. The texture is released when the window closes. */
+	void OpenFullResolution(uint64 Key);
+
+	/** Release every texture and forget all registered images */
+	void Reset();
+
+	/** Bytes of texture data currently resident in the pool */
+	int64 GetResidentBytes() const { return ResidentBytes; }
+
+private:
+	struct FImageSlot
+	{
+		/** Rooted while resident; released on eviction */
+		UTexture2D* Texture = nullptr;
+
+		/** Stable for the lifetime of the entry since Slate keeps raw pointers to it */
+		TSharedPtr<FSlateBrush> Brush;
+
+		int64 Bytes = 0;
+		uint64 LastUsedFrame = 0;
+		int32 PinCount = 0;
+		bool bLoading = false;
+
+		/** Set when this resolution could not be decoded or uploaded; it is not retried */
+		bool bFailed = false;
+	};
+
+	struct FImageEntry
+	{
+		/** Base64 source, shared with in-flight decode tasks */
+		TSharedPtr<const FString, ESPMode::ThreadSafe> Source;
+
+		/** Original pixel size, known after the first decode */
+		FIntPoint SourceSize = FIntPoint::ZeroValue;
+
+		/** Largest thumbnail size requested by any widget, in physical pixels */
+		FIntPoint ThumbnailMaxSize = FIntPoint::ZeroValue;
+
+		FImageSlot Thumbnail;
+		FImageSlot Full;
+	};
+
+	static FImageSlot& GetSlot(FImageEntry& Entry, EUnrealGPTImageResolution Resolution);
+
+	/** Kick off a worker-thread decode for a slot that is not resident or already loading */
+	void RequestDecode(uint64 Key, EUnrealGPTImageResolution Resolution);
+
+	/** Game-thread completion of a decode: uploads the texture and enforces the budget */
+	void OnDecodeFinished(uint64 Key, EUnrealGPTImageResolution Resolution, uint32 RequestGeneration, const FUnrealGPTDecodedImage& Decoded);
+
+	/** Drop the full-resolution texture once no viewer window references it */
+	void ReleaseFullResolution(uint64 Key);
+
+	void ReleaseSlot(FImageSlot& Slot);
+
+	/** Evict least recently painted textures until the pool fits the budget */
+	void EnforceBudget(const FImageSlot* KeepSlot);
+
+	/** Size the thumbnail occupies in the chat panel (placeholder size until the image has been decoded once) */
+	FVector2D GetDisplaySize(uint64 Key, const FVector2D& MaxDisplaySize) const;
+
+	bool IsResident(uint64 Key) const;
+	bool HasFailed(uint64 Key) const;
+
+	TMap<uint64, FImageEntry> Entries;
+
+	int64 ResidentBytes = 0;
+
+	/** Bumped by Reset() so decodes that finish afterwards are discarded */
+	uint32 Generation = 0;
+
+	/** Loaded on the game thread at construction; CreateImageWrapper is safe to call from workers */
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+};
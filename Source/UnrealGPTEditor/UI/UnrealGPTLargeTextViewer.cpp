@@ -0,0 +1,457 @@
+#include "UnrealGPTLargeTextViewer.h"
+#include "UnrealGPTChatStyle.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SScrollBar.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Styling/AppStyle.h"
+#include "Styling/CoreStyle.h"
+
+using namespace UnrealGPTChatStyle;
+
+namespace
+{
+	/** Longer lines are split into several rows (single-line JSON dumps would otherwise be one giant row) */
+	constexpr int64 MaxDisplayBytesPerLine = 2000;
+
+	/** Lines moved per mouse wheel notch */
+	constexpr int32 WheelScrollLines = 3;
+
+	FORCEINLINE uint8 ToLowerAscii(uint8 Byte)
+	{
+		return (Byte >= 'A' && Byte <= 'Z') ? Byte + ('a' - 'A') : Byte;
+	}
+}
+
+void SUnrealGPTLargeTextViewer::Construct(const FArguments& InArgs)
+{
+	FilePath = InArgs._FilePath;
+	NumRows = FMath::Max(1, InArgs._VisibleRows);
+
+	if (!MapFile())
+	{
+		ChildSlot
+		[
+			SNew(STextBlock)
+			.Text(FText::Format(NSLOCTEXT("UnrealGPT", "LargeResultMissing", "Full result is no longer available: {0}"), FText::FromString(FilePath)))
+			.Font(GetUnrealGPTSmallBodyItalicFont())
+			.ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f, 1.0f))
+			.AutoWrapText(true)
+		];
+		return;
+	}
+
+	BuildLineIndex();
+
+	const FSlateFontInfo MonoFont = FCoreStyle::GetDefaultFontStyle("Mono", 8);
+
+	TSharedRef<SVerticalBox> GutterBox = SNew(SVerticalBox);
+	TSharedRef<SVerticalBox> RowBox = SNew(SVerticalBox);
+
+	for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+	{
+		TSharedPtr<STextBlock> Row;
+		RowBox->AddSlot()
+			.AutoHeight()
+			[
+				SAssignNew(Row, STextBlock)
+				.Font(MonoFont)
+				.ColorAndOpacity(FLinearColor(0.9f, 0.9f, 0.9f, 1.0f))
+				.HighlightText_Lambda([this]() { return SearchText; })
+			];
+		Rows.Add(Row);
+
+		// Line numbers track FirstVisibleLine without needing a refresh
+		GutterBox->AddSlot()
+			.AutoHeight()
+			.HAlign(HAlign_Right)
+			[
+				SNew(STextBlock)
+				.Font(MonoFont)
+				.ColorAndOpacity(FLinearColor(0.4f, 0.4f, 0.4f, 1.0f))
+				.Text_Lambda([this, RowIndex]()
+				{
+					const int32 LineIndex = FirstVisibleLine + RowIndex;
+					return LineIndex < LineStarts.Num() ? FText::AsNumber(LineIndex + 1, &FNumberFormattingOptions::DefaultNoGrouping()) : FText::GetEmpty();
+				})
+			];
+	}
+
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderImage(FAppStyle::GetBrush("Brushes.Recessed"))
+		.BorderBackgroundColor(FLinearColor(0.02f, 0.02f, 0.02f, 1.0f))
+		.Padding(FMargin(6.0f))
+		[
+			SNew(SVerticalBox)
+
+			// Search toolbar
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 0.0f, 0.0f, 6.0f)
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				[
+					SNew(SSearchBox)
+					.HintText(NSLOCTEXT("UnrealGPT", "LargeResultSearchHint", "Search result..."))
+					.OnTextChanged(this, &SUnrealGPTLargeTextViewer::OnSearchTextChanged)
+					.OnTextCommitted(this, &SUnrealGPTLargeTextViewer::OnSearchTextCommitted)
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(4.0f, 0.0f, 0.0f, 0.0f)
+				[
+					SNew(SButton)
+					.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+					.ToolTipText(NSLOCTEXT("UnrealGPT", "LargeResultPrevious", "Previous match"))
+					.OnClicked(this, &SUnrealGPTLargeTextViewer::OnFindNext, false)
+					[
+						SNew(STextBlock)
+						.Font(FAppStyle::Get().GetFontStyle("FontAwesome.10"))
+						.Text(FText::FromString(FString(TEXT("\xf077")))) // Chevron up
+					]
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+					.ToolTipText(NSLOCTEXT("UnrealGPT", "LargeResultNext", "Next match"))
+					.OnClicked(this, &SUnrealGPTLargeTextViewer::OnFindNext, true)
+					[
+						SNew(STextBlock)
+						.Font(FAppStyle::Get().GetFontStyle("FontAwesome.10"))
+						.Text(FText::FromString(FString(TEXT("\xf078")))) // Chevron down
+					]
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+					.ToolTipText(NSLOCTEXT("UnrealGPT", "LargeResultOpen", "Open the full result in the default text editor"))
+					.OnClicked_Lambda([this]()
+					{
+						FPlatformProcess::LaunchFileInDefaultExternalApplication(*FilePath);
+						return FReply::Handled();
+					})
+					[
+						SNew(STextBlock)
+						.Font(FAppStyle::Get().GetFontStyle("FontAwesome.10"))
+						.Text(FText::FromString(FString(TEXT("\xf08e")))) // External link
+					]
+				]
+			]
+
+			// Visible rows
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					GutterBox
+				]
+
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				[
+					RowBox
+				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew(ScrollBar, SScrollBar)
+					.Orientation(Orient_Vertical)
+					.AlwaysShowScrollbar(true)
+					.OnUserScrolled(this, &SUnrealGPTLargeTextViewer::OnUserScrolled)
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SUnrealGPTLargeTextViewer::GetStatusText)
+				.Font(GetUnrealGPTSmallBodyFont())
+				.ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
+			]
+		]
+	];
+
+	RefreshRows();
+}
+
+SUnrealGPTLargeTextViewer::~SUnrealGPTLargeTextViewer()
+{
+	// The region must be released before the handle it was mapped from
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+bool SUnrealGPTLargeTextViewer::MapFile()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (FilePath.IsEmpty() || !PlatformFile.FileExists(*FilePath) || PlatformFile.FileSize(*FilePath) <= 0)
+	{
+		return false;
+	}
+
+	FOpenMappedResult OpenResult = PlatformFile.OpenMappedEx(*FilePath);
+	if (OpenResult.HasError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to memory-map tool result file: %s"), *FilePath);
+		return false;
+	}
+
+	MappedHandle = OpenResult.StealValue();
+	MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+	if (!MappedRegion.IsValid())
+	{
+		MappedHandle.Reset();
+		return false;
+	}
+
+	Data = MappedRegion->GetMappedPtr();
+	DataSize = MappedRegion->GetMappedSize();
+	return Data != nullptr;
+}
+
+void SUnrealGPTLargeTextViewer::BuildLineIndex()
+{
+	LineStarts.Reset();
+	LineStarts.Add(0);
+
+	for (int64 Offset = 0; Offset < DataSize; ++Offset)
+	{
+		if (Data[Offset] == '\n')
+		{
+			if (Offset + 1 < DataSize)
+			{
+				LineStarts.Add(Offset + 1);
+			}
+		}
+		else if (Offset - LineStarts.Last() >= MaxDisplayBytesPerLine && (Data[Offset] & 0xC0) != 0x80)
+		{
+			// Soft break, never inside a UTF-8 sequence
+			LineStarts.Add(Offset);
+		}
+	}
+}
+
+FString SUnrealGPTLargeTextViewer::GetLine(int32 LineIndex) const
+{
+	if (!LineStarts.IsValidIndex(LineIndex))
+	{
+		return FString();
+	}
+
+	const int64 Start = LineStarts[LineIndex];
+	int64 End = LineStarts.IsValidIndex(LineIndex + 1) ? LineStarts[LineIndex + 1] : DataSize;
+	while (End > Start && (Data[End - 1] == '\n' || Data[End - 1] == '\r'))
+	{
+		--End;
+	}
+
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Start), static_cast<int32>(End - Start));
+	return FString(Converted.Length(), Converted.Get());
+}
+
+void SUnrealGPTLargeTextViewer::ScrollToLine(int32 LineIndex)
+{
+	const int32 MaxFirstLine = FMath::Max(0, LineStarts.Num() - NumRows);
+	const int32 NewFirstLine = FMath::Clamp(LineIndex, 0, MaxFirstLine);
+	if (NewFirstLine != FirstVisibleLine)
+	{
+		FirstVisibleLine = NewFirstLine;
+		RefreshRows();
+	}
+}
+
+void SUnrealGPTLargeTextViewer::RefreshRows()
+{
+	// Only the visible window is ever decoded
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		Rows[RowIndex]->SetText(FText::FromString(GetLine(FirstVisibleLine + RowIndex)));
+	}
+
+	if (ScrollBar.IsValid() && LineStarts.Num() > 0)
+	{
+		const float NumLines = static_cast<float>(LineStarts.Num());
+		ScrollBar->SetState(FirstVisibleLine / NumLines, FMath::Min(1.0f, NumRows / NumLines));
+	}
+}
+
+void SUnrealGPTLargeTextViewer::OnUserScrolled(float ScrollOffset)
+{
+	ScrollToLine(FMath::RoundToInt(ScrollOffset * LineStarts.Num()));
+}
+
+FReply SUnrealGPTLargeTextViewer::OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (!IsValid() || LineStarts.Num() <= NumRows)
+	{
+		return FReply::Unhandled();
+	}
+
+	// Consume the wheel so the chat history does not scroll underneath
+	ScrollToLine(FirstVisibleLine - FMath::RoundToInt(MouseEvent.GetWheelDelta()) * WheelScrollLines);
+	return FReply::Handled();
+}
+
+void SUnrealGPTLargeTextViewer::OnSearchTextChanged(const FText& InText)
+{
+	SearchText = InText;
+
+	const FTCHARToUTF8 Utf8(*InText.ToString());
+	SearchBytes.Reset(Utf8.Length());
+	for (int32 Index = 0; Index < Utf8.Length(); ++Index)
+	{
+		SearchBytes.Add(ToLowerAscii(static_cast<uint8>(Utf8.Get()[Index])));
+	}
+
+	// Search as you type, starting from the top of the current view
+	CurrentMatchOffset = INDEX_NONE;
+	CurrentMatchLine = INDEX_NONE;
+	if (SearchBytes.Num() > 0)
+	{
+		const int64 Match = FindMatch(LineStarts.IsValidIndex(FirstVisibleLine) ? LineStarts[FirstVisibleLine] : 0, true);
+		if (Match != INDEX_NONE)
+		{
+			CurrentMatchOffset = Match;
+			CurrentMatchLine = GetLineForOffset(Match);
+			if (CurrentMatchLine < FirstVisibleLine || CurrentMatchLine >= FirstVisibleLine + NumRows)
+			{
+				ScrollToLine(CurrentMatchLine - NumRows / 2);
+			}
+		}
+	}
+}
+
+void SUnrealGPTLargeTextViewer::OnSearchTextCommitted(const FText& InText, ETextCommit::Type CommitType)
+{
+	if (CommitType == ETextCommit::OnEnter)
+	{
+		OnFindNext(true);
+	}
+}
+
+FReply SUnrealGPTLargeTextViewer::OnFindNext(bool bForward)
+{
+	if (SearchBytes.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	const int64 StartOffset = CurrentMatchOffset == INDEX_NONE
+		? (bForward ? 0 : DataSize - 1)
+		: (bForward ? CurrentMatchOffset + 1 : CurrentMatchOffset - 1);
+
+	int64 Match = FindMatch(StartOffset, bForward);
+	if (Match == INDEX_NONE)
+	{
+		// Wrap around
+		Match = FindMatch(bForward ? 0 : DataSize - 1, bForward);
+	}
+
+	if (Match != INDEX_NONE)
+	{
+		CurrentMatchOffset = Match;
+		CurrentMatchLine = GetLineForOffset(Match);
+		ScrollToLine(CurrentMatchLine - NumRows / 2);
+	}
+	return FReply::Handled();
+}
+
+int64 SUnrealGPTLargeTextViewer::FindMatch(int64 StartOffset, bool bForward) const
+{
+	const int64 NeedleLength = SearchBytes.Num();
+	if (NeedleLength == 0 || NeedleLength > DataSize)
+	{
+		return INDEX_NONE;
+	}
+
+	const int64 LastStart = DataSize - NeedleLength;
+	const uint8 FirstByte = SearchBytes[0];
+
+	auto MatchesAt = [this, NeedleLength](int64 Offset)
+	{
+		for (int64 Index = 1; Index < NeedleLength; ++Index)
+		{
+			if (ToLowerAscii(Data[Offset + Index]) != SearchBytes[Index])
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	if (bForward)
+	{
+		for (int64 Offset = FMath::Max<int64>(StartOffset, 0); Offset <= LastStart; ++Offset)
+		{
+			if (ToLowerAscii(Data[Offset]) == FirstByte && MatchesAt(Offset))
+			{
+				return Offset;
+			}
+		}
+	}
+	else
+	{
+		for (int64 Offset = FMath::Min(StartOffset, LastStart); Offset >= 0; --Offset)
+		{
+			if (ToLowerAscii(Data[Offset]) == FirstByte && MatchesAt(Offset))
+			{
+				return Offset;
+			}
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 SUnrealGPTLargeTextViewer::GetLineForOffset(int64 Offset) const
+{
+	// Last line start that is <= Offset
+	const int32 UpperBound = Algo::UpperBound(LineStarts, Offset);
+	return FMath::Max(0, UpperBound - 1);
+}
+
+FText SUnrealGPTLargeTextViewer::GetStatusText() const
+{
+	const int32 LastVisibleLine = FMath::Min(FirstVisibleLine + NumRows, LineStarts.Num());
+	FText Status = FText::Format(NSLOCTEXT("UnrealGPT", "LargeResultStatus", "Lines {0}-{1} of {2} ({3})"),
+		FText::AsNumber(FirstVisibleLine + 1),
+		FText::AsNumber(LastVisibleLine),
+		FText::AsNumber(LineStarts.Num()),
+		FText::AsMemory(static_cast<uint64>(DataSize)));
+
+	if (SearchBytes.Num() > 0)
+	{
+		Status = CurrentMatchLine == INDEX_NONE
+			? FText::Format(NSLOCTEXT("UnrealGPT", "LargeResultNoMatch", "{0} - no matches"), Status)
+			: FText::Format(NSLOCTEXT("UnrealGPT", "LargeResultMatch", "{0} - match on line {1}"), Status, FText::AsNumber(CurrentMatchLine + 1));
+	}
+	return Status;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class SScrollBar;
+class STextBlock;
+
+/**
+ * Read-only viewer for tool results that were spilled to a scratch file.
+ *
+ * The file is memory-mapped and indexed by line offsets once; only the rows currently on
+ * screen are decoded into Slate text, so a multi-megabyte dump costs a fixed number of
+ * text blocks regardless of its size. Supports incremental search over the mapped bytes.
+ */
+class SUnrealGPTLargeTextViewer : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SUnrealGPTLargeTextViewer)
+		: _VisibleRows(18)
+	{}
+		/** UTF-8 file to display */
+		SLATE_ARGUMENT(FString, FilePath)
+		/** Number of text rows kept alive */
+		SLATE_ARGUMENT(int32, VisibleRows)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	virtual ~SUnrealGPTLargeTextViewer() override;
+
+	virtual FReply OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+	/** True if the file could be mapped */
+	bool IsValid() const { return Data != nullptr; }
+
+private:
+	bool MapFile();
+	void BuildLineIndex();
+
+	/** Decode one row from the mapped bytes */
+	FString GetLine(int32 LineIndex) const;
+
+	void ScrollToLine(int32 LineIndex);
+	void RefreshRows();
+	void OnUserScrolled(float ScrollOffset);
+
+	void OnSearchTextChanged(const FText& InText);
+	void OnSearchTextCommitted(const FText& InText, ETextCommit::Type CommitType);
+	FReply OnFindNext(bool bForward);
+
+	/** Byte offset of the next/previous case-insensitive match of the search text, or INDEX_NONE */
+	int64 FindMatch(int64 StartOffset, bool bForward) const;
+
+	int32 GetLineForOffset(int64 Offset) const;
+
+	FText GetStatusText() const;
+
+	FString FilePath;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	/** Byte offset of the start of each row; long lines are split into several rows */
+	TArray<int64> LineStarts;
+
+	int32 NumRows = 18;
+	int32 FirstVisibleLine = 0;
+
+	TArray<TSharedPtr<STextBlock>> Rows;
+	TSharedPtr<SScrollBar> ScrollBar;
+
+	/** UTF-8 lower-cased search query */
+	TArray<uint8> SearchBytes;
+	FText SearchText;
+	int64 CurrentMatchOffset = INDEX_NONE;
+	int32 CurrentMatchLine = INDEX_NONE;
+};
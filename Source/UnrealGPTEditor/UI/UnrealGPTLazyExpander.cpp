@@ -0,0 +1,142 @@
+#include "UnrealGPTLazyExpander.h"
+#include "UnrealGPTChatStyle.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Styling/AppStyle.h"
+
+using namespace UnrealGPTChatStyle;
+
+void SUnrealGPTLazyExpander::Construct(const FArguments& InArgs)
+{
+	OnGenerateDetails = InArgs._OnGenerateDetails;
+
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderImage(FAppStyle::GetBrush("Brushes.White"))
+		.BorderBackgroundColor(FLinearColor(0.04f, 0.04f, 0.04f, 1.0f))
+		.Padding(FMargin(8.0f, 4.0f))
+		[
+			SNew(SVerticalBox)
+
+			// Header row - the only part that exists while collapsed
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SButton)
+				.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+				.ContentPadding(FMargin(2.0f))
+				.OnClicked(this, &SUnrealGPTLazyExpander::OnHeaderClicked)
+				[
+					SNew(SHorizontalBox)
+
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					.Padding(0.0f, 0.0f, 6.0f, 0.0f)
+					[
+						SNew(STextBlock)
+						.Font(FAppStyle::Get().GetFontStyle("FontAwesome.9"))
+						.Text_Lambda([this]()
+						{
+							return FText::FromString(bExpanded ? FString(TEXT("\xf078")) : FString(TEXT("\xf054"))); // Chevron down / right
+						})
+						.ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f, 1.0f))
+					]
+
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+					[
+						SNew(SBox)
+						.WidthOverride(20.0f)
+						.HeightOverride(20.0f)
+						[
+							SNew(SBorder)
+							.BorderImage(FAppStyle::GetBrush("Brushes.White"))
+							.BorderBackgroundColor(InArgs._AccentColor)
+							.Padding(0.0f)
+							.HAlign(HAlign_Center)
+							.VAlign(VAlign_Center)
+							[
+								SNew(STextBlock)
+								.Font(FAppStyle::Get().GetFontStyle("FontAwesome.10"))
+								.Text(FText::FromString(InArgs._Icon))
+								.ColorAndOpacity(FLinearColor::White)
+							]
+						]
+					]
+
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+					[
+						SNew(STextBlock)
+						.Text(InArgs._Title)
+						.Font(GetUnrealGPTBodyBoldFont())
+						.ColorAndOpacity(InArgs._AccentColor)
+					]
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text(InArgs._Summary)
+						.ToolTipText(InArgs._Summary)
+						.Font(GetUnrealGPTSmallBodyFont())
+						.ColorAndOpacity(FLinearColor(0.7f, 0.7f, 0.7f, 1.0f))
+						.OverflowPolicy(ETextOverflowPolicy::Ellipsis)
+					]
+				]
+			]
+
+			// Details - generated on expand, emptied on collapse
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SAssignNew(DetailsBox, SBox)
+				.Visibility(EVisibility::Collapsed)
+				.Padding(FMargin(0.0f, 6.0f, 0.0f, 4.0f))
+			]
+		]
+	];
+
+	if (InArgs._InitiallyExpanded)
+	{
+		SetExpanded(true);
+	}
+}
+
+void SUnrealGPTLazyExpander::SetExpanded(bool bInExpanded)
+{
+	if (bExpanded == bInExpanded || !DetailsBox.IsValid())
+	{
+		return;
+	}
+
+	bExpanded = bInExpanded;
+
+	if (bExpanded && OnGenerateDetails.IsBound())
+	{
+		DetailsBox->SetContent(OnGenerateDetails.Execute());
+		DetailsBox->SetVisibility(EVisibility::Visible);
+	}
+	else
+	{
+		// Drop the details tree so collapsed entries cost only their header
+		DetailsBox->SetContent(SNullWidget::NullWidget);
+		DetailsBox->SetVisibility(EVisibility::Collapsed);
+	}
+}
+
+FReply SUnrealGPTLazyExpander::OnHeaderClicked()
+{
+	SetExpanded(!bExpanded);
+	return FReply::Handled();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+
+class SBox;
+
+/** Builds the detailed body of an expander when it is opened */
+DECLARE_DELEGATE_RetVal(TSharedRef<SWidget>, FOnGenerateUnrealGPTDetails);
+
+/**
+ * Collapsible chat entry that shows a one-line header until expanded.
+ *
+ * The detailed widget tree is generated on expand and released on collapse, so a long tool
+ * loop only keeps the lightweight headers alive.
+ */
+class SUnrealGPTLazyExpander : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SUnrealGPTLazyExpander)
+		: _AccentColor(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
+		, _InitiallyExpanded(false)
+	{}
+		/** Font Awesome glyph shown in the colored badge */
+		SLATE_ARGUMENT(FString, Icon)
+		/** Bold title, e.g. the tool name */
+		SLATE_ARGUMENT(FText, Title)
+		/** One-line summary shown next to the title */
+		SLATE_ARGUMENT(FText, Summary)
+		SLATE_ARGUMENT(FLinearColor, AccentColor)
+		SLATE_ARGUMENT(bool, InitiallyExpanded)
+		SLATE_EVENT(FOnGenerateUnrealGPTDetails, OnGenerateDetails)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	bool IsExpanded() const { return bExpanded; }
+
+	/** Expand (building the details) or collapse (releasing them) */
+	void SetExpanded(bool bInExpanded);
+
+private:
+	FReply OnHeaderClicked();
+
+	FOnGenerateUnrealGPTDetails OnGenerateDetails;
+
+	TSharedPtr<SBox> DetailsBox;
+
+	bool bExpanded = false;
+};
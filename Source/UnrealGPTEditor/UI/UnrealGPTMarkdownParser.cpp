@@ -0,0 +1,186 @@
+#include "UnrealGPTMarkdownParser.h"
+#include "Hash/CityHash.h"
+
+namespace
+{
+	// Find the end of the line starting at Offset. Returns the index of the '\n' or Text.Len().
+	int32 FindLineEnd(const FString& Text, int32 Offset)
+	{
+		const TCHAR* Data = *Text;
+		const int32 Length = Text.Len();
+		int32 Pos = Offset;
+		while (Pos < Length && Data[Pos] != TEXT('\n'))
+		{
+			++Pos;
+		}
+		return Pos;
+	}
+
+	FString GetLine(const FString& Text, int32 Start, int32 End)
+	{
+		// Strip a trailing '\r' from CRLF text
+		if (End > Start && Text[End - 1] == TEXT('\r'))
+		{
+			--End;
+		}
+		return Text.Mid(Start, End - Start);
+	}
+
+	bool IsFenceLine(const FString& Text, int32 LineStart, int32 LineEnd)
+	{
+		return LineEnd - LineStart >= 3
+			&& Text[LineStart] == TEXT('`')
+			&& Text[LineStart + 1] == TEXT('`')
+			&& Text[LineStart + 2] == TEXT('`');
+	}
+}
+
+int32 FUnrealGPTMarkdownDocument::SetText(const FString& InText)
+{
+	if (InText.StartsWith(Text, ESearchCase::CaseSensitive))
+	{
+		return Append(InText.Mid(Text.Len()));
+	}
+
+	// Length of the unchanged prefix
+	const int32 MaxCommon = FMath::Min(Text.Len(), InText.Len());
+	int32 Common = 0;
+	while (Common < MaxCommon && Text[Common] == InText[Common])
+	{
+		++Common;
+	}
+
+	// Closed blocks that end inside the common prefix are unaffected
+	int32 FirstChanged = 0;
+	while (FirstChanged < Blocks.Num()
+		&& !Blocks[FirstChanged].bOpen
+		&& Blocks[FirstChanged].SourceStart + Blocks[FirstChanged].SourceLength <= Common)
+	{
+		++FirstChanged;
+	}
+
+	Text = InText;
+	ReparseFrom(FirstChanged);
+	return FirstChanged;
+}
+
+int32 FUnrealGPTMarkdownDocument::Append(const FString& Delta)
+{
+	const int32 FirstChanged = (Blocks.Num() > 0 && Blocks.Last().bOpen) ? Blocks.Num() - 1 : Blocks.Num();
+	if (Delta.IsEmpty())
+	{
+		return Blocks.Num();
+	}
+
+	Text += Delta;
+	ReparseFrom(FirstChanged);
+	return FirstChanged;
+}
+
+void FUnrealGPTMarkdownDocument::ReparseFrom(int32 BlockIndex)
+{
+	int32 Offset = 0;
+	if (Blocks.IsValidIndex(BlockIndex))
+	{
+		Offset = Blocks[BlockIndex].SourceStart;
+	}
+	else if (Blocks.Num() > 0)
+	{
+		const FUnrealGPTMarkdownBlock& Last = Blocks.Last();
+		Offset = Last.SourceStart + Last.SourceLength;
+	}
+
+	Blocks.SetNum(FMath::Min(BlockIndex, Blocks.Num()));
+
+	const int32 Length = Text.Len();
+	while (Offset < Length)
+	{
+		FUnrealGPTMarkdownBlock Block = ParseBlock(Offset);
+		Offset += Block.SourceLength;
+		Blocks.Add(MoveTemp(Block));
+	}
+}
+
+FUnrealGPTMarkdownBlock FUnrealGPTMarkdownDocument::ParseBlock(int32 Offset) const
+{
+	FUnrealGPTMarkdownBlock Block;
+	Block.SourceStart = Offset;
+
+	const int32 Length = Text.Len();
+	const int32 LineEnd = FindLineEnd(Text, Offset);
+	int32 BlockEnd = LineEnd < Length ? LineEnd + 1 : Length;
+	Block.bOpen = LineEnd >= Length;
+
+	if (IsFenceLine(Text, Offset, LineEnd))
+	{
+		// Fenced code: consume lines until the closing fence (or the end of the text if still streaming)
+		Block.Type = EUnrealGPTMarkdownBlockType::Code;
+		Block.Language = GetLine(Text, Offset + 3, LineEnd).TrimStartAndEnd();
+
+		int32 ContentStart = BlockEnd;
+		int32 ContentEnd = ContentStart;
+		int32 Pos = ContentStart;
+		Block.bOpen = true;
+
+		if (LineEnd < Length)
+		{
+			while (Pos < Length)
+			{
+				const int32 End = FindLineEnd(Text, Pos);
+				if (IsFenceLine(Text, Pos, End))
+				{
+					BlockEnd = End < Length ? End + 1 : Length;
+					Block.bOpen = End >= Length;
+					break;
+				}
+				ContentEnd = End;
+				Pos = End < Length ? End + 1 : Length;
+				BlockEnd = Pos;
+			}
+		}
+
+		Block.Text = ContentEnd > ContentStart ? GetLine(Text, ContentStart, ContentEnd) : FString();
+		Block.Text.ReplaceInline(TEXT("\r\n"), TEXT("\n"), ESearchCase::CaseSensitive);
+	}
+	else
+	{
+		const FString Line = GetLine(Text, Offset, LineEnd);
+
+		if (Line.TrimStartAndEnd().IsEmpty())
+		{
+			Block.Type = EUnrealGPTMarkdownBlockType::Blank;
+		}
+		else if (Line.StartsWith(TEXT("### ")))
+		{
+			Block.Type = EUnrealGPTMarkdownBlockType::Heading;
+			Block.HeadingLevel = 3;
+			Block.Text = Line.Mid(4);
+		}
+		else if (Line.StartsWith(TEXT("## ")))
+		{
+			Block.Type = EUnrealGPTMarkdownBlockType::Heading;
+			Block.HeadingLevel = 2;
+			Block.Text = Line.Mid(3);
+		}
+		else if (Line.StartsWith(TEXT("# ")))
+		{
+			Block.Type = EUnrealGPTMarkdownBlockType::Heading;
+			Block.HeadingLevel = 1;
+			Block.Text = Line.Mid(2);
+		}
+		else if (Line.StartsWith(TEXT("- ")) || Line.StartsWith(TEXT("* ")))
+		{
+			Block.Type = EUnrealGPTMarkdownBlockType::Bullet;
+			Block.Text = Line.Mid(2);
+		}
+		else
+		{
+			Block.Type = EUnrealGPTMarkdownBlockType::Paragraph;
+			Block.Text = Line;
+		}
+	}
+
+	Block.SourceLength = BlockEnd - Offset;
+	Block.Hash = CityHash64(reinterpret_cast<const char*>(*Text + Offset), Block.SourceLength * sizeof(TCHAR));
+	return Block;
+}
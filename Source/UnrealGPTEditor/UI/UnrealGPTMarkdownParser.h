@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Block kinds understood by the chat markdown renderer */
+enum class EUnrealGPTMarkdownBlockType : uint8
+{
+	Blank,		// Empty line, rendered as a small spacer
+	Paragraph,	// Plain line with inline **bold** spans
+	Heading,	// "# ", "## " or "### " line
+	Bullet,		// "- " or "* " line
+	Code		// ``` fenced block, fences stripped
+};
+
+/** One parsed markdown block and the slice of source text it came from */
+struct FUnrealGPTMarkdownBlock
+{
+	EUnrealGPTMarkdownBlockType Type = EUnrealGPTMarkdownBlockType::Paragraph;
+
+	/** 1-3 for headings, 0 otherwise */
+	int32 HeadingLevel = 0;
+
+	/** Display text with markdown markers removed */
+	FString Text;
+
+	/** Info string after the opening fence of a code block (e.g. "python") */
+	FString Language;
+
+	/** Offset and length of the block's raw source in the document */
+	int32 SourceStart = 0;
+	int32 SourceLength = 0;
+
+	/** Hash of the raw source; equal hashes render identically */
+	uint64 Hash = 0;
+
+	/** True if the block runs to the end of the text unterminated and may still grow on append */
+	bool bOpen = false;
+};
+
+/**
+ * Block-level markdown document that supports incremental appends.
+ *
+ * Every block ends at a newline (or at a closing fence for code), so text appended to the
+ * document can only extend the last block. Append() re-parses from the start of that open tail
+ * block and leaves all closed blocks, including their hashes, untouched.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTMarkdownDocument
+{
+public:
+	/**
+	 * Replace the document text. If the new text shares a prefix with the old one, only blocks
+	 * from the first affected one onward are re-parsed.
+	 * @return Index of the first block that may have changed
+	 */
+	int32 SetText(const FString& InText);
+
+	/**
+	 * Append streamed text to the document.
+	 * @return Index of the first block that may have changed
+	 */
+	int32 Append(const FString& Delta);
+
+	const FString& GetText() const { return Text; }
+	const TArray<FUnrealGPTMarkdownBlock>& GetBlocks() const { return Blocks; }
+
+private:
+	/** Drop blocks from BlockIndex onward and parse the text again from the start of that block */
+	void ReparseFrom(int32 BlockIndex);
+
+	/** Parse one block starting at Offset (which must be at a line start) */
+	FUnrealGPTMarkdownBlock ParseBlock(int32 Offset) const;
+
+	FString Text;
+	TArray<FUnrealGPTMarkdownBlock> Blocks;
+};
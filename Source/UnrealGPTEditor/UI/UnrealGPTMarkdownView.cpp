@@ -0,0 +1,168 @@
+#include "UnrealGPTMarkdownView.h"
+#include "UnrealGPTChatStyle.h"
+#include "UnrealGPTSyntaxHighlighter.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/Layout/SSpacer.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Styling/CoreStyle.h"
+
+using namespace UnrealGPTChatStyle;
+
+void SUnrealGPTMarkdownView::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SAssignNew(Container, SVerticalBox)
+	];
+
+	SetText(InArgs._Text);
+}
+
+void SUnrealGPTMarkdownView::SetText(const FString& InText)
+{
+	SyncBlocks(Document.SetText(InText));
+}
+
+void SUnrealGPTMarkdownView::AppendText(const FString& Delta)
+{
+	SyncBlocks(Document.Append(Delta));
+}
+
+void SUnrealGPTMarkdownView::SyncBlocks(int32 FirstChangedBlock)
+{
+	const TArray<FUnrealGPTMarkdownBlock>& Blocks = Document.GetBlocks();
+	const int32 First = FMath::Clamp(FirstChangedBlock, 0, FMath::Min(Blocks.Num(), RenderedBlocks.Num()));
+
+	// Widgets from the changed range can be reused by any new block with the same content hash
+	TArray<FRenderedBlock> OldTail(RenderedBlocks.GetData() + First, RenderedBlocks.Num() - First);
+	TArray<bool> OldTailUsed;
+	OldTailUsed.SetNumZeroed(OldTail.Num());
+
+	TMultiMap<uint64, int32> OldTailByHash;
+	for (int32 Index = 0; Index < OldTail.Num(); ++Index)
+	{
+		OldTailByHash.Add(OldTail[Index].Hash, Index);
+	}
+
+	RenderedBlocks.SetNum(First);
+
+	for (int32 BlockIndex = First; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		const FUnrealGPTMarkdownBlock& Block = Blocks[BlockIndex];
+		const int32 TailIndex = BlockIndex - First;
+
+		if (const int32* Cached = OldTailByHash.Find(Block.Hash))
+		{
+			const int32 CachedIndex = *Cached;
+			OldTailByHash.RemoveSingle(Block.Hash, CachedIndex);
+			OldTailUsed[CachedIndex] = true;
+			RenderedBlocks.Add(OldTail[CachedIndex]);
+		}
+		else if (Block.Type == EUnrealGPTMarkdownBlockType::Code
+			&& OldTail.IsValidIndex(TailIndex)
+			&& !OldTailUsed[TailIndex]
+			&& OldTail[TailIndex].CodeText.IsValid())
+		{
+			// A code block that is still streaming: update the existing text box instead of rebuilding it
+			OldTailUsed[TailIndex] = true;
+			OldTailByHash.RemoveSingle(OldTail[TailIndex].Hash, TailIndex);
+
+			FRenderedBlock Rendered = OldTail[TailIndex];
+			Rendered.Hash = Block.Hash;
+			Rendered.CodeText->SetText(FText::FromString(Block.Text));
+			RenderedBlocks.Add(Rendered);
+		}
+		else
+		{
+			RenderedBlocks.Add(CreateBlock(Block));
+		}
+	}
+
+	// Patch only the slots from the first changed block onward
+	while (Container->NumSlots() > First)
+	{
+		Container->RemoveSlot(Container->GetSlot(Container->NumSlots() - 1).GetWidget());
+	}
+
+	for (int32 BlockIndex = First; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		Container->AddSlot()
+			.AutoHeight()
+			.Padding(GetBlockPadding(Blocks[BlockIndex]))
+			[
+				RenderedBlocks[BlockIndex].Widget.ToSharedRef()
+			];
+	}
+}
+
+SUnrealGPTMarkdownView::FRenderedBlock SUnrealGPTMarkdownView::CreateBlock(const FUnrealGPTMarkdownBlock& Block) const
+{
+	FRenderedBlock Rendered;
+	Rendered.Hash = Block.Hash;
+	Rendered.Type = Block.Type;
+
+	switch (Block.Type)
+	{
+	case EUnrealGPTMarkdownBlockType::Blank:
+		Rendered.Widget = SNew(SSpacer)
+			.Size(FVector2D(1.0f, 4.0f));
+		break;
+
+	case EUnrealGPTMarkdownBlockType::Code:
+		// Monospace, no wrapping, selectable for copying; highlighted when the fence names python or json
+		Rendered.CodeText = CreateCodeTextWidget(
+			Block.Text,
+			UnrealGPTSyntaxHighlighter::LanguageFromTag(Block.Language),
+			false /* bAutoWrap */);
+		Rendered.Widget = Rendered.CodeText;
+		break;
+
+	case EUnrealGPTMarkdownBlockType::Heading:
+		Rendered.Widget = SNew(STextBlock)
+			.Text(FText::FromString(Block.Text))
+			.AutoWrapText(true)
+			.Font(GetUnrealGPTBodyBoldFont())
+			.ColorAndOpacity(Block.HeadingLevel == 1
+				? FLinearColor(0.98f, 0.98f, 0.98f, 1.0f)
+				: FLinearColor(0.96f, 0.96f, 0.96f, 1.0f));
+		break;
+
+	case EUnrealGPTMarkdownBlockType::Bullet:
+		Rendered.Widget = SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Top)
+			.Padding(0.0f, 0.0f, 6.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("\u2022"))) // Bullet character
+				.Font(GetUnrealGPTBodyFont())
+				.ColorAndOpacity(FLinearColor(0.95f, 0.95f, 0.95f, 1.0f))
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Top)
+			[
+				CreateInlineMarkdownTextWidget(Block.Text)
+			];
+		break;
+
+	case EUnrealGPTMarkdownBlockType::Paragraph:
+	default:
+		// Supports inline **bold** spans
+		Rendered.Widget = CreateInlineMarkdownTextWidget(Block.Text);
+		break;
+	}
+
+	return Rendered;
+}
+
+FMargin SUnrealGPTMarkdownView::GetBlockPadding(const FUnrealGPTMarkdownBlock& Block)
+{
+	if (Block.Type == EUnrealGPTMarkdownBlockType::Heading)
+	{
+		return Block.HeadingLevel == 1 ? FMargin(0.0f, 8.0f, 0.0f, 4.0f) : FMargin(0.0f, 6.0f, 0.0f, 2.0f);
+	}
+	return FMargin(0.0f);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "UnrealGPTMarkdownParser.h"
+
+class SVerticalBox;
+class SMultiLineEditableTextBox;
+
+/**
+ * Chat message body rendered from markdown, one child widget per block.
+ *
+ * Widgets are cached per block by content hash. SetText()/AppendText() only rebuild the
+ * blocks whose source changed, so streaming into a long message patches its tail instead
+ * of re-creating (and re-laying-out) the whole tree.
+ *
+ * The agent client delivers each message whole, so the chat panel only sets the initial text for
+ * now; nothing calls SetText()/AppendText() until responses are streamed.
+ */
+class SUnrealGPTMarkdownView : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SUnrealGPTMarkdownView) {}
+		/** Initial markdown content */
+		SLATE_ARGUMENT(FString, Text)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** Replace the content, rebuilding only blocks that differ from the current ones */
+	void SetText(const FString& InText);
+
+	/** Append streamed content; only the open tail block is re-parsed and rebuilt */
+	void AppendText(const FString& Delta);
+
+private:
+	struct FRenderedBlock
+	{
+		uint64 Hash = 0;
+		EUnrealGPTMarkdownBlockType Type = EUnrealGPTMarkdownBlockType::Paragraph;
+		TSharedPtr<SWidget> Widget;
+
+		/** Set for code blocks so a growing block can update its text in place */
+		TSharedPtr<SMultiLineEditableTextBox> CodeText;
+	};
+
+	/** Bring the child slots in line with the document, starting at the first changed block */
+	void SyncBlocks(int32 FirstChangedBlock);
+
+	FRenderedBlock CreateBlock(const FUnrealGPTMarkdownBlock& Block) const;
+
+	static FMargin GetBlockPadding(const FUnrealGPTMarkdownBlock& Block);
+
+	FUnrealGPTMarkdownDocument Document;
+
+	/** Parallel to Document.GetBlocks() and to the slots of Container */
+	TArray<FRenderedBlock> RenderedBlocks;
+
+	TSharedPtr<SVerticalBox> Container;
+};
@@ -0,0 +1,13 @@
+#include "UnrealGPTStats.h"
+
+DEFINE_STAT(STAT_UnrealGPT_Paint);
+DEFINE_STAT(STAT_UnrealGPT_AgentTick);
+DEFINE_STAT(STAT_UnrealGPT_CreateMessageWidget);
+DEFINE_STAT(STAT_UnrealGPT_CreateToolWidget);
+DEFINE_STAT(STAT_UnrealGPT_CreateMarkdownWidget);
+DEFINE_STAT(STAT_UnrealGPT_DisplayImage);
+DEFINE_STAT(STAT_UnrealGPT_DecodeImage);
+DEFINE_STAT(STAT_UnrealGPT_RebuildChatHistory);
+
+DEFINE_STAT(STAT_UnrealGPT_ChatRows);
+DEFINE_STAT(STAT_UnrealGPT_ImageMemory);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Chat panel instrumentation. Costs nothing unless enabled: run "stat UnrealGPT" in the editor
+ * console for the live overlay, or record an Unreal Insights trace with the cpu channel.
+ */
+DECLARE_STATS_GROUP(TEXT("UnrealGPT"), STATGROUP_UnrealGPT, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Chat Panel Paint"), STAT_UnrealGPT_Paint, STATGROUP_UnrealGPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Agent Tick"), STAT_UnrealGPT_AgentTick, STATGROUP_UnrealGPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Message Widget"), STAT_UnrealGPT_CreateMessageWidget, STATGROUP_UnrealGPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Tool Widget"), STAT_UnrealGPT_CreateToolWidget, STATGROUP_UnrealGPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Markdown Widget"), STAT_UnrealGPT_CreateMarkdownWidget, STATGROUP_UnrealGPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Display Image"), STAT_UnrealGPT_DisplayImage, STATGROUP_UnrealGPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decode Image"), STAT_UnrealGPT_DecodeImage, STATGROUP_UnrealGPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rebuild Chat History"), STAT_UnrealGPT_RebuildChatHistory, STATGROUP_UnrealGPT, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Chat Rows"), STAT_UnrealGPT_ChatRows, STATGROUP_UnrealGPT, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Chat Image Memory"), STAT_UnrealGPT_ImageMemory, STATGROUP_UnrealGPT, );
+
+/**
+ * Times the enclosing scope for both the stat overlay and Insights. A cycle counter already emits
+ * a cpu trace event, so the plain trace scope is only used in builds without stats.
+ */
+#if STATS
+#define UNREALGPT_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define UNREALGPT_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
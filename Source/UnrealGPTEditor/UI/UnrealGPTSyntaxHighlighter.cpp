@@ -0,0 +1,523 @@
+#include "UnrealGPTSyntaxHighlighter.h"
+#include "Containers/LruCache.h"
+#include "Framework/Text/IRichTextMarkupParser.h"
+#include "Framework/Text/IRichTextMarkupWriter.h"
+#include "Framework/Text/RichTextLayoutMarshaller.h"
+#include "Hash/CityHash.h"
+#include "Styling/CoreStyle.h"
+#include "Styling/SlateStyle.h"
+#include "Styling/SlateTypes.h"
+
+namespace
+{
+	/** Tokenized sources kept alive; a 2,000-line script is roughly 20k spans (160 KB) */
+	constexpr int32 MaxCachedSources = 128;
+
+	const TCHAR* const PythonKeywords[] = {
+		TEXT("and"), TEXT("as"), TEXT("assert"), TEXT("async"), TEXT("await"), TEXT("break"), TEXT("class"),
+		TEXT("continue"), TEXT("def"), TEXT("del"), TEXT("elif"), TEXT("else"), TEXT("except"), TEXT("finally"),
+		TEXT("for"), TEXT("from"), TEXT("global"), TEXT("if"), TEXT("import"), TEXT("in"), TEXT("is"),
+		TEXT("lambda"), TEXT("nonlocal"), TEXT("not"), TEXT("or"), TEXT("pass"), TEXT("raise"), TEXT("return"),
+		TEXT("try"), TEXT("while"), TEXT("with"), TEXT("yield")
+	};
+
+	const TCHAR* const PythonBuiltins[] = {
+		TEXT("abs"), TEXT("all"), TEXT("any"), TEXT("bool"), TEXT("dict"), TEXT("enumerate"), TEXT("float"),
+		TEXT("getattr"), TEXT("hasattr"), TEXT("int"), TEXT("isinstance"), TEXT("len"), TEXT("list"), TEXT("max"),
+		TEXT("min"), TEXT("print"), TEXT("range"), TEXT("round"), TEXT("self"), TEXT("set"), TEXT("setattr"),
+		TEXT("sorted"), TEXT("str"), TEXT("sum"), TEXT("super"), TEXT("tuple"), TEXT("type"), TEXT("unreal"),
+		TEXT("zip")
+	};
+
+	const TCHAR* const PythonLiterals[] = { TEXT("True"), TEXT("False"), TEXT("None") };
+	const TCHAR* const JsonLiterals[] = { TEXT("true"), TEXT("false"), TEXT("null") };
+
+	template <int32 N>
+	bool IsOneOf(FStringView Word, const TCHAR* const (&Words)[N])
+	{
+		for (const TCHAR* Candidate : Words)
+		{
+			if (Word.Equals(FStringView(Candidate), ESearchCase::CaseSensitive))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsIdentifierStart(TCHAR Char)
+	{
+		return FChar::IsAlpha(Char) || Char == TEXT('_');
+	}
+
+	bool IsIdentifierChar(TCHAR Char)
+	{
+		return FChar::IsAlnum(Char) || Char == TEXT('_');
+	}
+
+	/** Appends spans, merging adjacent runs of the same token */
+	struct FSpanWriter
+	{
+		TArray<FUnrealGPTSyntaxSpan>& Spans;
+
+		void Emit(EUnrealGPTSyntaxToken Token, int32 Length)
+		{
+			if (Length <= 0)
+			{
+				return;
+			}
+			if (Spans.Num() > 0 && Spans.Last().Token == Token)
+			{
+				Spans.Last().Length += Length;
+				return;
+			}
+			FUnrealGPTSyntaxSpan& Span = Spans.AddDefaulted_GetRef();
+			Span.Token = Token;
+			Span.Length = Length;
+		}
+	};
+
+	/** Returns the end of a quoted string starting at Pos (which points at the opening quote) */
+	int32 ScanString(FStringView Source, int32 Pos, bool bAllowTriple)
+	{
+		const int32 Len = Source.Len();
+		const TCHAR Quote = Source[Pos];
+		const bool bTriple = bAllowTriple && Pos + 2 < Len && Source[Pos + 1] == Quote && Source[Pos + 2] == Quote;
+
+		int32 Index = Pos + (bTriple ? 3 : 1);
+		while (Index < Len)
+		{
+			const TCHAR Char = Source[Index];
+			if (Char == TEXT('\\'))
+			{
+				Index += 2;
+				continue;
+			}
+			if (Char == Quote)
+			{
+				if (!bTriple)
+				{
+					return Index + 1;
+				}
+				if (Index + 2 < Len && Source[Index + 1] == Quote && Source[Index + 2] == Quote)
+				{
+					return Index + 3;
+				}
+			}
+			else if (Char == TEXT('\n') && !bTriple)
+			{
+				// Unterminated single-line string
+				return Index;
+			}
+			++Index;
+		}
+		return Len;
+	}
+
+	int32 ScanNumber(FStringView Source, int32 Pos)
+	{
+		// Loose on purpose: covers ints, floats, exponents, hex and complex literals
+		int32 Index = Pos;
+		while (Index < Source.Len())
+		{
+			const TCHAR Char = Source[Index];
+			const bool bSignedExponent = (Char == TEXT('+') || Char == TEXT('-')) && Index > Pos
+				&& (Source[Index - 1] == TEXT('e') || Source[Index - 1] == TEXT('E'));
+			if (!IsIdentifierChar(Char) && Char != TEXT('.') && !bSignedExponent)
+			{
+				break;
+			}
+			++Index;
+		}
+		return Index;
+	}
+
+	void TokenizePython(FStringView Source, FSpanWriter& Writer)
+	{
+		const int32 Len = Source.Len();
+		bool bAtLineStart = true;
+		bool bExpectName = false;
+		int32 Pos = 0;
+
+		while (Pos < Len)
+		{
+			const TCHAR Char = Source[Pos];
+
+			if (Char == TEXT('\n'))
+			{
+				Writer.Emit(EUnrealGPTSyntaxToken::Default, 1);
+				bAtLineStart = true;
+				++Pos;
+				continue;
+			}
+
+			if (FChar::IsWhitespace(Char))
+			{
+				int32 End = Pos + 1;
+				while (End < Len && Source[End] != TEXT('\n') && FChar::IsWhitespace(Source[End]))
+				{
+					++End;
+				}
+				Writer.Emit(EUnrealGPTSyntaxToken::Default, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			const bool bLineStart = bAtLineStart;
+			bAtLineStart = false;
+
+			if (Char == TEXT('#'))
+			{
+				int32 End = Pos;
+				while (End < Len && Source[End] != TEXT('\n'))
+				{
+					++End;
+				}
+				Writer.Emit(EUnrealGPTSyntaxToken::Comment, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			if (Char == TEXT('@') && bLineStart)
+			{
+				int32 End = Pos + 1;
+				while (End < Len && (IsIdentifierChar(Source[End]) || Source[End] == TEXT('.')))
+				{
+					++End;
+				}
+				Writer.Emit(EUnrealGPTSyntaxToken::Decorator, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			if (Char == TEXT('"') || Char == TEXT('\''))
+			{
+				const int32 End = ScanString(Source, Pos, true);
+				Writer.Emit(EUnrealGPTSyntaxToken::String, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			if (FChar::IsDigit(Char) || (Char == TEXT('.') && Pos + 1 < Len && FChar::IsDigit(Source[Pos + 1])))
+			{
+				const int32 End = ScanNumber(Source, Pos);
+				Writer.Emit(EUnrealGPTSyntaxToken::Number, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			if (IsIdentifierStart(Char))
+			{
+				int32 End = Pos + 1;
+				while (End < Len && IsIdentifierChar(Source[End]))
+				{
+					++End;
+				}
+
+				// String prefixes: r"", b'', f"""...""", rb'' etc.
+				if (End - Pos <= 2 && End < Len && (Source[End] == TEXT('"') || Source[End] == TEXT('\'')))
+				{
+					bool bIsPrefix = true;
+					for (int32 Index = Pos; Index < End; ++Index)
+					{
+						bIsPrefix &= FCString::Strchr(TEXT("rRbBfFuU"), Source[Index]) != nullptr;
+					}
+					if (bIsPrefix)
+					{
+						const int32 StringEnd = ScanString(Source, End, true);
+						Writer.Emit(EUnrealGPTSyntaxToken::String, StringEnd - Pos);
+						Pos = StringEnd;
+						continue;
+					}
+				}
+
+				const FStringView Word = Source.Mid(Pos, End - Pos);
+				EUnrealGPTSyntaxToken Token = EUnrealGPTSyntaxToken::Default;
+				if (bExpectName)
+				{
+					Token = EUnrealGPTSyntaxToken::Function;
+					bExpectName = false;
+				}
+				else if (IsOneOf(Word, PythonKeywords))
+				{
+					Token = EUnrealGPTSyntaxToken::Keyword;
+					bExpectName = Word.Equals(FStringView(TEXT("def")), ESearchCase::CaseSensitive) || Word.Equals(FStringView(TEXT("class")), ESearchCase::CaseSensitive);
+				}
+				else if (IsOneOf(Word, PythonLiterals))
+				{
+					Token = EUnrealGPTSyntaxToken::Literal;
+				}
+				else if (IsOneOf(Word, PythonBuiltins))
+				{
+					Token = EUnrealGPTSyntaxToken::Builtin;
+				}
+
+				Writer.Emit(Token, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			bExpectName = false;
+			Writer.Emit(EUnrealGPTSyntaxToken::Default, 1);
+			++Pos;
+		}
+	}
+
+	void TokenizeJson(FStringView Source, FSpanWriter& Writer)
+	{
+		const int32 Len = Source.Len();
+		int32 Pos = 0;
+
+		while (Pos < Len)
+		{
+			const TCHAR Char = Source[Pos];
+
+			if (Char == TEXT('"'))
+			{
+				const int32 End = ScanString(Source, Pos, false);
+
+				// A string followed by ':' is an object key
+				int32 Next = End;
+				while (Next < Len && FChar::IsWhitespace(Source[Next]))
+				{
+					++Next;
+				}
+				const bool bIsKey = Next < Len && Source[Next] == TEXT(':');
+
+				Writer.Emit(bIsKey ? EUnrealGPTSyntaxToken::Key : EUnrealGPTSyntaxToken::String, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			if (FChar::IsDigit(Char) || (Char == TEXT('-') && Pos + 1 < Len && FChar::IsDigit(Source[Pos + 1])))
+			{
+				const int32 End = ScanNumber(Source, Pos + 1);
+				Writer.Emit(EUnrealGPTSyntaxToken::Number, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			if (IsIdentifierStart(Char))
+			{
+				int32 End = Pos + 1;
+				while (End < Len && IsIdentifierChar(Source[End]))
+				{
+					++End;
+				}
+				const bool bIsLiteral = IsOneOf(Source.Mid(Pos, End - Pos), JsonLiterals);
+				Writer.Emit(bIsLiteral ? EUnrealGPTSyntaxToken::Literal : EUnrealGPTSyntaxToken::Default, End - Pos);
+				Pos = End;
+				continue;
+			}
+
+			Writer.Emit(EUnrealGPTSyntaxToken::Default, 1);
+			++Pos;
+		}
+	}
+
+	using FSpanCache = TLruCache<uint64, TSharedRef<const TArray<FUnrealGPTSyntaxSpan>>>;
+
+	FSpanCache& GetSpanCache()
+	{
+		static FSpanCache Cache(MaxCachedSources);
+		return Cache;
+	}
+
+	/** Builds the layout runs straight from cached spans instead of parsing markup */
+	class FUnrealGPTSyntaxMarkupParser : public IRichTextMarkupParser
+	{
+	public:
+		explicit FUnrealGPTSyntaxMarkupParser(EUnrealGPTSyntaxLanguage InLanguage)
+			: Language(InLanguage)
+		{
+		}
+
+		virtual void Process(TArray<FTextLineParseResults>& Results, const FString& Input, FString& Output) override
+		{
+			Output = Input;
+
+			TArray<FTextRange> LineRanges;
+			FTextRange::CalculateLineRangesFromString(Output, LineRanges);
+			Results.Reserve(Results.Num() + LineRanges.Num());
+
+			const TSharedRef<const TArray<FUnrealGPTSyntaxSpan>> SpansRef = UnrealGPTSyntaxHighlighter::GetSpans(Output, Language);
+			const TArray<FUnrealGPTSyntaxSpan>& Spans = *SpansRef;
+
+			int32 SpanIndex = 0;
+			int32 SpanBegin = 0;
+
+			for (const FTextRange& LineRange : LineRanges)
+			{
+				FTextLineParseResults& LineResults = Results.Emplace_GetRef(LineRange);
+
+				// Skip spans that end before this line (line terminators)
+				while (SpanIndex < Spans.Num() && SpanBegin + Spans[SpanIndex].Length <= LineRange.BeginIndex)
+				{
+					SpanBegin += Spans[SpanIndex].Length;
+					++SpanIndex;
+				}
+
+				int32 Cursor = LineRange.BeginIndex;
+				while (Cursor < LineRange.EndIndex && SpanIndex < Spans.Num())
+				{
+					const int32 SpanEnd = SpanBegin + Spans[SpanIndex].Length;
+					const int32 RunEnd = FMath::Min(SpanEnd, LineRange.EndIndex);
+					AddRun(LineResults, Spans[SpanIndex].Token, FTextRange(Cursor, RunEnd));
+					Cursor = RunEnd;
+
+					if (RunEnd == SpanEnd)
+					{
+						SpanBegin = SpanEnd;
+						++SpanIndex;
+					}
+				}
+
+				if (Cursor < LineRange.EndIndex || LineResults.Runs.Num() == 0)
+				{
+					AddRun(LineResults, EUnrealGPTSyntaxToken::Default, FTextRange(Cursor, LineRange.EndIndex));
+				}
+			}
+		}
+
+	private:
+		static void AddRun(FTextLineParseResults& LineResults, EUnrealGPTSyntaxToken Token, const FTextRange& Range)
+		{
+			const FName StyleName = UnrealGPTSyntaxHighlighter::GetStyleName(Token);
+			LineResults.Runs.Emplace(StyleName.IsNone() ? FString() : StyleName.ToString(), Range, Range);
+		}
+
+		EUnrealGPTSyntaxLanguage Language;
+	};
+
+	/** Writes the plain source back so GetText() and copy return the original code */
+	class FUnrealGPTPlainTextMarkupWriter : public IRichTextMarkupWriter
+	{
+	public:
+		virtual void Write(const TArray<FRichTextLine>& InLines, FString& Output) override
+		{
+			for (int32 LineIndex = 0; LineIndex < InLines.Num(); ++LineIndex)
+			{
+				if (LineIndex > 0)
+				{
+					Output.AppendChar(TEXT('\n'));
+				}
+				for (const FRichTextRun& Run : InLines[LineIndex].Runs)
+				{
+					Output.Append(Run.Text);
+				}
+			}
+		}
+	};
+}
+
+EUnrealGPTSyntaxLanguage UnrealGPTSyntaxHighlighter::LanguageFromTag(const FString& Tag)
+{
+	const FString LowerTag = Tag.TrimStartAndEnd().ToLower();
+	if (LowerTag == TEXT("python") || LowerTag == TEXT("py") || LowerTag == TEXT("python3"))
+	{
+		return EUnrealGPTSyntaxLanguage::Python;
+	}
+	if (LowerTag == TEXT("json") || LowerTag == TEXT("jsonc"))
+	{
+		return EUnrealGPTSyntaxLanguage::Json;
+	}
+	return EUnrealGPTSyntaxLanguage::Plain;
+}
+
+void UnrealGPTSyntaxHighlighter::Tokenize(FStringView Source, EUnrealGPTSyntaxLanguage Language, TArray<FUnrealGPTSyntaxSpan>& OutSpans)
+{
+	OutSpans.Reset();
+	FSpanWriter Writer{ OutSpans };
+
+	switch (Language)
+	{
+	case EUnrealGPTSyntaxLanguage::Python:
+		TokenizePython(Source, Writer);
+		break;
+
+	case EUnrealGPTSyntaxLanguage::Json:
+		TokenizeJson(Source, Writer);
+		break;
+
+	case EUnrealGPTSyntaxLanguage::Plain:
+	default:
+		Writer.Emit(EUnrealGPTSyntaxToken::Default, Source.Len());
+		break;
+	}
+}
+
+TSharedRef<const TArray<FUnrealGPTSyntaxSpan>> UnrealGPTSyntaxHighlighter::GetSpans(FStringView Source, EUnrealGPTSyntaxLanguage Language)
+{
+	check(IsInGameThread());
+
+	const uint64 Key = CityHash64WithSeed(reinterpret_cast<const char*>(Source.GetData()), Source.Len() * sizeof(TCHAR), static_cast<uint64>(Language));
+
+	FSpanCache& Cache = GetSpanCache();
+	if (const TSharedRef<const TArray<FUnrealGPTSyntaxSpan>>* Cached = Cache.FindAndTouch(Key))
+	{
+		return *Cached;
+	}
+
+	TSharedRef<TArray<FUnrealGPTSyntaxSpan>> Spans = MakeShared<TArray<FUnrealGPTSyntaxSpan>>();
+	Tokenize(Source, Language, *Spans);
+	Spans->Shrink();
+
+	Cache.Add(Key, Spans);
+	return Spans;
+}
+
+TSharedRef<ITextLayoutMarshaller> UnrealGPTSyntaxHighlighter::CreateMarshaller(EUnrealGPTSyntaxLanguage Language)
+{
+	return FRichTextLayoutMarshaller::Create(
+		MakeShared<FUnrealGPTSyntaxMarkupParser>(Language),
+		MakeShared<FUnrealGPTPlainTextMarkupWriter>(),
+		TArray<TSharedRef<ITextDecorator>>(),
+		&GetStyleSet());
+}
+
+const ISlateStyle& UnrealGPTSyntaxHighlighter::GetStyleSet()
+{
+	static TSharedPtr<FSlateStyleSet> StyleSet;
+	if (!StyleSet.IsValid())
+	{
+		StyleSet = MakeShared<FSlateStyleSet>(TEXT("UnrealGPTSyntax"));
+
+		const FTextBlockStyle BaseStyle = FTextBlockStyle(FCoreStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText"))
+			.SetFont(FCoreStyle::GetDefaultFontStyle("Mono", 9));
+
+		auto AddStyle = [&BaseStyle](EUnrealGPTSyntaxToken Token, const FLinearColor& Color)
+		{
+			StyleSet->Set(GetStyleName(Token), FTextBlockStyle(BaseStyle).SetColorAndOpacity(Color));
+		};
+
+		AddStyle(EUnrealGPTSyntaxToken::Keyword, FLinearColor(0.78f, 0.47f, 0.87f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::Builtin, FLinearColor(0.31f, 0.79f, 0.69f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::Function, FLinearColor(0.86f, 0.86f, 0.67f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::Decorator, FLinearColor(0.86f, 0.86f, 0.67f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::String, FLinearColor(0.81f, 0.57f, 0.47f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::Number, FLinearColor(0.71f, 0.81f, 0.66f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::Literal, FLinearColor(0.34f, 0.61f, 0.84f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::Comment, FLinearColor(0.42f, 0.60f, 0.33f, 1.0f));
+		AddStyle(EUnrealGPTSyntaxToken::Key, FLinearColor(0.61f, 0.86f, 0.99f, 1.0f));
+	}
+	return *StyleSet;
+}
+
+FName UnrealGPTSyntaxHighlighter::GetStyleName(EUnrealGPTSyntaxToken Token)
+{
+	switch (Token)
+	{
+	case EUnrealGPTSyntaxToken::Keyword:   return TEXT("Syntax.Keyword");
+	case EUnrealGPTSyntaxToken::Builtin:   return TEXT("Syntax.Builtin");
+	case EUnrealGPTSyntaxToken::Function:  return TEXT("Syntax.Function");
+	case EUnrealGPTSyntaxToken::Decorator: return TEXT("Syntax.Decorator");
+	case EUnrealGPTSyntaxToken::String:    return TEXT("Syntax.String");
+	case EUnrealGPTSyntaxToken::Number:    return TEXT("Syntax.Number");
+	case EUnrealGPTSyntaxToken::Literal:   return TEXT("Syntax.Literal");
+	case EUnrealGPTSyntaxToken::Comment:   return TEXT("Syntax.Comment");
+	case EUnrealGPTSyntaxToken::Key:       return TEXT("Syntax.Key");
+	case EUnrealGPTSyntaxToken::Default:
+	default:
+		return NAME_None;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ISlateStyle;
+class ITextLayoutMarshaller;
+
+enum class EUnrealGPTSyntaxLanguage : uint8
+{
+	Plain,
+	Python,
+	Json
+};
+
+enum class EUnrealGPTSyntaxToken : uint8
+{
+	Default,
+	Keyword,
+	Builtin,
+	Function,
+	Decorator,
+	String,
+	Number,
+	Literal,
+	Comment,
+	Key
+};
+
+/** Run-length encoded token: spans are contiguous and cover the whole source */
+struct FUnrealGPTSyntaxSpan
+{
+	EUnrealGPTSyntaxToken Token = EUnrealGPTSyntaxToken::Default;
+	int32 Length = 0;
+};
+
+/**
+ * Python/JSON syntax highlighting for code shown in the chat panel.
+ *
+ * Token spans are cached by source hash, so re-laying-out or rebuilding a code widget never
+ * re-tokenizes it. The spans feed a rich text marshaller whose runs are styled from a
+ * dedicated style set, the same mechanism SRichTextBlock decorators use.
+ */
+class UNREALGPTEDITOR_API UnrealGPTSyntaxHighlighter
+{
+public:
+	/** Map a fenced code block tag ("python", "py", "json", ...) to a language */
+	static EUnrealGPTSyntaxLanguage LanguageFromTag(const FString& Tag);
+
+	/** Tokenize without touching the cache */
+	static void Tokenize(FStringView Source, EUnrealGPTSyntaxLanguage Language, TArray<FUnrealGPTSyntaxSpan>& OutSpans);
+
+	/** Cached spans for the given source */
+	static TSharedRef<const TArray<FUnrealGPTSyntaxSpan>> GetSpans(FStringView Source, EUnrealGPTSyntaxLanguage Language);
+
+	/** Marshaller for SRichTextBlock / SMultiLineEditableTextBox that renders highlighted code */
+	static TSharedRef<ITextLayoutMarshaller> CreateMarshaller(EUnrealGPTSyntaxLanguage Language);
+
+	/** Text styles for each token, named "Syntax.<Token>" */
+	static const ISlateStyle& GetStyleSet();
+
+	/** Style name used for runs of the given token; NAME_None for default text */
+	static FName GetStyleName(EUnrealGPTSyntaxToken Token);
+};
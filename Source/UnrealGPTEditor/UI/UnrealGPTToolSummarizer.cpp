@@ -0,0 +1,336 @@
+#include "UnrealGPTToolSummarizer.h"
+#include "UnrealGPTToolResultProcessor.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	// Count the elements of the array whose ArrayStart was just read, skipping over nested values
+	int32 CountArrayElements(const TSharedRef<TJsonReader<>>& Reader)
+	{
+		int32 Count = 0;
+		EJsonNotation Notation;
+		while (Reader->ReadNext(Notation))
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::ArrayEnd:
+			case EJsonNotation::Error:
+				return Count;
+
+			case EJsonNotation::ObjectStart:
+				++Count;
+				if (!Reader->SkipObject())
+				{
+					return Count;
+				}
+				break;
+
+			case EJsonNotation::ArrayStart:
+				++Count;
+				if (!Reader->SkipArray())
+				{
+					return Count;
+				}
+				break;
+
+			default:
+				++Count;
+				break;
+			}
+		}
+		return Count;
+	}
+
+	// Scan the object whose ObjectStart was just read for the given numeric and string fields, skipping nested values
+	void ScanNestedObject(const TSharedRef<TJsonReader<>>& Reader, FUnrealGPTToolResultSummary& Summary)
+	{
+		EJsonNotation Notation;
+		while (Reader->ReadNext(Notation))
+		{
+			if (Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::Error)
+			{
+				return;
+			}
+
+			const FString& Identifier = Reader->GetIdentifier();
+			if (Notation == EJsonNotation::Number && Identifier == TEXT("total_matched"))
+			{
+				Summary.TotalMatched = static_cast<int32>(Reader->GetValueAsNumber());
+			}
+			else if (Notation == EJsonNotation::String && Identifier == TEXT("traceback") && !Reader->GetValueAsString().IsEmpty())
+			{
+				Summary.bIsError = true;
+			}
+			else if (Notation == EJsonNotation::ObjectStart)
+			{
+				Reader->SkipObject();
+			}
+			else if (Notation == EJsonNotation::ArrayStart)
+			{
+				Reader->SkipArray();
+			}
+		}
+	}
+
+	bool LooksLikeBase64Image(const FString& Text, int32 Start)
+	{
+		return FCString::Strncmp(*Text + Start, TEXT("iVBORw0KGgo"), 11) == 0
+			|| FCString::Strncmp(*Text + Start, TEXT("/9j/"), 4) == 0;
+	}
+}
+
+FUnrealGPTToolResultSummary UnrealGPTToolSummarizer::SummarizeResult(const FString& Result)
+{
+	// Spilled results: summarize the inline preview and report the size of the full file
+	FString SpillPreview;
+	FString SpillFilePath;
+	if (UnrealGPTToolResultProcessor::ParseSpilledResult(Result, SpillPreview, SpillFilePath))
+	{
+		FUnrealGPTToolResultSummary Summary = SummarizeResult(SpillPreview);
+		Summary.SpillFilePath = SpillFilePath;
+
+		const int64 FileSize = IFileManager::Get().FileSize(*SpillFilePath);
+		if (FileSize >= 0)
+		{
+			Summary.OneLine += FString::Printf(TEXT(" [%s on disk]"), *FText::AsMemory(static_cast<uint64>(FileSize)).ToString());
+		}
+		return Summary;
+	}
+
+	FUnrealGPTToolResultSummary Summary;
+
+	const TCHAR* Data = *Result;
+	const int32 Length = Result.Len();
+
+	int32 Start = 0;
+	while (Start < Length && FChar::IsWhitespace(Data[Start]))
+	{
+		++Start;
+	}
+
+	Summary.LineCount = Start < Length ? 1 : 0;
+	for (int32 Index = Start; Index < Length; ++Index)
+	{
+		if (Data[Index] == TEXT('\n'))
+		{
+			++Summary.LineCount;
+		}
+	}
+
+	Summary.bIsImage = (Length - Start > 100 && LooksLikeBase64Image(Result, Start))
+		|| Result.Contains(TEXT("\n__IMAGE_BASE64__\n"), ESearchCase::CaseSensitive);
+
+	if (Summary.bIsImage)
+	{
+		Summary.OneLine = TEXT("Viewport screenshot");
+		return Summary;
+	}
+
+	if (Start < Length && (Data[Start] == TEXT('{') || Data[Start] == TEXT('[')))
+	{
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(FStringView(Data + Start, Length - Start));
+		EJsonNotation Notation;
+
+		if (Reader->ReadNext(Notation))
+		{
+			if (Notation == EJsonNotation::ArrayStart)
+			{
+				Summary.bIsJson = true;
+				Summary.ItemCount = CountArrayElements(Reader);
+			}
+			else if (Notation == EJsonNotation::ObjectStart)
+			{
+				Summary.bIsJson = true;
+
+				while (Reader->ReadNext(Notation))
+				{
+					if (Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::Error)
+					{
+						break;
+					}
+
+					const FString& Identifier = Reader->GetIdentifier();
+					switch (Notation)
+					{
+					case EJsonNotation::String:
+						if (Identifier == TEXT("status"))
+						{
+							Summary.Status = Reader->GetValueAsString();
+						}
+						else if (Identifier == TEXT("message"))
+						{
+							Summary.Message = ToOneLine(Reader->GetValueAsString());
+						}
+						else if (Identifier == TEXT("traceback") && !Reader->GetValueAsString().IsEmpty())
+						{
+							Summary.bIsError = true;
+						}
+						break;
+
+					case EJsonNotation::ObjectStart:
+						if (Identifier == TEXT("summary") || Identifier == TEXT("details"))
+						{
+							ScanNestedObject(Reader, Summary);
+						}
+						else
+						{
+							Reader->SkipObject();
+						}
+						break;
+
+					case EJsonNotation::ArrayStart:
+						if (Identifier == TEXT("actors") || Identifier == TEXT("items") || Identifier == TEXT("files"))
+						{
+							Summary.ItemCount = CountArrayElements(Reader);
+						}
+						else
+						{
+							Reader->SkipArray();
+						}
+						break;
+
+					default:
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	const FString LowerStatus = Summary.Status.ToLower();
+	if (LowerStatus == TEXT("error") || LowerStatus == TEXT("failed") || LowerStatus == TEXT("failure"))
+	{
+		Summary.bIsError = true;
+	}
+
+	if (Summary.TotalMatched != INDEX_NONE)
+	{
+		Summary.OneLine = FString::Printf(TEXT("Matched %d actor(s)"), Summary.TotalMatched);
+		if (Summary.ItemCount != INDEX_NONE && Summary.ItemCount < Summary.TotalMatched)
+		{
+			Summary.OneLine += FString::Printf(TEXT(", showing %d"), Summary.ItemCount);
+		}
+	}
+	else if (!Summary.Status.IsEmpty() || !Summary.Message.IsEmpty())
+	{
+		Summary.OneLine = Summary.Message.IsEmpty()
+			? Summary.Status
+			: (Summary.Status.IsEmpty() ? Summary.Message : FString::Printf(TEXT("%s: %s"), *Summary.Status, *Summary.Message));
+
+		if (Summary.ItemCount != INDEX_NONE)
+		{
+			Summary.OneLine += FString::Printf(TEXT(" (%d item(s))"), Summary.ItemCount);
+		}
+	}
+	else if (Summary.ItemCount != INDEX_NONE)
+	{
+		Summary.OneLine = FString::Printf(TEXT("Found %d item(s)"), Summary.ItemCount);
+	}
+	else
+	{
+		Summary.OneLine = ToOneLine(Result.Mid(Start, 4096));
+		if (Summary.LineCount > 1)
+		{
+			Summary.OneLine += FString::Printf(TEXT(" (+%d lines)"), Summary.LineCount - 1);
+		}
+	}
+
+	return Summary;
+}
+
+FString UnrealGPTToolSummarizer::SummarizeArguments(const FString& ToolName, const FString& ArgumentsJson)
+{
+	TSharedPtr<FJsonObject> ArgsObj;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgumentsJson);
+	if (!FJsonSerializer::Deserialize(Reader, ArgsObj) || !ArgsObj.IsValid())
+	{
+		return ToOneLine(ArgumentsJson);
+	}
+
+	if (ToolName == TEXT("python_execute"))
+	{
+		FString Code;
+		ArgsObj->TryGetStringField(TEXT("code"), Code);
+
+		TArray<FString> CodeLines;
+		Code.TrimStartAndEnd().ParseIntoArrayLines(CodeLines);
+
+		// Skip imports so the summary shows what the script actually does
+		FString FirstStatement;
+		for (const FString& Line : CodeLines)
+		{
+			const FString TrimmedLine = Line.TrimStartAndEnd();
+			if (!TrimmedLine.IsEmpty() && !TrimmedLine.StartsWith(TEXT("import ")) && !TrimmedLine.StartsWith(TEXT("from ")))
+			{
+				FirstStatement = TrimmedLine;
+				break;
+			}
+		}
+
+		return FString::Printf(TEXT("%d line(s): %s"), CodeLines.Num(), *ToOneLine(FirstStatement, 100));
+	}
+
+	if (ToolName == TEXT("web_search") || ToolName == TEXT("file_search"))
+	{
+		FString Query;
+		const TArray<TSharedPtr<FJsonValue>>* QueriesArray = nullptr;
+		if (ArgsObj->TryGetArrayField(TEXT("queries"), QueriesArray) && QueriesArray && QueriesArray->Num() > 0)
+		{
+			(*QueriesArray)[0]->TryGetString(Query);
+		}
+		if (Query.IsEmpty())
+		{
+			ArgsObj->TryGetStringField(TEXT("query"), Query);
+		}
+		return ToOneLine(Query);
+	}
+
+	if (ToolName == TEXT("check_placement"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>* PlacementsArray = nullptr;
+		const int32 NumPlacements = ArgsObj->TryGetArrayField(TEXT("placements"), PlacementsArray) ? PlacementsArray->Num() : 0;
+		return FString::Printf(TEXT("%d placement(s)"), NumPlacements);
+	}
+
+	// Generic: key=value pairs for scalar arguments
+	TArray<FString> Parts;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : ArgsObj->Values)
+	{
+		FString Value;
+		if (Pair.Key != TEXT("max_results") && Pair.Value.IsValid() && Pair.Value->TryGetString(Value) && !Value.IsEmpty())
+		{
+			Parts.Add(FString::Printf(TEXT("%s=%s"), *Pair.Key, *Value));
+		}
+	}
+
+	if (Parts.Num() == 0)
+	{
+		if (ToolName == TEXT("scene_query"))
+		{
+			return TEXT("All actors");
+		}
+		return ToolName == TEXT("scene_overview") ? TEXT("Whole level") : ToOneLine(ArgumentsJson);
+	}
+	return ToOneLine(FString::Join(Parts, TEXT(", ")));
+}
+
+FString UnrealGPTToolSummarizer::ToOneLine(const FString& Text, int32 MaxChars)
+{
+	FString Line = Text.TrimStart();
+
+	int32 NewlineIndex = INDEX_NONE;
+	if (Line.FindChar(TEXT('\n'), NewlineIndex))
+	{
+		Line.LeftInline(NewlineIndex);
+	}
+	Line.TrimEndInline();
+
+	if (Line.Len() > MaxChars)
+	{
+		Line = Line.Left(MaxChars) + TEXT("...");
+	}
+	return Line;
+}
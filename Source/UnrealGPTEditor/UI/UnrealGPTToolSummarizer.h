@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Fields pulled out of a tool result without building a JSON DOM */
+struct FUnrealGPTToolResultSummary
+{
+	/** Top-level "status" field, if any */
+	FString Status;
+
+	/** First line of the top-level "message" field, if any */
+	FString Message;
+
+	/** Element count of a top-level array, or of the "actors"/"items"/"files" array of an object */
+	int32 ItemCount = INDEX_NONE;
+
+	/** "summary.total_matched" from scene_query results */
+	int32 TotalMatched = INDEX_NONE;
+
+	/** Number of lines in the raw result */
+	int32 LineCount = 0;
+
+	bool bIsJson = false;
+	bool bIsImage = false;
+
+	/** True if the status reports a failure or the result carries a traceback */
+	bool bIsError = false;
+
+	/** Scratch file holding the full result when it was too large to keep inline */
+	FString SpillFilePath;
+
+	/** One-line description for the collapsed tool widget */
+	FString OneLine;
+};
+
+/**
+ * Builds the one-line summaries shown for collapsed tool calls in the chat panel.
+ * Results are scanned with a streaming JSON reader that skips nested values, so summarizing
+ * a multi-megabyte result does not allocate a JSON object tree.
+ */
+class UnrealGPTToolSummarizer
+{
+public:
+	/** Summarize a tool result string */
+	static FUnrealGPTToolResultSummary SummarizeResult(const FString& Result);
+
+	/** Summarize the arguments of a tool call (e.g. the first line of a Python script or the search query) */
+	static FString SummarizeArguments(const FString& ToolName, const FString& ArgumentsJson);
+
+private:
+	/** Shorten to a single line of at most MaxChars characters */
+	static FString ToOneLine(const FString& Text, int32 MaxChars = 120);
+};
@@ -0,0 +1,475 @@
+#include "UnrealGPTTranscriptionBackend.h"
+#include "UnrealGPTSettings.h"
+#include "UnrealGPTAudioEncoder.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/Paths.h"
+#include "Misc/QueuedThreadPool.h"
+
+#if WITH_WHISPER_CPP
+#include "whisper.h"
+#endif
+
+namespace
+{
+	const TCHAR* MultipartBoundary = TEXT("----UnrealGPTWhisperBoundary");
+
+#if WITH_WHISPER_CPP
+	/** whisper.cpp rejects inputs shorter than one second */
+	constexpr int32 MinWhisperSamples = UnrealGPTAudioEncoder::SpeechSampleRate + UnrealGPTAudioEncoder::SpeechSampleRate / 20;
+
+	/** Stack for the whisper thread; whisper.cpp keeps its buffers on the heap */
+	constexpr uint32 WhisperThreadStackSize = 4 * 1024 * 1024;
+
+	/** Process-wide model, loaded on first use and kept for the editor session. A whisper context
+	 *  is not re-entrant, so it is only ever touched from the whisper thread. */
+	whisper_context* ModelContext = nullptr;
+	FString ModelContextPath;
+
+	/**
+	 * Single thread that loads the model and decodes segments in order. Work that has to wait for
+	 * the model or an earlier segment waits in its queue instead of holding a shared pool thread.
+	 */
+	FQueuedThreadPool& GetWhisperThread()
+	{
+		static FQueuedThreadPool* WhisperThread = []()
+		{
+			FQueuedThreadPool* Pool = FQueuedThreadPool::Allocate();
+			verify(Pool->Create(1, WhisperThreadStackSize, TPri_Normal, TEXT("UnrealGPTWhisper")));
+			return Pool;
+		}();
+		return *WhisperThread;
+	}
+
+	/** Whisper thread only */
+	whisper_context* AcquireModel(const FString& ModelPath, FString& OutError)
+	{
+		if (ModelContext && ModelContextPath == ModelPath)
+		{
+			return ModelContext;
+		}
+
+		if (ModelContext)
+		{
+			whisper_free(ModelContext);
+			ModelContext = nullptr;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		whisper_context_params ContextParams = whisper_context_default_params();
+		ContextParams.use_gpu = false;
+		ModelContext = whisper_init_from_file_with_params(TCHAR_TO_UTF8(*ModelPath), ContextParams);
+		ModelContextPath = ModelPath;
+
+		if (!ModelContext)
+		{
+			OutError = FString::Printf(TEXT("Failed to load whisper model: %s"), *ModelPath);
+			UE_LOG(LogTemp, Error, TEXT("UnrealGPT: %s"), *OutError);
+			return nullptr;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Loaded local whisper model %s in %.2fs"), *FPaths::GetCleanFilename(ModelPath), FPlatformTime::Seconds() - StartTime);
+		return ModelContext;
+	}
+#endif
+}
+
+// ==================== BACKEND SELECTION ====================
+
+TSharedRef<IUnrealGPTTranscriptionBackend> IUnrealGPTTranscriptionBackend::Create()
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	if (Settings->TranscriptionBackend == EUnrealGPTTranscriptionBackend::Local)
+	{
+		TSharedRef<FUnrealGPTLocalTranscriptionBackend> Local = MakeShared<FUnrealGPTLocalTranscriptionBackend>();
+
+		FString Reason;
+		if (Local->IsAvailable(&Reason))
+		{
+			return Local;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Local transcription unavailable (%s), using the remote endpoint"), *Reason);
+	}
+
+	return MakeShared<FUnrealGPTHttpTranscriptionBackend>();
+}
+
+// ==================== REMOTE ENDPOINT ====================
+
+bool FUnrealGPTHttpTranscriptionBackend::IsAvailable(FString* OutReason) const
+{
+	if (GetDefault<UUnrealGPTSettings>()->ApiKey.IsEmpty())
+	{
+		if (OutReason)
+		{
+			*OutReason = TEXT("API Key not set in settings");
+		}
+		return false;
+	}
+	return true;
+}
+
+void FUnrealGPTHttpTranscriptionBackend::Transcribe(TArray<float>&& MonoSamples, int32 SampleRate, FOnUnrealGPTTranscriptionComplete OnComplete)
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	const FString Endpoint = GetTranscriptionEndpoint();
+	const FString ApiKey = Settings->ApiKey;
+	const bool bCompress = Settings->bCompressVoiceUploads;
+	const uint32 RequestGeneration = Generation;
+	const double StartTime = FPlatformTime::Seconds();
+	const double AudioSeconds = static_cast<double>(MonoSamples.Num()) / FMath::Max(SampleRate, 1);
+
+	// Resample and encode on a worker, then upload from the game thread
+	TWeakPtr<FUnrealGPTHttpTranscriptionBackend> WeakThis = AsShared();
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Audio = MoveTemp(MonoSamples), SampleRate, bCompress, Endpoint, ApiKey, RequestGeneration, StartTime, AudioSeconds, OnComplete]()
+	{
+		TArray<uint8> Body = BuildTranscriptionBody(Audio, SampleRate, bCompress);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Body = MoveTemp(Body), Endpoint, ApiKey, RequestGeneration, StartTime, AudioSeconds, OnComplete]() mutable
+		{
+			TSharedPtr<FUnrealGPTHttpTranscriptionBackend> Backend = WeakThis.Pin();
+			if (!Backend.IsValid() || Backend->Generation != RequestGeneration)
+			{
+				return;
+			}
+
+			FUnrealGPTTranscriptionResult Result;
+			Result.AudioSeconds = AudioSeconds;
+
+			if (Body.Num() == 0)
+			{
+				Result.Error = TEXT("Failed to encode audio");
+				Result.ProcessingSeconds = FPlatformTime::Seconds() - StartTime;
+				OnComplete.ExecuteIfBound(Result);
+				return;
+			}
+
+			TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+			Request->SetURL(Endpoint);
+			Request->SetVerb(TEXT("POST"));
+			Request->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+			Request->SetHeader(TEXT("Content-Type"), FString::Printf(TEXT("multipart/form-data; boundary=%s"), MultipartBoundary));
+			Request->SetContent(MoveTemp(Body));
+			Request->OnProcessRequestComplete().BindSP(Backend.ToSharedRef(), &FUnrealGPTHttpTranscriptionBackend::OnResponseReceived, RequestGeneration, StartTime, AudioSeconds, OnComplete);
+
+			Backend->ActiveRequests.Add(Request);
+			if (!Request->ProcessRequest())
+			{
+				Backend->ActiveRequests.Remove(Request);
+				Result.Error = TEXT("Failed to process Whisper API request");
+				Result.ProcessingSeconds = FPlatformTime::Seconds() - StartTime;
+				OnComplete.ExecuteIfBound(Result);
+			}
+		});
+	});
+}
+
+void FUnrealGPTHttpTranscriptionBackend::CancelAll()
+{
+	++Generation;
+
+	TArray<FHttpRequestPtr> Requests = MoveTemp(ActiveRequests);
+	for (const FHttpRequestPtr& Request : Requests)
+	{
+		Request->CancelRequest();
+	}
+}
+
+void FUnrealGPTHttpTranscriptionBackend::OnResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 RequestGeneration, double StartTime, double AudioSeconds, FOnUnrealGPTTranscriptionComplete OnComplete)
+{
+	ActiveRequests.Remove(Request);
+	if (RequestGeneration != Generation)
+	{
+		return;
+	}
+
+	FUnrealGPTTranscriptionResult Result;
+	Result.AudioSeconds = AudioSeconds;
+	Result.ProcessingSeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (!bWasSuccessful || !Response.IsValid())
+	{
+		Result.Error = TEXT("Whisper API request failed");
+		OnComplete.ExecuteIfBound(Result);
+		return;
+	}
+
+	const int32 ResponseCode = Response->GetResponseCode();
+	if (ResponseCode != 200)
+	{
+		Result.Error = FString::Printf(TEXT("Whisper API returned error code %d: %s"), ResponseCode, *Response->GetContentAsString());
+		OnComplete.ExecuteIfBound(Result);
+		return;
+	}
+
+	// Parse JSON response
+	const FString ResponseContent = Response->GetContentAsString();
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseContent);
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		Result.Error = FString::Printf(TEXT("Failed to parse Whisper API response: %s"), *ResponseContent);
+	}
+	else if (!JsonObject->TryGetStringField(TEXT("text"), Result.Text))
+	{
+		Result.Error = TEXT("Whisper response missing 'text' field");
+	}
+	else
+	{
+		Result.bSuccess = true;
+	}
+
+	OnComplete.ExecuteIfBound(Result);
+}
+
+FString FUnrealGPTHttpTranscriptionBackend::GetTranscriptionEndpoint()
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+
+	// Determine Whisper API endpoint (respecting relative or absolute API endpoint settings)
+	FString WhisperEndpoint = Settings->ApiEndpoint;
+
+	// First, normalize the path portion for audio transcriptions
+	WhisperEndpoint.ReplaceInline(TEXT("/v1/responses"), TEXT("/v1/audio/transcriptions"));
+
+	// If the configured endpoint is not a full URL, build it from the base URL
+	if (!WhisperEndpoint.StartsWith(TEXT("http")))
+	{
+		FString BaseUrl = Settings->BaseUrlOverride.IsEmpty()
+			? TEXT("https://api.openai.com")
+			: Settings->BaseUrlOverride;
+
+		// Ensure we have a sensible path
+		FString Path = WhisperEndpoint;
+		if (Path.IsEmpty())
+		{
+			Path = TEXT("/v1/audio/transcriptions");
+		}
+		else
+		{
+			if (!Path.StartsWith(TEXT("/")))
+			{
+				Path = TEXT("/") + Path;
+			}
+
+			if (!Path.Contains(TEXT("/v1/audio/transcriptions")))
+			{
+				Path = TEXT("/v1/audio/transcriptions");
+			}
+		}
+
+		WhisperEndpoint = BaseUrl + Path;
+	}
+
+	return WhisperEndpoint;
+}
+
+TArray<uint8> FUnrealGPTHttpTranscriptionBackend::BuildTranscriptionBody(TConstArrayView<float> MonoSamples, int32 SampleRate, bool bCompress)
+{
+	TArray<float> Speech;
+	UnrealGPTAudioEncoder::Resample(MonoSamples, SampleRate, UnrealGPTAudioEncoder::SpeechSampleRate, Speech);
+
+	TArray<uint8> Body;
+	if (Speech.Num() == 0)
+	{
+		return Body;
+	}
+
+	auto AppendUtf8 = [&Body](const FString& Text)
+	{
+		FTCHARToUTF8 Utf8(*Text);
+		Body.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	};
+
+	// Multipart framing is a few hundred bytes; the audio is encoded straight into the body
+	Body.Reserve(UnrealGPTAudioEncoder::GetMaxEncodedSize(Speech.Num()) + 512);
+
+	// Part 1: file
+	AppendUtf8(FString::Printf(TEXT("--%s\r\n"), MultipartBoundary));
+	if (bCompress)
+	{
+		AppendUtf8(TEXT("Content-Disposition: form-data; name=\"file\"; filename=\"audio.flac\"\r\n"));
+		AppendUtf8(TEXT("Content-Type: audio/flac\r\n\r\n"));
+		UnrealGPTAudioEncoder::AppendFLAC(Speech, UnrealGPTAudioEncoder::SpeechSampleRate, Body);
+	}
+	else
+	{
+		AppendUtf8(TEXT("Content-Disposition: form-data; name=\"file\"; filename=\"audio.wav\"\r\n"));
+		AppendUtf8(TEXT("Content-Type: audio/wav\r\n\r\n"));
+		UnrealGPTAudioEncoder::AppendWAV(Speech, UnrealGPTAudioEncoder::SpeechSampleRate, Body);
+	}
+
+	// Part 2: model
+	AppendUtf8(TEXT("\r\n"));
+	AppendUtf8(FString::Printf(TEXT("--%s\r\n"), MultipartBoundary));
+	AppendUtf8(TEXT("Content-Disposition: form-data; name=\"model\"\r\n\r\n"));
+	AppendUtf8(TEXT("whisper-1\r\n"));
+
+	// Final closing boundary
+	AppendUtf8(FString::Printf(TEXT("--%s--\r\n"), MultipartBoundary));
+
+	return Body;
+}
+
+// ==================== LOCAL WHISPER.CPP ====================
+
+bool FUnrealGPTLocalTranscriptionBackend::IsAvailable(FString* OutReason) const
+{
+	FString Reason;
+#if WITH_WHISPER_CPP
+	const FString ModelPath = GetModelPath();
+	if (ModelPath.IsEmpty())
+	{
+		Reason = TEXT("no local model file configured");
+	}
+	else if (!FPaths::FileExists(ModelPath))
+	{
+		Reason = FString::Printf(TEXT("model file not found: %s"), *ModelPath);
+	}
+#else
+	Reason = TEXT("plugin built without whisper.cpp");
+#endif
+
+	if (OutReason)
+	{
+		*OutReason = Reason;
+	}
+	return Reason.IsEmpty();
+}
+
+void FUnrealGPTLocalTranscriptionBackend::Prepare()
+{
+#if WITH_WHISPER_CPP
+	// Load the model while the user is still talking so the first segment only pays for decoding
+	const FString ModelPath = GetModelPath();
+	AsyncPool(GetWhisperThread(), [ModelPath]()
+	{
+		FString Error;
+		AcquireModel(ModelPath, Error);
+	});
+#endif
+}
+
+void FUnrealGPTLocalTranscriptionBackend::Transcribe(TArray<float>&& MonoSamples, int32 SampleRate, FOnUnrealGPTTranscriptionComplete OnComplete)
+{
+	const UUnrealGPTSettings* Settings = GetDefault<UUnrealGPTSettings>();
+	const FString ModelPath = GetModelPath();
+	const FString Language = Settings->LocalTranscriptionLanguage.IsEmpty() ? FString(TEXT("auto")) : Settings->LocalTranscriptionLanguage;
+	const int32 NumThreads = GetNumThreads();
+	const uint32 TaskGeneration = Generation;
+	const double StartTime = FPlatformTime::Seconds();
+
+	TWeakPtr<FUnrealGPTLocalTranscriptionBackend> WeakThis = AsShared();
+	auto Task = [WeakThis, Audio = MoveTemp(MonoSamples), SampleRate, ModelPath, Language, NumThreads, TaskGeneration, StartTime, OnComplete]()
+	{
+		auto IsCancelled = [WeakThis, TaskGeneration]()
+		{
+			TSharedPtr<FUnrealGPTLocalTranscriptionBackend> Backend = WeakThis.Pin();
+			return !Backend.IsValid() || Backend->Generation != TaskGeneration;
+		};
+
+		FUnrealGPTTranscriptionResult Result;
+		Result.AudioSeconds = static_cast<double>(Audio.Num()) / FMath::Max(SampleRate, 1);
+
+#if WITH_WHISPER_CPP
+		TArray<float> Speech;
+		UnrealGPTAudioEncoder::Resample(Audio, SampleRate, UnrealGPTAudioEncoder::SpeechSampleRate, Speech);
+		if (Speech.Num() < MinWhisperSamples)
+		{
+			Speech.SetNumZeroed(MinWhisperSamples);
+		}
+
+		{
+			// Segments reach the whisper thread one at a time; each decode already uses NumThreads cores
+			if (!IsCancelled())
+			{
+				whisper_context* Context = AcquireModel(ModelPath, Result.Error);
+				if (Context)
+				{
+					const FTCHARToUTF8 LanguageUtf8(*Language);
+
+					whisper_full_params Params = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
+					Params.n_threads = NumThreads;
+					Params.language = LanguageUtf8.Get();
+					Params.no_context = true;
+					Params.no_timestamps = true;
+					Params.print_progress = false;
+					Params.print_realtime = false;
+					Params.print_special = false;
+					Params.print_timestamps = false;
+
+					if (whisper_full(Context, Params, Speech.GetData(), Speech.Num()) == 0)
+					{
+						const int32 NumSegments = whisper_full_n_segments(Context);
+						for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+						{
+							Result.Text += UTF8_TO_TCHAR(whisper_full_get_segment_text(Context, Segment));
+						}
+						Result.Text.TrimStartAndEndInline();
+						Result.bSuccess = true;
+					}
+					else
+					{
+						Result.Error = TEXT("whisper_full failed");
+					}
+				}
+			}
+		}
+#else
+		Result.Error = TEXT("Plugin built without whisper.cpp");
+#endif
+
+		Result.ProcessingSeconds = FPlatformTime::Seconds() - StartTime;
+
+		AsyncTask(ENamedThreads::GameThread, [IsCancelled, Result, OnComplete]()
+		{
+			if (!IsCancelled())
+			{
+				OnComplete.ExecuteIfBound(Result);
+			}
+		});
+	};
+
+#if WITH_WHISPER_CPP
+	AsyncPool(GetWhisperThread(), MoveTemp(Task));
+#else
+	Async(EAsyncExecution::ThreadPool, MoveTemp(Task));
+#endif
+}
+
+void FUnrealGPTLocalTranscriptionBackend::CancelAll()
+{
+	++Generation;
+}
+
+FString FUnrealGPTLocalTranscriptionBackend::GetModelPath()
+{
+	FString ModelPath = GetDefault<UUnrealGPTSettings>()->LocalWhisperModelPath.FilePath;
+	if (ModelPath.IsEmpty())
+	{
+		return ModelPath;
+	}
+
+	if (FPaths::IsRelative(ModelPath))
+	{
+		ModelPath = FPaths::Combine(FPaths::ProjectDir(), ModelPath);
+	}
+	return FPaths::ConvertRelativePathToFull(ModelPath);
+}
+
+int32 FUnrealGPTLocalTranscriptionBackend::GetNumThreads()
+{
+	const int32 Configured = GetDefault<UUnrealGPTSettings>()->LocalTranscriptionThreads;
+	if (Configured > 0)
+	{
+		return Configured;
+	}
+
+	// Leave a core for the editor; whisper.cpp stops scaling well past eight threads
+	return FMath::Clamp(FPlatformMisc::NumberOfCores() - 1, 1, 8);
+}
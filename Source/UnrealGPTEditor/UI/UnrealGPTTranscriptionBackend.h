@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Http.h"
+#include <atomic>
+
+/** Outcome of transcribing one speech segment */
+struct FUnrealGPTTranscriptionResult
+{
+	bool bSuccess = false;
+	FString Text;
+	FString Error;
+
+	/** Length of the submitted audio */
+	double AudioSeconds = 0.0;
+
+	/** Wall time from submission to result, including encoding, upload or decoding */
+	double ProcessingSeconds = 0.0;
+
+	/** Processing time per second of audio; below 1 is faster than real time */
+	double GetRealTimeFactor() const { return AudioSeconds > 0.0 ? ProcessingSeconds / AudioSeconds : 0.0; }
+};
+
+DECLARE_DELEGATE_OneParam(FOnUnrealGPTTranscriptionComplete, const FUnrealGPTTranscriptionResult& /*Result*/);
+
+/**
+ * Speech-to-text engine used by voice input.
+ *
+ * Backends receive mono audio at the capture rate and do their own resampling and encoding off
+ * the game thread. Completion delegates are always invoked on the game thread.
+ */
+class IUnrealGPTTranscriptionBackend
+{
+public:
+	virtual ~IUnrealGPTTranscriptionBackend() = default;
+
+	/** Short name for logs */
+	virtual FString GetName() const = 0;
+
+	/** False if the backend cannot run in this build or configuration; OutReason explains why */
+	virtual bool IsAvailable(FString* OutReason = nullptr) const = 0;
+
+	/** Called when recording starts so expensive setup overlaps with the user speaking */
+	virtual void Prepare() {}
+
+	virtual void Transcribe(TArray<float>&& MonoSamples, int32 SampleRate, FOnUnrealGPTTranscriptionComplete OnComplete) = 0;
+
+	/** Drop every outstanding transcription; their delegates are not invoked */
+	virtual void CancelAll() = 0;
+
+	/** Backend selected in settings, falling back to the remote endpoint if the local one is unavailable */
+	static TSharedRef<IUnrealGPTTranscriptionBackend> Create();
+};
+
+/** OpenAI-compatible /v1/audio/transcriptions endpoint */
+class FUnrealGPTHttpTranscriptionBackend : public IUnrealGPTTranscriptionBackend, public TSharedFromThis<FUnrealGPTHttpTranscriptionBackend>
+{
+public:
+	virtual FString GetName() const override { return TEXT("remote"); }
+	virtual bool IsAvailable(FString* OutReason = nullptr) const override;
+	virtual void Transcribe(TArray<float>&& MonoSamples, int32 SampleRate, FOnUnrealGPTTranscriptionComplete OnComplete) override;
+	virtual void CancelAll() override;
+
+	/** Transcription URL derived from the API endpoint settings */
+	static FString GetTranscriptionEndpoint();
+
+	/** Resample to 16 kHz and encode into a multipart/form-data body. Safe to call off the game thread. */
+	static TArray<uint8> BuildTranscriptionBody(TConstArrayView<float> MonoSamples, int32 SampleRate, bool bCompress);
+
+private:
+	void OnResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 RequestGeneration, double StartTime, double AudioSeconds, FOnUnrealGPTTranscriptionComplete OnComplete);
+
+	/** Uploads still in flight, so a cancel can abort them */
+	TArray<FHttpRequestPtr> ActiveRequests;
+
+	/** Bumped on cancel so late results are dropped */
+	uint32 Generation = 0;
+};
+
+/**
+ * In-process CPU transcription with whisper.cpp.
+ *
+ * The ggml model (quantized models work unchanged) is loaded once per process and kept warm
+ * across recordings. Loading and decoding run on one dedicated thread, one segment at a time
+ * with several worker threads each, so no shared pool thread waits on the model. Only available when whisper.cpp headers and libraries are present under
+ * Source/ThirdParty/whisper, which makes the build define WITH_WHISPER_CPP.
+ */
+class FUnrealGPTLocalTranscriptionBackend : public IUnrealGPTTranscriptionBackend, public TSharedFromThis<FUnrealGPTLocalTranscriptionBackend>
+{
+public:
+	virtual FString GetName() const override { return TEXT("local"); }
+	virtual bool IsAvailable(FString* OutReason = nullptr) const override;
+	virtual void Prepare() override;
+	virtual void Transcribe(TArray<float>&& MonoSamples, int32 SampleRate, FOnUnrealGPTTranscriptionComplete OnComplete) override;
+	virtual void CancelAll() override;
+
+	/** Model file from settings, relative paths resolved against the project directory */
+	static FString GetModelPath();
+
+	/** Decoder threads: the setting, or a share of the physical cores when 0 */
+	static int32 GetNumThreads();
+
+private:
+	/** Bumped on cancel; read by queued tasks so pending segments are skipped without decoding */
+	std::atomic<uint32> Generation { 0 };
+};
@@ -0,0 +1,164 @@
+#include "UnrealGPTVoiceActivityDetector.h"
+
+namespace
+{
+	constexpr int32 FrameMs = 20;
+
+	/** Consecutive speech frames needed to open a segment; shorter bursts are clicks and taps */
+	constexpr int32 OnsetFrames = 3;
+
+	/** Audio kept before the detected onset and after the last speech frame */
+	constexpr int32 PreRollMs = 240;
+	constexpr int32 TrailingPadMs = 160;
+
+	/** Segments with less speech than this are dropped */
+	constexpr int32 MinSpeechMs = 200;
+
+	/** Long monologues are split so earlier text comes back while the user keeps talking */
+	constexpr int32 MaxSegmentMs = 20000;
+
+	/** Energy above the noise floor for a frame to count as speech; voiced frames need less */
+	constexpr float VoicedMarginDb = 10.0f;
+	constexpr float UnvoicedMarginDb = 18.0f;
+	constexpr float AbsoluteThresholdDb = -50.0f;
+
+	/** Zero crossings per sample above which a frame looks like noise or a fricative rather than voicing */
+	constexpr float VoicedZeroCrossingRate = 0.25f;
+
+	int32 MsToSamples(int32 Ms, int32 SampleRate)
+	{
+		return static_cast<int32>(static_cast<int64>(Ms) * SampleRate / 1000);
+	}
+}
+
+FUnrealGPTVoiceActivityDetector::FUnrealGPTVoiceActivityDetector(int32 InSampleRate, int32 InSilenceTimeoutMs)
+	: SampleRate(FMath::Max(InSampleRate, 1000))
+{
+	FrameSize = MsToSamples(FrameMs, SampleRate);
+	SilenceTimeoutFrames = FMath::Max(1, InSilenceTimeoutMs / FrameMs);
+}
+
+void FUnrealGPTVoiceActivityDetector::ProcessSamples(TConstArrayView<float> Samples, TArray<TArray<float>>& OutSegments)
+{
+	PendingSamples.Append(Samples.GetData(), Samples.Num());
+
+	int32 Consumed = 0;
+	while (PendingSamples.Num() - Consumed >= FrameSize)
+	{
+		ProcessFrame(PendingSamples.GetData() + Consumed, OutSegments);
+		Consumed += FrameSize;
+	}
+
+	PendingSamples.RemoveAt(0, Consumed, EAllowShrinking::No);
+}
+
+void FUnrealGPTVoiceActivityDetector::Flush(TArray<TArray<float>>& OutSegments)
+{
+	// A trailing partial frame is under 20 ms and never decides anything
+	PendingSamples.Reset();
+
+	if (bInSpeech)
+	{
+		CloseSegment(OutSegments);
+	}
+
+	PreRoll.Reset();
+	ConsecutiveSpeechFrames = 0;
+}
+
+void FUnrealGPTVoiceActivityDetector::ProcessFrame(const float* Frame, TArray<TArray<float>>& OutSegments)
+{
+	const bool bSpeech = IsSpeechFrame(Frame);
+
+	if (!bInSpeech)
+	{
+		PreRoll.Append(Frame, FrameSize);
+		const int32 PreRollSamples = MsToSamples(PreRollMs, SampleRate);
+		if (PreRoll.Num() > PreRollSamples)
+		{
+			PreRoll.RemoveAt(0, PreRoll.Num() - PreRollSamples, EAllowShrinking::No);
+		}
+
+		ConsecutiveSpeechFrames = bSpeech ? ConsecutiveSpeechFrames + 1 : 0;
+		if (ConsecutiveSpeechFrames >= OnsetFrames)
+		{
+			// The onset frames are already in the pre-roll
+			bInSpeech = true;
+			Segment = MoveTemp(PreRoll);
+			PreRoll.Reset();
+			SegmentSpeechEnd = Segment.Num();
+			SegmentSpeechFrames = ConsecutiveSpeechFrames;
+			ConsecutiveSilentFrames = 0;
+		}
+		return;
+	}
+
+	Segment.Append(Frame, FrameSize);
+
+	if (bSpeech)
+	{
+		SegmentSpeechEnd = Segment.Num();
+		++SegmentSpeechFrames;
+		ConsecutiveSilentFrames = 0;
+	}
+	else if (++ConsecutiveSilentFrames >= SilenceTimeoutFrames)
+	{
+		CloseSegment(OutSegments);
+		return;
+	}
+
+	if (Segment.Num() >= MsToSamples(MaxSegmentMs, SampleRate))
+	{
+		CloseSegment(OutSegments);
+	}
+}
+
+bool FUnrealGPTVoiceActivityDetector::IsSpeechFrame(const float* Frame)
+{
+	double SumSquares = 0.0;
+	int32 ZeroCrossings = 0;
+	for (int32 Index = 0; Index < FrameSize; ++Index)
+	{
+		SumSquares += static_cast<double>(Frame[Index]) * Frame[Index];
+		if (Index > 0 && (Frame[Index] >= 0.0f) != (Frame[Index - 1] >= 0.0f))
+		{
+			++ZeroCrossings;
+		}
+	}
+
+	const float EnergyDb = 10.0f * FMath::LogX(10.0f, static_cast<float>(SumSquares / FrameSize) + 1e-10f);
+	const float ZeroCrossingRate = static_cast<float>(ZeroCrossings) / FrameSize;
+
+	const bool bSpeech = EnergyDb > AbsoluteThresholdDb
+		&& (EnergyDb > NoiseFloorDb + UnvoicedMarginDb
+			|| (EnergyDb > NoiseFloorDb + VoicedMarginDb && ZeroCrossingRate < VoicedZeroCrossingRate));
+
+	// Track the floor quickly downwards and slowly upwards, barely at all while someone talks
+	if (EnergyDb < NoiseFloorDb)
+	{
+		NoiseFloorDb += (EnergyDb - NoiseFloorDb) * 0.3f;
+	}
+	else
+	{
+		NoiseFloorDb += (EnergyDb - NoiseFloorDb) * (bSpeech ? 0.002f : 0.05f);
+	}
+	NoiseFloorDb = FMath::Max(NoiseFloorDb, -90.0f);
+
+	return bSpeech;
+}
+
+void FUnrealGPTVoiceActivityDetector::CloseSegment(TArray<TArray<float>>& OutSegments)
+{
+	if (SegmentSpeechFrames * FrameMs >= MinSpeechMs)
+	{
+		Segment.SetNum(FMath::Min(Segment.Num(), SegmentSpeechEnd + MsToSamples(TrailingPadMs, SampleRate)));
+		OutSegments.Add(MoveTemp(Segment));
+	}
+
+	Segment.Reset();
+	SegmentSpeechEnd = 0;
+	SegmentSpeechFrames = 0;
+	ConsecutiveSpeechFrames = 0;
+	ConsecutiveSilentFrames = 0;
+	bInSpeech = false;
+}
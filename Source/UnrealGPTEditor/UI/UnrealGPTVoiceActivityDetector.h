@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Streaming voice-activity detector that cuts microphone audio into speech segments.
+ *
+ * Works on 20 ms mono frames using short-term energy against an adaptive noise floor, with the
+ * zero-crossing rate separating voiced speech from broadband noise near the threshold. A segment
+ * opens after a short run of speech frames (keeping a little pre-roll so onsets are not clipped)
+ * and closes after a configurable stretch of silence, so leading and trailing silence never
+ * reaches the transcription endpoint.
+ */
+class UNREALGPTEDITOR_API FUnrealGPTVoiceActivityDetector
+{
+public:
+	FUnrealGPTVoiceActivityDetector(int32 InSampleRate, int32 InSilenceTimeoutMs = 600);
+
+	/** Feed mono samples; segments that ended inside this block are appended to OutSegments */
+	void ProcessSamples(TConstArrayView<float> Samples, TArray<TArray<float>>& OutSegments);
+
+	/** End of stream: close the open segment, if any, without its trailing silence */
+	void Flush(TArray<TArray<float>>& OutSegments);
+
+	/** True while a segment is open */
+	bool IsInSpeech() const { return bInSpeech; }
+
+	int32 GetSampleRate() const { return SampleRate; }
+
+private:
+	void ProcessFrame(const float* Frame, TArray<TArray<float>>& OutSegments);
+	bool IsSpeechFrame(const float* Frame);
+	void CloseSegment(TArray<TArray<float>>& OutSegments);
+
+	int32 SampleRate;
+	int32 FrameSize;
+	int32 SilenceTimeoutFrames;
+
+	/** Samples not yet forming a whole frame */
+	TArray<float> PendingSamples;
+
+	/** Recent frames kept while idle so a segment can start slightly before its onset */
+	TArray<float> PreRoll;
+
+	/** Samples of the open segment, including any silence since the last speech frame */
+	TArray<float> Segment;
+
+	/** Length of Segment up to the end of the last speech frame */
+	int32 SegmentSpeechEnd = 0;
+	int32 SegmentSpeechFrames = 0;
+
+	int32 ConsecutiveSpeechFrames = 0;
+	int32 ConsecutiveSilentFrames = 0;
+
+	/** Running noise floor estimate in dBFS */
+	float NoiseFloorDb = -60.0f;
+
+	bool bInSpeech = false;
+};
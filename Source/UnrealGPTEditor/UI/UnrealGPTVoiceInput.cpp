@@ -1,8 +1,9 @@
 #include "UnrealGPTVoiceInput.h"
 #include "UnrealGPTSettings.h"
+#include "UnrealGPTAudioEncoder.h"
+#include "UnrealGPTVoiceActivityDetector.h"
+#include "UnrealGPTTranscriptionBackend.h"
 #include "Misc/Base64.h"
-#include "Dom/JsonObject.h"
-#include "Serialization/JsonSerializer.h"
 #include "Sound/SoundWave.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
@@ -11,6 +12,9 @@ UUnrealGPTVoiceInput::UUnrealGPTVoiceInput()
 	: RecordingSampleRate(16000)
 	, RecordingNumChannels(1)
 	, bIsRecording(false)
+	, bAwaitingFinalTranscript(false)
+	, RecordingGeneration(0)
+	, CapturedSampleCount(0)
 {
 	Settings = GetMutableDefault<UUnrealGPTSettings>();
 }
@@ -33,6 +37,12 @@ void UUnrealGPTVoiceInput::Initialize()
 	}
 }
 
+void UUnrealGPTVoiceInput::BeginDestroy()
+{
+	StopCaptureTicker();
+	Super::BeginDestroy();
+}
+
 bool UUnrealGPTVoiceInput::StartRecording()
 {
 	if (bIsRecording)
@@ -41,8 +51,20 @@ bool UUnrealGPTVoiceInput::StartRecording()
 		return false;
 	}
 
-	// Clear previous audio data
-	CapturedAudioData.Empty();
+	if (bAwaitingFinalTranscript)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Previous recording is still being transcribed"));
+		return false;
+	}
+
+	// Segments are transcribed while recording, so the backend must be usable up front
+	Backend = IUnrealGPTTranscriptionBackend::Create();
+	FString UnavailableReason;
+	if (!Backend->IsAvailable(&UnavailableReason))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealGPT: %s"), *UnavailableReason);
+		return false;
+	}
 
 	// Open default capture stream if needed
 	if (!CaptureSynth.IsStreamOpen())
@@ -69,6 +91,20 @@ bool UUnrealGPTVoiceInput::StartRecording()
 		return false;
 	}
 
+	// Fresh transcript; responses from an earlier recording are ignored
+	++RecordingGeneration;
+	SegmentTexts.Reset();
+	SegmentCompleted.Reset();
+	LastPartialTranscript.Reset();
+	CapturedSampleCount = 0;
+	Detector = MakeUnique<FUnrealGPTVoiceActivityDetector>(RecordingSampleRate, Settings->VoiceSilenceTimeoutMs);
+	Backend->Prepare();
+
+	CaptureTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UUnrealGPTVoiceInput::OnCaptureTick),
+		0.1f  // Drain the microphone every 100ms
+	);
+
 	bIsRecording = true;
 	OnRecordingStarted.Broadcast();
 	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Started audio recording"));
@@ -86,269 +122,195 @@ void UUnrealGPTVoiceInput::StopRecordingAndTranscribe()
 
 	// Stop capturing
 	CaptureSynth.StopCapturing();
-	
-	// Pull all queued audio data from the synth
-	TArray<float> Chunk;
-	while (CaptureSynth.GetAudioData(Chunk))
+	StopCaptureTicker();
+
+	// Whatever is still queued in the synth, then the open segment minus its trailing silence
+	DrainCapturedAudio();
+
+	TArray<TArray<float>> Segments;
+	Detector->Flush(Segments);
+	for (TArray<float>& Segment : Segments)
 	{
-		if (Chunk.Num() > 0)
-		{
-			CapturedAudioData.Append(Chunk);
-		}
+		SubmitSegment(MoveTemp(Segment));
 	}
-	
+	Detector.Reset();
+
 	bIsRecording = false;
 	OnRecordingStopped.Broadcast();
 
-	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Stopped recording, captured %d samples"), CapturedAudioData.Num());
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Stopped recording, captured %lld samples in %d speech segments"), CapturedSampleCount, SegmentTexts.Num());
 
-	if (CapturedAudioData.Num() == 0)
+	if (SegmentTexts.Num() == 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: No audio data captured from microphone"));
+		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: No speech detected in recording"));
 		OnTranscriptionComplete.Broadcast(TEXT(""));
 		return;
 	}
 
-	// Ensure Settings is valid
-	if (!Settings)
+	bAwaitingFinalTranscript = true;
+	TryCompleteTranscript();
+}
+
+bool UUnrealGPTVoiceInput::OnCaptureTick(float DeltaTime)
+{
+	if (!bIsRecording)
 	{
-		Settings = GetMutableDefault<UUnrealGPTSettings>();
-		if (!Settings)
-		{
-			UE_LOG(LogTemp, Error, TEXT("UnrealGPT: Settings is null and could not be retrieved"));
-			OnTranscriptionComplete.Broadcast(TEXT(""));
-			return;
-		}
+		CaptureTickerHandle.Reset();
+		return false;
 	}
 
-	if (Settings->ApiKey.IsEmpty())
+	DrainCapturedAudio();
+	return true;
+}
+
+void UUnrealGPTVoiceInput::StopCaptureTicker()
+{
+	if (CaptureTickerHandle.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGPT: API Key not set in settings"));
-		OnTranscriptionComplete.Broadcast(TEXT(""));
-		return;
+		FTSTicker::GetCoreTicker().RemoveTicker(CaptureTickerHandle);
+		CaptureTickerHandle.Reset();
 	}
+}
 
-	// Convert audio to WAV format
-	TArray<uint8> WAVData = ConvertToWAV(CapturedAudioData, RecordingSampleRate, RecordingNumChannels);
-	if (WAVData.Num() == 0)
+void UUnrealGPTVoiceInput::DrainCapturedAudio()
+{
+	if (!Detector.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGPT: Failed to convert audio to WAV"));
-		OnTranscriptionComplete.Broadcast(TEXT(""));
 		return;
 	}
 
-	// Create HTTP request to Whisper API
-	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
-	
-	// Determine Whisper API endpoint (respecting relative or absolute API endpoint settings)
-	FString WhisperEndpoint = Settings->ApiEndpoint;
-
-	// First, normalize the path portion for audio transcriptions
-	WhisperEndpoint.ReplaceInline(TEXT("/v1/responses"), TEXT("/v1/audio/transcriptions"));
-
-	// If the configured endpoint is not a full URL, build it from the base URL
-	if (!WhisperEndpoint.StartsWith(TEXT("http")))
+	// Pull all queued audio data from the synth and run it through the detector
+	TArray<float> Chunk;
+	TArray<float> Mono;
+	TArray<TArray<float>> Segments;
+	while (CaptureSynth.GetAudioData(Chunk))
 	{
-		FString BaseUrl = Settings->BaseUrlOverride.IsEmpty()
-			? TEXT("https://api.openai.com")
-			: Settings->BaseUrlOverride;
-
-		// Ensure we have a sensible path
-		FString Path = WhisperEndpoint;
-		if (Path.IsEmpty())
+		if (Chunk.Num() > 0)
 		{
-			Path = TEXT("/v1/audio/transcriptions");
+			UnrealGPTAudioEncoder::DownmixToMono(Chunk, FMath::Max(1, RecordingNumChannels), Mono);
+			CapturedSampleCount += Mono.Num();
+			Detector->ProcessSamples(Mono, Segments);
 		}
-		else
+	}
+
+	for (TArray<float>& Segment : Segments)
+	{
+		SubmitSegment(MoveTemp(Segment));
+	}
+}
+
+void UUnrealGPTVoiceInput::SubmitSegment(TArray<float>&& Samples)
+{
+	const int32 SegmentIndex = SegmentTexts.Add(FString());
+	SegmentCompleted.Add(false);
+
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Submitting speech segment %d (%.2fs) to %s transcription"),
+		SegmentIndex, static_cast<float>(Samples.Num()) / RecordingSampleRate, *Backend->GetName());
+
+	const uint32 Generation = RecordingGeneration;
+	Backend->Transcribe(MoveTemp(Samples), RecordingSampleRate, FOnUnrealGPTTranscriptionComplete::CreateWeakLambda(this,
+		[this, SegmentIndex, Generation](const FUnrealGPTTranscriptionResult& Result)
 		{
-			if (!Path.StartsWith(TEXT("/")))
+			if (Generation != RecordingGeneration)
 			{
-				Path = TEXT("/") + Path;
+				return;
 			}
 
-			if (!Path.Contains(TEXT("/v1/audio/transcriptions")))
+			if (Result.bSuccess)
 			{
-				Path = TEXT("/v1/audio/transcriptions");
+				UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Transcribed segment %d (%.2fs of audio in %.2fs, RTF %.2f): %s"),
+					SegmentIndex, Result.AudioSeconds, Result.ProcessingSeconds, Result.GetRealTimeFactor(), *Result.Text);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("UnrealGPT: Transcription of segment %d failed: %s"), SegmentIndex, *Result.Error);
 			}
-		}
-
-		WhisperEndpoint = BaseUrl + Path;
-	}
-
-	Request->SetURL(WhisperEndpoint);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *Settings->ApiKey));
-
-	// Build multipart form data
-	const FString Boundary = TEXT("----UnrealGPTWhisperBoundary");
-	Request->SetHeader(TEXT("Content-Type"), FString::Printf(TEXT("multipart/form-data; boundary=%s"), *Boundary));
 
-	TArray<uint8> RequestData;
+			CompleteSegment(SegmentIndex, Result.bSuccess ? Result.Text : FString());
+		}));
+}
 
-	// Part 1: file
+void UUnrealGPTVoiceInput::CompleteSegment(int32 SegmentIndex, const FString& Text)
+{
+	if (!SegmentTexts.IsValidIndex(SegmentIndex))
 	{
-		FString FileHeader;
-		FileHeader += FString::Printf(TEXT("--%s\r\n"), *Boundary);
-		FileHeader += TEXT("Content-Disposition: form-data; name=\"file\"; filename=\"audio.wav\"\r\n");
-		FileHeader += TEXT("Content-Type: audio/wav\r\n\r\n");
-
-		FTCHARToUTF8 FileHeaderUtf8(*FileHeader);
-		RequestData.Append(reinterpret_cast<const uint8*>(FileHeaderUtf8.Get()), FileHeaderUtf8.Length());
-
-		// Binary WAV data
-		RequestData.Append(WAVData);
+		return;
 	}
 
-	// Part 2: model
-	{
-		FString ModelPart;
-		ModelPart += TEXT("\r\n");
-		ModelPart += FString::Printf(TEXT("--%s\r\n"), *Boundary);
-		ModelPart += TEXT("Content-Disposition: form-data; name=\"model\"\r\n\r\n");
-		ModelPart += TEXT("whisper-1\r\n");
-
-		FTCHARToUTF8 ModelUtf8(*ModelPart);
-		RequestData.Append(reinterpret_cast<const uint8*>(ModelUtf8.Get()), ModelUtf8.Length());
-	}
+	SegmentTexts[SegmentIndex] = Text.TrimStartAndEnd();
+	SegmentCompleted[SegmentIndex] = true;
 
-	// Final closing boundary
+	// Segments can finish out of order; only the contiguous finished prefix is shown
+	const FString Partial = StitchTranscript();
+	if (Partial != LastPartialTranscript)
 	{
-		FString Closing = FString::Printf(TEXT("--%s--\r\n"), *Boundary);
-		FTCHARToUTF8 ClosingUtf8(*Closing);
-		RequestData.Append(reinterpret_cast<const uint8*>(ClosingUtf8.Get()), ClosingUtf8.Length());
+		LastPartialTranscript = Partial;
+		OnTranscriptionPartial.Broadcast(Partial);
 	}
 
-	Request->SetContent(RequestData);
-	Request->OnProcessRequestComplete().BindUObject(this, &UUnrealGPTVoiceInput::OnWhisperResponseReceived);
+	TryCompleteTranscript();
+}
 
-	if (!Request->ProcessRequest())
+FString UUnrealGPTVoiceInput::StitchTranscript() const
+{
+	FString Transcript;
+	for (int32 Index = 0; Index < SegmentTexts.Num() && SegmentCompleted[Index]; ++Index)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGPT: Failed to process Whisper API request"));
-		OnTranscriptionComplete.Broadcast(TEXT(""));
+		if (SegmentTexts[Index].IsEmpty())
+		{
+			continue;
+		}
+
+		if (!Transcript.IsEmpty())
+		{
+			Transcript += TEXT(" ");
+		}
+		Transcript += SegmentTexts[Index];
 	}
+	return Transcript;
 }
 
-void UUnrealGPTVoiceInput::CancelRecording()
+void UUnrealGPTVoiceInput::TryCompleteTranscript()
 {
-	if (!bIsRecording)
+	if (!bAwaitingFinalTranscript || SegmentCompleted.Contains(false))
 	{
 		return;
 	}
 
-	// Stop capturing if active
-	CaptureSynth.StopCapturing();
-	
-	bIsRecording = false;
-	CapturedAudioData.Empty();
-	OnRecordingStopped.Broadcast();
-	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Recording cancelled"));
+	bAwaitingFinalTranscript = false;
+	OnTranscriptionComplete.Broadcast(StitchTranscript());
 }
 
-void UUnrealGPTVoiceInput::OnWhisperResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UUnrealGPTVoiceInput::CancelRecording()
 {
-	FString TranscribedText;
-
-	if (!bWasSuccessful || !Response.IsValid())
+	if (!bIsRecording && !bAwaitingFinalTranscript)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGPT: Whisper API request failed"));
-		OnTranscriptionComplete.Broadcast(TEXT(""));
 		return;
 	}
 
-	int32 ResponseCode = Response->GetResponseCode();
-	if (ResponseCode != 200)
+	// Stop capturing if active
+	if (bIsRecording)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGPT: Whisper API returned error code %d: %s"), 
-			ResponseCode, *Response->GetContentAsString());
-		OnTranscriptionComplete.Broadcast(TEXT(""));
-		return;
+		CaptureSynth.StopCapturing();
+		StopCaptureTicker();
+		Detector.Reset();
 	}
 
-	// Parse JSON response
-	FString ResponseContent = Response->GetContentAsString();
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseContent);
-
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-	{
-		if (JsonObject->TryGetStringField(TEXT("text"), TranscribedText))
-		{
-			UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Transcription successful: %s"), *TranscribedText);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Whisper response missing 'text' field"));
-		}
-	}
-	else
+	// Drop every in-flight segment of this recording
+	++RecordingGeneration;
+	if (Backend.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealGPT: Failed to parse Whisper API response: %s"), *ResponseContent);
+		Backend->CancelAll();
 	}
 
-	OnTranscriptionComplete.Broadcast(TranscribedText);
-}
+	SegmentTexts.Reset();
+	SegmentCompleted.Reset();
+	bAwaitingFinalTranscript = false;
 
-TArray<uint8> UUnrealGPTVoiceInput::ConvertToWAV(const TArray<float>& PCMData, int32 SampleRate, int32 NumChannels)
-{
-	TArray<uint8> WAVData;
-
-	if (PCMData.Num() == 0)
-	{
-		return WAVData;
-	}
-
-	// WAV file header structure
-	struct FWAVHeader
-	{
-		uint32 ChunkID;        // "RIFF"
-		uint32 ChunkSize;      // File size - 8
-		uint32 Format;         // "WAVE"
-		uint32 Subchunk1ID;    // "fmt "
-		uint32 Subchunk1Size;  // 16 for PCM
-		uint16 AudioFormat;    // 1 for PCM
-		uint16 NumChannels;    // 1 or 2
-		uint32 SampleRate;     // e.g., 16000
-		uint32 ByteRate;       // SampleRate * NumChannels * BitsPerSample/8
-		uint16 BlockAlign;     // NumChannels * BitsPerSample/8
-		uint16 BitsPerSample;  // 16
-		uint32 Subchunk2ID;    // "data"
-		uint32 Subchunk2Size;  // NumSamples * NumChannels * BitsPerSample/8
-	};
-
-	const int32 BitsPerSample = 16;
-	const int32 NumSamples = PCMData.Num() / NumChannels;
-	const int32 DataSize = NumSamples * NumChannels * (BitsPerSample / 8);
-
-	FWAVHeader Header;
-	Header.ChunkID = 0x46464952; // "RIFF"
-	Header.ChunkSize = 36 + DataSize;
-	Header.Format = 0x45564157; // "WAVE"
-	Header.Subchunk1ID = 0x20746D66; // "fmt "
-	Header.Subchunk1Size = 16;
-	Header.AudioFormat = 1; // PCM
-	Header.NumChannels = NumChannels;
-	Header.SampleRate = SampleRate;
-	Header.ByteRate = SampleRate * NumChannels * (BitsPerSample / 8);
-	Header.BlockAlign = NumChannels * (BitsPerSample / 8);
-	Header.BitsPerSample = BitsPerSample;
-	Header.Subchunk2ID = 0x61746164; // "data"
-	Header.Subchunk2Size = DataSize;
-
-	// Write header
-	WAVData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FWAVHeader));
-
-	// Convert float samples to 16-bit PCM
-	for (int32 i = 0; i < PCMData.Num(); ++i)
+	if (bIsRecording)
 	{
-		// Clamp and convert to int16
-		float Sample = FMath::Clamp(PCMData[i], -1.0f, 1.0f);
-		int16 PCMSample = static_cast<int16>(Sample * 32767.0f);
-		
-		// Write as little-endian
-		WAVData.Add(static_cast<uint8>(PCMSample & 0xFF));
-		WAVData.Add(static_cast<uint8>((PCMSample >> 8) & 0xFF));
+		bIsRecording = false;
+		OnRecordingStopped.Broadcast();
 	}
-
-	return WAVData;
+	UE_LOG(LogTemp, Log, TEXT("UnrealGPT: Recording cancelled"));
 }
-
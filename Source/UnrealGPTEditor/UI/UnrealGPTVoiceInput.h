@@ -5,9 +5,12 @@
 #include "AudioCaptureCore.h"
 #include "Sound/SoundWave.h"
 #include "Http.h"
+#include "Containers/Ticker.h"
+#include "UnrealGPTVoiceActivityDetector.h"
 #include "UnrealGPTVoiceInput.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTranscriptionComplete, const FString&, TranscribedText);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTranscriptionPartial, const FString&, PartialText);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnRecordingStarted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnRecordingStopped);
 
@@ -22,10 +25,12 @@ public:
 	/** Initialize the voice input system */
 	void Initialize();
 
+	virtual void BeginDestroy() override;
+
 	/** Start recording audio from microphone */
 	bool StartRecording();
 
-	/** Stop recording and transcribe using Whisper API */
+	/** Stop recording, submit the last speech segment and complete once every segment is transcribed */
 	void StopRecordingAndTranscribe();
 
 	/** Cancel current recording without transcribing */
@@ -38,6 +43,10 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FOnTranscriptionComplete OnTranscriptionComplete;
 
+	/** Delegate fired with the transcript so far each time a leading speech segment is transcribed */
+	UPROPERTY(BlueprintAssignable)
+	FOnTranscriptionPartial OnTranscriptionPartial;
+
 	/** Delegate fired when recording starts */
 	UPROPERTY(BlueprintAssignable)
 	FOnRecordingStarted OnRecordingStarted;
@@ -47,14 +56,35 @@ public:
 	FOnRecordingStopped OnRecordingStopped;
 
 private:
-	/** Handle Whisper API response */
-	void OnWhisperResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	/** Pull queued microphone audio into the voice-activity detector while recording */
+	bool OnCaptureTick(float DeltaTime);
+	void StopCaptureTicker();
+	void DrainCapturedAudio();
+
+	/** Encode and upload a finished speech segment */
+	void SubmitSegment(TArray<float>&& Samples);
+
+	/** Record a segment's text and broadcast the updated transcript */
+	void CompleteSegment(int32 SegmentIndex, const FString& Text);
+
+	/** Texts of the contiguous run of finished segments from the start of the recording */
+	FString StitchTranscript() const;
 
-	/** Convert captured audio to WAV format */
-	TArray<uint8> ConvertToWAV(const TArray<float>& PCMData, int32 SampleRate, int32 NumChannels);
+	/** Broadcast the final transcript once recording stopped and no segment is outstanding */
+	void TryCompleteTranscript();
 
-	/** Captured audio data (interleaved floats) */
-	TArray<float> CapturedAudioData;
+	/** Splits the microphone stream into speech segments (device sample rate, mono) */
+	TUniquePtr<FUnrealGPTVoiceActivityDetector> Detector;
+
+	/** Per-segment transcripts in recording order */
+	TArray<FString> SegmentTexts;
+	TArray<bool> SegmentCompleted;
+	FString LastPartialTranscript;
+
+	/** Speech-to-text engine chosen in settings when recording starts */
+	TSharedPtr<class IUnrealGPTTranscriptionBackend> Backend;
+
+	FTSTicker::FDelegateHandle CaptureTickerHandle;
 
 	/** Low-level audio capture synth (handles microphone capture) */
 	Audio::FAudioCaptureSynth CaptureSynth;
@@ -68,6 +98,15 @@ private:
 	/** Is currently recording */
 	bool bIsRecording;
 
+	/** Recording stopped but some segments are still being transcribed */
+	bool bAwaitingFinalTranscript;
+
+	/** Bumped per recording so late responses from a cancelled one are ignored */
+	uint32 RecordingGeneration;
+
+	/** Mono samples captured in the current recording */
+	int64 CapturedSampleCount;
+
 	/** Settings reference */
 	class UUnrealGPTSettings* Settings;
 };
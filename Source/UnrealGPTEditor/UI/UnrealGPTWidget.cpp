@@ -22,8 +22,6 @@
 #include "Framework/Text/SlateTextRun.h"
 #include "Framework/Text/SlateTextLayout.h"
 #include "Widgets/Layout/SSpacer.h"
-#include "IImageWrapper.h"
-#include "IImageWrapperModule.h"
 #include "Engine/Texture2D.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "RenderingThread.h"
@@ -31,6 +29,16 @@
 #include "ImageUtils.h"
 #include "TextureResource.h"
 #include "UnrealGPTVoiceInput.h"
+#include "UnrealGPTImageCache.h"
+#include "UnrealGPTChatStyle.h"
+#include "UnrealGPTMarkdownView.h"
+#include "UnrealGPTLazyExpander.h"
+#include "UnrealGPTToolSummarizer.h"
+#include "UnrealGPTSyntaxHighlighter.h"
+#include "UnrealGPTLargeTextViewer.h"
+#include "UnrealGPTToolResultProcessor.h"
+#include "UnrealGPTStats.h"
+#include "UnrealGPTToolExecutor.h"
 #include "DesktopPlatformModule.h"
 #include "IDesktopPlatform.h"
 #include "Framework/Application/SlateApplication.h"
@@ -40,176 +48,7 @@
 #include "Widgets/Layout/SWrapBox.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
 
-namespace
-{
-	// Helper to build a Geist-based Slate font from this plugin's Content/Fonts folder.
-	// Falls back to the default editor fonts if anything goes wrong.
-	FSlateFontInfo MakeGeistFont(int32 Size, bool bBold = false, bool bItalic = false)
-	{
-		static bool bInitialized = false;
-		static FString PluginContentDir;
-
-		if (!bInitialized)
-		{
-			if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealGPT")))
-			{
-				PluginContentDir = Plugin->GetContentDir();
-			}
-			bInitialized = true;
-		}
-
-		if (!PluginContentDir.IsEmpty())
-		{
-			FString FileName;
-			if (bBold && bItalic)
-			{
-				FileName = TEXT("Geist-BoldItalic.ttf");
-			}
-			else if (bBold)
-			{
-				FileName = TEXT("Geist-Bold.ttf");
-			}
-			else if (bItalic)
-			{
-				FileName = TEXT("Geist-RegularItalic.ttf");
-			}
-			else
-			{
-				FileName = TEXT("Geist-Regular.ttf");
-			}
-
-			const FString FontPath = FPaths::Combine(PluginContentDir, TEXT("Fonts/Geist/ttf"), FileName);
-			return FSlateFontInfo(FontPath, Size);
-		}
-
-		// Fallback to the standard editor fonts if the plugin content directory is not available.
-		if (bBold)
-		{
-			return FAppStyle::GetFontStyle("NormalFontBold");
-		}
-		if (bItalic)
-		{
-			return FAppStyle::GetFontStyle("NormalFontItalic");
-		}
-		return FAppStyle::GetFontStyle("NormalFont");
-	}
-
-	FSlateFontInfo GetUnrealGPTBodyFont()
-	{
-		return MakeGeistFont(10, false, false);
-	}
-
-	FSlateFontInfo GetUnrealGPTBodyBoldFont()
-	{
-		return MakeGeistFont(10, true, false);
-	}
-
-	FSlateFontInfo GetUnrealGPTSmallBodyFont()
-	{
-		return MakeGeistFont(8, false, false);
-	}
-
-	FSlateFontInfo GetUnrealGPTSmallBodyItalicFont()
-	{
-		return MakeGeistFont(8, false, true);
-	}
-
-	FSlateFontInfo GetUnrealGPTBodyItalicFont()
-	{
-		return MakeGeistFont(10, false, true);
-	}
-
-	// Create a read-only, selectable/copyable text widget for displaying results.
-	// Uses SMultiLineEditableTextBox with IsReadOnly(true) to enable text selection and Ctrl+C copying.
-	TSharedRef<SWidget> CreateSelectableTextWidget(const FString& Text, const FSlateFontInfo& Font, const FLinearColor& TextColor = FLinearColor(0.9f, 0.9f, 0.9f, 1.0f), bool bAutoWrap = true)
-	{
-		// Use a static style that persists beyond this function call
-		// The style needs to live as long as the widget, so we create a shared copy
-		static TSharedPtr<FEditableTextBoxStyle> BaseStyle;
-		if (!BaseStyle.IsValid())
-		{
-			BaseStyle = MakeShareable(new FEditableTextBoxStyle(FCoreStyle::Get().GetWidgetStyle<FEditableTextBoxStyle>("NormalEditableTextBox")));
-			BaseStyle->SetBackgroundImageNormal(FSlateNoResource());
-			BaseStyle->SetBackgroundImageHovered(FSlateNoResource());
-			BaseStyle->SetBackgroundImageFocused(FSlateNoResource());
-			BaseStyle->SetBackgroundImageReadOnly(FSlateNoResource());
-			BaseStyle->SetPadding(FMargin(0.0f));
-			BaseStyle->SetBackgroundColor(FLinearColor::Transparent);
-			// Set scroll bar style to invisible/minimal to avoid visual clutter
-			BaseStyle->ScrollBarStyle.SetHorizontalBackgroundImage(FSlateNoResource());
-			BaseStyle->ScrollBarStyle.SetVerticalBackgroundImage(FSlateNoResource());
-		}
-
-		return SNew(SMultiLineEditableTextBox)
-			.Text(FText::FromString(Text))
-			.IsReadOnly(true)
-			.AutoWrapText(bAutoWrap)
-			.Style(BaseStyle.Get())
-			.Font(Font)
-			.ForegroundColor(FSlateColor(TextColor))
-			.Padding(FMargin(0.0f))
-			.SelectAllTextWhenFocused(false)
-			.AllowContextMenu(true); // Enable right-click context menu for copy
-	}
-
-	// Render a single chat line with inline markdown support using SRichTextBlock.
-	// Converts **bold** markers to rich text format for proper inline styling with word wrapping.
-	TSharedRef<SWidget> CreateInlineMarkdownTextWidget(const FString& Line)
-	{
-		// Convert **bold** markdown to rich text markup: **text** -> <RichTextBlock.Bold>text</>
-		FString RichText;
-		int32 Pos = 0;
-		const int32 Length = Line.Len();
-
-		while (Pos < Length)
-		{
-			const int32 Open = Line.Find(TEXT("**"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
-			if (Open == INDEX_NONE)
-			{
-				// No more bold markers; add the rest as normal text.
-				RichText += Line.Mid(Pos);
-				break;
-			}
-
-			// Add any normal text before the bold span.
-			if (Open > Pos)
-			{
-				RichText += Line.Mid(Pos, Open - Pos);
-			}
-
-			const int32 Close = Line.Find(TEXT("**"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Open + 2);
-			if (Close == INDEX_NONE)
-			{
-				// Unmatched '**' – treat the remainder as normal text including the markers.
-				RichText += Line.Mid(Open);
-				break;
-			}
-
-			// Extract the bold span between the markers and wrap with rich text tags.
-			const int32 BoldStart = Open + 2;
-			const int32 BoldLen = Close - BoldStart;
-			if (BoldLen > 0)
-			{
-				RichText += TEXT("<RichTextBlock.Bold>");
-				RichText += Line.Mid(BoldStart, BoldLen);
-				RichText += TEXT("</>");
-			}
-
-			Pos = Close + 2;
-		}
-
-		// Create a text style with our desired color and font
-		static FTextBlockStyle ChatTextStyle = FTextBlockStyle()
-			.SetFont(GetUnrealGPTBodyFont())
-			.SetColorAndOpacity(FSlateColor(FLinearColor(0.95f, 0.95f, 0.95f, 1.0f)));
-
-		return SNew(SRichTextBlock)
-			.Text(FText::FromString(RichText))
-			.AutoWrapText(true)
-			.DecoratorStyleSet(&FCoreStyle::Get())
-			.TextStyle(&ChatTextStyle);
-	}
-}
+using namespace UnrealGPTChatStyle;
 
 void SUnrealGPTWidget::Construct(const FArguments& InArgs)
 {
@@ -228,12 +67,14 @@ void SUnrealGPTWidget::Construct(const FArguments& InArgs)
 	AgentClient->OnAgentReasoning.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnAgentReasoningReceived);
 	AgentClient->OnToolCall.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnToolCallReceived);
 	AgentClient->OnToolResult.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnToolResultReceived);
+	AgentClient->OnToolProgress.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnToolProgressReceived);
 
 	// Create voice input instance - AddToRoot immediately to prevent GC before Initialize()
 	VoiceInput = NewObject<UUnrealGPTVoiceInput>();
 	VoiceInput->AddToRoot();
 	VoiceInput->Initialize();
 	VoiceInput->OnTranscriptionComplete.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnTranscriptionCompleteReceived);
+	VoiceInput->OnTranscriptionPartial.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnTranscriptionPartialReceived);
 	VoiceInput->OnRecordingStarted.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnRecordingStartedReceived);
 	VoiceInput->OnRecordingStopped.AddDynamic(DelegateHandler, &UUnrealGPTWidgetDelegateHandler::OnRecordingStoppedReceived);
 
@@ -242,11 +83,10 @@ void SUnrealGPTWidget::Construct(const FArguments& InArgs)
 	AgentController->Initialize(AgentClient);
 	DelegateHandler->BindToAgentController(AgentController.Get());
 
-	// Register ticker to drive the agent state machine
-	AgentTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
-		FTickerDelegate::CreateSP(this, &SUnrealGPTWidget::OnAgentTick),
-		0.1f  // Tick every 100ms
-	);
+	ImageCache = MakeShared<FUnrealGPTImageCache>();
+
+	// The agent ticker is only registered while the controller has work to do
+	AgentController->OnWakeRequested.BindSP(this, &SUnrealGPTWidget::WakeAgentTicker);
 
 	ChildSlot
 	[
@@ -843,151 +683,19 @@ FLinearColor SUnrealGPTWidget::GetRoleColor(const FString& Role) const
 
 TSharedRef<SWidget> SUnrealGPTWidget::CreateMarkdownWidget(const FString& Content)
 {
-	// Lightweight markdown renderer that keeps formatting readable in the chat UI
-	// while avoiding any heavy parsing or external dependencies.
-	//
-	// Supported (best-effort) features:
-	// - Headings: lines starting with "# ", "## ", or "### "
-	// - Bullet lists: lines starting with "- " or "* "
-	// - Fenced code blocks: sections wrapped in ``` fences (language tag after ``` is ignored)
-	// - Blank-line spacing
-
-	TSharedRef<SVerticalBox> Container = SNew(SVerticalBox);
-
-	TArray<FString> Lines;
-	Content.ParseIntoArrayLines(Lines, /*bCullEmpty*/ false);
+	UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_CreateMarkdownWidget);
 
-	bool bInCodeBlock = false;
-
-	for (const FString& RawLine : Lines)
-	{
-		FString Line = RawLine;
-
-		// Toggle fenced code blocks (```), discard the fence line itself
-		if (Line.StartsWith(TEXT("```")))
-		{
-			bInCodeBlock = !bInCodeBlock;
-			continue;
-		}
-
-		// Blank line → small vertical spacer
-		if (Line.TrimStartAndEnd().IsEmpty())
-		{
-			Container->AddSlot()
-				.AutoHeight()
-				[
-					SNew(SSpacer)
-					.Size(FVector2D(1.0f, 4.0f))
-				];
-			continue;
-		}
-
-		// Lines inside fenced code block: monospace, no wrapping, selectable for copying
-		if (bInCodeBlock)
-		{
-			Container->AddSlot()
-				.AutoHeight()
-				[
-					CreateSelectableTextWidget(
-						Line,
-						FCoreStyle::GetDefaultFontStyle("Mono", 9),
-						FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
-						false /* bAutoWrap */
-					)
-				];
-			continue;
-		}
-
-		// Headings (# / ## / ###) – render slightly emphasized
-		if (Line.StartsWith(TEXT("### ")))
-		{
-			const FString HeadingText = Line.Mid(4);
-			Container->AddSlot()
-				.AutoHeight()
-				.Padding(0.0f, 6.0f, 0.0f, 2.0f)
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString(HeadingText))
-					.AutoWrapText(true)
-					.Font(GetUnrealGPTBodyBoldFont())
-					.ColorAndOpacity(FLinearColor(0.96f, 0.96f, 0.96f, 1.0f))
-				];
-			continue;
-		}
-		if (Line.StartsWith(TEXT("## ")))
-		{
-			const FString HeadingText = Line.Mid(3);
-			Container->AddSlot()
-				.AutoHeight()
-				.Padding(0.0f, 6.0f, 0.0f, 2.0f)
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString(HeadingText))
-					.AutoWrapText(true)
-					.Font(GetUnrealGPTBodyBoldFont())
-					.ColorAndOpacity(FLinearColor(0.96f, 0.96f, 0.96f, 1.0f))
-				];
-			continue;
-		}
-		if (Line.StartsWith(TEXT("# ")))
-		{
-			const FString HeadingText = Line.Mid(2);
-			Container->AddSlot()
-				.AutoHeight()
-				.Padding(0.0f, 8.0f, 0.0f, 4.0f)
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString(HeadingText))
-					.AutoWrapText(true)
-					.Font(GetUnrealGPTBodyBoldFont())
-					.ColorAndOpacity(FLinearColor(0.98f, 0.98f, 0.98f, 1.0f))
-				];
-			continue;
-		}
-
-		// Simple bullet list items: "- " or "* " at line start
-		if (Line.StartsWith(TEXT("- ")) || Line.StartsWith(TEXT("* ")))
-		{
-			const FString ItemText = Line.Mid(2);
-
-			Container->AddSlot()
-				.AutoHeight()
-				[
-					SNew(SHorizontalBox)
-					+ SHorizontalBox::Slot()
-					.AutoWidth()
-					.VAlign(VAlign_Top)
-					.Padding(0.0f, 0.0f, 6.0f, 0.0f)
-					[
-						SNew(STextBlock)
-						.Text(FText::FromString(TEXT("\u2022"))) // Bullet character
-						.Font(GetUnrealGPTBodyFont())
-						.ColorAndOpacity(FLinearColor(0.95f, 0.95f, 0.95f, 1.0f))
-					]
-					+ SHorizontalBox::Slot()
-					.FillWidth(1.0f)
-					.VAlign(VAlign_Top)
-					[
-						CreateInlineMarkdownTextWidget(ItemText)
-					]
-				];
-
-			continue;
-		}
-
-		// Default paragraph line (supports inline **bold** spans)
-		Container->AddSlot()
-			.AutoHeight()
-			[
-				CreateInlineMarkdownTextWidget(Line)
-			];
-	}
-
-	return Container;
+	// Lightweight block-level markdown renderer (headings, bullets, ``` fences, blank-line spacing).
+	// The view caches one widget per block. Messages currently arrive whole, so only the initial text is
+	// set; SetText/AppendText are there for when the agent client streams deltas.
+	return SNew(SUnrealGPTMarkdownView)
+		.Text(Content);
 }
 
 TSharedRef<SWidget> SUnrealGPTWidget::CreateMessageWidget(const FString& Role, const FString& Content)
 {
+	UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_CreateMessageWidget);
+
 	const bool bIsUser = Role == TEXT("user");
 	const FLinearColor RoleColor = GetRoleColor(Role);
 	const FLinearColor BackgroundColor = bIsUser 
@@ -1069,20 +777,66 @@ const FSlateBrush* SUnrealGPTWidget::GetToolIcon(const FString& ToolName) const
 	return FAppStyle::GetBrush("Icons.Tool");
 }
 
-TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& ToolName, const FString& Arguments, const FString& Result)
+void SUnrealGPTWidget::GetToolStyle(const FString& ToolName, FLinearColor& OutColor, FString& OutIcon, FString& OutDisplayName) const
 {
-	FLinearColor ToolColor;
-	FString ToolIcon;
-	FString ToolDisplayName;
-	TSharedPtr<SWidget> ContentWidget;
-
 	// Assign colors and icons based on tool type
 	if (ToolName == TEXT("python_execute"))
 	{
-		ToolColor = FLinearColor(0.2f, 0.5f, 0.8f, 1.0f);
-		ToolIcon = FString(TEXT("\xf121")); // Code icon
-		ToolDisplayName = TEXT("Python Execution");
+		OutColor = FLinearColor(0.2f, 0.5f, 0.8f, 1.0f);
+		OutIcon = FString(TEXT("\xf121")); // Code icon
+		OutDisplayName = TEXT("Python Execution");
+	}
+	else if (ToolName == TEXT("scene_query"))
+	{
+		OutColor = FLinearColor(0.6f, 0.4f, 0.9f, 1.0f);
+		OutIcon = FString(TEXT("\xf002")); // Search icon
+		OutDisplayName = TEXT("Scene Query");
+	}
+	else if (ToolName == TEXT("scene_overview"))
+	{
+		OutColor = FLinearColor(0.6f, 0.4f, 0.9f, 1.0f);
+		OutIcon = FString(TEXT("\xf279")); // Map icon
+		OutDisplayName = TEXT("Scene Overview");
+	}
+	else if (ToolName == TEXT("check_placement"))
+	{
+		OutColor = FLinearColor(0.6f, 0.4f, 0.9f, 1.0f);
+		OutIcon = FString(TEXT("\xf00c")); // Check icon
+		OutDisplayName = TEXT("Placement Check");
+	}
+	else if (ToolName == TEXT("viewport_screenshot"))
+	{
+		OutColor = FLinearColor(0.3f, 0.8f, 0.6f, 1.0f);
+		OutIcon = FString(TEXT("\xf030")); // Camera icon
+		OutDisplayName = TEXT("Viewport Screenshot");
+	}
+	else if (ToolName == TEXT("web_search"))
+	{
+		OutColor = FLinearColor(0.2f, 0.7f, 0.9f, 1.0f); // Cyan-ish blue
+		OutIcon = FString(TEXT("\xf0ac")); // Globe icon
+		OutDisplayName = TEXT("Web Search");
+	}
+	else if (ToolName == TEXT("file_search"))
+	{
+		OutColor = FLinearColor(0.8f, 0.6f, 0.2f, 1.0f); // Amber/Orange
+		OutIcon = FString(TEXT("\xf02d")); // Book icon (documentation)
+		OutDisplayName = TEXT("UE API Docs Search"); // Clearer name indicating it searches Unreal Engine documentation
+	}
+	else
+	{
+		OutColor = FLinearColor(0.5f, 0.5f, 0.5f, 1.0f);
+		OutIcon = FString(TEXT("\xf085")); // Cog icon
+		OutDisplayName = ToolName;
+	}
+}
+
+TSharedRef<SWidget> SUnrealGPTWidget::CreateToolDetailsWidget(const FString& ToolName, const FString& Arguments, const FString& Result)
+{
+	TSharedPtr<SWidget> ContentWidget;
 
+	// Build the arguments view based on tool type
+	if (ToolName == TEXT("python_execute"))
+	{
 		// Parse JSON to extract code cleanly
 		FString Code = Arguments;
 		TSharedPtr<FJsonObject> ArgsObj;
@@ -1117,10 +871,9 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 			.Padding(FMargin(8.0f))
 			.BorderBackgroundColor(FLinearColor(0.05f, 0.05f, 0.05f, 1.0f))
 			[
-				CreateSelectableTextWidget(
+				CreateCodeTextWidget(
 					Code,
-					FCoreStyle::GetDefaultFontStyle("Mono", 9),
-					FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
+					EUnrealGPTSyntaxLanguage::Python,
 					true /* bAutoWrap */
 				)
 			];
@@ -1140,10 +893,9 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 				+ SVerticalBox::Slot()
 				.AutoHeight()
 				[
-					CreateSelectableTextWidget(
+					CreateCodeTextWidget(
 						CodePreview,
-						FCoreStyle::GetDefaultFontStyle("Mono", 9),
-						FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
+						EUnrealGPTSyntaxLanguage::Python,
 						true /* bAutoWrap */
 					)
 				]
@@ -1176,10 +928,9 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 				+ SVerticalBox::Slot()
 				.AutoHeight()
 				[
-					CreateSelectableTextWidget(
+					CreateCodeTextWidget(
 						Code,
-						FCoreStyle::GetDefaultFontStyle("Mono", 9),
-						FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
+						EUnrealGPTSyntaxLanguage::Python,
 						true /* bAutoWrap */
 					)
 				]
@@ -1249,10 +1000,6 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 	}
 	else if (ToolName == TEXT("scene_query"))
 	{
-		ToolColor = FLinearColor(0.6f, 0.4f, 0.9f, 1.0f);
-		ToolIcon = FString(TEXT("\xf002")); // Search icon
-		ToolDisplayName = TEXT("Scene Query");
-		
 		// Parse filters to show them nicely
 		FString FilterSummary;
 		TSharedPtr<FJsonObject> ArgsObj;
@@ -1296,10 +1043,6 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 	}
 	else if (ToolName == TEXT("viewport_screenshot"))
 	{
-		ToolColor = FLinearColor(0.3f, 0.8f, 0.6f, 1.0f);
-		ToolIcon = FString(TEXT("\xf030")); // Camera icon
-		ToolDisplayName = TEXT("Viewport Screenshot");
-
 		// Check if we have a result with an image to display
 		FString ImageBase64;
 		FString MetadataJson;
@@ -1314,112 +1057,40 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 		if (!ImageBase64.IsEmpty() &&
 			(ImageBase64.StartsWith(TEXT("iVBORw0KGgo")) || ImageBase64.StartsWith(TEXT("/9j/"))))
 		{
-			// We have a valid image - decode and display it inline
-			TArray<uint8> ImageData;
-			if (FBase64::Decode(ImageBase64, ImageData))
-			{
-				IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-				TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
-				if (!ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num()))
-				{
-					ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-					ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num());
-				}
+			// We have a valid image - display it inline (max 500x350), decoded off the game thread
+			const uint64 ImageKey = ImageCache->AddImage(ImageBase64);
 
-				if (ImageWrapper->GetWidth() > 0 && ImageWrapper->GetHeight() > 0)
+			// Parse metadata for display info
+			FString CameraInfo;
+			TSharedPtr<FJsonObject> MetaObj;
+			TSharedRef<TJsonReader<>> MetaReader = TJsonReaderFactory<>::Create(MetadataJson);
+			if (FJsonSerializer::Deserialize(MetaReader, MetaObj) && MetaObj.IsValid())
+			{
+				const TSharedPtr<FJsonObject>* ResolutionObj = nullptr;
+				if (MetaObj->TryGetObjectField(TEXT("resolution"), ResolutionObj) && ResolutionObj)
 				{
-					TArray<uint8> UncompressedBGRA;
-					if (ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA))
-					{
-						const int32 Width = ImageWrapper->GetWidth();
-						const int32 Height = ImageWrapper->GetHeight();
-
-						TArray<FColor> Colors;
-						Colors.SetNum(Width * Height);
-						for (int32 i = 0; i < Width * Height; ++i)
-						{
-							Colors[i].B = UncompressedBGRA[i * 4 + 0];
-							Colors[i].G = UncompressedBGRA[i * 4 + 1];
-							Colors[i].R = UncompressedBGRA[i * 4 + 2];
-							Colors[i].A = UncompressedBGRA[i * 4 + 3];
-						}
-
-						FCreateTexture2DParameters Params;
-						Params.bDeferCompression = true;
-						Params.CompressionSettings = TC_Default;
-						UTexture2D* Texture = FImageUtils::CreateTexture2D(Width, Height, Colors, GetTransientPackage(), TEXT("ToolScreenshot"), RF_Transient, Params);
-						if (Texture)
-						{
-							Texture->AddToRoot();
-							ScreenshotTextures.Add(Texture);
-
-							TSharedPtr<FSlateBrush> Brush = MakeShared<FSlateBrush>();
-							Brush->SetResourceObject(Texture);
-							Brush->ImageSize = FVector2D(Width, Height);
-							ScreenshotBrushes.Add(Brush);
-
-							// Calculate display size (max 500x350 for inline display)
-							const float MaxDisplayWidth = 500.0f;
-							const float MaxDisplayHeight = 350.0f;
-							float DisplayWidth = static_cast<float>(Width);
-							float DisplayHeight = static_cast<float>(Height);
-
-							if (DisplayWidth > MaxDisplayWidth)
-							{
-								DisplayHeight *= MaxDisplayWidth / DisplayWidth;
-								DisplayWidth = MaxDisplayWidth;
-							}
-							if (DisplayHeight > MaxDisplayHeight)
-							{
-								DisplayWidth *= MaxDisplayHeight / DisplayHeight;
-								DisplayHeight = MaxDisplayHeight;
-							}
-
-							// Parse metadata for display info
-							FString CameraInfo;
-							TSharedPtr<FJsonObject> MetaObj;
-							TSharedRef<TJsonReader<>> MetaReader = TJsonReaderFactory<>::Create(MetadataJson);
-							if (FJsonSerializer::Deserialize(MetaReader, MetaObj) && MetaObj.IsValid())
-							{
-								const TSharedPtr<FJsonObject>* ResolutionObj = nullptr;
-								if (MetaObj->TryGetObjectField(TEXT("resolution"), ResolutionObj) && ResolutionObj)
-								{
-									int32 ResW = 0, ResH = 0;
-									(*ResolutionObj)->TryGetNumberField(TEXT("width"), ResW);
-									(*ResolutionObj)->TryGetNumberField(TEXT("height"), ResH);
-									CameraInfo = FString::Printf(TEXT("Resolution: %dx%d"), ResW, ResH);
-								}
-							}
-
-							ContentWidget = SNew(SVerticalBox)
-								+ SVerticalBox::Slot()
-								.AutoHeight()
-								[
-									SNew(SBox)
-									.WidthOverride(DisplayWidth)
-									.HeightOverride(DisplayHeight)
-									[
-										SNew(SImage)
-										.Image(Brush.Get())
-									]
-								]
-								+ SVerticalBox::Slot()
-								.AutoHeight()
-								.Padding(0.0f, 4.0f, 0.0f, 0.0f)
-								[
-									SNew(STextBlock)
-									.Text(FText::FromString(CameraInfo))
-									.Font(GetUnrealGPTSmallBodyFont())
-									.ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f, 1.0f))
-								];
-
-							// Mark that we handled the result so it doesn't get shown again
-							// We do this by setting a flag that the result display code will check
-							// Actually, we need to skip the result section for viewport_screenshot
-						}
-					}
+					int32 ResW = 0, ResH = 0;
+					(*ResolutionObj)->TryGetNumberField(TEXT("width"), ResW);
+					(*ResolutionObj)->TryGetNumberField(TEXT("height"), ResH);
+					CameraInfo = FString::Printf(TEXT("Resolution: %dx%d"), ResW, ResH);
 				}
 			}
+
+			ContentWidget = SNew(SVerticalBox)
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					ImageCache->CreateThumbnailWidget(ImageKey, FVector2D(500.0f, 350.0f))
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString(CameraInfo))
+					.Font(GetUnrealGPTSmallBodyFont())
+					.ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f, 1.0f))
+				];
 		}
 
 		// Fallback if we couldn't decode the image or there's no result yet
@@ -1497,10 +1168,6 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 	// }
 	else if (ToolName == TEXT("web_search"))
 	{
-		ToolColor = FLinearColor(0.2f, 0.7f, 0.9f, 1.0f); // Cyan-ish blue
-		ToolIcon = FString(TEXT("\xf0ac")); // Globe icon
-		ToolDisplayName = TEXT("Web Search");
-
 		// Parse the query from arguments
 		FString Query;
 		TSharedPtr<FJsonObject> ArgsObj;
@@ -1536,10 +1203,6 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 	}
 	else if (ToolName == TEXT("file_search"))
 	{
-		ToolColor = FLinearColor(0.8f, 0.6f, 0.2f, 1.0f); // Amber/Orange
-		ToolIcon = FString(TEXT("\xf02d")); // Book icon (documentation)
-		ToolDisplayName = TEXT("UE API Docs Search"); // Clearer name indicating it searches Unreal Engine documentation
-
 		// Parse the query from arguments
 		// OpenAI file_search_call uses "queries" (array) in its arguments.
 		FString Query;
@@ -1605,10 +1268,6 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 	}
 	else
 	{
-		ToolColor = FLinearColor(0.5f, 0.5f, 0.5f, 1.0f);
-		ToolIcon = FString(TEXT("\xf085")); // Cog icon
-		ToolDisplayName = ToolName;
-		
 		ContentWidget = SNew(SVerticalBox)
 			+ SVerticalBox::Slot()
 			.AutoHeight()
@@ -1635,7 +1294,29 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 	TSharedPtr<SWidget> ResultWidget;
 	const FString TrimmedResult = Result.TrimStartAndEnd();
 	const bool bSkipResultDisplay = (ToolName == TEXT("viewport_screenshot"));
-	if (!bSkipResultDisplay && !TrimmedResult.IsEmpty() && TrimmedResult != TEXT("[]") && TrimmedResult != TEXT("{}"))
+	FString SpillPreview;
+	FString SpillFilePath;
+	if (!bSkipResultDisplay && UnrealGPTToolResultProcessor::ParseSpilledResult(Result, SpillPreview, SpillFilePath))
+	{
+		// Too large to render as text: page through the scratch file instead
+		ResultWidget = SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.Text(NSLOCTEXT("UnrealGPT", "ToolResult", "Result:"))
+				.Font(GetUnrealGPTSmallBodyFont())
+				.ColorAndOpacity(FLinearColor(0.5f, 0.7f, 0.5f, 1.0f))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+			[
+				SNew(SUnrealGPTLargeTextViewer)
+				.FilePath(SpillFilePath)
+			];
+	}
+	else if (!bSkipResultDisplay && !TrimmedResult.IsEmpty() && TrimmedResult != TEXT("[]") && TrimmedResult != TEXT("{}"))
 	{
 		// Parse and format the result for display
 		FString DisplayResult = TrimmedResult;
@@ -1705,6 +1386,38 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 			];
 	}
 
+	TSharedRef<SVerticalBox> DetailsBox = SNew(SVerticalBox)
+
+		// Content Section (Arguments)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(0.0f, 0.0f, 0.0f, 8.0f)
+		[
+			ContentWidget.ToSharedRef()
+		];
+
+	// Add result section if we have one
+	if (ResultWidget.IsValid())
+	{
+		DetailsBox->AddSlot()
+			.AutoHeight()
+			[
+				ResultWidget.ToSharedRef()
+			];
+	}
+
+	return DetailsBox;
+}
+
+TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& ToolName, const FString& Arguments, const FString& Result)
+{
+	UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_CreateToolWidget);
+
+	FLinearColor ToolColor;
+	FString ToolIcon;
+	FString ToolDisplayName;
+	GetToolStyle(ToolName, ToolColor, ToolIcon, ToolDisplayName);
+
 	TSharedRef<SVerticalBox> MainVerticalBox = SNew(SVerticalBox)
 
 		// Tool header with icon
@@ -1759,25 +1472,14 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 			]
 		]
 
-		// Content Section (Arguments)
+		// Arguments and result
 		+ SVerticalBox::Slot()
 		.AutoHeight()
-		.Padding(42.0f, 0.0f, 0.0f, 8.0f)
+		.Padding(42.0f, 0.0f, 0.0f, 0.0f)
 		[
-			ContentWidget.ToSharedRef()
+			CreateToolDetailsWidget(ToolName, Arguments, Result)
 		];
 
-	// Add result section if we have one
-	if (ResultWidget.IsValid())
-	{
-		MainVerticalBox->AddSlot()
-			.AutoHeight()
-			.Padding(42.0f, 0.0f, 0.0f, 0.0f)
-			[
-				ResultWidget.ToSharedRef()
-			];
-	}
-
 	return SNew(SBorder)
 		.BorderImage(FAppStyle::GetBrush("Brushes.White"))
 		.BorderBackgroundColor(FLinearColor(0.04f, 0.04f, 0.04f, 1.0f))
@@ -1789,7 +1491,38 @@ TSharedRef<SWidget> SUnrealGPTWidget::CreateToolSpecificWidget(const FString& To
 
 TSharedRef<SWidget> SUnrealGPTWidget::CreateToolCallWidget(const FString& ToolName, const FString& Arguments, const FString& Result)
 {
-	return CreateToolSpecificWidget(ToolName, Arguments, Result);
+	// Screenshots are the point of the call, so show them without an extra click
+	if (ToolName == TEXT("viewport_screenshot") && !Result.IsEmpty())
+	{
+		return CreateToolSpecificWidget(ToolName, Arguments, Result);
+	}
+
+	FLinearColor ToolColor;
+	FString ToolIcon;
+	FString ToolDisplayName;
+	GetToolStyle(ToolName, ToolColor, ToolIcon, ToolDisplayName);
+
+	// Prefer the result summary once we have one, otherwise describe the arguments
+	FString SummaryLine = UnrealGPTToolSummarizer::SummarizeArguments(ToolName, Arguments);
+	if (!Result.IsEmpty())
+	{
+		const FUnrealGPTToolResultSummary ResultSummary = UnrealGPTToolSummarizer::SummarizeResult(Result);
+		if (!ResultSummary.OneLine.IsEmpty())
+		{
+			SummaryLine = ResultSummary.OneLine;
+		}
+		if (ResultSummary.bIsError)
+		{
+			ToolColor = FLinearColor(0.9f, 0.3f, 0.3f, 1.0f);
+		}
+	}
+
+	return SNew(SUnrealGPTLazyExpander)
+		.Icon(ToolIcon)
+		.Title(FText::FromString(ToolDisplayName))
+		.Summary(FText::FromString(SummaryLine))
+		.AccentColor(ToolColor)
+		.OnGenerateDetails(FOnGenerateUnrealGPTDetails::CreateSP(this, &SUnrealGPTWidget::CreateToolDetailsWidget, ToolName, Arguments, Result));
 }
 
 FReply SUnrealGPTWidget::OnSendClicked()
@@ -1849,14 +1582,7 @@ FReply SUnrealGPTWidget::OnSendClicked()
 		AgentClient->SendMessage(Message, PendingAttachedImages);
 
 		// Show reasoning indicator while the agent is working
-		if (ReasoningStatusBorder.IsValid())
-		{
-			ReasoningStatusBorder->SetVisibility(EVisibility::Visible);
-		}
-		if (ReasoningSummaryText.IsValid())
-		{
-			ReasoningSummaryText->SetText(NSLOCTEXT("UnrealGPT", "ReasoningPendingShort", "Thinking..."));
-		}
+		ShowReasoningPending();
 
 		// Clear any pending images after sending
 		PendingAttachedImages.Empty();
@@ -1877,8 +1603,8 @@ FReply SUnrealGPTWidget::OnRequestContextClicked()
 	FString ScreenshotBase64 = UUnrealGPTSceneContext::CaptureViewportScreenshotResized(1024, 768);
 
 	// Get compact scene summary (no component details) to avoid overwhelming the API
-	// The compact summary only includes actor name, label, class, and location
-	FString SceneSummary = UUnrealGPTSceneContext::GetCompactSceneSummary(50);
+	// The compact summary only includes actor name, label, class, and location, as table rows
+	FString SceneSummary = UUnrealGPTSceneContext::GetCompactSceneSummary(50, true);
 
 	// Build context message
 	FString ContextMessage = FString::Printf(
@@ -1916,6 +1642,7 @@ FReply SUnrealGPTWidget::OnClearHistoryClicked()
 	if (ChatHistoryBox.IsValid())
 	{
 		ChatHistoryBox->ClearChildren();
+		ToolProgressRows.Reset();
 	}
 
 	// Also clear any pending attachments
@@ -1923,26 +1650,11 @@ FReply SUnrealGPTWidget::OnClearHistoryClicked()
 
 	ToolCallHistory.Empty();
 
-	// Clean up screenshot textures - remove from root so they can be garbage collected
-	for (UTexture2D* Texture : ScreenshotTextures)
-	{
-		if (IsValid(Texture) && Texture->IsRooted())
-		{
-			Texture->RemoveFromRoot();
-		}
-	}
-	ScreenshotTextures.Empty();
-	ScreenshotBrushes.Empty();
+	// Release screenshot textures so they can be garbage collected
+	ImageCache->Reset();
 
 	// Hide reasoning status as the conversation has been reset
-	if (ReasoningStatusBorder.IsValid())
-	{
-		ReasoningStatusBorder->SetVisibility(EVisibility::Collapsed);
-	}
-	if (ReasoningSummaryText.IsValid())
-	{
-		ReasoningSummaryText->SetText(FText::GetEmpty());
-	}
+	HideReasoningStatus();
 
 	return FReply::Handled();
 }
@@ -1959,6 +1671,7 @@ FReply SUnrealGPTWidget::OnNewConversationClicked()
 	if (ChatHistoryBox.IsValid())
 	{
 		ChatHistoryBox->ClearChildren();
+		ToolProgressRows.Reset();
 	}
 
 	// Clear pending attachments
@@ -1966,26 +1679,11 @@ FReply SUnrealGPTWidget::OnNewConversationClicked()
 
 	ToolCallHistory.Empty();
 
-	// Clean up screenshot textures - remove from root so they can be garbage collected
-	for (UTexture2D* Texture : ScreenshotTextures)
-	{
-		if (IsValid(Texture) && Texture->IsRooted())
-		{
-			Texture->RemoveFromRoot();
-		}
-	}
-	ScreenshotTextures.Empty();
-	ScreenshotBrushes.Empty();
+	// Release screenshot textures so they can be garbage collected
+	ImageCache->Reset();
 
 	// Hide reasoning status as the conversation has been reset
-	if (ReasoningStatusBorder.IsValid())
-	{
-		ReasoningStatusBorder->SetVisibility(EVisibility::Collapsed);
-	}
-	if (ReasoningSummaryText.IsValid())
-	{
-		ReasoningSummaryText->SetText(FText::GetEmpty());
-	}
+	HideReasoningStatus();
 
 	// Clear current session selection and refresh dropdown
 	CurrentSelectedSession.Reset();
@@ -2090,15 +1788,53 @@ SUnrealGPTWidget::~SUnrealGPTWidget()
 	}
 }
 
+int32 SUnrealGPTWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_Paint);
+
+	if (ChatHistoryBox.IsValid())
+	{
+		SET_DWORD_STAT(STAT_UnrealGPT_ChatRows, ChatHistoryBox->NumSlots());
+	}
+	if (ImageCache.IsValid())
+	{
+		SET_MEMORY_STAT(STAT_UnrealGPT_ImageMemory, ImageCache->GetResidentBytes());
+	}
+
+	return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+}
+
 bool SUnrealGPTWidget::OnAgentTick(float DeltaTime)
 {
+	UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_AgentTick);
+
 	// Drive the agent state machine when in agent mode
 	if (bAgentModeEnabled && AgentController.IsValid())
 	{
 		AgentController->Tick();
+
+		if (AgentController->NeedsTick())
+		{
+			return true; // Continue ticking
+		}
 	}
 
-	return true; // Continue ticking
+	// Nothing to do until the controller requests a wake-up
+	AgentTickerHandle.Reset();
+	return false;
+}
+
+void SUnrealGPTWidget::WakeAgentTicker()
+{
+	if (AgentTickerHandle.IsValid() || !bAgentModeEnabled || !AgentController.IsValid() || !AgentController->NeedsTick())
+	{
+		return;
+	}
+
+	AgentTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &SUnrealGPTWidget::OnAgentTick),
+		0.1f  // Tick every 100ms
+	);
 }
 
 void SUnrealGPTWidget::HandleAgentMessage(const FString& Role, const FString& Content, const TArray<FString>& ToolCalls)
@@ -2116,14 +1852,7 @@ void SUnrealGPTWidget::HandleAgentMessage(const FString& Role, const FString& Co
 	// its current step, so we can hide the thinking UI.
 	if (Role == TEXT("assistant") && ToolCalls.Num() == 0)
 	{
-		if (ReasoningStatusBorder.IsValid())
-		{
-			ReasoningStatusBorder->SetVisibility(EVisibility::Collapsed);
-		}
-		if (ReasoningSummaryText.IsValid())
-		{
-			ReasoningSummaryText->SetText(FText::GetEmpty());
-		}
+		HideReasoningStatus();
 	}
 }
 
@@ -2140,6 +1869,9 @@ void SUnrealGPTWidget::HandleAgentReasoning(const FString& ReasoningContent)
 		ReasoningStatusBorder->SetVisibility(EVisibility::Visible);
 	}
 
+	// Real content replaces the animated placeholder
+	StopReasoningAnimation();
+
 	if (ReasoningSummaryText.IsValid())
 	{
 		ReasoningSummaryText->SetText(FText::FromString(ReasoningContent));
@@ -2152,6 +1884,63 @@ void SUnrealGPTWidget::HandleAgentReasoning(const FString& ReasoningContent)
 	}
 }
 
+void SUnrealGPTWidget::ShowReasoningPending()
+{
+	if (ReasoningStatusBorder.IsValid())
+	{
+		ReasoningStatusBorder->SetVisibility(EVisibility::Visible);
+	}
+	if (ReasoningSummaryText.IsValid())
+	{
+		ReasoningSummaryText->SetText(NSLOCTEXT("UnrealGPT", "ReasoningPendingShort", "Thinking..."));
+	}
+
+	// Slate only invalidates the strip while the placeholder is animating
+	ReasoningAnimationFrame = 0;
+	if (!ReasoningAnimationHandle.IsValid())
+	{
+		ReasoningAnimationHandle = RegisterActiveTimer(0.4f, FWidgetActiveTimerDelegate::CreateSP(this, &SUnrealGPTWidget::AnimateReasoningPending));
+	}
+}
+
+void SUnrealGPTWidget::HideReasoningStatus()
+{
+	StopReasoningAnimation();
+
+	if (ReasoningStatusBorder.IsValid())
+	{
+		ReasoningStatusBorder->SetVisibility(EVisibility::Collapsed);
+	}
+	if (ReasoningSummaryText.IsValid())
+	{
+		ReasoningSummaryText->SetText(FText::GetEmpty());
+	}
+}
+
+void SUnrealGPTWidget::StopReasoningAnimation()
+{
+	if (TSharedPtr<FActiveTimerHandle> Handle = ReasoningAnimationHandle.Pin())
+	{
+		UnRegisterActiveTimer(Handle.ToSharedRef());
+	}
+	ReasoningAnimationHandle.Reset();
+}
+
+EActiveTimerReturnType SUnrealGPTWidget::AnimateReasoningPending(double InCurrentTime, float InDeltaTime)
+{
+	if (!ReasoningSummaryText.IsValid() || !ReasoningStatusBorder.IsValid() || ReasoningStatusBorder->GetVisibility() != EVisibility::Visible)
+	{
+		ReasoningAnimationHandle.Reset();
+		return EActiveTimerReturnType::Stop;
+	}
+
+	static const TCHAR* Dots[] = { TEXT("."), TEXT(".."), TEXT("...") };
+	ReasoningAnimationFrame = (ReasoningAnimationFrame + 1) % UE_ARRAY_COUNT(Dots);
+	ReasoningSummaryText->SetText(FText::Format(NSLOCTEXT("UnrealGPT", "ReasoningPendingAnimated", "Thinking{0}"), FText::FromString(Dots[ReasoningAnimationFrame])));
+
+	return EActiveTimerReturnType::Continue;
+}
+
 void SUnrealGPTWidget::HandleToolCall(const FString& ToolName, const FString& Arguments)
 {
 	// Add tool call to history list (internal tracking)
@@ -2164,7 +1953,7 @@ void SUnrealGPTWidget::HandleToolCall(const FString& ToolName, const FString& Ar
 		ChatHistoryBox->AddSlot()
 			.Padding(12.0f, 6.0f)
 			[
-				CreateToolSpecificWidget(ToolName, Arguments, TEXT(""))
+				CreateToolCallWidget(ToolName, Arguments, TEXT(""))
 			];
 		
 		// Scroll to bottom to show new tool call
@@ -2174,6 +1963,13 @@ void SUnrealGPTWidget::HandleToolCall(const FString& ToolName, const FString& Ar
 
 void SUnrealGPTWidget::HandleToolResult(const FString& ToolCallId, const FString& Result)
 {
+	// The result takes the place of the live progress row
+	FToolProgressRow ProgressRow;
+	if (ToolProgressRows.RemoveAndCopyValue(ToolCallId, ProgressRow) && ChatHistoryBox.IsValid() && ProgressRow.Row.IsValid())
+	{
+		ChatHistoryBox->RemoveSlot(ProgressRow.Row.ToSharedRef());
+	}
+
 	// Don't spam the UI with empty results
 	const FString Trimmed = Result.TrimStartAndEnd();
 	if (Trimmed.IsEmpty() || Trimmed == TEXT("[]"))
@@ -2202,22 +1998,166 @@ void SUnrealGPTWidget::HandleToolResult(const FString& ToolCallId, const FString
 		if (ImageBase64.Len() > 100 &&
 			(ImageBase64.StartsWith(TEXT("iVBORw0KGgo")) || ImageBase64.StartsWith(TEXT("/9j/"))))
 		{
-			bIsScreenshot = true;
+			bIsScreenshot = true;
+		}
+	}
+	// Legacy format: raw base64 image (no metadata)
+	else if (Trimmed.Len() > 100 &&
+		(Trimmed.StartsWith(TEXT("iVBORw0KGgo")) || Trimmed.StartsWith(TEXT("/9j/"))))
+	{
+		bIsScreenshot = true;
+		ImageBase64 = Trimmed;
+	}
+
+	if (ChatHistoryBox.IsValid())
+	{
+		// Handle screenshot display specially
+		if (bIsScreenshot)
+		{
+			// Decoding and texture upload are handled asynchronously by the image cache (max 800x600)
+			const uint64 ImageKey = ImageCache->AddImage(ImageBase64);
+
+			ChatHistoryBox->AddSlot()
+				.Padding(12.0f, 6.0f)
+				[
+					SNew(SBorder)
+					.BorderImage(FAppStyle::GetBrush("Brushes.White"))
+					.BorderBackgroundColor(FLinearColor(0.05f, 0.05f, 0.06f, 1.0f))
+					.Padding(FMargin(14.0f, 10.0f))
+					[
+						SNew(SVerticalBox)
+
+						+ SVerticalBox::Slot()
+						.AutoHeight()
+						.Padding(0.0f, 0.0f, 0.0f, 8.0f)
+						[
+							SNew(STextBlock)
+							.Text(NSLOCTEXT("UnrealGPT", "ScreenshotResult", "Viewport Screenshot"))
+							.Font(FAppStyle::GetFontStyle("SmallFontBold"))
+							.ColorAndOpacity(FLinearColor(0.3f, 0.8f, 0.6f, 1.0f))
+						]
+
+						+ SVerticalBox::Slot()
+						.AutoHeight()
+						[
+							ImageCache->CreateThumbnailWidget(ImageKey, FVector2D(800.0f, 600.0f))
+						]
+					]
+				];
+
+			return;
+		}
+		
+		// Only the one-line summary is built here; the formatted result is generated when the entry is expanded
+		const FUnrealGPTToolResultSummary Summary = UnrealGPTToolSummarizer::SummarizeResult(Trimmed);
+		const bool bIsSceneQueryResult = Trimmed.StartsWith(TEXT("[")) && Summary.ItemCount > 0;
+
+		FLinearColor AccentColor = bIsSceneQueryResult ? FLinearColor(0.6f, 0.4f, 0.9f, 1.0f) : FLinearColor(0.3f, 0.7f, 0.3f, 1.0f);
+		if (Summary.bIsError)
+		{
+			AccentColor = FLinearColor(0.9f, 0.3f, 0.3f, 1.0f);
+		}
+
+		ChatHistoryBox->AddSlot()
+			.Padding(12.0f, 6.0f)
+			[
+				SNew(SUnrealGPTLazyExpander)
+				.Icon(Summary.bIsError ? FString(TEXT("\xf00d")) : FString(TEXT("\xf00c"))) // Times or Check icon
+				.Title(NSLOCTEXT("UnrealGPT", "ToolResult", "Tool Result"))
+				.Summary(FText::FromString(Summary.OneLine))
+				.AccentColor(AccentColor)
+				.OnGenerateDetails(FOnGenerateUnrealGPTDetails::CreateSP(this, &SUnrealGPTWidget::CreateToolResultDetailsWidget, Result))
+			];
+	}
+}
+
+void SUnrealGPTWidget::HandleToolProgress(const FString& ToolCallId, const FString& Status, float Progress)
+{
+	if (!ChatHistoryBox.IsValid())
+	{
+		return;
+	}
+
+	FToolProgressRow* ProgressRow = ToolProgressRows.Find(ToolCallId);
+	if (!ProgressRow)
+	{
+		ProgressRow = &ToolProgressRows.Add(ToolCallId);
+
+		TSharedRef<SWidget> RowWidget = SNew(SBorder)
+			.BorderImage(FAppStyle::GetBrush("Brushes.White"))
+			.BorderBackgroundColor(FLinearColor(0.05f, 0.05f, 0.06f, 1.0f))
+			.Padding(FMargin(14.0f, 8.0f))
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.0f, 0.0f, 0.0f, 6.0f)
+				[
+					SAssignNew(ProgressRow->StatusText, STextBlock)
+					.Font(FAppStyle::GetFontStyle("SmallFont"))
+					.ColorAndOpacity(FLinearColor(0.7f, 0.7f, 0.75f, 1.0f))
+					.AutoWrapText(true)
+				]
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SAssignNew(ProgressRow->ProgressBar, SProgressBar)
+				]
+			];
+
+		ProgressRow->Row = RowWidget;
+		ChatHistoryBox->AddSlot()
+			.Padding(12.0f, 6.0f)
+			[
+				RowWidget
+			];
+		ChatHistoryBox->ScrollToEnd();
+	}
+
+	ProgressRow->StatusText->SetText(FText::FromString(Status));
+
+	// An unset percentage shows the indeterminate marquee
+	ProgressRow->ProgressBar->SetPercent(Progress >= 0.0f ? TOptional<float>(FMath::Clamp(Progress, 0.0f, 1.0f)) : TOptional<float>());
+}
+
+TSharedRef<SWidget> SUnrealGPTWidget::CreateToolResultDetailsWidget(const FString& Result)
+{
+	FString SpillPreview;
+	FString SpillFilePath;
+	if (UnrealGPTToolResultProcessor::ParseSpilledResult(Result, SpillPreview, SpillFilePath))
+	{
+		TSharedRef<SUnrealGPTLargeTextViewer> Viewer = SNew(SUnrealGPTLargeTextViewer)
+			.FilePath(SpillFilePath);
+
+		if (Viewer->IsValid())
+		{
+			return Viewer;
 		}
+
+		// Scratch file was cleaned up: show why, then whatever preview was kept inline
+		return SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 0.0f, 0.0f, 6.0f)
+			[
+				Viewer
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				CreateToolResultDetailsWidget(SpillPreview)
+			];
 	}
-	// Legacy format: raw base64 image (no metadata)
-	else if (Trimmed.Len() > 100 &&
-		(Trimmed.StartsWith(TEXT("iVBORw0KGgo")) || Trimmed.StartsWith(TEXT("/9j/"))))
-	{
-		bIsScreenshot = true;
-		ImageBase64 = Trimmed;
-	}
+
+	const FString Trimmed = Result.TrimStartAndEnd();
 
 	// Try to generate a friendlier summary for JSON array results (e.g., scene_query)
 	FString DisplayText;
 	bool bIsSceneQueryResult = false;
 	
-	if (!bIsScreenshot && Trimmed.StartsWith(TEXT("[")))
+	if (Trimmed.StartsWith(TEXT("[")))
 	{
 		TArray<TSharedPtr<FJsonValue>> JsonArray;
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Trimmed);
@@ -2267,8 +2207,8 @@ void SUnrealGPTWidget::HandleToolResult(const FString& ToolCallId, const FString
 		}
 	}
 
-	// Fallback: just show the raw result (unless it's a screenshot)
-	if (DisplayText.IsEmpty() && !bIsScreenshot)
+	// Fallback: just show the raw result
+	if (DisplayText.IsEmpty())
 	{
 		// Try to parse Python result JSON structure (status/message/details)
 		bool bIsPythonResult = false;
@@ -2321,322 +2261,127 @@ void SUnrealGPTWidget::HandleToolResult(const FString& ToolCallId, const FString
 		}
 	}
 
-	if (ChatHistoryBox.IsValid())
+	// Determine if content is large enough to warrant collapsible display
+	TArray<FString> ResultLines;
+	DisplayText.ParseIntoArrayLines(ResultLines);
+	const int32 ResultLineCount = ResultLines.Num();
+	const int32 MaxResultLines = 10;
+	const int32 MaxResultChars = 1000;
+	const bool bNeedsCollapsible = (ResultLineCount > MaxResultLines) || (DisplayText.Len() > MaxResultChars);
+
+	// Build preview for collapsed state
+	FString ResultPreview;
+	if (bNeedsCollapsible)
 	{
-		// Handle screenshot display specially
-		if (bIsScreenshot)
+		const int32 PreviewLines = FMath::Min(MaxResultLines, ResultLineCount);
+		for (int32 i = 0; i < PreviewLines; ++i)
 		{
-			// Decode base64 and create texture (use ImageBase64 which has the actual image data)
-			TArray<uint8> ImageData;
-			if (FBase64::Decode(ImageBase64, ImageData))
-			{
-				IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-
-				// Try JPEG first (resized screenshots), then fall back to PNG (original full-res)
-				TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
-				bool bImageLoaded = ImageWrapper.IsValid() && ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num());
-
-				if (!bImageLoaded)
-				{
-					// Try PNG as fallback
-					ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-					bImageLoaded = ImageWrapper.IsValid() && ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num());
-				}
-
-				if (bImageLoaded)
-				{
-					TArray<uint8> UncompressedBGRA;
-					if (ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA))
-					{
-						int32 Width = ImageWrapper->GetWidth();
-						int32 Height = ImageWrapper->GetHeight();
-						
-						// Generate unique texture name using timestamp to prevent texture reuse
-						static int32 ScreenshotCounter = 0;
-						const FString TextureName = FString::Printf(TEXT("ScreenshotTexture_%d_%lld"), ScreenshotCounter++, FDateTime::Now().GetTicks());
-
-						// Create texture on game thread using FImageUtils (UE5.6 compatible)
-						AsyncTask(ENamedThreads::GameThread, [this, Width, Height, UncompressedBGRA, TextureName]()
-						{
-							// Widget may have been destroyed between scheduling and execution
-							if (!ChatHistoryBox.IsValid())
-							{
-								return;
-							}
-
-							// Convert BGRA to FColor array for FImageUtils
-							TArray<FColor> ColorData;
-							ColorData.Reserve(Width * Height);
-							for (int32 i = 0; i < UncompressedBGRA.Num(); i += 4)
-							{
-								// BGRA format: B, G, R, A
-								FColor Color;
-								Color.B = UncompressedBGRA[i + 0];
-								Color.G = UncompressedBGRA[i + 1];
-								Color.R = UncompressedBGRA[i + 2];
-								Color.A = UncompressedBGRA[i + 3];
-								ColorData.Add(Color);
-							}
-							
-							// Create texture using FImageUtils (UE5.6 compatible API).
-							// Use the transient package as the outer so the texture is not considered for saving/packaging.
-							// Each texture gets a unique name to prevent Unreal from reusing/updating existing textures.
-							FCreateTexture2DParameters TextureParams;
-							UTexture2D* Texture = FImageUtils::CreateTexture2D(
-								Width,
-								Height,
-								ColorData,
-								GetTransientPackage(),			// Outer
-								*TextureName,					// Unique name per screenshot
-								RF_Transient,					// Flags (not saved/packaged)
-								TextureParams);
-							
-							if (Texture)
-							{
-								// Root the texture to prevent garbage collection during PIE transitions.
-								// Slate brushes hold raw pointers to textures, so we must keep them alive.
-								Texture->AddToRoot();
-								ScreenshotTextures.Add(Texture);
-
-								// Create brush from texture (using MakeShareable for proper memory management)
-								TSharedPtr<FSlateBrush> Brush = MakeShareable(new FSlateBrush());
-								Brush->SetResourceObject(Texture);
-								Brush->ImageSize = FVector2D(Width, Height);
-								Brush->ImageType = ESlateBrushImageType::FullColor;
-
-								// Keep the brush alive as long as the widget is alive so Slate
-								// never dereferences a freed FSlateBrush pointer.
-								ScreenshotBrushes.Add(Brush);
-								
-								// Add screenshot widget to chat
-								if (ChatHistoryBox.IsValid())
-								{
-									ChatHistoryBox->AddSlot()
-										.Padding(12.0f, 6.0f)
-										[
-											SNew(SBorder)
-											.BorderImage(FAppStyle::GetBrush("Brushes.White"))
-											.BorderBackgroundColor(FLinearColor(0.05f, 0.05f, 0.06f, 1.0f))
-											.Padding(FMargin(14.0f, 10.0f))
-											[
-												SNew(SVerticalBox)
-												
-												+ SVerticalBox::Slot()
-												.AutoHeight()
-												.Padding(0.0f, 0.0f, 0.0f, 8.0f)
-												[
-													SNew(STextBlock)
-													.Text(NSLOCTEXT("UnrealGPT", "ScreenshotResult", "Viewport Screenshot"))
-													.Font(FAppStyle::GetFontStyle("SmallFontBold"))
-													.ColorAndOpacity(FLinearColor(0.3f, 0.8f, 0.6f, 1.0f))
-												]
-												
-												+ SVerticalBox::Slot()
-												.AutoHeight()
-												[
-													SNew(SBox)
-													.WidthOverride(FMath::Min(800.0f, static_cast<float>(Width)))
-													.HeightOverride(FMath::Min(600.0f, static_cast<float>(Height) * 800.0f / static_cast<float>(Width)))
-													[
-														SNew(SImage)
-														.Image(Brush.Get())
-													]
-												]
-											]
-										];
-								}
-							}
-						});
-						
-						return; // Exit early, screenshot will be added async
-					}
-				}
-			}
-			// If decoding failed, fall through to show as text
-			DisplayText = TEXT("Screenshot captured (failed to decode image for display)");
+			ResultPreview += ResultLines[i] + TEXT("\n");
 		}
-		
-		// Determine if content is large enough to warrant collapsible display
-		TArray<FString> ResultLines;
-		DisplayText.ParseIntoArrayLines(ResultLines);
-		const int32 ResultLineCount = ResultLines.Num();
-		const int32 MaxResultLines = 10;
-		const int32 MaxResultChars = 1000;
-		const bool bNeedsCollapsible = (ResultLineCount > MaxResultLines) || (DisplayText.Len() > MaxResultChars);
-
-		// Build preview for collapsed state
-		FString ResultPreview;
-		if (bNeedsCollapsible)
+		ResultPreview = ResultPreview.TrimEnd();
+		if (ResultPreview.Len() > MaxResultChars)
 		{
-			const int32 PreviewLines = FMath::Min(MaxResultLines, ResultLineCount);
-			for (int32 i = 0; i < PreviewLines; ++i)
-			{
-				ResultPreview += ResultLines[i] + TEXT("\n");
-			}
-			ResultPreview = ResultPreview.TrimEnd();
-			if (ResultPreview.Len() > MaxResultChars)
-			{
-				ResultPreview = ResultPreview.Left(MaxResultChars);
-			}
+			ResultPreview = ResultPreview.Left(MaxResultChars);
 		}
+	}
 
-		// Create the result display (either direct or collapsible)
-		TSharedRef<SWidget> ResultDisplay = SNullWidget::NullWidget;
+	// Create the result display (either direct or collapsible)
+	TSharedRef<SWidget> ResultDisplay = SNullWidget::NullWidget;
 
-		if (bNeedsCollapsible)
-		{
-			// Use widget switcher for clean expand/collapse without persistent header
-			TSharedPtr<SWidgetSwitcher> ResultSwitcher = SNew(SWidgetSwitcher)
-				.WidgetIndex(0); // Start collapsed
+	if (bNeedsCollapsible)
+	{
+		// Use widget switcher for clean expand/collapse without persistent header
+		TSharedPtr<SWidgetSwitcher> ResultSwitcher = SNew(SWidgetSwitcher)
+			.WidgetIndex(0); // Start collapsed
 
-			const int32 ExtraResultLines = ResultLineCount - FMath::Min(MaxResultLines, ResultLineCount);
-			FSlateFontInfo ResultFont = bIsSceneQueryResult ? GetUnrealGPTBodyFont() : FCoreStyle::GetDefaultFontStyle("Mono", 8);
+		const int32 ExtraResultLines = ResultLineCount - FMath::Min(MaxResultLines, ResultLineCount);
+		FSlateFontInfo ResultFont = bIsSceneQueryResult ? GetUnrealGPTBodyFont() : FCoreStyle::GetDefaultFontStyle("Mono", 8);
 
-			// Slot 0: Collapsed state (preview + "Show more" button)
-			ResultSwitcher->AddSlot()
+		// Slot 0: Collapsed state (preview + "Show more" button)
+		ResultSwitcher->AddSlot()
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
 			[
-				SNew(SVerticalBox)
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					CreateSelectableTextWidget(
-						ResultPreview,
-						ResultFont,
-						FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
-						true /* bAutoWrap */
-					)
-				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				.Padding(0.0f, 6.0f, 0.0f, 0.0f)
-				[
-					SNew(SButton)
-					.ButtonStyle(FAppStyle::Get(), "SimpleButton")
-					.OnClicked_Lambda([ResultSwitcher]() {
-						if (ResultSwitcher.IsValid())
-						{
-							ResultSwitcher->SetActiveWidgetIndex(1);
-						}
-						return FReply::Handled();
-					})
-					[
-						SNew(STextBlock)
-						.Text(FText::FromString(FString::Printf(TEXT("... Show %d more lines"), ExtraResultLines)))
-						.Font(GetUnrealGPTSmallBodyItalicFont())
-						.ColorAndOpacity(FLinearColor(0.5f, 0.7f, 1.0f, 1.0f))
-					]
-				]
-			];
-
-			// Slot 1: Expanded state (full content + "Show less" button)
-			ResultSwitcher->AddSlot()
+				CreateSelectableTextWidget(
+					ResultPreview,
+					ResultFont,
+					FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
+					true /* bAutoWrap */
+				)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 6.0f, 0.0f, 0.0f)
 			[
-				SNew(SVerticalBox)
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					CreateSelectableTextWidget(
-						DisplayText,
-						ResultFont,
-						FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
-						true /* bAutoWrap */
-					)
-				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				.Padding(0.0f, 6.0f, 0.0f, 0.0f)
+				SNew(SButton)
+				.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+				.OnClicked_Lambda([ResultSwitcher]() {
+					if (ResultSwitcher.IsValid())
+					{
+						ResultSwitcher->SetActiveWidgetIndex(1);
+					}
+					return FReply::Handled();
+				})
 				[
-					SNew(SButton)
-					.ButtonStyle(FAppStyle::Get(), "SimpleButton")
-					.OnClicked_Lambda([ResultSwitcher]() {
-						if (ResultSwitcher.IsValid())
-						{
-							ResultSwitcher->SetActiveWidgetIndex(0);
-						}
-						return FReply::Handled();
-					})
-					[
-						SNew(STextBlock)
-						.Text(FText::FromString(TEXT("Show less")))
-						.Font(GetUnrealGPTSmallBodyItalicFont())
-						.ColorAndOpacity(FLinearColor(0.5f, 0.7f, 1.0f, 1.0f))
-					]
+					SNew(STextBlock)
+					.Text(FText::FromString(FString::Printf(TEXT("... Show %d more lines"), ExtraResultLines)))
+					.Font(GetUnrealGPTSmallBodyItalicFont())
+					.ColorAndOpacity(FLinearColor(0.5f, 0.7f, 1.0f, 1.0f))
 				]
-			];
-
-			ResultDisplay = ResultSwitcher.ToSharedRef();
-		}
-		else
-		{
-			ResultDisplay = CreateSelectableTextWidget(
-				DisplayText,
-				bIsSceneQueryResult ? GetUnrealGPTBodyFont() : FCoreStyle::GetDefaultFontStyle("Mono", 8),
-				FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
-				true /* bAutoWrap */
-			);
-		}
+			]
+		];
 
-		// Standard tool result display
-		ChatHistoryBox->AddSlot()
-			.Padding(12.0f, 6.0f)
+		// Slot 1: Expanded state (full content + "Show less" button)
+		ResultSwitcher->AddSlot()
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
 			[
-				SNew(SBorder)
-				.BorderImage(FAppStyle::GetBrush("Brushes.White"))
-				.BorderBackgroundColor(FLinearColor(0.05f, 0.05f, 0.06f, 1.0f))
-				.Padding(FMargin(14.0f, 10.0f))
+				CreateSelectableTextWidget(
+					DisplayText,
+					ResultFont,
+					FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
+					true /* bAutoWrap */
+				)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 6.0f, 0.0f, 0.0f)
+			[
+				SNew(SButton)
+				.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+				.OnClicked_Lambda([ResultSwitcher]() {
+					if (ResultSwitcher.IsValid())
+					{
+						ResultSwitcher->SetActiveWidgetIndex(0);
+					}
+					return FReply::Handled();
+				})
 				[
-					SNew(SHorizontalBox)
-
-					// Result icon
-					+ SHorizontalBox::Slot()
-					.AutoWidth()
-					.Padding(0.0f, 0.0f, 12.0f, 0.0f)
-					[
-						SNew(SBox)
-						.WidthOverride(32.0f)
-						.HeightOverride(32.0f)
-						[
-							SNew(SBorder)
-							.BorderImage(FAppStyle::GetBrush("Brushes.White"))
-							.BorderBackgroundColor(bIsSceneQueryResult ? FLinearColor(0.6f, 0.4f, 0.9f, 1.0f) :
-								(bIsScreenshot ? FLinearColor(0.3f, 0.8f, 0.6f, 1.0f) : FLinearColor(0.3f, 0.7f, 0.3f, 1.0f)))
-							.Padding(0.0f)
-							.HAlign(HAlign_Center)
-							.VAlign(VAlign_Center)
-							[
-								SNew(STextBlock)
-								.Font(FAppStyle::Get().GetFontStyle("FontAwesome.12"))
-								.Text(FText::FromString(bIsScreenshot ? FString(TEXT("\xf030")) : FString(TEXT("\xf00c")))) // Camera or Check icon
-								.ColorAndOpacity(FLinearColor::White)
-							]
-						]
-					]
-
-					// Result content
-					+ SHorizontalBox::Slot()
-					.FillWidth(1.0f)
-					[
-						SNew(SVerticalBox)
-
-						+ SVerticalBox::Slot()
-						.AutoHeight()
-						.Padding(0.0f, 0.0f, 0.0f, 6.0f)
-						[
-							SNew(STextBlock)
-							.Text(NSLOCTEXT("UnrealGPT", "ToolResult", "Tool Result"))
-							.Font(GetUnrealGPTSmallBodyFont())
-							.ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f, 1.0f))
-						]
-
-						+ SVerticalBox::Slot()
-						.AutoHeight()
-						[
-							ResultDisplay
-						]
-					]
+					SNew(STextBlock)
+					.Text(FText::FromString(TEXT("Show less")))
+					.Font(GetUnrealGPTSmallBodyItalicFont())
+					.ColorAndOpacity(FLinearColor(0.5f, 0.7f, 1.0f, 1.0f))
 				]
-			];
+			]
+		];
+
+		ResultDisplay = ResultSwitcher.ToSharedRef();
+	}
+	else
+	{
+		ResultDisplay = CreateSelectableTextWidget(
+			DisplayText,
+			bIsSceneQueryResult ? GetUnrealGPTBodyFont() : FCoreStyle::GetDefaultFontStyle("Mono", 8),
+			FLinearColor(0.9f, 0.9f, 0.9f, 1.0f),
+			true /* bAutoWrap */
+		);
 	}
+
+	return ResultDisplay;
 }
 
 FReply SUnrealGPTWidget::OnVoiceInputClicked()
@@ -2665,31 +2410,43 @@ FReply SUnrealGPTWidget::OnVoiceInputClicked()
 
 void SUnrealGPTWidget::OnTranscriptionComplete(const FString& TranscribedText)
 {
-	if (!TranscribedText.IsEmpty() && InputTextBox.IsValid())
+	SetVoiceTranscriptText(TranscribedText);
+
+	// Optionally auto-send (commented out - user can manually send)
+	// OnSendClicked();
+}
+
+void SUnrealGPTWidget::OnTranscriptionPartial(const FString& PartialText)
+{
+	SetVoiceTranscriptText(PartialText);
+}
+
+void SUnrealGPTWidget::SetVoiceTranscriptText(const FString& Transcript)
+{
+	if (Transcript.IsEmpty() || !InputTextBox.IsValid())
 	{
-		// Set transcribed text in input box
-		FText CurrentText = InputTextBox->GetText();
-		FString NewText = CurrentText.ToString();
-		
-		// Append transcribed text (or replace if empty)
-		if (NewText.IsEmpty())
-		{
-			NewText = TranscribedText;
-		}
-		else
-		{
-			NewText += TEXT(" ") + TranscribedText;
-		}
-		
-		InputTextBox->SetText(FText::FromString(NewText));
-		
-		// Optionally auto-send (commented out - user can manually send)
-		// OnSendClicked();
+		return;
 	}
+
+	// Append transcribed text (or replace if empty)
+	FString NewText = VoiceBaseText;
+	if (NewText.IsEmpty())
+	{
+		NewText = Transcript;
+	}
+	else
+	{
+		NewText += TEXT(" ") + Transcript;
+	}
+
+	InputTextBox->SetText(FText::FromString(NewText));
 }
 
 void SUnrealGPTWidget::OnRecordingStarted()
 {
+	// Partial transcripts replace everything after this text as segments come back
+	VoiceBaseText = InputTextBox.IsValid() ? InputTextBox->GetText().ToString() : FString();
+
 	// Update button appearance if needed
 	if (VoiceInputButton.IsValid())
 	{
@@ -2838,6 +2595,8 @@ FText SUnrealGPTWidget::GetCurrentSessionText() const
 
 void SUnrealGPTWidget::RebuildChatHistoryFromSession()
 {
+	UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_RebuildChatHistory);
+
 	if (!ChatHistoryBox.IsValid() || !IsValid(AgentClient))
 	{
 		return;
@@ -2851,25 +2610,15 @@ void SUnrealGPTWidget::RebuildChatHistoryFromSession()
 
 	// Clear existing UI
 	ChatHistoryBox->ClearChildren();
+	ToolProgressRows.Reset();
 
 	// Clean up old textures
-	for (UTexture2D* Texture : ScreenshotTextures)
-	{
-		if (IsValid(Texture) && Texture->IsRooted())
-		{
-			Texture->RemoveFromRoot();
-		}
-	}
-	ScreenshotTextures.Empty();
-	ScreenshotBrushes.Empty();
+	ImageCache->Reset();
 	ToolCallHistory.Empty();
 	PendingAttachedImages.Empty();
 
 	// Hide reasoning status
-	if (ReasoningStatusBorder.IsValid())
-	{
-		ReasoningStatusBorder->SetVisibility(EVisibility::Collapsed);
-	}
+	HideReasoningStatus();
 
 	const FSessionData& Session = SessionManager->GetCurrentSessionData();
 	int32 ToolCallIndex = 0;
@@ -2922,7 +2671,7 @@ void SUnrealGPTWidget::RebuildChatHistoryFromSession()
 				ChatHistoryBox->AddSlot()
 					.Padding(12.0f, 6.0f)
 					[
-						CreateToolSpecificWidget(TC.ToolName, TC.Arguments, TC.Result)
+						CreateToolCallWidget(TC.ToolName, TC.Arguments, TC.Result)
 					];
 				ToolCallIndex++;
 			}
@@ -2944,106 +2693,20 @@ void SUnrealGPTWidget::RebuildChatHistoryFromSession()
 
 void SUnrealGPTWidget::DisplayImageFromBase64(const FString& ImageBase64)
 {
-	if (ImageBase64.IsEmpty() || !ChatHistoryBox.IsValid())
-	{
-		return;
-	}
-
-	// Decode base64 to binary
-	TArray<uint8> ImageData;
-	if (!FBase64::Decode(ImageBase64, ImageData))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to decode base64 image"));
-		return;
-	}
-
-	// Load image wrapper module
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-
-	// Try JPEG first, then PNG
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
-	if (!ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num()))
-	{
-		ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-		if (!ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num()))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to decompress image (not JPEG or PNG)"));
-			return;
-		}
-	}
-
-	// Get raw pixel data
-	TArray<uint8> UncompressedBGRA;
-	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to get raw image data"));
-		return;
-	}
-
-	const int32 Width = ImageWrapper->GetWidth();
-	const int32 Height = ImageWrapper->GetHeight();
-
-	// Convert BGRA to FColor array
-	TArray<FColor> Colors;
-	Colors.SetNum(Width * Height);
-	for (int32 i = 0; i < Width * Height; ++i)
-	{
-		Colors[i].B = UncompressedBGRA[i * 4 + 0];
-		Colors[i].G = UncompressedBGRA[i * 4 + 1];
-		Colors[i].R = UncompressedBGRA[i * 4 + 2];
-		Colors[i].A = UncompressedBGRA[i * 4 + 3];
-	}
+	UNREALGPT_SCOPE_CYCLE_COUNTER(STAT_UnrealGPT_DisplayImage);
 
-	// Create texture
-	FCreateTexture2DParameters Params;
-	Params.bDeferCompression = true;
-	Params.CompressionSettings = TC_Default;
-	UTexture2D* Texture = FImageUtils::CreateTexture2D(Width, Height, Colors, GetTransientPackage(), TEXT("SessionImage"), RF_Transient, Params);
-	if (!Texture)
+	if (ImageBase64.IsEmpty() || !ChatHistoryBox.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealGPT: Failed to create texture from image"));
 		return;
 	}
 
-	Texture->AddToRoot();
-	ScreenshotTextures.Add(Texture);
-
-	// Create brush
-	TSharedPtr<FSlateBrush> Brush = MakeShared<FSlateBrush>();
-	Brush->SetResourceObject(Texture);
-	Brush->ImageSize = FVector2D(Width, Height);
-	ScreenshotBrushes.Add(Brush);
-
-	// Calculate display size (max 600x400 in chat)
-	const float MaxDisplayWidth = 600.0f;
-	const float MaxDisplayHeight = 400.0f;
-	float DisplayWidth = static_cast<float>(Width);
-	float DisplayHeight = static_cast<float>(Height);
-
-	if (DisplayWidth > MaxDisplayWidth)
-	{
-		const float Scale = MaxDisplayWidth / DisplayWidth;
-		DisplayWidth = MaxDisplayWidth;
-		DisplayHeight *= Scale;
-	}
-	if (DisplayHeight > MaxDisplayHeight)
-	{
-		const float Scale = MaxDisplayHeight / DisplayHeight;
-		DisplayHeight = MaxDisplayHeight;
-		DisplayWidth *= Scale;
-	}
+	// Decoding happens on a worker thread the first time the thumbnail is painted (max 600x400 in chat)
+	const uint64 ImageKey = ImageCache->AddImage(ImageBase64);
 
-	// Add image to chat
 	ChatHistoryBox->AddSlot()
 		.Padding(12.0f, 6.0f)
 		[
-			SNew(SBox)
-			.WidthOverride(DisplayWidth)
-			.HeightOverride(DisplayHeight)
-			[
-				SNew(SImage)
-				.Image(Brush.Get())
-			]
+			ImageCache->CreateThumbnailWidget(ImageKey, FVector2D(600.0f, 400.0f))
 		];
 }
 
@@ -3957,6 +3620,8 @@ FReply SUnrealGPTWidget::OnAgentModeToggleClicked()
 		}
 	}
 
+	WakeAgentTicker();
+
 	return FReply::Handled();
 }
 
@@ -4010,6 +3675,14 @@ FReply SUnrealGPTWidget::OnAgentCancelClicked()
 
 	// Cancel the agent
 	AgentController->Cancel();
+	if (AgentClient)
+	{
+		AgentClient->CancelRequest();
+	}
+	else
+	{
+		UUnrealGPTToolExecutor::CancelPythonExecution();
+	}
 
 	// Also cancel any pending LLM requests
 	FAgentLLMInterface& LLMInterface = AgentController->GetLLMInterface();
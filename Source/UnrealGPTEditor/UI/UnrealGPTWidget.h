@@ -33,13 +33,16 @@ public:
 	void Construct(const FArguments& InArgs);
 	virtual ~SUnrealGPTWidget();
 
+	/** Timed for "stat UnrealGPT"; also publishes the chat row count and image memory */
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
 	friend class UUnrealGPTWidgetDelegateHandler;
 
 private:
 	/** Create chat message widget */
 	TSharedRef<SWidget> CreateMessageWidget(const FString& Role, const FString& Content);
 
-	/** Create tool call widget */
+	/** Create tool call widget: a one-line summary that builds its details only when expanded */
 	TSharedRef<SWidget> CreateToolCallWidget(const FString& ToolName, const FString& Arguments, const FString& Result);
 
 	/** Parse markdown to rich text for better message display */
@@ -48,6 +51,15 @@ private:
 	/** Create specialized widget for specific tool types */
 	TSharedRef<SWidget> CreateToolSpecificWidget(const FString& ToolName, const FString& Arguments, const FString& Result);
 
+	/** Arguments and result section of a tool widget, without the header */
+	TSharedRef<SWidget> CreateToolDetailsWidget(const FString& ToolName, const FString& Arguments, const FString& Result);
+
+	/** Detailed view of a tool result, built when its collapsed entry is expanded */
+	TSharedRef<SWidget> CreateToolResultDetailsWidget(const FString& Result);
+
+	/** Get accent color, Font Awesome glyph and display name for a tool */
+	void GetToolStyle(const FString& ToolName, FLinearColor& OutColor, FString& OutIcon, FString& OutDisplayName) const;
+
 	/** Get color scheme for message role */
 	FLinearColor GetRoleColor(const FString& Role) const;
 
@@ -98,6 +110,12 @@ private:
 	/** Handle transcription complete */
 	void OnTranscriptionComplete(const FString& TranscribedText);
 
+	/** Handle the transcript so far while the user is still talking */
+	void OnTranscriptionPartial(const FString& PartialText);
+
+	/** Show a voice transcript after the text that was in the input box when recording started */
+	void SetVoiceTranscriptText(const FString& Transcript);
+
 	/** Handle recording started */
 	void OnRecordingStarted();
 
@@ -119,6 +137,9 @@ private:
 	/** Handle tool result delegate - called from agent client */
 	void HandleToolResult(const FString& ToolCallId, const FString& Result);
 
+	/** Show or update the progress row of a long-running tool call until its result arrives */
+	void HandleToolProgress(const FString& ToolCallId, const FString& Status, float Progress);
+
 	// ==================== AGENT CONTROLLER HANDLERS ====================
 
 	/** Handle agent state changes - updates status display */
@@ -193,19 +214,28 @@ private:
 	 */
 	class UUnrealGPTVoiceInput* VoiceInput;
 
+	/** Input box text when voice recording started; transcripts are appended to it */
+	FString VoiceBaseText;
+
 	/** Tool call list */
 	TArray<FString> ToolCallHistory;
 
+	/** Progress row shown in the chat while a long-running tool call is in flight */
+	struct FToolProgressRow
+	{
+		TSharedPtr<SWidget> Row;
+		TSharedPtr<STextBlock> StatusText;
+		TSharedPtr<class SProgressBar> ProgressBar;
+	};
+
+	/** Progress rows by tool call ID */
+	TMap<FString, FToolProgressRow> ToolProgressRows;
+
 	/** Pending images attached by the user (base64-encoded) to be sent with the next message */
 	TArray<FString> PendingAttachedImages;
 
-	/** Persistent brushes for screenshots to ensure Slate does not reference freed memory */
-	TArray<TSharedPtr<FSlateBrush>> ScreenshotBrushes;
-
-	/** Persistent textures for screenshots that have been rooted to prevent GC.
-	 *  Each texture has AddToRoot() called when created to prevent garbage collection.
-	 */
-	TArray<UTexture2D*> ScreenshotTextures;
+	/** Decodes chat images off the game thread and owns their textures within a memory budget */
+	TSharedPtr<class FUnrealGPTImageCache> ImageCache;
 
 	/** Compact, dynamic area that shows when the agent is reasoning and its reasoning summary */
 	TSharedPtr<class SBorder> ReasoningStatusBorder;
@@ -213,6 +243,19 @@ private:
 	/** Text block used to display the latest reasoning summary from the agent */
 	TSharedPtr<class STextBlock> ReasoningSummaryText;
 
+	/** Active timer animating the "Thinking..." placeholder; only registered while it is shown */
+	TWeakPtr<FActiveTimerHandle> ReasoningAnimationHandle;
+	int32 ReasoningAnimationFrame = 0;
+
+	/** Show the reasoning strip with an animated placeholder until a summary arrives */
+	void ShowReasoningPending();
+
+	/** Collapse the reasoning strip and stop its animation */
+	void HideReasoningStatus();
+
+	void StopReasoningAnimation();
+	EActiveTimerReturnType AnimateReasoningPending(double InCurrentTime, float InDeltaTime);
+
 	// ==================== SESSION MANAGEMENT ====================
 
 	/** Session dropdown combobox */
@@ -231,12 +274,15 @@ private:
 	 */
 	TUniquePtr<FAgentController> AgentController;
 
-	/** Ticker handle for driving the agent state machine */
+	/** Ticker handle for driving the agent state machine; only registered while the controller has work */
 	FTSTicker::FDelegateHandle AgentTickerHandle;
 
 	/** Called by the ticker to drive the agent state machine */
 	bool OnAgentTick(float DeltaTime);
 
+	/** Register the agent ticker if the controller has work and it is not already running */
+	void WakeAgentTicker();
+
 	/** Agent status display border */
 	TSharedPtr<class SBorder> AgentStatusBorder;
 
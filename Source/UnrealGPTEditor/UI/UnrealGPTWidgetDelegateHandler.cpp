@@ -50,6 +50,14 @@ void UUnrealGPTWidgetDelegateHandler::OnToolResultReceived(const FString& ToolCa
 	}
 }
 
+void UUnrealGPTWidgetDelegateHandler::OnToolProgressReceived(const FString& ToolCallId, const FString& Status, float Progress)
+{
+	if (Widget)
+	{
+		Widget->HandleToolProgress(ToolCallId, Status, Progress);
+	}
+}
+
 void UUnrealGPTWidgetDelegateHandler::OnTranscriptionCompleteReceived(const FString& TranscribedText)
 {
 	if (Widget)
@@ -58,6 +66,14 @@ void UUnrealGPTWidgetDelegateHandler::OnTranscriptionCompleteReceived(const FStr
 	}
 }
 
+void UUnrealGPTWidgetDelegateHandler::OnTranscriptionPartialReceived(const FString& PartialText)
+{
+	if (Widget)
+	{
+		Widget->OnTranscriptionPartial(PartialText);
+	}
+}
+
 void UUnrealGPTWidgetDelegateHandler::OnRecordingStartedReceived()
 {
 	if (Widget)
@@ -30,9 +30,15 @@ public:
 	UFUNCTION()
 	void OnToolResultReceived(const FString& ToolCallId, const FString& Result);
 
+	UFUNCTION()
+	void OnToolProgressReceived(const FString& ToolCallId, const FString& Status, float Progress);
+
 	UFUNCTION()
 	void OnTranscriptionCompleteReceived(const FString& TranscribedText);
 
+	UFUNCTION()
+	void OnTranscriptionPartialReceived(const FString& PartialText);
+
 	UFUNCTION()
 	void OnRecordingStartedReceived();
 
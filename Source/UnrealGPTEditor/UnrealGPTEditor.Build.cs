@@ -1,3 +1,4 @@
+using System.IO;
 using UnrealBuildTool;
 
 public class UnrealGPTEditor : ModuleRules
@@ -64,9 +65,40 @@ public class UnrealGPTEditor : ModuleRules
 				"AudioCaptureCore",
 				"AudioMixer",
 				"RHI",
-				"RenderCore"
+				"RenderCore",
+				"AssetTools",
+				"AssetRegistry",
+				"Landscape",
+				"InterchangeCore",
+				"InterchangeEngine"
 			}
 		);
+
+		// Optional in-process speech-to-text: drop whisper.cpp headers into ThirdParty/whisper/include
+		// and its static or import libraries into ThirdParty/whisper/lib/<Platform>
+		string WhisperDir = Path.Combine(PluginDirectory, "Source", "ThirdParty", "whisper");
+		string WhisperLibDir = Path.Combine(WhisperDir, "lib", Target.Platform.ToString());
+		if (File.Exists(Path.Combine(WhisperDir, "include", "whisper.h")) && Directory.Exists(WhisperLibDir))
+		{
+			PrivateIncludePaths.Add(Path.Combine(WhisperDir, "include"));
+			foreach (string Library in Directory.GetFiles(WhisperLibDir))
+			{
+				string Extension = Path.GetExtension(Library).ToLowerInvariant();
+				if (Extension == ".lib" || Extension == ".a")
+				{
+					PublicAdditionalLibraries.Add(Library);
+				}
+				else if (Extension == ".dll" || Extension == ".so" || Extension == ".dylib")
+				{
+					RuntimeDependencies.Add(Library);
+				}
+			}
+			PrivateDefinitions.Add("WITH_WHISPER_CPP=1");
+		}
+		else
+		{
+			PrivateDefinitions.Add("WITH_WHISPER_CPP=0");
+		}
 	}
 }
 
@@ -1,6 +1,7 @@
 #include "UnrealGPTEditor.h"
 #include "ISettingsModule.h"
 #include "UnrealGPTSettings.h"
+#include "UnrealGPTToolResultCache.h"
 #include "LevelEditor.h"
 #include "ToolMenus.h"
 #include "UnrealGPTWidget.h"
@@ -14,10 +15,12 @@ static const FName UnrealGPTTabName("UnrealGPT");
 void FUnrealGPTEditorModule::StartupModule()
 {
 	RegisterMenus();
+	FUnrealGPTToolResultCache::Get().RegisterEditorHooks();
 }
 
 void FUnrealGPTEditorModule::ShutdownModule()
 {
+	FUnrealGPTToolResultCache::Get().UnregisterEditorHooks();
 }
 
 void FUnrealGPTEditorModule::RegisterMenus()
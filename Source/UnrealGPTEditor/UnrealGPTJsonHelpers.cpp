@@ -240,4 +240,55 @@ namespace UnrealGPTJsonHelpers
 		FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
 		return OutJson;
 	}
+
+	TSharedPtr<FJsonValue> Canonicalize(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return Value;
+		}
+
+		if (Value->Type == EJson::Object)
+		{
+			const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+			TArray<FString> Keys;
+			Object->Values.GetKeys(Keys);
+			Keys.Sort();
+
+			TSharedPtr<FJsonObject> Sorted = MakeShareable(new FJsonObject);
+			for (const FString& Key : Keys)
+			{
+				Sorted->SetField(Key, Canonicalize(Object->Values.FindRef(Key)));
+			}
+			return MakeShareable(new FJsonValueObject(Sorted));
+		}
+
+		if (Value->Type == EJson::Array)
+		{
+			TArray<TSharedPtr<FJsonValue>> Items;
+			for (const TSharedPtr<FJsonValue>& Item : Value->AsArray())
+			{
+				Items.Add(Canonicalize(Item));
+			}
+			return MakeShareable(new FJsonValueArray(Items));
+		}
+
+		return Value;
+	}
+
+	FString MakeCanonicalJson(const FString& Json)
+	{
+		TSharedPtr<FJsonValue> Value;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		if (!FJsonSerializer::Deserialize(Reader, Value) || !Value.IsValid())
+		{
+			return Json;
+		}
+
+		FString Canonical;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Canonical);
+		FJsonSerializer::Serialize(Canonicalize(Value), FString(), Writer);
+		return Canonical;
+	}
 }
@@ -17,4 +17,10 @@ namespace UnrealGPTJsonHelpers
 	TSharedPtr<FJsonObject> BuildPropertyJson(FProperty* Property);
 	TSharedPtr<FJsonObject> BuildFunctionJson(UFunction* Function);
 	FString BuildReflectionSchemaJson(UClass* Class);
+
+	/** Copy of a JSON value with object keys in sorted order, so equal inputs serialize identically */
+	TSharedPtr<FJsonValue> Canonicalize(const TSharedPtr<FJsonValue>& Value);
+
+	/** Json with sorted keys and no whitespace; returned unchanged if it does not parse */
+	FString MakeCanonicalJson(const FString& Json);
 }
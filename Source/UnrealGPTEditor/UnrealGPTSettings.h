@@ -3,8 +3,19 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Engine/DeveloperSettings.h"
+#include "Engine/EngineTypes.h"
 #include "UnrealGPTSettings.generated.h"
 
+UENUM()
+enum class EUnrealGPTTranscriptionBackend : uint8
+{
+	/** OpenAI-compatible /v1/audio/transcriptions endpoint */
+	Remote UMETA(DisplayName = "Remote Endpoint"),
+
+	/** In-process whisper.cpp on the CPU (requires a build with whisper.cpp) */
+	Local UMETA(DisplayName = "Local (whisper.cpp)")
+};
+
 UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "UnrealGPT"))
 class UNREALGPTEDITOR_API UUnrealGPTSettings : public UDeveloperSettings
 {
@@ -86,6 +97,14 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Replicate", meta = (DisplayName = "Video Model"))
 	FString ReplicateVideoModel;
 
+	/** Predictions running on Replicate at once; further ones (e.g. from a batch call) wait in a queue */
+	UPROPERTY(config, EditAnywhere, Category = "Replicate", meta = (DisplayName = "Max Concurrent Predictions", ClampMin = "1", ClampMax = "16", UIMin = "1", UIMax = "16"))
+	int32 ReplicateMaxConcurrentPredictions = 4;
+
+	/** Disk space for cached Replicate outputs reused by identical seeded requests; least recently used entries are evicted first. 0 disables the cache. */
+	UPROPERTY(config, EditAnywhere, Category = "Replicate", meta = (DisplayName = "Generation Cache Quota (MB)", ClampMin = "0", UIMin = "0"))
+	int32 ReplicateCacheQuotaMB = 2048;
+
 	/** Maximum execution timeout in seconds (recommended: 90-120 for reasoning models like gpt-5/o1/o3) */
 	UPROPERTY(config, EditAnywhere, Category = "Safety", meta = (DisplayName = "Execution Timeout (seconds)"))
 	float ExecutionTimeoutSeconds = 90.0f;
@@ -94,6 +113,13 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Safety", meta = (DisplayName = "Max Tool Call Iterations", ClampMin = "0", UIMin = "0"))
 	int32 MaxToolCallIterations = 100;
 
+	/**
+	 * Record everything the agent changes while working on a goal as one undo entry instead of one per tool call.
+	 * Keeps the undo buffer small on long runs; the editor cannot undo while the agent is executing or recovering a plan.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Safety", meta = (DisplayName = "Group Goal Changes Into One Undo"))
+	bool bGroupGoalTransactions = false;
+
 	/** Maximum context tokens per request */
 	UPROPERTY(config, EditAnywhere, Category = "Context", meta = (DisplayName = "Max Context Tokens"))
 	int32 MaxContextTokens = 100000;
@@ -102,6 +128,38 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Context", meta = (DisplayName = "Scene Summary Page Size"))
 	int32 SceneSummaryPageSize = 100;
 
+	/** Decimals kept for positions, rotations and scales in table-format scene results (scene_query format "table" and Capture Context) */
+	UPROPERTY(config, EditAnywhere, Category = "Context", meta = (DisplayName = "Scene Table Precision", ClampMin = "0", ClampMax = "6", UIMin = "0", UIMax = "6"))
+	int32 SceneTablePrecision = 1;
+
+	/** Memory budget for decoded chat images. Least recently viewed images are evicted and decoded again when scrolled back into view. */
+	UPROPERTY(config, EditAnywhere, Category = "Interface", meta = (DisplayName = "Image Cache Budget (MB)", ClampMin = "16", UIMin = "16"))
+	int32 ImageCacheBudgetMB = 128;
+
+	/** Upload voice recordings as 16 kHz FLAC instead of WAV. Disable for transcription endpoints that only accept WAV. */
+	UPROPERTY(config, EditAnywhere, Category = "Voice", meta = (DisplayName = "Compress Voice Uploads (FLAC)"))
+	bool bCompressVoiceUploads = true;
+
+	/** Silence after which a speech segment is closed and sent for transcription while recording continues */
+	UPROPERTY(config, EditAnywhere, Category = "Voice", meta = (DisplayName = "Segment Silence Timeout (ms)", ClampMin = "200", ClampMax = "3000", UIMin = "200", UIMax = "3000"))
+	int32 VoiceSilenceTimeoutMs = 600;
+
+	/** Where speech segments are transcribed. Local falls back to the remote endpoint when whisper.cpp or the model is missing. */
+	UPROPERTY(config, EditAnywhere, Category = "Voice", meta = (DisplayName = "Transcription Backend"))
+	EUnrealGPTTranscriptionBackend TranscriptionBackend = EUnrealGPTTranscriptionBackend::Remote;
+
+	/** ggml whisper model for local transcription (e.g. ggml-base.en-q5_1.bin). Relative paths are resolved against the project directory. */
+	UPROPERTY(config, EditAnywhere, Category = "Voice", meta = (DisplayName = "Local Model File", FilePathFilter = "bin", EditCondition = "TranscriptionBackend == EUnrealGPTTranscriptionBackend::Local"))
+	FFilePath LocalWhisperModelPath;
+
+	/** Decoder threads for local transcription. 0 picks one less than the number of physical cores, up to 8. */
+	UPROPERTY(config, EditAnywhere, Category = "Voice", meta = (DisplayName = "Local Decoder Threads", ClampMin = "0", ClampMax = "32", EditCondition = "TranscriptionBackend == EUnrealGPTTranscriptionBackend::Local"))
+	int32 LocalTranscriptionThreads = 0;
+
+	/** Spoken language code for local transcription, or empty to auto-detect (slower) */
+	UPROPERTY(config, EditAnywhere, Category = "Voice", meta = (DisplayName = "Local Language", EditCondition = "TranscriptionBackend == EUnrealGPTTranscriptionBackend::Local"))
+	FString LocalTranscriptionLanguage = TEXT("en");
+
 	virtual FName GetCategoryName() const override;
 };
 
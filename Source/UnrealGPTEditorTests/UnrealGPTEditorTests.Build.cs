@@ -23,6 +23,7 @@ public class UnrealGPTEditorTests : ModuleRules
 			{
 				"AutomationController",
 				"EditorStyle",
+				"Json",
 				"Slate",
 				"SlateCore",
 				"UnrealEd",
@@ -35,6 +36,8 @@ public class UnrealGPTEditorTests : ModuleRules
 			{
 				Path.Combine(ModuleDirectory, "../UnrealGPTEditor"),
 				Path.Combine(ModuleDirectory, "../UnrealGPTEditor/Agent"),
+				Path.Combine(ModuleDirectory, "../UnrealGPTEditor/AgentCore"),
+				Path.Combine(ModuleDirectory, "../UnrealGPTEditor/Protocol"),
 				Path.Combine(ModuleDirectory, "../UnrealGPTEditor/Tools"),
 				Path.Combine(ModuleDirectory, "../UnrealGPTEditor/UI")
 			}
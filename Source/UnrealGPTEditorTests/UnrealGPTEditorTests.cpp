@@ -15,6 +15,29 @@ IMPLEMENT_MODULE(FUnrealGPTEditorTestsModule, UnrealGPTEditorTests)
 #include "UnrealGPTSceneContext.h"
 #include "UnrealGPTSettings.h"
 #include "UnrealGPTAgentClient.h"
+#include "UnrealGPTMarkdownParser.h"
+#include "UnrealGPTSyntaxHighlighter.h"
+#include "UnrealGPTAudioEncoder.h"
+#include "UnrealGPTVoiceActivityDetector.h"
+#include "UnrealGPTReplicateClient.h"
+#include "UnrealGPTGenerationCache.h"
+#include "UnrealGPTSceneTable.h"
+#include "UnrealGPTSceneClusters.h"
+#include "UnrealGPTSceneSnapshot.h"
+#include "UnrealGPTResultCompactor.h"
+#include "UnrealGPTToolResultProcessor.h"
+#include "UnrealGPTToolResultCache.h"
+#include "UnrealGPTToolCallProcessor.h"
+#include "UnrealGPTPlacementValidator.h"
+#include "UnrealAgentPlanner.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTSettingsTest, "UnrealGPT.Settings", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
@@ -43,6 +66,200 @@ bool FUnrealGPTSceneContextTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+namespace UnrealGPTSceneBenchmark
+{
+	/** Forwards to the real allocator and counts game-thread allocations while enabled */
+	class FCountingMalloc : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation(Count);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation(Count);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+		FMalloc* Inner;
+		std::atomic<int64> NumAllocations { 0 };
+		std::atomic<int64> NumBytes { 0 };
+		std::atomic<bool> bCounting { false };
+
+	private:
+		void CountAllocation(SIZE_T Count)
+		{
+			if (bCounting.load(std::memory_order_relaxed) && IsInGameThread())
+			{
+				NumAllocations.fetch_add(1, std::memory_order_relaxed);
+				NumBytes.fetch_add(static_cast<int64>(Count), std::memory_order_relaxed);
+			}
+		}
+	};
+
+	struct FMeasurement
+	{
+		FString Output;
+		double Milliseconds = 0.0;
+		int64 Allocations = 0;
+		int64 Bytes = 0;
+	};
+
+	/** Runs Body with GMalloc routed through a counting proxy. The proxy is never freed: other threads may still hold it. */
+	static FMeasurement Measure(TFunctionRef<FString()> Body)
+	{
+		static FCountingMalloc* Proxy = new FCountingMalloc(GMalloc);
+
+		FMalloc* Previous = GMalloc;
+		GMalloc = Proxy;
+		Proxy->NumAllocations = 0;
+		Proxy->NumBytes = 0;
+		Proxy->bCounting = true;
+
+		FMeasurement Result;
+		const double StartTime = FPlatformTime::Seconds();
+		Result.Output = Body();
+		Result.Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		Proxy->bCounting = false;
+		GMalloc = Previous;
+		Result.Allocations = Proxy->NumAllocations;
+		Result.Bytes = Proxy->NumBytes;
+		return Result;
+	}
+
+	/** The FJsonObject-tree GetSceneSummary this plugin used before streaming, kept as the reference */
+	static FString BuildSummaryAsJsonTree(UWorld* World, int32 PageSize, int32 PageIndex)
+	{
+		auto SerializeXYZ = [](const FVector& Value)
+		{
+			TSharedPtr<FJsonObject> Json = MakeShareable(new FJsonObject);
+			Json->SetNumberField(TEXT("x"), Value.X);
+			Json->SetNumberField(TEXT("y"), Value.Y);
+			Json->SetNumberField(TEXT("z"), Value.Z);
+			return Json;
+		};
+
+		TArray<TSharedPtr<FJsonValue>> ActorsArray;
+		int32 ActorCount = 0;
+		for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+		{
+			AActor* Actor = *ActorItr;
+			if (!Actor || Actor->IsPendingKillPending())
+			{
+				continue;
+			}
+
+			if (ActorCount >= PageIndex * PageSize && ActorCount < (PageIndex + 1) * PageSize)
+			{
+				TSharedPtr<FJsonObject> ActorJson = MakeShareable(new FJsonObject);
+				ActorJson->SetStringField(TEXT("name"), Actor->GetName());
+				ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
+				ActorJson->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+
+				const FTransform Transform = Actor->GetActorTransform();
+				ActorJson->SetObjectField(TEXT("location"), SerializeXYZ(Transform.GetLocation()));
+
+				const FRotator Rotation = Transform.GetRotation().Rotator();
+				TSharedPtr<FJsonObject> RotationJson = MakeShareable(new FJsonObject);
+				RotationJson->SetNumberField(TEXT("pitch"), Rotation.Pitch);
+				RotationJson->SetNumberField(TEXT("yaw"), Rotation.Yaw);
+				RotationJson->SetNumberField(TEXT("roll"), Rotation.Roll);
+				ActorJson->SetObjectField(TEXT("rotation"), RotationJson);
+
+				ActorJson->SetObjectField(TEXT("scale"), SerializeXYZ(Transform.GetScale3D()));
+
+				TArray<UActorComponent*> Components;
+				Actor->GetComponents(Components);
+				TArray<TSharedPtr<FJsonValue>> ComponentsArray;
+				for (UActorComponent* Component : Components)
+				{
+					if (Component)
+					{
+						TSharedPtr<FJsonObject> ComponentJson = MakeShareable(new FJsonObject);
+						ComponentJson->SetStringField(TEXT("name"), Component->GetName());
+						ComponentJson->SetStringField(TEXT("class"), Component->GetClass()->GetName());
+						ComponentJson->SetBoolField(TEXT("is_active"), Component->IsActive());
+						ComponentsArray.Add(MakeShareable(new FJsonValueObject(ComponentJson)));
+					}
+				}
+				ActorJson->SetArrayField(TEXT("components"), ComponentsArray);
+
+				ActorsArray.Add(MakeShareable(new FJsonValueObject(ActorJson)));
+			}
+
+			ActorCount++;
+		}
+
+		TSharedPtr<FJsonObject> SummaryJson = MakeShareable(new FJsonObject);
+		SummaryJson->SetNumberField(TEXT("total_actors"), ActorCount);
+		SummaryJson->SetNumberField(TEXT("page_size"), PageSize);
+		SummaryJson->SetNumberField(TEXT("page_index"), PageIndex);
+		SummaryJson->SetNumberField(TEXT("actors_on_page"), ActorsArray.Num());
+		SummaryJson->SetArrayField(TEXT("actors"), ActorsArray);
+
+		FString OutputString;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+		FJsonSerializer::Serialize(SummaryJson.ToSharedRef(), Writer);
+		return OutputString;
+	}
+}
+
+// Perf filter, so not part of the regular run: select "UnrealGPT.Benchmark" in the Session Frontend.
+// Reports time and game-thread allocations of the old FJsonObject tree against the streaming writer.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTSceneSummaryBenchmark, "UnrealGPT.Benchmark.SceneSummary", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FUnrealGPTSceneSummaryBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumActors = 5000;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("UnrealGPTSceneBenchmark"));
+	if (!TestNotNull(TEXT("Benchmark world"), World))
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		const FVector Location((Index % 100) * 250.0, (Index / 100) * 250.0, 0.0);
+		World->SpawnActor<AStaticMeshActor>(Location, FRotator(0.0, Index % 360, 0.0));
+	}
+
+	const UnrealGPTSceneBenchmark::FMeasurement Tree = UnrealGPTSceneBenchmark::Measure([World, NumActors]()
+	{
+		return UnrealGPTSceneBenchmark::BuildSummaryAsJsonTree(World, NumActors, 0);
+	});
+	const UnrealGPTSceneBenchmark::FMeasurement Stream = UnrealGPTSceneBenchmark::Measure([World, NumActors]()
+	{
+		return UUnrealGPTSceneContext::GetSceneSummaryForWorld(World, NumActors, 0);
+	});
+
+	TestEqual(TEXT("Streaming output matches the JSON tree output"), Stream.Output, Tree.Output);
+
+	AddInfo(FString::Printf(TEXT("Scene summary of %d actors (%d chars):"), NumActors, Stream.Output.Len()));
+	AddInfo(FString::Printf(TEXT("  FJsonObject tree: %.1f ms, %lld allocations, %.1f MB requested"),
+		Tree.Milliseconds, Tree.Allocations, Tree.Bytes / (1024.0 * 1024.0)));
+	AddInfo(FString::Printf(TEXT("  Streaming writer: %.1f ms, %lld allocations, %.1f MB requested"),
+		Stream.Milliseconds, Stream.Allocations, Stream.Bytes / (1024.0 * 1024.0)));
+
+	World->DestroyWorld(false);
+	World->MarkAsGarbage();
+
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTAgentClientTest, "UnrealGPT.AgentClient", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
 bool FUnrealGPTAgentClientTest::RunTest(const FString& Parameters)
@@ -60,5 +277,739 @@ bool FUnrealGPTAgentClientTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTMarkdownParserTest, "UnrealGPT.MarkdownParser", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTMarkdownParserTest::RunTest(const FString& Parameters)
+{
+	const FString Content = TEXT("# Title\n\nSome **bold** text\n- item\n```python\nimport unreal\nprint(1)\n```\nDone");
+
+	FUnrealGPTMarkdownDocument Full;
+	Full.SetText(Content);
+	TestEqual(TEXT("Block count"), Full.GetBlocks().Num(), 6);
+	TestTrue(TEXT("Code block parsed"), Full.GetBlocks()[4].Type == EUnrealGPTMarkdownBlockType::Code);
+	TestEqual(TEXT("Code block text"), Full.GetBlocks()[4].Text, FString(TEXT("import unreal\nprint(1)")));
+
+	// Streaming the same content in small chunks must produce identical blocks
+	FUnrealGPTMarkdownDocument Streamed;
+	for (int32 Pos = 0; Pos < Content.Len(); Pos += 3)
+	{
+		const int32 PreviousBlockCount = Streamed.GetBlocks().Num();
+		const int32 FirstChanged = Streamed.Append(Content.Mid(Pos, 3));
+		TestTrue(TEXT("Only the tail block is re-parsed"), FirstChanged >= PreviousBlockCount - 1);
+	}
+
+	TestEqual(TEXT("Streamed block count"), Streamed.GetBlocks().Num(), Full.GetBlocks().Num());
+	for (int32 Index = 0; Index < FMath::Min(Streamed.GetBlocks().Num(), Full.GetBlocks().Num()); ++Index)
+	{
+		TestEqual(TEXT("Streamed block hash"), Streamed.GetBlocks()[Index].Hash, Full.GetBlocks()[Index].Hash);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTSyntaxHighlighterTest, "UnrealGPT.SyntaxHighlighter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTSyntaxHighlighterTest::RunTest(const FString& Parameters)
+{
+	const FString Code = TEXT("def spawn(count=3):\n    # comment\n    return unreal.log(f\"n={count}\", None)\n");
+
+	TArray<FUnrealGPTSyntaxSpan> Spans;
+	UnrealGPTSyntaxHighlighter::Tokenize(Code, EUnrealGPTSyntaxLanguage::Python, Spans);
+
+	int32 TotalLength = 0;
+	TArray<EUnrealGPTSyntaxToken> Tokens;
+	for (const FUnrealGPTSyntaxSpan& Span : Spans)
+	{
+		TotalLength += Span.Length;
+		Tokens.Add(Span.Token);
+	}
+
+	TestEqual(TEXT("Spans cover the source"), TotalLength, Code.Len());
+	TestTrue(TEXT("First span is the def keyword"), Spans.Num() > 0 && Spans[0].Token == EUnrealGPTSyntaxToken::Keyword && Spans[0].Length == 3);
+	TestTrue(TEXT("Function name"), Tokens.Contains(EUnrealGPTSyntaxToken::Function));
+	TestTrue(TEXT("Comment"), Tokens.Contains(EUnrealGPTSyntaxToken::Comment));
+	TestTrue(TEXT("f-string"), Tokens.Contains(EUnrealGPTSyntaxToken::String));
+	TestTrue(TEXT("None literal"), Tokens.Contains(EUnrealGPTSyntaxToken::Literal));
+
+	UnrealGPTSyntaxHighlighter::Tokenize(TEXT("{\"status\": \"ok\", \"count\": -1.5e3, \"done\": true}"), EUnrealGPTSyntaxLanguage::Json, Spans);
+	TestTrue(TEXT("JSON key"), Spans.Num() > 1 && Spans[1].Token == EUnrealGPTSyntaxToken::Key && Spans[1].Length == 8);
+
+	// Repeated lookups of the same source share one tokenization
+	TestTrue(TEXT("Spans are cached"),
+		&UnrealGPTSyntaxHighlighter::GetSpans(Code, EUnrealGPTSyntaxLanguage::Python).Get()
+		== &UnrealGPTSyntaxHighlighter::GetSpans(Code, EUnrealGPTSyntaxLanguage::Python).Get());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTAudioEncoderTest, "UnrealGPT.AudioEncoder", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTAudioEncoderTest::RunTest(const FString& Parameters)
+{
+	// One second of a 440 Hz tone, 48 kHz stereo
+	TArray<float> Interleaved;
+	for (int32 Index = 0; Index < 48000; ++Index)
+	{
+		const float Sample = 0.5f * FMath::Sin(2.0f * PI * 440.0f * Index / 48000.0f);
+		Interleaved.Add(Sample);
+		Interleaved.Add(Sample);
+	}
+
+	TArray<float> Mono;
+	UnrealGPTAudioEncoder::DownmixToMono(Interleaved, 2, Mono);
+	TestEqual(TEXT("Downmix frame count"), Mono.Num(), 48000);
+
+	TArray<float> Speech;
+	UnrealGPTAudioEncoder::Resample(Mono, 48000, UnrealGPTAudioEncoder::SpeechSampleRate, Speech);
+	TestEqual(TEXT("Resampled length"), Speech.Num(), 16000);
+
+	float Peak = 0.0f;
+	for (int32 Index = 1000; Index < 15000; ++Index)
+	{
+		Peak = FMath::Max(Peak, FMath::Abs(Speech[Index]));
+	}
+	TestTrue(TEXT("Passband tone keeps its level"), FMath::IsNearlyEqual(Peak, 0.5f, 0.01f));
+
+	TArray<uint8> Flac;
+	UnrealGPTAudioEncoder::AppendFLAC(Speech, UnrealGPTAudioEncoder::SpeechSampleRate, Flac);
+	TestTrue(TEXT("FLAC stream marker"), Flac.Num() > 4 && FMemory::Memcmp(Flac.GetData(), "fLaC", 4) == 0);
+	TestTrue(TEXT("FLAC is smaller than PCM"), Flac.Num() < Speech.Num() * 2);
+	TestTrue(TEXT("Size bound holds"), Flac.Num() <= UnrealGPTAudioEncoder::GetMaxEncodedSize(Speech.Num()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTVoiceActivityTest, "UnrealGPT.VoiceActivity", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTVoiceActivityTest::RunTest(const FString& Parameters)
+{
+	const int32 SampleRate = 16000;
+	FRandomStream Random(7);
+
+	// Quiet noise, speech-like harmonics, a second of noise, more speech, trailing noise
+	TArray<float> Audio;
+	auto AddNoise = [&](float Seconds)
+	{
+		for (int32 Index = 0; Index < Seconds * SampleRate; ++Index)
+		{
+			Audio.Add(Random.FRandRange(-0.005f, 0.005f));
+		}
+	};
+	auto AddVoice = [&](float Seconds)
+	{
+		for (int32 Index = 0; Index < Seconds * SampleRate; ++Index)
+		{
+			const float Time = static_cast<float>(Index) / SampleRate;
+			float Sample = 0.0f;
+			for (int32 Harmonic = 1; Harmonic <= 5; ++Harmonic)
+			{
+				Sample += 0.1f / Harmonic * FMath::Sin(2.0f * PI * 150.0f * Harmonic * Time);
+			}
+			Audio.Add(Sample + Random.FRandRange(-0.005f, 0.005f));
+		}
+	};
+	AddNoise(1.0f);
+	AddVoice(1.5f);
+	AddNoise(1.0f);
+	AddVoice(1.0f);
+	AddNoise(2.0f);
+
+	FUnrealGPTVoiceActivityDetector Detector(SampleRate, 600);
+	TArray<TArray<float>> Segments;
+
+	// Feed in 100 ms chunks like the capture ticker
+	for (int32 Offset = 0; Offset < Audio.Num(); Offset += SampleRate / 10)
+	{
+		const int32 Count = FMath::Min(SampleRate / 10, Audio.Num() - Offset);
+		Detector.ProcessSamples(TConstArrayView<float>(Audio.GetData() + Offset, Count), Segments);
+	}
+	TestEqual(TEXT("Both utterances closed before the end of the stream"), Segments.Num(), 2);
+
+	Detector.Flush(Segments);
+	TestEqual(TEXT("Trailing noise yields no segment"), Segments.Num(), 2);
+	if (Segments.Num() == 2)
+	{
+		// Silence is trimmed to a short pre-roll and tail around each utterance
+		TestTrue(TEXT("First segment length"), Segments[0].Num() > 1.4f * SampleRate && Segments[0].Num() < 2.0f * SampleRate);
+		TestTrue(TEXT("Second segment length"), Segments[1].Num() > 0.9f * SampleRate && Segments[1].Num() < 1.5f * SampleRate);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTReplicatePollTest, "UnrealGPT.ReplicatePoll", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTReplicatePollTest::RunTest(const FString& Parameters)
+{
+	// Cold boots back off from 1 s towards the 5 s cap
+	const float FirstStarting = FUnrealGPTReplicateGeneration::ComputePollDelay(TEXT("starting"), FString(), 0.0, 0.0f);
+	TestEqual(TEXT("First poll while starting"), FirstStarting, 1.0f);
+	TestEqual(TEXT("Starting backs off"), FUnrealGPTReplicateGeneration::ComputePollDelay(TEXT("starting"), FString(), 3.0, FirstStarting), 1.5f);
+	TestEqual(TEXT("Starting is capped"), FUnrealGPTReplicateGeneration::ComputePollDelay(TEXT("starting"), FString(), 60.0, 4.0f), 5.0f);
+
+	// Progress in the logs predicts the remaining time: 80% after 8 s leaves ~2 s, so poll after ~1 s
+	const FString Logs = TEXT("Loading weights\n 40%|####      | 20/50\n 80%|########  | 40/50");
+	TestEqual(TEXT("Poll halfway through the remaining time"), FUnrealGPTReplicateGeneration::ComputePollDelay(TEXT("processing"), Logs, 8.0, 0.0f), 1.0f);
+	TestEqual(TEXT("Completed progress polls right away"), FUnrealGPTReplicateGeneration::ComputePollDelay(TEXT("processing"), TEXT("100%"), 8.0, 0.0f), 0.25f);
+
+	// Without progress, poll less often the longer the job runs
+	const float Early = FUnrealGPTReplicateGeneration::ComputePollDelay(TEXT("processing"), FString(), 1.0, 0.0f);
+	const float Late = FUnrealGPTReplicateGeneration::ComputePollDelay(TEXT("processing"), FString(), 12.0, 0.0f);
+	TestTrue(TEXT("Long jobs are polled less often"), Late > Early);
+	TestTrue(TEXT("Delay stays within bounds"), Early >= 0.25f && Late <= 5.0f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTReplicateBatchResultTest, "UnrealGPT.ReplicateBatchResult", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTReplicateBatchResultTest::RunTest(const FString& Parameters)
+{
+	const FString Success = TEXT("{\"status\":\"success\",\"message\":\"ok\",\"details\":{\"files\":[{\"local_path\":\"C:/a.png\"}]}}");
+	const FString Failure = TEXT("{\"status\":\"error\",\"message\":\"NSFW content detected\"}");
+
+	TArray<FUnrealGPTReplicateRequest> Requests;
+	Requests.AddDefaulted(2);
+	Requests[0].Prompt = TEXT("mossy rock");
+	Requests[0].Seed = 7;
+	Requests[1].Prompt = TEXT("mossy rock");
+	Requests[1].Seed = 8;
+
+	// A single prediction passes through untouched
+	TestEqual(TEXT("Single result is unchanged"), FUnrealGPTReplicateBatch::BuildBatchResult({ Requests[0] }, { Success }, TEXT("image")), Success);
+
+	TSharedPtr<FJsonObject> Batch;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(
+		FUnrealGPTReplicateBatch::BuildBatchResult(Requests, { Success, Failure }, TEXT("image")));
+	if (!TestTrue(TEXT("Batch result parses"), FJsonSerializer::Deserialize(Reader, Batch) && Batch.IsValid()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Partial batch still succeeds"), Batch->GetStringField(TEXT("status")), FString(TEXT("success")));
+
+	const TSharedPtr<FJsonObject> Details = Batch->GetObjectField(TEXT("details"));
+	const TArray<TSharedPtr<FJsonValue>>& Files = Details->GetArrayField(TEXT("files"));
+	TestEqual(TEXT("Only the successful prediction contributes files"), Files.Num(), 1);
+	if (Files.Num() == 1)
+	{
+		TestEqual(TEXT("Files carry their seed"), static_cast<int32>(Files[0]->AsObject()->GetNumberField(TEXT("seed"))), 7);
+	}
+	TestEqual(TEXT("Every prediction is reported"), Details->GetArrayField(TEXT("predictions")).Num(), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTGenerationCacheKeyTest, "UnrealGPT.GenerationCacheKey", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTGenerationCacheKeyTest::RunTest(const FString& Parameters)
+{
+	const FString Url = TEXT("https://api.replicate.com/v1/predictions");
+	const FString Body = TEXT("{\"version\":\"abc\",\"input\":{\"prompt\":\"mossy rock\",\"seed\":7}}");
+	const FString Reordered = TEXT("{ \"input\": { \"seed\": 7, \"prompt\": \"mossy rock\" }, \"version\": \"abc\" }");
+
+	const FString Key = FUnrealGPTGenerationCache::MakeKey(Url, Body);
+	TestEqual(TEXT("Key ignores key order and whitespace"), FUnrealGPTGenerationCache::MakeKey(Url, Reordered), Key);
+	TestNotEqual(TEXT("Seed is part of the key"), FUnrealGPTGenerationCache::MakeKey(Url, Body.Replace(TEXT("7"), TEXT("8"))), Key);
+	TestNotEqual(TEXT("Endpoint is part of the key"), FUnrealGPTGenerationCache::MakeKey(Url + TEXT("/other"), Body), Key);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTSceneTableTest, "UnrealGPT.SceneTable", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTSceneTableTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Trailing zeros are dropped"), FUnrealGPTSceneTable::FormatNumber(120.0, 2), FString(TEXT("120")));
+	TestEqual(TEXT("Rounded to precision"), FUnrealGPTSceneTable::FormatNumber(-40.46, 1), FString(TEXT("-40.5")));
+	TestEqual(TEXT("No negative zero"), FUnrealGPTSceneTable::FormatNumber(-0.04, 1), FString(TEXT("0")));
+
+	FUnrealGPTSceneTable Table({ TEXT("id"), TEXT("label"), TEXT("x"), TEXT("mesh@") }, 1);
+	Table.BeginRow(TEXT("StaticMeshActor"));
+	Table.AddCell(TEXT("StaticMeshActor_1"));
+	Table.AddCell(TEXT("Rock|Large"));
+	Table.AddNumber(10.0);
+	Table.AddInterned(TEXT("/Game/Rock.Rock"));
+	Table.BeginRow(TEXT("StaticMeshActor"));
+	Table.AddCell(TEXT("StaticMeshActor_2"));
+	Table.AddCell(TEXT("Rock"));
+	Table.AddNumber(20.26);
+	Table.AddInterned(TEXT("/Game/Rock.Rock"));
+	Table.BeginRow(TEXT("PointLight"));
+	Table.AddCell(TEXT("PointLight_1"));
+	Table.AddCell(TEXT("Lamp"));
+	Table.AddNumber(0.0);
+	Table.AddInterned(FString());
+	Table.BeginRow(TEXT("PointLight"));
+	Table.AddCell(TEXT("PointLight_2"));
+	Table.AddCell(TEXT("Lamp\\"));
+	Table.AddNumber(0.0);
+	Table.AddInterned(FString());
+
+	FString Output;
+	TSharedRef<FUnrealGPTSceneTable::FWriter> Writer = FUnrealGPTSceneTable::FWriterFactory::Create(&Output);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("included_actors"), 4);
+	Table.Write(*Writer);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	TSharedPtr<FJsonObject> TableJson;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Output);
+	if (!TestTrue(TEXT("Table parses as JSON"), FJsonSerializer::Deserialize(Reader, TableJson) && TableJson.IsValid()))
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>> Legend = TableJson->GetArrayField(TEXT("legend"));
+	TestEqual(TEXT("Classes and meshes are interned once"), Legend.Num(), 3);
+
+	const TArray<TSharedPtr<FJsonValue>> Groups = TableJson->GetArrayField(TEXT("groups"));
+	if (!TestEqual(TEXT("Consecutive actors of a class share a group"), Groups.Num(), 2))
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>> Rows = Groups[0]->AsObject()->GetArrayField(TEXT("rows"));
+	TestEqual(TEXT("First row"), Rows[0]->AsString(), FString(TEXT("StaticMeshActor_1|Rock\\|Large|10|1")));
+	TestEqual(TEXT("Second row"), Rows[1]->AsString(), FString(TEXT("StaticMeshActor_2|Rock|20.3|1")));
+	TestEqual(TEXT("Empty interned cell"), Groups[1]->AsObject()->GetArrayField(TEXT("rows"))[0]->AsString(), FString(TEXT("PointLight_1|Lamp|0|")));
+	TestEqual(TEXT("Backslashes are escaped"), Groups[1]->AsObject()->GetArrayField(TEXT("rows"))[1]->AsString(), FString(TEXT("PointLight_2|Lamp\\\\|0|")));
+
+	// A compact summary has no summary object, so included_actors must follow the dropped rows
+	FString Fitted = Output;
+	if (!TestTrue(TEXT("Table fits a smaller budget"), UnrealGPTToolResultProcessor::FitTableToBudget(Fitted, Output.Len() - 10)))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> FittedJson;
+	TSharedRef<TJsonReader<>> FittedReader = TJsonReaderFactory<>::Create(Fitted);
+	if (!TestTrue(TEXT("Fitted table parses as JSON"), FJsonSerializer::Deserialize(FittedReader, FittedJson) && FittedJson.IsValid()))
+	{
+		return false;
+	}
+
+	const int32 NumTruncated = static_cast<int32>(FittedJson->GetNumberField(TEXT("truncated_rows")));
+	TestTrue(TEXT("Rows were dropped"), NumTruncated > 0);
+	TestEqual(TEXT("included_actors counts the rows left"), static_cast<int32>(FittedJson->GetNumberField(TEXT("included_actors"))), 4 - NumTruncated);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTSceneClustersTest, "UnrealGPT.SceneClusters", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTSceneClustersTest::RunTest(const FString& Parameters)
+{
+	// 100 x 100 grid of actors 100 units apart, spread over enough ParallelFor tasks to exercise the merge
+	FUnrealGPTSceneSnapshot Snapshot;
+	for (int32 Index = 0; Index < 10000; ++Index)
+	{
+		FUnrealGPTActorRecord& Record = Snapshot.Actors.AddDefaulted_GetRef();
+		Record.Name = FName(TEXT("Actor"), Index + 1);
+		Record.ClassName = Index % 10 == 0 ? FName(TEXT("PointLight")) : FName(TEXT("StaticMeshActor"));
+		Record.Location = FVector((Index % 100) * 100.0, (Index / 100) * 100.0, 0.0);
+		Record.Bounds = FBox::BuildAABB(Record.Location, FVector(Index == 4242 ? 5000.0 : 50.0));
+		Snapshot.Labels.Add(FString::Printf(TEXT("Label%d"), Index));
+	}
+
+	auto Summarize = [&Snapshot](const FString& Cell, const FString& ClassContains = FString())
+	{
+		FUnrealGPTSceneClusters::FOptions Options;
+		Options.CellId = Cell;
+		Options.ClassContains = ClassContains;
+
+		TSharedPtr<FJsonObject> Json;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FUnrealGPTSceneClusters::Summarize(Snapshot, Options));
+		FJsonSerializer::Deserialize(Reader, Json);
+		return Json;
+	};
+
+	auto SumCounts = [](const TSharedPtr<FJsonObject>& Json, int32& OutCellCount)
+	{
+		int32 Total = 0;
+		const TArray<TSharedPtr<FJsonValue>> Cells = Json->GetArrayField(TEXT("cells"));
+		for (const TSharedPtr<FJsonValue>& Cell : Cells)
+		{
+			Total += static_cast<int32>(Cell->AsObject()->GetNumberField(TEXT("count")));
+		}
+		OutCellCount = Cells.Num();
+		return Total;
+	};
+
+	const TSharedPtr<FJsonObject> Level = Summarize(FString());
+	if (!TestTrue(TEXT("Level summary parses"), Level.IsValid()))
+	{
+		return false;
+	}
+
+	int32 NumCells = 0;
+	TestEqual(TEXT("Cells account for every actor"), SumCounts(Level, NumCells), 10000);
+	TestEqual(TEXT("Default grid is 4x4"), NumCells, 16);
+	TestFalse(TEXT("Too many actors to list"), Level->HasField(TEXT("actors")));
+
+	// Cell 1_1 spans x and y 2475..4950, so it holds the actor with the large bounds
+	const TArray<TSharedPtr<FJsonValue>> LevelCells = Level->GetArrayField(TEXT("cells"));
+	TSharedPtr<FJsonObject> Cell11;
+	for (const TSharedPtr<FJsonValue>& Cell : LevelCells)
+	{
+		if (Cell->AsObject()->GetStringField(TEXT("id")) == TEXT("1_1"))
+		{
+			Cell11 = Cell->AsObject();
+		}
+	}
+	if (!TestTrue(TEXT("Cell 1_1 exists"), Cell11.IsValid()))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Largest actor is reported first"), Cell11->GetArrayField(TEXT("largest"))[0]->AsString(), FString(TEXT("Label4242")));
+
+	const TSharedPtr<FJsonObject> Drill = Summarize(TEXT("1_1"));
+	TestEqual(TEXT("Drill-down keeps the parent's actors"), SumCounts(Drill, NumCells), static_cast<int32>(Cell11->GetNumberField(TEXT("count"))));
+	TestEqual(TEXT("Child ids extend the parent id"), Drill->GetArrayField(TEXT("cells"))[0]->AsObject()->GetStringField(TEXT("id")).Left(4), FString(TEXT("1_1/")));
+
+	const TSharedPtr<FJsonObject> Leaf = Summarize(TEXT("1_1/0_0/0_0"));
+	TestTrue(TEXT("Small cells list their actors"), Leaf->HasField(TEXT("actors")));
+
+	const TSharedPtr<FJsonObject> Lights = Summarize(FString(), TEXT("light"));
+	TestEqual(TEXT("Class filter"), SumCounts(Lights, NumCells), 1000);
+
+	TestEqual(TEXT("Malformed cell id is an error"), Summarize(TEXT("9_9"))->GetStringField(TEXT("status")), FString(TEXT("error")));
+
+	TArray<FIntPoint> Path;
+	TestTrue(TEXT("Nested cell id parses"), FUnrealGPTSceneClusters::ParseCellId(TEXT("1_2/3_0"), 4, Path) && Path.Num() == 2 && Path[1] == FIntPoint(3, 0));
+	TestFalse(TEXT("Fractional cell index is rejected"), FUnrealGPTSceneClusters::ParseCellId(TEXT("1.5_1"), 4, Path));
+	TestFalse(TEXT("Negative cell index is rejected"), FUnrealGPTSceneClusters::ParseCellId(TEXT("-1_1"), 4, Path));
+	TestFalse(TEXT("Signed cell index is rejected"), FUnrealGPTSceneClusters::ParseCellId(TEXT("+1_1"), 4, Path));
+	TestFalse(TEXT("Empty cell index is rejected"), FUnrealGPTSceneClusters::ParseCellId(TEXT("1_"), 4, Path));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTResultCompactorTest, "UnrealGPT.ResultCompactor", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTResultCompactorTest::RunTest(const FString& Parameters)
+{
+	// A scene_query-like result with 500 actors and a long Python-style log
+	FString Result = TEXT("{\"status\":\"ok\",\"summary\":{\"total_matched\":500},\"logs\":{\"stdout\":\"START");
+	Result += FString::ChrN(20000, TEXT('x'));
+	Result += TEXT("END\"},\"actors\":[");
+	for (int32 Index = 0; Index < 500; ++Index)
+	{
+		Result += FString::Printf(TEXT("%s{\"id\":\"Actor_%d\",\"class\":\"%s\",\"location\":{\"x\":%d,\"y\":0,\"z\":0}}"),
+			Index > 0 ? TEXT(",") : TEXT(""), Index, Index % 5 == 0 ? TEXT("PointLight") : TEXT("StaticMeshActor"), Index);
+	}
+	Result += TEXT("]}");
+
+	const FString Compacted = UnrealGPTResultCompactor::Compact(TEXT("scene_query"), Result, 4000);
+	TestTrue(TEXT("Fits the budget"), Compacted.Len() <= 4000);
+
+	TSharedPtr<FJsonObject> Json;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Compacted);
+	if (!TestTrue(TEXT("Compacted result is valid JSON"), FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Scalars survive"), Json->GetStringField(TEXT("status")), FString(TEXT("ok")));
+	TestTrue(TEXT("Marked as compacted"), Json->HasField(TEXT("compacted")));
+
+	const FString Stdout = Json->GetObjectField(TEXT("logs"))->GetStringField(TEXT("stdout"));
+	TestTrue(TEXT("Log keeps its head and tail"), Stdout.StartsWith(TEXT("START")) && Stdout.EndsWith(TEXT("END")));
+
+	// The first items are kept, and the rest are counted by class in a trailing entry
+	const TArray<TSharedPtr<FJsonValue>> Actors = Json->GetArrayField(TEXT("actors"));
+	if (!TestTrue(TEXT("Some actors kept"), Actors.Num() > 1))
+	{
+		return false;
+	}
+	TestEqual(TEXT("First actor kept"), Actors[0]->AsObject()->GetStringField(TEXT("id")), FString(TEXT("Actor_0")));
+
+	const TSharedPtr<FJsonObject> Omitted = Actors.Last()->AsObject();
+	const int32 NumOmitted = static_cast<int32>(Omitted->GetNumberField(TEXT("omitted")));
+	TestEqual(TEXT("Kept and omitted add up"), Actors.Num() - 1 + NumOmitted, 500);
+
+	const TSharedPtr<FJsonObject> Classes = Omitted->GetObjectField(TEXT("omitted_classes"));
+	TestEqual(TEXT("Omitted actors are counted by class"),
+		static_cast<int32>(Classes->GetNumberField(TEXT("StaticMeshActor")) + Classes->GetNumberField(TEXT("PointLight"))), NumOmitted);
+
+	// Plain text keeps both ends
+	const FString Text = UnrealGPTResultCompactor::Compact(TEXT("python_execute"), TEXT("Traceback") + FString::ChrN(5000, TEXT('.')) + TEXT("ValueError"), 600);
+	TestTrue(TEXT("Text fits the budget"), Text.Len() <= 600);
+	TestTrue(TEXT("Text keeps head and tail"), Text.StartsWith(TEXT("Traceback")) && Text.EndsWith(TEXT("ValueError")));
+
+	TestEqual(TEXT("Results within budget are unchanged"), UnrealGPTResultCompactor::Compact(TEXT("scene_query"), TEXT("{\"status\":\"ok\"}"), 600), FString(TEXT("{\"status\":\"ok\"}")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTToolResultCacheTest, "UnrealGPT.ToolResultCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTToolResultCacheTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("scene_query is cacheable"), FUnrealGPTToolResultCache::IsCacheable(TEXT("scene_query")));
+	TestFalse(TEXT("python_execute is not cacheable"), FUnrealGPTToolResultCache::IsCacheable(TEXT("python_execute")));
+	TestTrue(TEXT("viewport_screenshot keeps the cache"), FUnrealGPTToolResultCache::IsNeutral(TEXT("viewport_screenshot")));
+	TestFalse(TEXT("python_execute invalidates the cache"), FUnrealGPTToolResultCache::IsNeutral(TEXT("python_execute")));
+	TestEqual(TEXT("Argument order does not change the key"),
+		FUnrealGPTToolResultCache::MakeKey(TEXT("get_actor"), TEXT("{\"id\":\"A\",\"fields\":{\"y\":1,\"x\":2}}")),
+		FUnrealGPTToolResultCache::MakeKey(TEXT("get_actor"), TEXT("{ \"fields\": {\"x\":2,\"y\":1}, \"id\": \"A\" }")));
+
+	FUnrealGPTToolResultCache& Cache = FUnrealGPTToolResultCache::Get();
+	Cache.Invalidate();
+
+	FString Cached;
+	Cache.Store(TEXT("get_actor"), TEXT("{\"id\":\"A\",\"detail\":true}"), TEXT("actor A"), Cache.GetGeneration());
+	TestTrue(TEXT("Repeated call hits"), Cache.Lookup(TEXT("get_actor"), TEXT("{\"detail\":true,\"id\":\"A\"}"), Cached));
+	TestEqual(TEXT("Hit returns the stored result"), Cached, FString(TEXT("actor A")));
+	TestFalse(TEXT("Other arguments miss"), Cache.Lookup(TEXT("get_actor"), TEXT("{\"id\":\"B\"}"), Cached));
+	TestFalse(TEXT("Other tools miss"), Cache.Lookup(TEXT("scene_query"), TEXT("{\"id\":\"A\",\"detail\":true}"), Cached));
+
+	// An editor edit while a call runs keeps its result out of the cache
+	const uint64 StartGeneration = Cache.GetGeneration();
+	FCoreUObjectDelegates::OnObjectModified.Broadcast(GetMutableDefault<UUnrealGPTSettings>());
+	TestFalse(TEXT("Editor edits invalidate"), Cache.Lookup(TEXT("get_actor"), TEXT("{\"id\":\"A\",\"detail\":true}"), Cached));
+
+	Cache.Store(TEXT("scene_query"), TEXT("{}"), TEXT("[]"), StartGeneration);
+	TestEqual(TEXT("Results computed across an edit are not stored"), Cache.Num(), 0);
+
+	Cache.Invalidate();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTAsyncToolBatchTest, "UnrealGPT.AsyncToolBatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTAsyncToolBatchTest::RunTest(const FString& Parameters)
+{
+	// First tool completes while the turn is still starting tools (error or cache hit), the second later
+	{
+		FUnrealGPTAsyncToolBatch Batch;
+		Batch.AddTool();
+		TestFalse(TEXT("Synchronous completion does not send while the turn holds its count"), Batch.CompleteTool({ TEXT("a") }));
+		Batch.AddTool();
+		TestFalse(TEXT("Release waits for the running tool"), Batch.Release({ TEXT("turn") }));
+		TestEqual(TEXT("One tool still pending"), Batch.GetNumPending(), 1);
+		TestTrue(TEXT("Deferred completion sends"), Batch.CompleteTool({ TEXT("b") }));
+		TestTrue(TEXT("Continuation carries every image, turn images first"), Batch.GetImages() == TArray<FString>({ TEXT("turn"), TEXT("a"), TEXT("b") }));
+	}
+
+	// Both tools complete synchronously: only the release sends
+	{
+		FUnrealGPTAsyncToolBatch Batch;
+		Batch.AddTool();
+		TestFalse(TEXT("First synchronous completion does not send"), Batch.CompleteTool({}));
+		Batch.AddTool();
+		TestFalse(TEXT("Second synchronous completion does not send"), Batch.CompleteTool({}));
+		TestTrue(TEXT("Release sends once"), Batch.Release({}));
+		TestEqual(TEXT("Nothing pending"), Batch.GetNumPending(), 0);
+	}
+
+	// Both tools deferred: only the last completion sends
+	{
+		FUnrealGPTAsyncToolBatch Batch;
+		Batch.AddTool();
+		Batch.AddTool();
+		TestFalse(TEXT("Release waits for both tools"), Batch.Release({}));
+		TestFalse(TEXT("First deferred completion does not send"), Batch.CompleteTool({}));
+		TestTrue(TEXT("Last deferred completion sends"), Batch.CompleteTool({}));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTPlacementValidatorTest, "UnrealGPT.PlacementValidator", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTPlacementValidatorTest::RunTest(const FString& Parameters)
+{
+	FUnrealGPTClearanceQuery Query;
+	TestTrue(TEXT("Box volume parses"), FUnrealGPTPlacementValidator::ParseExpression(TEXT("WorldModel.IsAreaClear(Box(100, -200.5, 50, 10, 20, 30))"), Query));
+	TestFalse(TEXT("Box is not a sphere"), Query.bSphere);
+	TestEqual(TEXT("Box center"), Query.Center, FVector(100.0, -200.5, 50.0));
+	TestEqual(TEXT("Box extent"), Query.Extent, FVector(10.0, 20.0, 30.0));
+
+	TestTrue(TEXT("Sphere volume parses"), FUnrealGPTPlacementValidator::ParseExpression(TEXT("WorldModel.IsAreaClear( Sphere(0,0,0,75) )"), Query));
+	TestTrue(TEXT("Sphere is a sphere"), Query.bSphere);
+	TestEqual(TEXT("Sphere radius"), Query.Extent.X, 75.0);
+
+	TestFalse(TEXT("Symbolic bounds are not parsed"), FUnrealGPTPlacementValidator::ParseExpression(TEXT("WorldModel.IsAreaClear(TargetBounds)"), Query));
+	TestFalse(TEXT("Wrong argument count is rejected"), FUnrealGPTPlacementValidator::ParseExpression(TEXT("WorldModel.IsAreaClear(Box(1, 2, 3))"), Query));
+	TestFalse(TEXT("Non-numeric arguments are rejected"), FUnrealGPTPlacementValidator::ParseExpression(TEXT("WorldModel.IsAreaClear(Sphere(x, 0, 0, 10))"), Query));
+
+	TestEqual(TEXT("Equal queries hash alike"), GetTypeHash(FUnrealGPTClearanceQuery::Sphere(FVector(1.0), 5.0)), GetTypeHash(FUnrealGPTClearanceQuery::Sphere(FVector(1.0), 5.0)));
+
+	TArray<FUnrealGPTClearanceResult> Results;
+	const FUnrealGPTClearanceQuery Queries[] = { Query };
+	TestFalse(TEXT("Nothing is validated without a world"), FUnrealGPTPlacementValidator::Get().Validate(nullptr, Queries, Results));
+	TestEqual(TEXT("No results without a world"), Results.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTPlacementOverlapTest, "UnrealGPT.PlacementValidator.Overlap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTPlacementOverlapTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("UnrealGPTPlacementTest"));
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Placement world"), World) || !TestNotNull(TEXT("Cube mesh"), Cube))
+	{
+		return false;
+	}
+
+	// A 100 cm cube at the origin; the scene query structure only sees it once the physics scene is flushed
+	AStaticMeshActor* Blocker = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+	Blocker->GetStaticMeshComponent()->SetStaticMesh(Cube);
+	Blocker->SetActorLabel(TEXT("PlacementBlocker"));
+	World->GetPhysicsScene()->Flush();
+
+	FUnrealGPTPlacementValidator& Validator = FUnrealGPTPlacementValidator::Get();
+	FUnrealGPTClearanceQuery Ignoring = FUnrealGPTClearanceQuery::Sphere(FVector::ZeroVector, 25.0);
+	Ignoring.IgnoreActor = TEXT("PlacementBlocker");
+	FUnrealGPTClearanceQuery CountingLandscapes = FUnrealGPTClearanceQuery::Box(FBox(FVector(-20.0), FVector(20.0)));
+	CountingLandscapes.bIgnoreLandscape = false;
+	const FUnrealGPTClearanceQuery Queries[] =
+	{
+		FUnrealGPTClearanceQuery::Box(FBox(FVector(-20.0), FVector(20.0))),
+		FUnrealGPTClearanceQuery::Box(FBox(FVector(1000.0), FVector(1040.0))),
+		FUnrealGPTClearanceQuery::Sphere(FVector(0.0, 0.0, 60.0), 25.0),
+		Ignoring,
+		CountingLandscapes
+	};
+
+	TArray<FUnrealGPTClearanceResult> Results;
+	TestTrue(TEXT("Validated against the test world"), Validator.Validate(World, Queries, Results));
+	if (!TestEqual(TEXT("One result per query"), Results.Num(), static_cast<int32>(UE_ARRAY_COUNT(Queries))))
+	{
+		World->DestroyWorld(false);
+		World->MarkAsGarbage();
+		return false;
+	}
+	TestFalse(TEXT("Box inside the cube is blocked"), Results[0].bClear);
+	TestTrue(TEXT("Blocker is reported by label"), Results[0].Blockers == TArray<FString>{ TEXT("PlacementBlocker") });
+	TestTrue(TEXT("Box away from the cube is clear"), Results[1].bClear);
+	TestFalse(TEXT("Sphere touching the top of the cube is blocked"), Results[2].bClear);
+	TestTrue(TEXT("Ignored actor does not block"), Results[3].bClear);
+	TestFalse(TEXT("A mesh blocks whether or not landscapes are ignored"), Results[4].bClear);
+
+	// The cube moves away; once the editor generation advances the cached results must not be reused
+	Blocker->SetActorLocation(FVector(0.0, 0.0, 5000.0));
+	World->GetPhysicsScene()->Flush();
+	FUnrealGPTToolResultCache::Get().Invalidate();
+
+	TestTrue(TEXT("Validated after the change"), Validator.Validate(World, Queries, Results));
+	TestTrue(TEXT("Box where the cube was is clear"), Results.Num() > 0 && Results[0].bClear);
+	const FUnrealGPTClearanceQuery Moved[] = { FUnrealGPTClearanceQuery::Box(FBox(FVector(-20.0, -20.0, 4980.0), FVector(20.0, 20.0, 5020.0))) };
+	TestTrue(TEXT("Box at the new location is blocked"), Validator.Validate(World, Moved, Results) && Results.Num() == 1 && !Results[0].bClear);
+
+	World->DestroyWorld(false);
+	World->MarkAsGarbage();
+
+	// Invalid sizes are errors rather than tiny volumes that pass
+	const FString ZeroRadius = FUnrealGPTPlacementValidator::CheckPlacements(TEXT("{\"placements\":[{\"location\":{\"x\":0,\"y\":0,\"z\":0},\"radius\":0}]}"));
+	TestTrue(TEXT("Zero radius is rejected"), ZeroRadius.Contains(TEXT("\"status\":\"error\"")) && ZeroRadius.Contains(TEXT("radius")));
+	const FString NegativeExtent = FUnrealGPTPlacementValidator::CheckPlacements(TEXT("{\"placements\":[{\"location\":{\"x\":0,\"y\":0,\"z\":0},\"extent\":{\"x\":10,\"y\":-5,\"z\":10}}]}"));
+	TestTrue(TEXT("Negative extent is rejected"), NegativeExtent.Contains(TEXT("\"status\":\"error\"")) && NegativeExtent.Contains(TEXT("extent")));
+
+	// A plan whose IsAreaClear volume has no size fails validation instead of passing unchecked
+	FAgentPlan Plan;
+	Plan.GoalId = TEXT("PlacementGoal");
+	FPlanStep& Step = Plan.Steps.AddDefaulted_GetRef();
+	Step.Description = TEXT("Inspect the spawn point");
+	Step.ToolName = TEXT("get_actor");
+	Step.ToolArguments.Add(TEXT("actor_id"), TEXT("PlacementBlocker"));
+	FStepPrecondition& Precondition = Step.Preconditions.AddDefaulted_GetRef();
+	Precondition.Description = TEXT("Spawn area is clear");
+	Precondition.CheckExpression = TEXT("WorldModel.IsAreaClear(Box(0, 0, 0, 50, 0, 50))");
+
+	FAgentPlanner Planner;
+	const FPlanValidation Validation = Planner.ValidatePlan(Plan);
+	TestFalse(TEXT("Plan with an empty volume is invalid"), Validation.IsValid());
+	TestTrue(TEXT("Error names the precondition"), Validation.Errors.ContainsByPredicate([](const FString& Error) { return Error.Contains(TEXT("Spawn area is clear")); }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTReplicateBatchArgumentsTest, "UnrealGPT.ReplicateBatchArguments", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTReplicateBatchArgumentsTest::RunTest(const FString& Parameters)
+{
+	UUnrealGPTSettings* Settings = GetMutableDefault<UUnrealGPTSettings>();
+	const bool bWasEnabled = Settings->bEnableReplicateTool;
+	const FString OldToken = Settings->ReplicateApiToken;
+	Settings->bEnableReplicateTool = true;
+	Settings->ReplicateApiToken = TEXT("test-token");
+
+	auto Build = [](const FString& Arguments, TArray<FUnrealGPTReplicateRequest>& OutRequests)
+	{
+		FString Url, OutputKind, ErrorJson;
+		OutRequests.Reset();
+		return UUnrealGPTReplicateClient::BuildCreateRequests(
+			TEXT("{\"version\":\"owner/model\",") + Arguments + TEXT("}"), Url, OutRequests, OutputKind, ErrorJson);
+	};
+
+	TArray<FUnrealGPTReplicateRequest> Requests;
+	TestTrue(TEXT("Count repeats each prompt"), Build(TEXT("\"prompts\":[\"a\",\"b\"],\"count\":3"), Requests) && Requests.Num() == 6);
+	TestTrue(TEXT("Count repeats a single prompt"), Build(TEXT("\"prompt\":\"a\",\"count\":2"), Requests) && Requests.Num() == 2);
+
+	if (TestTrue(TEXT("Seeds pair with prompts"), Build(TEXT("\"prompts\":[\"a\",\"b\"],\"seeds\":[1,2]"), Requests) && Requests.Num() == 2))
+	{
+		TestEqual(TEXT("Second prompt"), Requests[1].Prompt, FString(TEXT("b")));
+		TestEqual(TEXT("Second seed"), Requests[1].Seed.Get(0), static_cast<int64>(2));
+	}
+
+	TestFalse(TEXT("Extra seeds are an error"), Build(TEXT("\"prompts\":[\"a\"],\"seeds\":[1,2]"), Requests));
+	TestFalse(TEXT("Missing seeds are an error"), Build(TEXT("\"prompts\":[\"a\",\"b\"],\"seeds\":[1]"), Requests));
+	TestFalse(TEXT("Count with seeds is an error"), Build(TEXT("\"prompt\":\"a\",\"seeds\":[1,2],\"count\":2"), Requests));
+	TestFalse(TEXT("Zero count is an error"), Build(TEXT("\"prompt\":\"a\",\"count\":0"), Requests));
+	TestFalse(TEXT("Batch over the limit is an error"), Build(TEXT("\"prompts\":[\"a\",\"b\"],\"count\":9"), Requests));
+
+	Settings->bEnableReplicateTool = bWasEnabled;
+	Settings->ReplicateApiToken = OldToken;
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealGPTReplicateBatchLifetimeTest, "UnrealGPT.ReplicateBatchLifetime", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealGPTReplicateBatchLifetimeTest::RunTest(const FString& Parameters)
+{
+	// Point the create call at a closed local port, so the prediction fails without leaving the machine
+	UUnrealGPTSettings* Settings = GetMutableDefault<UUnrealGPTSettings>();
+	const bool bWasEnabled = Settings->bEnableReplicateTool;
+	const FString OldToken = Settings->ReplicateApiToken;
+	const FString OldUrl = Settings->ReplicateApiUrl;
+	Settings->bEnableReplicateTool = true;
+	Settings->ReplicateApiToken = TEXT("test-token");
+	Settings->ReplicateApiUrl = TEXT("http://127.0.0.1:9/v1/predictions");
+
+	TSharedRef<FString> Result = MakeShared<FString>();
+	{
+		// The returned pointer is dropped at once, as the tool dispatcher does
+		UUnrealGPTReplicateClient::GenerateAsync(TEXT("{\"prompt\":\"a\",\"version\":\"owner/model\"}"),
+			FOnUnrealGPTReplicateComplete::CreateLambda([Result](const FString& ResultJson)
+			{
+				*Result = ResultJson;
+			}));
+	}
+
+	const double Deadline = FPlatformTime::Seconds() + 30.0;
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Result, Deadline, Settings, bWasEnabled, OldToken, OldUrl]()
+	{
+		if (Result->IsEmpty() && FPlatformTime::Seconds() < Deadline)
+		{
+			return false;
+		}
+
+		TestTrue(TEXT("A dropped batch still reports its result"), Result->Contains(TEXT("\"error\"")));
+
+		UUnrealGPTReplicateClient::CancelAll();
+		Settings->bEnableReplicateTool = bWasEnabled;
+		Settings->ReplicateApiToken = OldToken;
+		Settings->ReplicateApiUrl = OldUrl;
+		return true;
+	}));
+
+	return true;
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
 